@@ -4,9 +4,9 @@
 #include <cstdio>
 #include <cstring>
 #include <cmath>
-#include "hardware/gpio.h"
 #include "pico/time.h"
-#include "hardware/sync.h"
+#include "adc/hx711_pio.h"
+#include "adc/load_cell_filter.h"
 
 namespace adc {
 
@@ -22,9 +22,22 @@ struct calibration_point {
     float known_weight_lbs;
 };
 
+/**
+ * @brief HX711 load cell ADC, sampled by PIO + DMA
+ *
+ * Conversions are clocked out by a PIO state machine and land in a DMA ring
+ * (see hx711_pio.h). update() only drains new ring entries through the
+ * streaming LoadCellFilter, so it never waits for the ADC, never disables
+ * interrupts and reports a new value as soon as one conversion lands.
+ * read_raw() is the one blocking call, used for console calibration: it
+ * sleeps until the oldest unread conversion is available. Calibration
+ * flushes the ring first so it only averages conversions taken after the
+ * call.
+ */
 class HX711 {
 private:
-    static constexpr uint32_t CLOCK_DELAY_US = 1;
+    static constexpr uint32_t READ_TIMEOUT_US = 1'000'000;
+    static constexpr uint32_t STALE_TIMEOUT_US = 500'000;  // 10 SPS -> 5 missed conversions
 
     static constexpr uint8_t DEFAULT_DATA_PIN = 6;
     static constexpr uint8_t DEFAULT_SCK_PIN = 7;
@@ -43,54 +56,34 @@ private:
     static constexpr uint8_t OVERSAMPLE_COUNT = 16;
     static constexpr uint8_t MAX_OVERSAMPLE_SIZE = 64;
 
+    HX711Pio reader;
+    LoadCellFilter filter;
+    uint32_t last_sample_us = 0;
+
     static constexpr uint8_t MAX_CALIBRATION_POINTS = 8;
     calibration_point calibration_points[MAX_CALIBRATION_POINTS];
     uint8_t calibration_count = 0;
     
-    static int32_t convert_to_signed(uint32_t raw) {
-        if (raw & 0x800000) {
-            return static_cast<int32_t>(raw | 0xFF000000);
-        }
-        return static_cast<int32_t>(raw & 0x00FFFFFF);
+    void publish(int32_t raw) {
+        current_data.raw_value = raw;
+        current_data.tared_value = raw + tare_offset;
+        current_data.weight = static_cast<float>(current_data.tared_value) / scale_factor;
+        current_data.valid = true;
     }
 
 public:
+    // Oldest unread conversion; blocks (sleeping, interrupts enabled) while
+    // the ring is empty
     bool read_raw(int32_t& value) {
-        uint32_t timeout = 0;
-        while (gpio_get(DATA)) {
-            sleep_us(100);
-            if (++timeout > 10000) {
+        uint32_t start = time_us_32();
+        while (!reader.pop(value)) {
+            if (time_us_32() - start > READ_TIMEOUT_US) {
                 printf("HX711: Timeout waiting for data ready\n");
                 return false;
             }
+            sleep_ms(1);
         }
-        
-        uint32_t interrupts = save_and_disable_interrupts();
-        uint32_t raw_data = 0;
-        
-        for (int i = 0; i < 24; i++) {
-            gpio_put(SCK, true);
-            busy_wait_us(CLOCK_DELAY_US);
-            
-            raw_data = (raw_data << 1);
-            if (gpio_get(DATA)) {
-                raw_data |= 1;
-            }
-            
-            gpio_put(SCK, false);
-            busy_wait_us(CLOCK_DELAY_US);
-        }
-        
-        for (int i = 0; i < gain_pulses; i++) {
-            gpio_put(SCK, true);
-            busy_wait_us(CLOCK_DELAY_US);
-            gpio_put(SCK, false);
-            busy_wait_us(CLOCK_DELAY_US);
-        }
-        
-        restore_interrupts(interrupts);
-        value = convert_to_signed(raw_data);
-        
+        last_sample_us = time_us_32();
         return true;
     }
 
@@ -105,69 +98,41 @@ public:
             return true;
         }
         
-        gpio_init(DATA);
-        gpio_init(SCK);
-        
-        gpio_set_dir(SCK, GPIO_IN);
-        gpio_set_dir(SCK, GPIO_OUT);
-        
-        gpio_pull_up(DATA);
-        
-        gpio_put(SCK, false);
-        
+        if (!reader.init(DATA, SCK, gain_pulses)) {
+            return false;
+        }
+
+        // Wait out the power-up settling time; the first conversion is discarded
         sleep_ms(400);
-    
         int32_t dummy;
         read_raw(dummy);
-        
+        filter.reset();
+
         initialized = true;
         printf("HX711: Initialized (data: GPIO%d, clock: GPIO%d)\n", DATA, SCK);
         
         return true;
     }
     
-    void update(uint16_t samples = OVERSAMPLE_COUNT) {
+    void update() {
         if (!initialized) {
             current_data.valid = false;
             return;
         }
 
-        if (samples > MAX_OVERSAMPLE_SIZE) {
-            printf("HX711: Warning - samples (%u) exceeds MAX_OVERSAMPLE_SIZE (%u), clamping to maximum\n", samples, MAX_OVERSAMPLE_SIZE);
-            samples = MAX_OVERSAMPLE_SIZE;
-        }
-
-        int64_t sum = 0;
-        int32_t current_reading = 0;
-        int success_count = 0;
-        int attempt_count = 0;
-        const int max_attempts = samples * 2; 
-
-        while (success_count < samples) {
-            if (read_raw(current_reading)) {
-                sum += current_reading;
-                success_count++;
-            }
-
-            attempt_count++;
-            if (attempt_count >= max_attempts) {
-                break;
+        // Non-blocking: stream whatever the DMA ring collected since last call
+        int32_t sample;
+        int32_t filtered;
+        while (reader.pop(sample)) {
+            last_sample_us = time_us_32();
+            if (filter.push(sample, filtered)) {
+                publish(filtered);
             }
         }
 
-        if (success_count < samples) {
-            printf("HX711: Failed to get enough samples. (%d/%u collected after %d attempts)\n", 
-                   success_count, samples, attempt_count);
+        if (time_us_32() - last_sample_us > STALE_TIMEOUT_US) {
             current_data.valid = false;
-            return;
         }
-
-        int32_t raw = sum / samples;
-
-        current_data.raw_value = raw;
-        current_data.tared_value = raw + tare_offset;
-        current_data.weight = static_cast<float>(current_data.tared_value) / scale_factor;
-        current_data.valid = true;
     }
     
     void zero() {
@@ -196,57 +161,38 @@ public:
             samples = MAX_OVERSAMPLE_SIZE;
         }
 
-        int32_t temp_samples[MAX_OVERSAMPLE_SIZE];
+        // Same streaming Hampel stage as live readings, averaged over the whole set
+        LoadCellFilter cal_filter({
+            .mode = LoadCellFilter::Mode::Hampel,
+            .average_window = samples,
+        });
+        int32_t averaged_raw = 0;
         int error_count = 0;
         int success_count = 0;
 
+        // The ring still holds conversions from before the weight was placed
+        reader.flush();
+
         while (success_count < samples) {
-            if (!read_raw(temp_samples[success_count])) {
+            int32_t sample;
+            if (!read_raw(sample)) {
                 if (++error_count >= samples) {
                     printf("HX711: Failed to gather calibration samples\n");
                     return false;
                 }
                 continue;
             }
+            printf("%d\n", sample);
+            cal_filter.push(sample, averaged_raw);
             success_count++;
         }
 
-        int64_t sum = 0;
-        for (uint8_t i = 0; i < samples; i++) {
-            sum += temp_samples[i];
-            printf("%d\n", temp_samples[i]);
-        }
-        float mean = static_cast<float>(sum) / samples;
-
-        float variance_sum = 0.0f;
-        for (uint8_t i = 0; i < samples; i++) {
-            float diff = temp_samples[i] - mean;
-            variance_sum += diff * diff;
-        }
-        float std_dev = sqrtf(variance_sum / samples);
-
-        int64_t filtered_sum = 0;
-        uint8_t filtered_count = 0;
-        for (uint8_t i = 0; i < samples; i++) {
-            float diff = temp_samples[i] - mean;
-            if (diff >= -std_dev && diff <= std_dev) {
-                filtered_sum += temp_samples[i];
-                filtered_count++;
-            }
-        }
-
-        if (filtered_count == 0) {
-            printf("HX711: No valid samples after filtering\n");
-            return false;
-        }
-
-        int32_t averaged_raw = filtered_sum / filtered_count;
         calibration_points[calibration_count].raw_reading = averaged_raw;
         calibration_points[calibration_count].known_weight_lbs = weight_lbs;
         calibration_count++;
 
-        printf("HX711: Calibration point %u: raw=%d, weight=%.3f lbs (filtered %u/%u samples)\n",
-               calibration_count, averaged_raw, weight_lbs, filtered_count, samples);
+        printf("HX711: Calibration point %u: raw=%d, weight=%.3f lbs (%lu/%u samples rejected)\n",
+               calibration_count, averaged_raw, weight_lbs, (unsigned long)cal_filter.rejected(), samples);
 
         return true;
     }
@@ -301,11 +247,21 @@ public:
     int32_t tared() const { return current_data.tared_value; }
     float weight() const { return current_data.weight; }
     bool valid() const { return current_data.valid; }
+    uint32_t overruns() const { return reader.overruns(); }
+    uint32_t rejected() const { return filter.rejected(); }
+
+    // Takes effect immediately; the new stage starts from an empty window
+    void set_filter(const LoadCellFilter::Config& config) { filter.configure(config); }
+    const LoadCellFilter::Config& filter_config() const { return filter.config(); }
 
     void set_scale(float scale) { scale_factor = scale; }
     void set_offset(int32_t offset) { tare_offset = offset; }
-    void set_gain(uint8_t gain) { gain_pulses = gain; }
+    void set_gain(uint8_t gain) {
+        gain_pulses = gain;
+        reader.set_gain_pulses(gain);
+    }
 
+    uint8_t get_gain() const { return gain_pulses; }
     float get_scale() { return scale_factor; }
     uint32_t get_offset() { return tare_offset; }
 };
@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file hx711_pio.h
+ * @brief HX711 acquisition on a PIO state machine with a DMA ring
+ *
+ * The hx711 PIO program waits for data-ready, clocks out 24 bits plus the
+ * gain pulses and pushes each sample into its RX FIFO. A DMA channel paced
+ * by that FIFO writes samples into a ring buffer (hardware address wrap), so
+ * acquisition costs no CPU time and never masks interrupts.
+ *
+ * The consumer tracks its own read index against the number of transfers the
+ * DMA channel has completed; if it falls RING_SIZE or more samples behind,
+ * the oldest samples are dropped and counted as overruns.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/pio.h"
+
+#include "hx711.pio.h"
+
+namespace adc {
+
+class HX711Pio {
+public:
+    static constexpr size_t RING_SIZE = 64;     // Samples, power of 2
+    static constexpr uint32_t RING_MASK = RING_SIZE - 1;
+
+private:
+    static constexpr size_t RING_BYTES = RING_SIZE * sizeof(uint32_t);
+    static constexpr uint RING_BITS = 8;        // log2(RING_BYTES)
+    static_assert((1u << RING_BITS) == RING_BYTES, "RING_BITS must match the ring size");
+
+    // TRANS_COUNT is 28 bits on RP2350; ~38 days at 80 SPS before a re-arm
+    static constexpr uint32_t TRANSFER_COUNT = 0x0FFFFFFF;
+
+    // DMA ring wrap requires natural alignment of the buffer
+    alignas(RING_BYTES) volatile uint32_t ring_[RING_SIZE]{};
+
+    PIO pio_ = nullptr;
+    uint sm_ = 0;
+    uint offset_ = 0;
+    int dma_channel_ = -1;
+
+    uint32_t armed_at_ = 0;     // Samples completed before the current DMA run
+    uint32_t read_count_ = 0;   // Samples consumed, monotonic
+    uint32_t overruns_ = 0;
+
+    static int32_t sign_extend(uint32_t raw) {
+        return static_cast<int32_t>(raw << 8) >> 8;
+    }
+
+    void arm_dma(uint32_t start_slot) {
+        dma_channel_config cfg = dma_channel_get_default_config(dma_channel_);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+        channel_config_set_read_increment(&cfg, false);             // Fixed RX FIFO
+        channel_config_set_write_increment(&cfg, true);
+        channel_config_set_ring(&cfg, true, RING_BITS);             // Wrap writes
+        channel_config_set_dreq(&cfg, pio_get_dreq(pio_, sm_, false));
+
+        dma_channel_configure(dma_channel_, &cfg,
+                              const_cast<uint32_t*>(&ring_[start_slot & RING_MASK]),
+                              &pio_->rxf[sm_],
+                              TRANSFER_COUNT,
+                              true);
+    }
+
+    // Samples written since init, monotonic
+    uint32_t write_count() {
+        const uint32_t remaining = dma_channel_hw_addr(dma_channel_)->transfer_count;
+        const uint32_t written = armed_at_ + (TRANSFER_COUNT - remaining);
+
+        // Run exhausted: restart at the ring slot the last transfer left off
+        if (remaining == 0 && !dma_channel_is_busy(dma_channel_)) {
+            armed_at_ = written;
+            arm_dma(written);
+        }
+        return written;
+    }
+
+public:
+    HX711Pio() = default;
+    HX711Pio(const HX711Pio&) = delete;
+    HX711Pio& operator=(const HX711Pio&) = delete;
+
+    ~HX711Pio() { deinit(); }
+
+    bool init(uint data_pin, uint sck_pin, uint8_t gain_pulses) {
+        if (dma_channel_ >= 0) {
+            return true;
+        }
+
+        const uint pin_base = data_pin < sck_pin ? data_pin : sck_pin;
+        const uint pin_count = (data_pin < sck_pin ? sck_pin - data_pin : data_pin - sck_pin) + 1;
+        if (!pio_claim_free_sm_and_add_program_for_gpio_range(&hx711_program, &pio_, &sm_, &offset_,
+                                                               pin_base, pin_count, true)) {
+            printf("HX711: No free PIO state machine\n");
+            return false;
+        }
+
+        dma_channel_ = dma_claim_unused_channel(false);
+        if (dma_channel_ < 0) {
+            printf("HX711: No free DMA channel\n");
+            pio_remove_program_and_unclaim_sm(&hx711_program, pio_, sm_, offset_);
+            return false;
+        }
+
+        hx711_program_init(pio_, sm_, offset_, data_pin, sck_pin);
+        pio_sm_exec(pio_, sm_, pio_encode_set(pio_y, gain_pulses - 1));
+
+        armed_at_ = 0;
+        read_count_ = 0;
+        overruns_ = 0;
+        arm_dma(0);
+        pio_sm_set_enabled(pio_, sm_, true);
+        return true;
+    }
+
+    void deinit() {
+        if (dma_channel_ < 0) {
+            return;
+        }
+        pio_sm_set_enabled(pio_, sm_, false);
+        dma_channel_abort(dma_channel_);
+        dma_channel_unclaim(dma_channel_);
+        pio_remove_program_and_unclaim_sm(&hx711_program, pio_, sm_, offset_);
+        dma_channel_ = -1;
+    }
+
+    // Gain/channel for the next conversion: 1 = A/128, 2 = B/32, 3 = A/64
+    void set_gain_pulses(uint8_t gain_pulses) {
+        if (dma_channel_ < 0 || gain_pulses < 1 || gain_pulses > 3) {
+            return;
+        }
+        pio_sm_set_enabled(pio_, sm_, false);
+        pio_sm_exec(pio_, sm_, pio_encode_set(pio_y, gain_pulses - 1));
+        pio_sm_set_enabled(pio_, sm_, true);
+    }
+
+    // Unread samples; drops (and counts) anything the ring already overwrote.
+    // At most RING_SIZE - 1: the slot the DMA writes next is never handed
+    // out, as the next conversion may land in it while it is being read.
+    size_t available() {
+        if (dma_channel_ < 0) {
+            return 0;
+        }
+        const uint32_t written = write_count();
+        if (written - read_count_ >= RING_SIZE) {
+            overruns_ += written - read_count_ - (RING_SIZE - 1);
+            read_count_ = written - (RING_SIZE - 1);
+        }
+        return written - read_count_;
+    }
+
+    // Oldest unread sample, non-blocking
+    bool pop(int32_t& value) {
+        if (available() == 0) {
+            return false;
+        }
+        value = sign_extend(ring_[read_count_ & RING_MASK]);
+        read_count_++;
+        return true;
+    }
+
+    // Drops every unread sample, so the next pop() returns a conversion
+    // completed after this call. Not counted as an overrun.
+    void flush() {
+        if (dma_channel_ >= 0) {
+            read_count_ = write_count();
+        }
+    }
+
+    uint32_t sample_count() { return dma_channel_ >= 0 ? write_count() : 0; }
+    uint32_t overruns() const { return overruns_; }
+    bool running() const { return dma_channel_ >= 0; }
+};
+
+} // namespace adc
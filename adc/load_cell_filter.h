@@ -0,0 +1,247 @@
+#pragma once
+
+/**
+ * @file load_cell_filter.h
+ * @brief Streaming filters for raw HX711 counts
+ *
+ * Every stage consumes one sample at a time and keeps its own history, so a
+ * new output is available as soon as a conversion lands instead of after a
+ * fresh batch of N readings. Work per sample is constant: the averages are
+ * running sums, the median keeps a sorted copy of a small bounded window.
+ *
+ *   Average  Moving average over `average_window` samples.
+ *   Median   Running median over `median_window` samples.
+ *   Hampel   Replaces samples further than k * 1.4826 * MAD from the running
+ *            median with the median, then averages like Average.
+ *   CIC      Order-`cic_order` CIC decimator by `cic_decimation`; for the
+ *            HX711 at 80 SPS (RATE high), 8 gives 10 outputs per second.
+ *
+ * Example Usage:
+ *
+ *   adc::LoadCellFilter filter({.mode = adc::LoadCellFilter::Mode::Hampel});
+ *   int32_t out;
+ *   if (filter.push(raw, out)) { ... }
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace adc {
+
+enum class LoadCellFilterMode : uint8_t {
+    Average,
+    Median,
+    Hampel,
+    CIC,
+};
+
+struct LoadCellFilterConfig {
+    LoadCellFilterMode mode = LoadCellFilterMode::Hampel;
+    uint8_t average_window = 16;
+    uint8_t median_window = 7;          // Odd, also the Hampel window
+    uint8_t hampel_k_x10 = 30;          // Threshold in MADs, x10
+    uint8_t cic_decimation = 8;
+    uint8_t cic_order = 3;
+};
+
+class LoadCellFilter {
+public:
+    using Mode = LoadCellFilterMode;
+    using Config = LoadCellFilterConfig;
+
+    static constexpr uint8_t MAX_AVERAGE_WINDOW = 64;
+    static constexpr uint8_t MAX_MEDIAN_WINDOW = 15;
+    static constexpr uint8_t MAX_CIC_ORDER = 4;
+
+private:
+    // 24-bit samples grow by log2(decimation) bits per stage; the state wraps
+    // modulo 2^64 and the comb output is exact while the true value fits
+    static constexpr uint32_t SAMPLE_BITS = 24;
+    static constexpr uint32_t MAX_DECIMATION_BITS = 8;
+    static_assert(SAMPLE_BITS + MAX_CIC_ORDER * MAX_DECIMATION_BITS <= 64, "CIC bit growth exceeds the 64-bit state");
+
+    Config config_;
+
+    // Moving average
+    int32_t average_ring_[MAX_AVERAGE_WINDOW]{};
+    int64_t average_sum_ = 0;
+    uint8_t average_index_ = 0;
+    uint8_t average_count_ = 0;
+
+    // Running median: insertion-order ring plus a sorted copy
+    int32_t median_ring_[MAX_MEDIAN_WINDOW]{};
+    int32_t median_sorted_[MAX_MEDIAN_WINDOW]{};
+    uint8_t median_index_ = 0;
+    uint8_t median_count_ = 0;
+
+    // CIC
+    uint64_t cic_integrators_[MAX_CIC_ORDER]{};
+    uint64_t cic_combs_[MAX_CIC_ORDER]{};
+    uint8_t cic_phase_ = 0;
+    uint8_t cic_outputs_ = 0;
+    int64_t cic_gain_ = 1;
+
+    uint32_t rejected_ = 0;
+
+    int32_t average(int32_t sample) {
+        if (average_count_ == config_.average_window) {
+            average_sum_ -= average_ring_[average_index_];
+        } else {
+            average_count_++;
+        }
+        average_ring_[average_index_] = sample;
+        average_sum_ += sample;
+        average_index_ = (average_index_ + 1) % config_.average_window;
+        return static_cast<int32_t>(average_sum_ / average_count_);
+    }
+
+    int32_t median(int32_t sample) {
+        int32_t* sorted = median_sorted_;
+
+        if (median_count_ == config_.median_window) {
+            int32_t* old = std::lower_bound(sorted, sorted + median_count_, median_ring_[median_index_]);
+            std::memmove(old, old + 1, (sorted + median_count_ - old - 1) * sizeof(int32_t));
+            median_count_--;
+        }
+        int32_t* pos = std::upper_bound(sorted, sorted + median_count_, sample);
+        std::memmove(pos + 1, pos, (sorted + median_count_ - pos) * sizeof(int32_t));
+        *pos = sample;
+        median_count_++;
+
+        median_ring_[median_index_] = sample;
+        median_index_ = (median_index_ + 1) % config_.median_window;
+        return sorted[median_count_ / 2];
+    }
+
+    // Median absolute deviation from the sorted window: the deviations on
+    // each side of the median are already ordered, so merge-walk to the middle
+    int32_t mad() const {
+        const int32_t* sorted = median_sorted_;
+        const int mid = median_count_ / 2;
+        const int32_t med = sorted[mid];
+
+        int lo = mid - 1;
+        int hi = mid + 1;
+        int32_t deviation = 0;    // The median itself
+        for (int k = 0; k < mid; ++k) {
+            const int32_t left = lo >= 0 ? med - sorted[lo] : INT32_MAX;
+            const int32_t right = hi < median_count_ ? sorted[hi] - med : INT32_MAX;
+            if (left <= right) {
+                deviation = left;
+                lo--;
+            } else {
+                deviation = right;
+                hi++;
+            }
+        }
+        return deviation;
+    }
+
+    int32_t hampel(int32_t sample) {
+        const int32_t med = median(sample);
+        if (median_count_ < config_.median_window) {
+            return sample;
+        }
+        const int64_t threshold = static_cast<int64_t>(mad()) * config_.hampel_k_x10 * 14826 / 100000;
+        const int64_t deviation = sample > med ? static_cast<int64_t>(sample) - med : static_cast<int64_t>(med) - sample;
+        if (deviation > threshold) {
+            rejected_++;
+            return med;
+        }
+        return sample;
+    }
+
+    bool cic(int32_t sample, int32_t& out) {
+        uint64_t value = static_cast<uint64_t>(static_cast<int64_t>(sample));
+        for (uint8_t i = 0; i < config_.cic_order; ++i) {
+            cic_integrators_[i] += value;
+            value = cic_integrators_[i];
+        }
+        if (++cic_phase_ < config_.cic_decimation) {
+            return false;
+        }
+        cic_phase_ = 0;
+
+        for (uint8_t i = 0; i < config_.cic_order; ++i) {
+            const uint64_t delayed = cic_combs_[i];
+            cic_combs_[i] = value;
+            value -= delayed;
+        }
+        out = static_cast<int32_t>(static_cast<int64_t>(value) / cic_gain_);
+        if (cic_outputs_ < config_.cic_order) {
+            cic_outputs_++;
+        }
+        return true;
+    }
+
+public:
+    explicit LoadCellFilter(const Config& config = Config{}) {
+        configure(config);
+    }
+
+    void configure(const Config& config) {
+        config_ = config;
+        config_.average_window = std::clamp<uint8_t>(config_.average_window, 1, MAX_AVERAGE_WINDOW);
+        config_.median_window = std::clamp<uint8_t>(config_.median_window | 1, 3, MAX_MEDIAN_WINDOW);
+        config_.cic_decimation = std::max<uint8_t>(config_.cic_decimation, 1);
+        config_.cic_order = std::clamp<uint8_t>(config_.cic_order, 1, MAX_CIC_ORDER);
+
+        cic_gain_ = 1;
+        for (uint8_t i = 0; i < config_.cic_order; ++i) {
+            cic_gain_ *= config_.cic_decimation;
+        }
+        reset();
+    }
+
+    void reset() {
+        average_sum_ = 0;
+        average_index_ = 0;
+        average_count_ = 0;
+        median_index_ = 0;
+        median_count_ = 0;
+        std::fill(std::begin(cic_integrators_), std::end(cic_integrators_), 0);
+        std::fill(std::begin(cic_combs_), std::end(cic_combs_), 0);
+        cic_phase_ = 0;
+        cic_outputs_ = 0;
+        rejected_ = 0;
+    }
+
+    // Feed one raw sample; returns true when `out` holds a new output
+    bool push(int32_t sample, int32_t& out) {
+        switch (config_.mode) {
+            case Mode::Average: out = average(sample);         return true;
+            case Mode::Median:  out = median(sample);          return true;
+            case Mode::Hampel:  out = average(hampel(sample)); return true;
+            case Mode::CIC:     return cic(sample, out);
+        }
+        return false;
+    }
+
+    // Full window since reset (CIC: comb transient flushed)
+    bool settled() const {
+        switch (config_.mode) {
+            case Mode::Average: return average_count_ == config_.average_window;
+            case Mode::Median:  return median_count_ == config_.median_window;
+            case Mode::Hampel:  return average_count_ == config_.average_window;
+            case Mode::CIC:     return cic_outputs_ == config_.cic_order;
+        }
+        return false;
+    }
+
+    const Config& config() const { return config_; }
+    uint32_t rejected() const { return rejected_; }
+
+    static const char* mode_name(Mode mode) {
+        switch (mode) {
+            case Mode::Average: return "average";
+            case Mode::Median:  return "median";
+            case Mode::Hampel:  return "hampel";
+            case Mode::CIC:     return "cic";
+        }
+        return "?";
+    }
+};
+
+} // namespace adc
@@ -0,0 +1,440 @@
+#pragma once
+
+/**
+ * @file native_adc.h
+ * @brief Free-running on-chip ADC capture with per-channel decimation
+ *
+ * The ADC converts continuously in round-robin over the selected inputs
+ * (up to 500 kSPS aggregate at the 48 MHz ADC clock). A DMA channel paced by
+ * DREQ_ADC writes every result into a ring buffer using the hardware address
+ * wrap; when it completes a lap it chains to a second channel that re-arms
+ * its transfer count, so capture never stops and the ADC FIFO (4 deep)
+ * absorbs the couple of cycles the reload takes. A DMA IRQ per lap counts
+ * laps so the consumer can tell how far the ring has advanced.
+ *
+ * process() demultiplexes new samples by channel and feeds a decimator per
+ * channel:
+ *
+ *   Boxcar  Sum of `decimation` samples (log2(decimation) extra bits).
+ *   CIC     Order-`cic_order` CIC by `decimation`, normalised to the same
+ *           gain as Boxcar; better alias rejection for the same rate.
+ *
+ * Each channel also tracks the raw min/max since it was last read, so a
+ * transient shorter than one decimated output still shows up.
+ *
+ * process() must run at least once per ring lap (RING_SIZE samples, 8 ms at
+ * 500 kSPS); if it falls further behind, the oldest samples are skipped,
+ * counted as overruns and the decimators restart.
+ *
+ * Example Usage:
+ *
+ *   adc::NativeADC adc;
+ *   adc.init({.input_mask = 0b0011, .sample_rate_hz = 200'000, .decimation = 64});
+ *
+ *   // Core 1 loop
+ *   adc.process();
+ *   int32_t value;
+ *   while (adc.read(0, value)) { float volts = adc.volts_scale().to_float(value); }
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+#include "i2c/i2c_units.h"
+
+namespace adc {
+
+enum class Decimator : uint8_t {
+    Boxcar,
+    CIC,
+};
+
+struct NativeADCConfig {
+    uint8_t input_mask = 0b0001;        // Bit n = ADC input n (GPIO 26 + n; 4 = temperature)
+    uint32_t sample_rate_hz = 200'000;  // Aggregate across all inputs
+    Decimator decimator = Decimator::Boxcar;
+    uint16_t decimation = 64;           // Per channel
+    uint8_t cic_order = 2;
+};
+
+class NativeADC {
+public:
+    using Config = NativeADCConfig;
+
+    static constexpr uint8_t MAX_INPUTS = 5;
+    static constexpr size_t RING_SIZE = 4096;       // Samples, power of 2
+    static constexpr size_t OUTPUT_SIZE = 64;       // Decimated outputs per channel, power of 2
+    static constexpr uint8_t MAX_CIC_ORDER = 3;
+    static constexpr float REFERENCE_VOLTS = 3.3f;
+
+    struct Peak {
+        uint16_t min;
+        uint16_t max;
+    };
+
+    struct Stats {
+        uint32_t samples;       // Raw samples consumed
+        uint32_t outputs;       // Decimated outputs produced, all channels
+        uint32_t overruns;      // Raw samples lost to a slow consumer
+        uint32_t dropped;       // Decimated outputs lost to a full output ring
+    };
+
+private:
+    static constexpr size_t RING_BYTES = RING_SIZE * sizeof(uint16_t);
+    static constexpr uint RING_BITS = 13;           // log2(RING_BYTES)
+    static_assert((1u << RING_BITS) == RING_BYTES, "RING_BITS must match the ring size");
+    static constexpr uint32_t ADC_CLOCK_HZ = 48'000'000;
+    static constexpr uint32_t MIN_CYCLES_PER_SAMPLE = 96;
+
+    // CIC state grows by log2(decimation) bits per stage on top of the 12-bit
+    // sample. The registers wrap modulo 2^64; the comb differences are exact
+    // as long as the true output fits, which this guarantees for any uint16_t
+    // decimation.
+    static constexpr uint32_t SAMPLE_BITS = 12;
+    static constexpr uint32_t MAX_DECIMATION_BITS = 16;
+    static_assert(SAMPLE_BITS + MAX_CIC_ORDER * MAX_DECIMATION_BITS <= 64, "CIC bit growth exceeds the 64-bit state");
+
+    struct Channel {
+        uint8_t input;
+        uint16_t phase;
+        uint64_t integrators[MAX_CIC_ORDER];
+        uint64_t combs[MAX_CIC_ORDER];
+        int64_t boxcar;
+        Peak peak;
+        std::array<int32_t, OUTPUT_SIZE> outputs;
+        uint32_t head;
+        uint32_t tail;
+        int32_t latest;
+    };
+
+    alignas(RING_BYTES) volatile uint16_t ring_[RING_SIZE]{};
+
+    Config config_;
+    std::array<Channel, MAX_INPUTS> channels_{};
+    uint8_t channel_count_ = 0;
+    uint8_t next_slot_ = 0;                 // Round-robin position of the next sample
+    uint64_t cic_normaliser_ = 1;
+
+    int data_channel_ = -1;
+    int reload_channel_ = -1;
+    uint32_t reload_count_ = RING_SIZE;     // Read by the reload channel
+
+    std::atomic<uint32_t> laps_{0};
+    uint32_t last_written_ = 0;
+    uint32_t read_count_ = 0;               // Samples consumed, monotonic
+    Stats stats_{};
+
+    static inline NativeADC* irq_instance_ = nullptr;
+
+    static void dma_irq_handler() {
+        NativeADC* self = irq_instance_;
+        if (self && dma_channel_get_irq1_status(self->data_channel_)) {
+            dma_channel_acknowledge_irq1(self->data_channel_);
+            self->laps_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    // Samples written since start, monotonic: completed laps plus the
+    // position of the write pointer in the current one
+    uint32_t write_count() {
+        uint32_t laps, position;
+        do {
+            laps = laps_.load(std::memory_order_acquire);
+            const uintptr_t address = dma_channel_hw_addr(data_channel_)->write_addr;
+            position = (address - reinterpret_cast<uintptr_t>(ring_)) / sizeof(uint16_t);
+        } while (laps != laps_.load(std::memory_order_acquire));
+
+        // The pointer wraps a moment before the lap IRQ runs: never go backwards
+        uint32_t written = laps * RING_SIZE + (position & (RING_SIZE - 1));
+        if (static_cast<int32_t>(written - last_written_) < 0) {
+            written += RING_SIZE;
+        }
+        last_written_ = written;
+        return written;
+    }
+
+    void reset_decimators() {
+        for (uint8_t i = 0; i < channel_count_; ++i) {
+            Channel& ch = channels_[i];
+            ch.phase = 0;
+            ch.boxcar = 0;
+            for (uint8_t r = 0; r < MAX_CIC_ORDER; ++r) {
+                ch.integrators[r] = 0;
+                ch.combs[r] = 0;
+            }
+        }
+    }
+
+    void emit(Channel& ch, int32_t value) {
+        ch.latest = value;
+        stats_.outputs++;
+        if (ch.head - ch.tail >= OUTPUT_SIZE) {
+            ch.tail++;              // Keep the newest
+            stats_.dropped++;
+        }
+        ch.outputs[ch.head & (OUTPUT_SIZE - 1)] = value;
+        ch.head++;
+    }
+
+    void decimate(Channel& ch, uint16_t sample) {
+        if (sample < ch.peak.min) ch.peak.min = sample;
+        if (sample > ch.peak.max) ch.peak.max = sample;
+
+        if (config_.decimator == Decimator::Boxcar) {
+            ch.boxcar += sample;
+            if (++ch.phase == config_.decimation) {
+                emit(ch, static_cast<int32_t>(ch.boxcar));
+                ch.boxcar = 0;
+                ch.phase = 0;
+            }
+            return;
+        }
+
+        uint64_t value = sample;
+        for (uint8_t r = 0; r < config_.cic_order; ++r) {
+            ch.integrators[r] += value;
+            value = ch.integrators[r];
+        }
+        if (++ch.phase < config_.decimation) {
+            return;
+        }
+        ch.phase = 0;
+        for (uint8_t r = 0; r < config_.cic_order; ++r) {
+            const uint64_t delayed = ch.combs[r];
+            ch.combs[r] = value;
+            value -= delayed;
+        }
+        emit(ch, static_cast<int32_t>(value / cic_normaliser_));
+    }
+
+    Channel* channel_for(uint8_t input) {
+        for (uint8_t i = 0; i < channel_count_; ++i) {
+            if (channels_[i].input == input) {
+                return &channels_[i];
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    NativeADC() = default;
+    NativeADC(const NativeADC&) = delete;
+    NativeADC& operator=(const NativeADC&) = delete;
+
+    ~NativeADC() { deinit(); }
+
+    bool init(const Config& config = Config{}) {
+        if (data_channel_ >= 0) {
+            return true;
+        }
+        if (irq_instance_) {
+            printf("NativeADC: Only one capture instance is supported\n");
+            return false;
+        }
+
+        config_ = config;
+        config_.input_mask &= (1u << MAX_INPUTS) - 1;
+        if (config_.input_mask == 0 || config_.decimation == 0) {
+            printf("NativeADC: Invalid configuration\n");
+            return false;
+        }
+        if (config_.cic_order < 1 || config_.cic_order > MAX_CIC_ORDER) {
+            config_.cic_order = 2;
+        }
+
+        // CIC gain is decimation^order; scale down to the boxcar gain
+        cic_normaliser_ = 1;
+        for (uint8_t r = 1; r < config_.cic_order; ++r) {
+            cic_normaliser_ *= config_.decimation;
+        }
+
+        channel_count_ = 0;
+        for (uint8_t input = 0; input < MAX_INPUTS; ++input) {
+            if (config_.input_mask & (1u << input)) {
+                channels_[channel_count_] = Channel{};
+                channels_[channel_count_].input = input;
+                channels_[channel_count_].peak = Peak{UINT16_MAX, 0};
+                channel_count_++;
+            }
+        }
+
+        data_channel_ = dma_claim_unused_channel(false);
+        reload_channel_ = dma_claim_unused_channel(false);
+        if (data_channel_ < 0 || reload_channel_ < 0) {
+            printf("NativeADC: No free DMA channels\n");
+            deinit();
+            return false;
+        }
+
+        adc_init();
+        for (uint8_t i = 0; i < channel_count_; ++i) {
+            if (channels_[i].input < 4) {
+                adc_gpio_init(26 + channels_[i].input);
+            } else {
+                adc_set_temp_sensor_enabled(true);
+            }
+        }
+        adc_select_input(channels_[0].input);      // Round robin starts here
+        adc_set_round_robin(channel_count_ > 1 ? config_.input_mask : 0);
+        adc_fifo_setup(true, true, 1, false, false);
+
+        uint32_t cycles = ADC_CLOCK_HZ / (config_.sample_rate_hz ? config_.sample_rate_hz : 1);
+        if (cycles < MIN_CYCLES_PER_SAMPLE) {
+            cycles = MIN_CYCLES_PER_SAMPLE;
+        }
+        adc_set_clkdiv(static_cast<float>(cycles - 1));
+
+        // Data channel: FIFO -> ring, one lap per run, chains to the reload
+        dma_channel_config data_cfg = dma_channel_get_default_config(data_channel_);
+        channel_config_set_transfer_data_size(&data_cfg, DMA_SIZE_16);
+        channel_config_set_read_increment(&data_cfg, false);
+        channel_config_set_write_increment(&data_cfg, true);
+        channel_config_set_ring(&data_cfg, true, RING_BITS);
+        channel_config_set_dreq(&data_cfg, DREQ_ADC);
+        channel_config_set_chain_to(&data_cfg, reload_channel_);
+        dma_channel_configure(data_channel_, &data_cfg,
+                              const_cast<uint16_t*>(ring_), &adc_hw->fifo, RING_SIZE, false);
+
+        // Reload channel: rewrite the data channel's count and retrigger it;
+        // the write address carries on from where the ring wrapped
+        dma_channel_config reload_cfg = dma_channel_get_default_config(reload_channel_);
+        channel_config_set_transfer_data_size(&reload_cfg, DMA_SIZE_32);
+        channel_config_set_read_increment(&reload_cfg, false);
+        channel_config_set_write_increment(&reload_cfg, false);
+        dma_channel_configure(reload_channel_, &reload_cfg,
+                              &dma_hw->ch[data_channel_].al1_transfer_count_trig, &reload_count_, 1, false);
+
+        irq_instance_ = this;
+        dma_channel_set_irq1_enabled(data_channel_, true);
+        irq_add_shared_handler(DMA_IRQ_1, &NativeADC::dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+
+        laps_.store(0, std::memory_order_relaxed);
+        last_written_ = 0;
+        read_count_ = 0;
+        next_slot_ = 0;
+        stats_ = Stats{};
+
+        dma_channel_start(data_channel_);
+        adc_run(true);
+
+        printf("NativeADC: Capturing inputs 0x%02X at %lu SPS, %s / %u\n",
+               config_.input_mask, (unsigned long)(ADC_CLOCK_HZ / cycles),
+               config_.decimator == Decimator::CIC ? "CIC" : "boxcar", config_.decimation);
+        return true;
+    }
+
+    void deinit() {
+        if (data_channel_ >= 0 && irq_instance_ == this) {
+            adc_run(false);
+            adc_fifo_drain();
+            dma_channel_set_irq1_enabled(data_channel_, false);
+            irq_remove_handler(DMA_IRQ_1, &NativeADC::dma_irq_handler);
+            irq_instance_ = nullptr;
+        }
+        if (reload_channel_ >= 0) {
+            dma_channel_abort(reload_channel_);
+            dma_channel_unclaim(reload_channel_);
+            reload_channel_ = -1;
+        }
+        if (data_channel_ >= 0) {
+            dma_channel_abort(data_channel_);
+            dma_channel_unclaim(data_channel_);
+            data_channel_ = -1;
+        }
+    }
+
+    // Consumer: demux and decimate everything captured since the last call.
+    // Returns the number of raw samples consumed.
+    size_t process() {
+        if (data_channel_ < 0) {
+            return 0;
+        }
+        const uint32_t written = write_count();
+        if (written - read_count_ > RING_SIZE) {
+            const uint32_t skip_to = written - RING_SIZE;
+            const uint32_t skipped = skip_to - read_count_;
+            stats_.overruns += skipped;
+            next_slot_ = static_cast<uint8_t>((next_slot_ + skipped % channel_count_) % channel_count_);
+            read_count_ = skip_to;
+            reset_decimators();
+        }
+
+        const size_t count = written - read_count_;
+        for (; read_count_ != written; ++read_count_) {
+            // Tracked separately: the 32-bit sample count wrapping is not a
+            // multiple of 3, 5 or 6 channels
+            Channel& ch = channels_[next_slot_];
+            if (++next_slot_ == channel_count_) {
+                next_slot_ = 0;
+            }
+            decimate(ch, ring_[read_count_ & (RING_SIZE - 1)] & 0x0FFF);
+        }
+        stats_.samples += count;
+        return count;
+    }
+
+    // Oldest unread decimated output for an ADC input
+    bool read(uint8_t input, int32_t& value) {
+        Channel* ch = channel_for(input);
+        if (!ch || ch->head == ch->tail) {
+            return false;
+        }
+        value = ch->outputs[ch->tail & (OUTPUT_SIZE - 1)];
+        ch->tail++;
+        return true;
+    }
+
+    // Newest decimated output, without consuming
+    int32_t latest(uint8_t input) {
+        Channel* ch = channel_for(input);
+        return ch ? ch->latest : 0;
+    }
+
+    // Raw 12-bit extremes since the last call; restarts the window
+    Peak take_peak(uint8_t input) {
+        Channel* ch = channel_for(input);
+        if (!ch) {
+            return Peak{0, 0};
+        }
+        Peak peak = ch->peak;
+        ch->peak = Peak{UINT16_MAX, 0};
+        return peak;
+    }
+
+    // Decimated output -> volts at the ADC pin
+    i2c::units::Scale volts_scale() const {
+        return i2c::units::Scale{REFERENCE_VOLTS / (4096.0 * config_.decimation), 0.0};
+    }
+
+    // Raw 12-bit sample -> volts at the ADC pin
+    static constexpr i2c::units::Scale raw_volts_scale() {
+        return i2c::units::Scale{REFERENCE_VOLTS / 4096.0, 0.0};
+    }
+
+    uint32_t output_rate_hz() const {
+        uint32_t cycles = ADC_CLOCK_HZ / (config_.sample_rate_hz ? config_.sample_rate_hz : 1);
+        if (cycles < MIN_CYCLES_PER_SAMPLE) {
+            cycles = MIN_CYCLES_PER_SAMPLE;
+        }
+        return ADC_CLOCK_HZ / cycles / channel_count_ / config_.decimation;
+    }
+
+    const Config& config() const { return config_; }
+    Stats stats() const { return stats_; }
+
+    void print_stats() const {
+        printf("NativeADC: %lu samples, %lu outputs (%lu Hz/ch), %lu overruns, %lu dropped\n",
+               (unsigned long)stats_.samples, (unsigned long)stats_.outputs,
+               (unsigned long)output_rate_hz(), (unsigned long)stats_.overruns, (unsigned long)stats_.dropped);
+    }
+};
+
+} // namespace adc
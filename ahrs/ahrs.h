@@ -0,0 +1,250 @@
+#pragma once
+
+/**
+ * @file ahrs.h
+ * @brief Attitude estimator fed by ICM20948 samples
+ *
+ * Samples are pushed from the I2C polling callback (timer IRQ context) into
+ * a single-producer/single-consumer ring. Core 1 drains the ring in batches
+ * with process(), runs the selected filter once per sample and publishes the
+ * attitude at the configured rate. Every filter update is timed with the
+ * cycle counter and checked against a per-update budget; the owner must
+ * call cycles::enable() on the core that runs process().
+ *
+ * Example Usage:
+ *
+ *   ahrs::Estimator estimator({.filter = ahrs::FilterType::Madgwick, .publish_rate_hz = 50});
+ *   estimator.set_publish_callback([](const ahrs::Attitude& att) { ... });
+ *
+ *   SensorBus::add_device<i2c::drivers::ICM20948>([&](const icm20948_data& d) { estimator.push(d); });
+ *
+ *   // Core 1 loop
+ *   estimator.process();
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+#include "pico/time.h"
+
+#include "ahrs/filters.h"
+#include "common/cycle_counter.h"
+#include "i2c/i2c_config.h"
+
+namespace ahrs {
+
+enum class FilterType : uint8_t {
+    Complementary,
+    Madgwick,
+    Mahony,
+};
+
+struct Config {
+    FilterType filter = FilterType::Madgwick;
+    uint32_t sample_rate_hz = 500;      // IMU poll rate, up to 1 kHz
+    uint32_t publish_rate_hz = 50;
+    uint32_t cycle_budget = 15'000;     // Per filter update, 100 us at 150 MHz
+
+    float alpha = 0.98f;                // Complementary
+    float beta = 0.1f;                  // Madgwick
+    float kp = 1.0f;                    // Mahony
+    float ki = 0.0f;                    // Mahony
+};
+
+struct Attitude {
+    Quaternion q;
+    Euler euler;
+    uint32_t timestamp_us;
+};
+
+struct Stats {
+    uint32_t updates;
+    uint32_t dropped;           // Ring full at push
+    uint32_t budget_overruns;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+    uint32_t published;
+};
+
+class Estimator {
+private:
+    struct Sample {
+        i2c::drivers::icm20948_data imu;
+        uint32_t timestamp_us;
+    };
+
+    static constexpr size_t RING_SIZE = 32;     // Power of 2
+    static constexpr size_t RING_MASK = RING_SIZE - 1;
+
+    // Clamp on dt so a stalled producer does not integrate a huge step
+    static constexpr float MAX_DT_S = 0.05f;
+
+    Config config_;
+    ComplementaryFilter complementary_;
+    MadgwickFilter madgwick_;
+    MahonyFilter mahony_;
+
+    std::array<Sample, RING_SIZE> ring_{};
+    std::atomic<uint32_t> head_{0};     // Written by push()
+    std::atomic<uint32_t> tail_{0};     // Written by process()
+
+    std::function<void(const Attitude&)> publish_callback_;
+    i2c::drivers::icm20948_data last_imu_{};
+    uint32_t last_sample_us_ = 0;
+    uint32_t last_publish_us_ = 0;
+    bool have_sample_ = false;
+
+    Stats stats_{};
+    std::atomic<uint32_t> dropped_{0};
+
+    void apply_config() {
+        complementary_.alpha = config_.alpha;
+        madgwick_.beta = config_.beta;
+        mahony_.kp = config_.kp;
+        mahony_.ki = config_.ki;
+    }
+
+    void run_filter(const Vec3& gyro, const Vec3& accel, float dt) {
+        switch (config_.filter) {
+            case FilterType::Complementary: complementary_.update(gyro, accel, dt); break;
+            case FilterType::Madgwick:      madgwick_.update(gyro, accel, dt);      break;
+            case FilterType::Mahony:        mahony_.update(gyro, accel, dt);        break;
+        }
+    }
+
+    void update_one(const Sample& sample) {
+        using Data = i2c::drivers::icm20948_data;
+
+        // Lazy conversion: raw counts to SI only here, where they are consumed
+        const Vec3 gyro{Data::gyro_scale.to_float(sample.imu.gyro[0]),
+                        Data::gyro_scale.to_float(sample.imu.gyro[1]),
+                        Data::gyro_scale.to_float(sample.imu.gyro[2])};
+        const Vec3 accel{Data::accel_scale.to_float(sample.imu.accel[0]),
+                         Data::accel_scale.to_float(sample.imu.accel[1]),
+                         Data::accel_scale.to_float(sample.imu.accel[2])};
+
+        float dt = have_sample_ ? (sample.timestamp_us - last_sample_us_) * 1e-6f
+                                : 1.0f / config_.sample_rate_hz;
+        if (dt <= 0.0f || dt > MAX_DT_S) {
+            dt = 1.0f / config_.sample_rate_hz;
+        }
+        last_sample_us_ = sample.timestamp_us;
+        last_imu_ = sample.imu;
+        have_sample_ = true;
+
+        const uint32_t start = cycles::now();
+        run_filter(gyro, accel, dt);
+        const uint32_t spent = cycles::now() - start;
+
+        stats_.updates++;
+        stats_.last_cycles = spent;
+        if (spent > stats_.max_cycles) stats_.max_cycles = spent;
+        if (spent > config_.cycle_budget) stats_.budget_overruns++;
+    }
+
+public:
+    explicit Estimator(const Config& config = Config{}) : config_(config) {
+        apply_config();
+    }
+
+    // Producer side (IRQ context). Returns false if the ring is full.
+    bool push(const i2c::drivers::icm20948_data& imu) {
+        return push(imu, time_us_32());
+    }
+
+    // Replay with recorded timestamps
+    bool push(const i2c::drivers::icm20948_data& imu, uint32_t timestamp_us) {
+        if (!imu.valid) {
+            return false;
+        }
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= RING_SIZE) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        ring_[head & RING_MASK] = Sample{imu, timestamp_us};
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side (Core 1). Drains every queued sample; returns the count.
+    size_t process() {
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t count = head - tail;
+
+        for (; tail != head; ++tail) {
+            update_one(ring_[tail & RING_MASK]);
+        }
+        tail_.store(tail, std::memory_order_release);
+
+        if (count > 0 && config_.publish_rate_hz > 0) {
+            const uint32_t period_us = 1'000'000 / config_.publish_rate_hz;
+            if (last_sample_us_ - last_publish_us_ >= period_us) {
+                last_publish_us_ = last_sample_us_;
+                stats_.published++;
+                if (publish_callback_) {
+                    publish_callback_(attitude());
+                }
+            }
+        }
+        return count;
+    }
+
+    Attitude attitude() const {
+        const Quaternion& q = quaternion();
+        return Attitude{q, q.to_euler(), last_sample_us_};
+    }
+
+    const Quaternion& quaternion() const {
+        switch (config_.filter) {
+            case FilterType::Complementary: return complementary_.quaternion();
+            case FilterType::Mahony:        return mahony_.quaternion();
+            case FilterType::Madgwick:
+            default:                        return madgwick_.quaternion();
+        }
+    }
+
+    // Most recent raw sample consumed by the filter
+    const i2c::drivers::icm20948_data& last_sample() const { return last_imu_; }
+
+    void set_publish_callback(std::function<void(const Attitude&)> cb) {
+        publish_callback_ = std::move(cb);
+    }
+
+    // Switching filters restarts the estimate from level
+    void set_filter(FilterType filter) {
+        config_.filter = filter;
+        reset();
+    }
+
+    void set_publish_rate(uint32_t rate_hz) { config_.publish_rate_hz = rate_hz; }
+
+    void reset() {
+        complementary_.reset();
+        madgwick_.reset();
+        mahony_.reset();
+        have_sample_ = false;
+    }
+
+    const Config& config() const { return config_; }
+
+    Stats stats() const {
+        Stats s = stats_;
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void print_stats() const {
+        Stats s = stats();
+        printf("AHRS: %lu updates, %lu dropped, %lu published, cycles last %lu max %lu (budget %lu, %lu over)\n",
+               (unsigned long)s.updates, (unsigned long)s.dropped, (unsigned long)s.published,
+               (unsigned long)s.last_cycles, (unsigned long)s.max_cycles,
+               (unsigned long)config_.cycle_budget, (unsigned long)s.budget_overruns);
+    }
+};
+
+} // namespace ahrs
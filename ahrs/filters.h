@@ -0,0 +1,253 @@
+#pragma once
+
+/**
+ * @file filters.h
+ * @brief Single-precision 6-axis attitude filters
+ *
+ * All three filters share one interface:
+ *
+ *   void update(const Vec3& gyro_rads, const Vec3& accel_mps2, float dt_s);
+ *   const Quaternion& quaternion() const;
+ *   void reset();
+ *
+ * Kernels use only float add/mul, sqrtf and (complementary only) atan2f,
+ * which map onto the RP2350 M33 single-precision FPU.
+ */
+
+#include <cmath>
+
+namespace ahrs {
+
+struct Vec3 {
+    float x;
+    float y;
+    float z;
+};
+
+struct Euler {
+    float roll;     // rad
+    float pitch;    // rad
+    float yaw;      // rad
+};
+
+struct Quaternion {
+    float w = 1.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+
+    void normalize() {
+        float norm = sqrtf(w * w + x * x + y * y + z * z);
+        if (norm > 0.0f) {
+            float inv = 1.0f / norm;
+            w *= inv; x *= inv; y *= inv; z *= inv;
+        }
+    }
+
+    Euler to_euler() const {
+        Euler e;
+        e.roll = atan2f(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y));
+        float sinp = 2.0f * (w * y - z * x);
+        e.pitch = fabsf(sinp) >= 1.0f ? copysignf(static_cast<float>(M_PI_2), sinp) : asinf(sinp);
+        e.yaw = atan2f(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z));
+        return e;
+    }
+
+    static Quaternion from_euler(const Euler& e) {
+        float cr = cosf(e.roll * 0.5f),  sr = sinf(e.roll * 0.5f);
+        float cp = cosf(e.pitch * 0.5f), sp = sinf(e.pitch * 0.5f);
+        float cy = cosf(e.yaw * 0.5f),   sy = sinf(e.yaw * 0.5f);
+        return Quaternion{
+            cr * cp * cy + sr * sp * sy,
+            sr * cp * cy - cr * sp * sy,
+            cr * sp * cy + sr * cp * sy,
+            cr * cp * sy - sr * sp * cy,
+        };
+    }
+};
+
+// ============================================================================
+// COMPLEMENTARY
+// ============================================================================
+/**
+ * @brief Euler-angle complementary filter
+ *
+ * Gyro rates are integrated through the Euler kinematics; roll and pitch are
+ * then blended toward the accelerometer tilt with weight (1 - alpha). Yaw is
+ * gyro-only. Cheapest of the three, but degrades near +/-90 deg pitch.
+ */
+class ComplementaryFilter {
+public:
+    float alpha = 0.98f;
+
+    void update(const Vec3& g, const Vec3& a, float dt) {
+        float sr = sinf(euler_.roll), cr = cosf(euler_.roll);
+        float cp = cosf(euler_.pitch), tp = tanf(euler_.pitch);
+        if (fabsf(cp) < 1e-3f) cp = copysignf(1e-3f, cp);
+
+        euler_.roll  += (g.x + (g.y * sr + g.z * cr) * tp) * dt;
+        euler_.pitch += (g.y * cr - g.z * sr) * dt;
+        euler_.yaw   += ((g.y * sr + g.z * cr) / cp) * dt;
+
+        float norm_sq = a.x * a.x + a.y * a.y + a.z * a.z;
+        if (norm_sq > 0.0f) {
+            float roll_acc = atan2f(a.y, a.z);
+            float pitch_acc = atan2f(-a.x, sqrtf(a.y * a.y + a.z * a.z));
+            euler_.roll = alpha * euler_.roll + (1.0f - alpha) * roll_acc;
+            euler_.pitch = alpha * euler_.pitch + (1.0f - alpha) * pitch_acc;
+        }
+
+        euler_.yaw = wrap_pi(euler_.yaw);
+        q_ = Quaternion::from_euler(euler_);
+    }
+
+    const Quaternion& quaternion() const { return q_; }
+
+    void reset() {
+        euler_ = Euler{0.0f, 0.0f, 0.0f};
+        q_ = Quaternion{};
+    }
+
+private:
+    static float wrap_pi(float angle) {
+        if (angle > static_cast<float>(M_PI)) angle -= 2.0f * static_cast<float>(M_PI);
+        if (angle < -static_cast<float>(M_PI)) angle += 2.0f * static_cast<float>(M_PI);
+        return angle;
+    }
+
+    Euler euler_{0.0f, 0.0f, 0.0f};
+    Quaternion q_{};
+};
+
+// ============================================================================
+// MADGWICK
+// ============================================================================
+/**
+ * @brief Madgwick gradient-descent filter (IMU form)
+ *
+ * One normalized gradient step toward the accelerometer per update, weighted
+ * by beta (rad/s). No trig in the update path.
+ */
+class MadgwickFilter {
+public:
+    float beta = 0.1f;
+
+    void update(const Vec3& g, const Vec3& a, float dt) {
+        float q0 = q_.w, q1 = q_.x, q2 = q_.y, q3 = q_.z;
+
+        // Rate of change from gyroscope
+        float qd0 = 0.5f * (-q1 * g.x - q2 * g.y - q3 * g.z);
+        float qd1 = 0.5f * ( q0 * g.x + q2 * g.z - q3 * g.y);
+        float qd2 = 0.5f * ( q0 * g.y - q1 * g.z + q3 * g.x);
+        float qd3 = 0.5f * ( q0 * g.z + q1 * g.y - q2 * g.x);
+
+        float norm_sq = a.x * a.x + a.y * a.y + a.z * a.z;
+        if (norm_sq > 0.0f) {
+            float inv = 1.0f / sqrtf(norm_sq);
+            float ax = a.x * inv, ay = a.y * inv, az = a.z * inv;
+
+            float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+            float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+            float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+            float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+
+            // Gradient of the gravity objective
+            float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+            float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1
+                     + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+            float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2
+                     + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+            float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+
+            float s_norm_sq = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+            if (s_norm_sq > 0.0f) {
+                float s_inv = beta / sqrtf(s_norm_sq);
+                qd0 -= s0 * s_inv;
+                qd1 -= s1 * s_inv;
+                qd2 -= s2 * s_inv;
+                qd3 -= s3 * s_inv;
+            }
+        }
+
+        q_.w = q0 + qd0 * dt;
+        q_.x = q1 + qd1 * dt;
+        q_.y = q2 + qd2 * dt;
+        q_.z = q3 + qd3 * dt;
+        q_.normalize();
+    }
+
+    const Quaternion& quaternion() const { return q_; }
+
+    void reset() { q_ = Quaternion{}; }
+
+private:
+    Quaternion q_{};
+};
+
+// ============================================================================
+// MAHONY
+// ============================================================================
+/**
+ * @brief Mahony nonlinear complementary filter (IMU form)
+ *
+ * Proportional-integral feedback on the cross product between measured and
+ * estimated gravity; the integral term tracks gyro bias when ki > 0.
+ */
+class MahonyFilter {
+public:
+    float kp = 1.0f;
+    float ki = 0.0f;
+
+    void update(const Vec3& gyro, const Vec3& a, float dt) {
+        float gx = gyro.x, gy = gyro.y, gz = gyro.z;
+        float q0 = q_.w, q1 = q_.x, q2 = q_.y, q3 = q_.z;
+
+        float norm_sq = a.x * a.x + a.y * a.y + a.z * a.z;
+        if (norm_sq > 0.0f) {
+            float inv = 1.0f / sqrtf(norm_sq);
+            float ax = a.x * inv, ay = a.y * inv, az = a.z * inv;
+
+            // Estimated gravity direction (third row of the rotation matrix)
+            float vx = q1 * q3 - q0 * q2;
+            float vy = q0 * q1 + q2 * q3;
+            float vz = q0 * q0 - 0.5f + q3 * q3;
+
+            float ex = ay * vz - az * vy;
+            float ey = az * vx - ax * vz;
+            float ez = ax * vy - ay * vx;
+
+            if (ki > 0.0f) {
+                integral_.x += 2.0f * ki * ex * dt;
+                integral_.y += 2.0f * ki * ey * dt;
+                integral_.z += 2.0f * ki * ez * dt;
+                gx += integral_.x;
+                gy += integral_.y;
+                gz += integral_.z;
+            }
+
+            gx += 2.0f * kp * ex;
+            gy += 2.0f * kp * ey;
+            gz += 2.0f * kp * ez;
+        }
+
+        float h = 0.5f * dt;
+        q_.w = q0 + (-q1 * gx - q2 * gy - q3 * gz) * h;
+        q_.x = q1 + ( q0 * gx + q2 * gz - q3 * gy) * h;
+        q_.y = q2 + ( q0 * gy - q1 * gz + q3 * gx) * h;
+        q_.z = q3 + ( q0 * gz + q1 * gy - q2 * gx) * h;
+        q_.normalize();
+    }
+
+    const Quaternion& quaternion() const { return q_; }
+
+    void reset() {
+        q_ = Quaternion{};
+        integral_ = Vec3{0.0f, 0.0f, 0.0f};
+    }
+
+private:
+    Quaternion q_{};
+    Vec3 integral_{0.0f, 0.0f, 0.0f};
+};
+
+} // namespace ahrs
@@ -0,0 +1,273 @@
+#pragma once
+
+/**
+ * @file airspeed.h
+ * @brief MS4525D0 differential-pressure to airspeed pipeline
+ *
+ * Runs once per sensor sample from the I2C polling callback (500 Hz):
+ *
+ *   raw -> reject stale -> dp (mPa) - zero offset -> median / IIR -> IAS -> TAS
+ *
+ * Everything on the per-sample path is integer: pressure comes from the
+ * MS4525D0 scale descriptor in fixed point, filtering is in mPa and IAS uses
+ * the integer sqrt kernel. TAS scales IAS by sqrt(rho0 / rho), a Q16 factor
+ * recomputed in float only when the sensor temperature or the static
+ * pressure changes.
+ *
+ * The latest output is published through a sequence lock so Core 1 can read
+ * it at logging rate while the polling IRQ keeps writing.
+ *
+ * Example Usage:
+ *
+ *   airspeed::Pipeline pipeline({.filter = airspeed::FilterType::MedianIIR});
+ *   SensorBus::add_device<i2c::drivers::MS4525D0>([&](const auto& d) { pipeline.process(d); });
+ *
+ *   pipeline.begin_zero();                  // Pitot covered / no wind
+ *   airspeed::Sample s = pipeline.latest();
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "pico/time.h"
+
+#include "common/fixed_point.h"
+#include "i2c/i2c_config.h"
+
+namespace airspeed {
+
+enum class FilterType : uint8_t {
+    None,
+    IIR,
+    Median,
+    MedianIIR,
+};
+
+struct Config {
+    FilterType filter = FilterType::MedianIIR;
+    uint8_t median_window = 5;          // Odd, 3..MAX_MEDIAN_WINDOW
+    float iir_cutoff_hz = 10.0f;
+    uint32_t sample_rate_hz = i2c::DeviceTraits<i2c::drivers::MS4525D0>::default_poll_rate;
+    uint16_t zero_samples = 250;        // 0.5 s at 500 Hz
+};
+
+struct Sample {
+    float ias_mps;
+    float tas_mps;
+    float dp_pa;                // Filtered, zero-corrected
+    float temperature_c;
+    uint32_t timestamp_us;
+};
+
+struct Stats {
+    uint32_t samples;
+    uint32_t stale;
+    int32_t zero_offset_mpa;
+    bool zeroed;
+};
+
+class Pipeline {
+public:
+    static constexpr uint8_t MAX_MEDIAN_WINDOW = 7;
+
+private:
+    using Data = i2c::drivers::ms4525d0_data;
+
+    static constexpr uint8_t STATUS_MASK = 0xC0;
+    static constexpr uint8_t STATUS_NORMAL = 0x00;
+    static constexpr double GAS_CONSTANT_AIR = 287.05;      // J/(kg K)
+
+    Config config_;
+    fixed::q16_t iir_alpha_ = fixed::Q16_ONE;
+
+    // Filter state (producer only)
+    int32_t median_buffer_[MAX_MEDIAN_WINDOW]{};
+    uint8_t median_count_ = 0;
+    uint8_t median_index_ = 0;
+    int32_t iir_state_mpa_ = 0;
+    bool iir_primed_ = false;
+
+    // Zero calibration
+    std::atomic<bool> zero_requested_{false};
+    bool zeroing_ = false;
+    int64_t zero_sum_ = 0;
+    uint16_t zero_count_ = 0;
+    int32_t zero_offset_mpa_ = 0;
+    bool zeroed_ = false;
+
+    // Density compensation, cached on its inputs
+    std::atomic<uint32_t> static_pressure_pa_{static_cast<uint32_t>(i2c::units::SEA_LEVEL_PRESSURE)};
+    uint16_t cached_temperature_raw_ = 0xFFFF;
+    uint32_t cached_static_pa_ = 0;
+    fixed::q16_t tas_factor_ = fixed::Q16_ONE;
+
+    // Published output
+    std::atomic<uint32_t> sequence_{0};
+    Sample latest_{};
+
+    uint32_t samples_ = 0;
+    uint32_t stale_ = 0;
+
+    int32_t median(int32_t value) {
+        median_buffer_[median_index_] = value;
+        median_index_ = (median_index_ + 1) % config_.median_window;
+        if (median_count_ < config_.median_window) {
+            median_count_++;
+        }
+
+        int32_t sorted[MAX_MEDIAN_WINDOW];
+        std::copy_n(median_buffer_, median_count_, sorted);
+        for (uint8_t i = 1; i < median_count_; ++i) {
+            int32_t key = sorted[i];
+            int8_t j = static_cast<int8_t>(i - 1);
+            while (j >= 0 && sorted[j] > key) {
+                sorted[j + 1] = sorted[j];
+                j--;
+            }
+            sorted[j + 1] = key;
+        }
+        return sorted[median_count_ / 2];
+    }
+
+    int32_t iir(int32_t value) {
+        if (!iir_primed_) {
+            iir_state_mpa_ = value;
+            iir_primed_ = true;
+        } else {
+            iir_state_mpa_ += static_cast<int32_t>((static_cast<int64_t>(value - iir_state_mpa_) * iir_alpha_) >> fixed::Q16_SHIFT);
+        }
+        return iir_state_mpa_;
+    }
+
+    int32_t filter(int32_t dp_mpa) {
+        switch (config_.filter) {
+            case FilterType::IIR:       return iir(dp_mpa);
+            case FilterType::Median:    return median(dp_mpa);
+            case FilterType::MedianIIR: return iir(median(dp_mpa));
+            case FilterType::None:
+            default:                    return dp_mpa;
+        }
+    }
+
+    void reset_filters() {
+        median_count_ = 0;
+        median_index_ = 0;
+        iir_primed_ = false;
+    }
+
+    // sqrt(rho0 / rho), rho = p / (R T); only when an input changes
+    void update_density(uint16_t temperature_raw) {
+        const uint32_t static_pa = static_pressure_pa_.load(std::memory_order_relaxed);
+        if (temperature_raw == cached_temperature_raw_ && static_pa == cached_static_pa_) {
+            return;
+        }
+        cached_temperature_raw_ = temperature_raw;
+        cached_static_pa_ = static_pa;
+
+        const float temperature_k = Data::temperature_scale.to_float(temperature_raw) + 273.15f;
+        const float rho = static_cast<float>(static_pa) / (static_cast<float>(GAS_CONSTANT_AIR) * temperature_k);
+        const float rho0 = i2c::units::SEA_LEVEL_DENSITY_G_M3 * 0.001f;
+        tas_factor_ = rho > 0.0f ? fixed::from_float(sqrtf(rho0 / rho)) : fixed::Q16_ONE;
+    }
+
+    void publish(const Sample& sample) {
+        sequence_.fetch_add(1, std::memory_order_acq_rel);     // Odd: write in progress
+        latest_ = sample;
+        sequence_.fetch_add(1, std::memory_order_release);
+    }
+
+public:
+    explicit Pipeline(const Config& config = Config{}) {
+        configure(config);
+    }
+
+    // Not safe while process() may run concurrently; call before polling starts
+    void configure(const Config& config) {
+        config_ = config;
+        config_.median_window = std::clamp<uint8_t>(config_.median_window | 1, 3, MAX_MEDIAN_WINDOW);
+        const float alpha = 1.0f - expf(-2.0f * static_cast<float>(M_PI) * config_.iir_cutoff_hz / config_.sample_rate_hz);
+        iir_alpha_ = fixed::from_float(std::clamp(alpha, 0.0f, 1.0f));
+        reset_filters();
+    }
+
+    // Average the next zero_samples fresh readings into the zero offset
+    void begin_zero() {
+        zero_requested_.store(true, std::memory_order_release);
+    }
+
+    // Static pressure for density (e.g. from the BMP581); defaults to ISA sea level
+    void set_static_pressure(float pa) {
+        static_pressure_pa_.store(static_cast<uint32_t>(pa), std::memory_order_relaxed);
+    }
+
+    // Producer: call once per MS4525D0 sample. Returns true if an output was published.
+    bool process(const Data& data) {
+        if (!data.valid) {
+            return false;
+        }
+        if ((data.status & STATUS_MASK) != STATUS_NORMAL) {
+            stale_++;
+            return false;
+        }
+        samples_++;
+
+        const int32_t raw_dp = data.pressure_mpa();
+
+        if (zero_requested_.exchange(false, std::memory_order_acq_rel)) {
+            zeroing_ = true;
+            zero_sum_ = 0;
+            zero_count_ = 0;
+        }
+        if (zeroing_) {
+            zero_sum_ += raw_dp;
+            if (++zero_count_ >= config_.zero_samples) {
+                zero_offset_mpa_ = static_cast<int32_t>(zero_sum_ / zero_count_);
+                zeroing_ = false;
+                zeroed_ = true;
+                reset_filters();
+            }
+            return false;
+        }
+
+        const int32_t dp = filter(raw_dp - zero_offset_mpa_);
+        const uint32_t ias_mm_s = i2c::units::airspeed_mm_s(dp);
+
+        update_density(data.temperature_raw);
+        const uint32_t tas_mm_s = static_cast<uint32_t>((static_cast<uint64_t>(ias_mm_s) * tas_factor_) >> fixed::Q16_SHIFT);
+
+        publish(Sample{
+            ias_mm_s * 0.001f,
+            tas_mm_s * 0.001f,
+            dp * 0.001f,
+            data.temperature_c(),
+            time_us_32(),
+        });
+        return true;
+    }
+
+    // Consumer: latest published output, consistent across fields
+    Sample latest() const {
+        Sample sample;
+        uint32_t before, after;
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            sample = latest_;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return sample;
+    }
+
+    bool is_zeroing() const { return zeroing_ || zero_requested_.load(std::memory_order_relaxed); }
+
+    Stats stats() const {
+        return Stats{samples_, stale_, zero_offset_mpa_, zeroed_};
+    }
+
+    const Config& config() const { return config_; }
+};
+
+} // namespace airspeed
@@ -6,13 +6,29 @@
 #include "sdcard.h"
 #include "i2c/i2c_bus.h"
 #include "i2c/drivers/ads1115.h"
+#include "i2c/drivers/icm20948.h"
+#include "i2c/drivers/ms4525d0.h"
+#include "ahrs/ahrs.h"
+#include "airspeed/airspeed.h"
 #include "adc/hx711.h"
+#include "config/config_store.h"
 #include "network/handlers/shared_state.h"
 
 #include <cctype>
 
 using SensorBus = i2c::I2CBus<i2c0, 4, 5>;
 using ADS1115Data = i2c::drivers::ads1115_data;
+using ICM20948Data = i2c::drivers::icm20948_data;
+using MS4525D0Data = i2c::drivers::ms4525d0_data;
+
+// ACS770 output across the ADS1115 AIN0-AIN1 pair at +/-2.048 V:
+// amps = (volts + 1.65625) * 78.30445, folded into a single multiply-add.
+// These are the defaults; the config store can override both constants.
+static constexpr auto ADS1115_GAIN = i2c::drivers::ADS1115::Gain::FS_2_048V;
+static constexpr float ACS770_ZERO_VOLTS = 1.65625f;
+static constexpr float ACS770_AMPS_PER_VOLT = 78.30445f;
+static constexpr i2c::units::Scale ACS770_VOLTS = i2c::drivers::ADS1115::scale_for(ADS1115_GAIN).then(1.0, ACS770_ZERO_VOLTS);
+static constexpr i2c::units::Scale ACS770_AMPS = ACS770_VOLTS.then(ACS770_AMPS_PER_VOLT);
 
 class Core1Controller : public SystemCore<Core1Controller> {
 private:
@@ -20,6 +36,72 @@ private:
 
     Scheduler scheduler_;
     adc::HX711 scale_;
+    ahrs::Estimator ahrs_{ahrs::Config{
+        .filter = ahrs::FilterType::Madgwick,
+        .sample_rate_hz = 500,
+        .publish_rate_hz = 50,
+    }};
+    airspeed::Pipeline airspeed_{airspeed::Config{
+        .filter = airspeed::FilterType::MedianIIR,
+        .median_window = 5,
+        .iir_cutoff_hz = 10.0f,
+    }};
+    bool session_was_active_ = false;
+
+    // Loaded from the config store at init; defaults above otherwise
+    i2c::units::Scale acs770_volts_ = ACS770_VOLTS;
+    i2c::units::Scale acs770_amps_ = ACS770_AMPS;
+    i2c::drivers::ADS1115::Rate ads1115_rate_ = i2c::drivers::ADS1115::Rate::SPS_64;
+    uint32_t ads1115_poll_rate_ = i2c::DeviceTraits<i2c::drivers::ADS1115>::default_poll_rate;
+    uint32_t imu_rate_ = 500;
+    uint32_t airspeed_rate_ = i2c::DeviceTraits<i2c::drivers::MS4525D0>::default_poll_rate;
+
+    void load_config() {
+        config::Store::init();
+
+        float scale;
+        int32_t offset;
+        uint8_t gain;
+        uint8_t filter;
+        if (config::Store::get(config::Key::HX711Scale, scale) && config::Store::get(config::Key::HX711Offset, offset)) {
+            scale_.set_scale(scale);
+            scale_.set_offset(offset);
+            printf("Core 1: HX711 calibration loaded (scale %.2f, offset %ld)\n", scale, (long)offset);
+        }
+        if (config::Store::get(config::Key::HX711Gain, gain)) {
+            scale_.set_gain(gain);
+        }
+        if (config::Store::get(config::Key::HX711Filter, filter) && filter <= static_cast<uint8_t>(adc::LoadCellFilterMode::CIC)) {
+            adc::LoadCellFilter::Config filter_config = scale_.filter_config();
+            filter_config.mode = static_cast<adc::LoadCellFilterMode>(filter);
+            scale_.set_filter(filter_config);
+        }
+
+        float zero_volts = ACS770_ZERO_VOLTS;
+        float amps_per_volt = ACS770_AMPS_PER_VOLT;
+        uint8_t ads_rate;
+        config::Store::get(config::Key::ACS770ZeroVolts, zero_volts);
+        config::Store::get(config::Key::ACS770AmpsPerVolt, amps_per_volt);
+        // Rate codes are the DR field, multiples of 0x20; anything else keeps SPS_64
+        if (config::Store::get(config::Key::ADS1115Rate, ads_rate) && ads_rate % 0x20 == 0) {
+            ads1115_rate_ = static_cast<i2c::drivers::ADS1115::Rate>(ads_rate);
+        }
+        acs770_volts_ = i2c::drivers::ADS1115::scale_for(ADS1115_GAIN).then(1.0, zero_volts);
+        acs770_amps_ = acs770_volts_.then(amps_per_volt);
+
+        config::Store::get(config::Key::ADS1115PollRate, ads1115_poll_rate_);
+        config::Store::get(config::Key::ICM20948Rate, imu_rate_);
+        config::Store::get(config::Key::MS4525D0Rate, airspeed_rate_);
+    }
+
+    // Stage the current HX711 calibration and write it to flash
+    bool save_hx711_config() {
+        config::Store::set(config::Key::HX711Scale, scale_.get_scale());
+        config::Store::set(config::Key::HX711Offset, static_cast<int32_t>(scale_.get_offset()));
+        config::Store::set(config::Key::HX711Gain, scale_.get_gain());
+        config::Store::set(config::Key::HX711Filter, static_cast<uint8_t>(scale_.filter_config().mode));
+        return config::Store::commit();
+    }
 
     void poll_hx711() {
         scale_.update();
@@ -33,23 +115,67 @@ private:
         }
     }
 
+    // The pipeline runs per sample in the poll callback; this only reports
+    void log_airspeed() {
+        using network::handlers::g_shared_state;
+
+        if (airspeed_.is_zeroing()) {
+            return;
+        }
+        const airspeed::Sample sample = airspeed_.latest();
+        sdcard::SDFile<sdcard::Speed>::Write("(%u) TAS: %.2f m/s IAS: %.2f m/s [dP: %.1f Pa, T: %.1f C]\n",
+                                             sample.timestamp_us, sample.tas_mps, sample.ias_mps,
+                                             sample.dp_pa, sample.temperature_c);
+        g_shared_state.airspeed.store(sample.tas_mps);
+        g_shared_state.airspeed_ias.store(sample.ias_mps);
+        g_shared_state.dynamic_pressure.store(sample.dp_pa);
+    }
+
     void flush_sd_cards() {
         sdcard::SDFile<sdcard::Force>::Sync();
         sdcard::SDFile<sdcard::Current>::Sync();
+        sdcard::SDFile<sdcard::Speed>::Sync();
     }
 
     void on_ads1115_data(const ADS1115Data& data) {
         if (data.valid) {
-            float voltage = data.voltage + 1.65625f;
-            float current = voltage * 78.30445f;
-            sdcard::SDFile<sdcard::Current>::Write("(%u) Amps: %.3fA [ADC: %d (%.3fV)]\n", time_us_32(), current, data.raw, voltage);
+            float current = acs770_amps_.to_float(data.raw);
+            sdcard::SDFile<sdcard::Current>::Write("(%u) Amps: %.3fA [ADC: %d (%.3fV)]\n", time_us_32(), current, data.raw,
+                                                    acs770_volts_.to_float(data.raw));
             network::handlers::g_shared_state.power.store(current);
         }
     }
 
+    void on_attitude(const ahrs::Attitude& attitude) {
+        using network::handlers::g_shared_state;
+        static constexpr float RAD_TO_DEG = 57.2957795f;
+
+        g_shared_state.roll.store(attitude.euler.roll * RAD_TO_DEG);
+        g_shared_state.pitch.store(attitude.euler.pitch * RAD_TO_DEG);
+        g_shared_state.yaw.store(attitude.euler.yaw * RAD_TO_DEG);
+        g_shared_state.quat_w.store(attitude.q.w);
+        g_shared_state.quat_x.store(attitude.q.x);
+        g_shared_state.quat_y.store(attitude.q.y);
+        g_shared_state.quat_z.store(attitude.q.z);
+
+        // Raw IMU is converted for display at the publish rate only
+        const ICM20948Data& imu = ahrs_.last_sample();
+        g_shared_state.accel_x.store(imu.accel_mps2(0));
+        g_shared_state.accel_y.store(imu.accel_mps2(1));
+        g_shared_state.accel_z.store(imu.accel_mps2(2));
+        g_shared_state.gyro_x.store(imu.gyro_rads(0));
+        g_shared_state.gyro_y.store(imu.gyro_rads(1));
+        g_shared_state.gyro_z.store(imu.gyro_rads(2));
+    }
+
     bool init_impl() {
         printf("Core 1: Initializing...\n");
 
+        // The DWT is per core; the AHRS budget is measured on this one
+        cycles::enable();
+
+        load_config();
+
         if (!scale_.init()) {
             printf("Core 1: Failed to initialize HX711!\n");
             return false;
@@ -65,14 +191,49 @@ private:
         auto& ads = SensorBus::get_device<i2c::drivers::ADS1115>();
         ads.configure(
             i2c::drivers::ADS1115::Mux::DIFF_0_1, 
-            i2c::drivers::ADS1115::Gain::FS_2_048V, 
-            i2c::drivers::ADS1115::Rate::SPS_64
+            ADS1115_GAIN, 
+            ads1115_rate_
         );
 
         network::handlers::g_shared_state.power_ready.store(true);
+
+        // Timer callback only queues the raw sample; filtering runs in loop_impl
+        bool imu_ready = SensorBus::add_device<i2c::drivers::ICM20948>([this](const ICM20948Data& data) {
+            this->ahrs_.push(data);
+        });
+        ahrs_.set_publish_callback([this](const ahrs::Attitude& attitude) { this->on_attitude(attitude); });
+
+        // Full-rate airspeed: stale rejection and filtering run in the poll callback
+        airspeed::Config airspeed_config = airspeed_.config();
+        airspeed_config.sample_rate_hz = airspeed_rate_;
+        airspeed_.configure(airspeed_config);
+        bool airspeed_ready = SensorBus::add_device<i2c::drivers::MS4525D0>([this](const MS4525D0Data& data) {
+            this->airspeed_.process(data);
+        });
+
+        SensorBus::enable();
+        SensorBus::poll_rate<i2c::drivers::ADS1115>(ads1115_poll_rate_);
+        if (imu_ready) {
+            SensorBus::poll_rate<i2c::drivers::ICM20948>(imu_rate_);
+            network::handlers::g_shared_state.accel_ready.store(true);
+            network::handlers::g_shared_state.gyro_ready.store(true);
+            network::handlers::g_shared_state.attitude_ready.store(true);
+        } else {
+            printf("Core 1: ICM20948 not available, AHRS disabled.\n");
+        }
+        if (airspeed_ready) {
+            SensorBus::poll_rate<i2c::drivers::MS4525D0>(airspeed_rate_);
+            airspeed_.begin_zero();
+            network::handlers::g_shared_state.airspeed_ready.store(true);
+        } else {
+            printf("Core 1: MS4525D0 not available, airspeed disabled.\n");
+        }
         printf("Core 1: ADS1115 Initialized and polling started by I2C Bus Manager.\n");
 
         scheduler_.add_task([this]() { this->poll_hx711(); }, 50);
+        if (airspeed_ready) {
+            scheduler_.add_task([this]() { this->log_airspeed(); }, 50);
+        }
         scheduler_.add_task([this]() { this->flush_sd_cards(); }, 1000);
 
         printf("Core 1: Initialized successfully.\n");
@@ -80,7 +241,17 @@ private:
     }
 
     void loop_impl() {
+        // Keep the attitude converged even outside a session
+        ahrs_.process();
+
         bool is_scheduler_active = network::handlers::g_shared_state.session_active.load();
+
+        // Re-zero the pitot at every session start (aircraft at rest)
+        if (is_scheduler_active && !session_was_active_) {
+            airspeed_.begin_zero();
+        }
+        session_was_active_ = is_scheduler_active;
+
         if (is_scheduler_active) {
             scheduler_.run();
         } else {
@@ -91,6 +262,18 @@ private:
                         this->shutdown();
                         return;
                     }
+                    case 'a': {
+                        ahrs_.print_stats();
+                        break;
+                    }
+                    case 'p': {
+                        airspeed::Stats s = airspeed_.stats();
+                        airspeed::Sample sample = airspeed_.latest();
+                        printf("Core 1: Airspeed TAS %.2f m/s IAS %.2f m/s, %lu samples, %lu stale, zero %ld mPa%s\n",
+                               sample.tas_mps, sample.ias_mps, (unsigned long)s.samples, (unsigned long)s.stale,
+                               (long)s.zero_offset_mpa, s.zeroed ? "" : " (not zeroed)");
+                        break;
+                    }
                     case 'z': {
                         scale_.zero();
                         printf("Core 1: HX711 Zero'd.\n");
@@ -145,13 +328,30 @@ private:
                         if (result) {
                             printf("Core 1: HX711 Calibration successful.\n");
                             printf("\tScale: %.2f | Offset: %d\n", scale_.get_scale(), scale_.get_offset());
+                            if (!save_hx711_config()) {
+                                printf("Core 1: HX711 Calibration not saved to flash.\n");
+                            }
                         } else {
                             printf("Core 1: HX711 Calibration failed.\n");
                         }
                         break;
                     }
+                    case 'f': {
+                        using Mode = adc::LoadCellFilter::Mode;
+                        adc::LoadCellFilter::Config config = scale_.filter_config();
+                        config.mode = static_cast<Mode>((static_cast<uint8_t>(config.mode) + 1) % (static_cast<uint8_t>(Mode::CIC) + 1));
+                        scale_.set_filter(config);
+                        printf("Core 1: HX711 filter set to %s\n", adc::LoadCellFilter::mode_name(config.mode));
+                        break;
+                    }
+                    case 'c': {
+                        if (save_hx711_config()) {
+                            printf("Core 1: Config saved (snapshot %lu).\n", (unsigned long)config::Store::sequence());
+                        }
+                        break;
+                    }
                     case 'w': {
-                        scale_.update(32);
+                        scale_.update();
                         if (scale_.valid()) {
                             printf("Core 1: HX711 Current Weight: %.2f lbs (Raw: %d, Tared: %d)\n", 
                                    scale_.weight(), scale_.raw(), scale_.tared());
@@ -175,6 +375,7 @@ private:
         SensorBus::shutdown();
         sdcard::SDFile<sdcard::Force>::Close();
         sdcard::SDFile<sdcard::Current>::Close();
+        sdcard::SDFile<sdcard::Speed>::Close();
         printf("Core 1: Shutdown complete.\n");
         sleep_ms(100);
     }
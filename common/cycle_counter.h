@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * @file cycle_counter.h
+ * @brief Cycle-accurate timing for per-update budgets
+ *
+ * On the RP2350 Arm cores this reads the M33 DWT cycle counter. Host builds
+ * (sim/) fall back to steady_clock nanoseconds so the same code compiles.
+ * The DWT block is per core, so enable() must run on the core that reads it.
+ *
+ * Example Usage:
+ *
+ *   cycles::enable();
+ *   uint32_t start = cycles::now();
+ *   run_kernel();
+ *   uint32_t spent = cycles::now() - start;    // wraps safely
+ */
+
+#include <cstdint>
+
+#if defined(__arm__)
+#include "hardware/structs/m33.h"
+#else
+#include <chrono>
+#endif
+
+namespace cycles {
+
+#if defined(__arm__)
+
+inline void enable() {
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_cyccnt = 0;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+}
+
+inline uint32_t now() {
+    return m33_hw->dwt_cyccnt;
+}
+
+#else
+
+inline void enable() {}
+
+inline uint32_t now() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#endif
+
+} // namespace cycles
@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file fixed_point.h
+ * @brief Integer arithmetic helpers for the sensor conversion path
+ *
+ * Q16.16 helpers, integer square roots and constexpr ln/exp/pow used to
+ * build lookup tables at compile time (std::pow is not constexpr).
+ */
+
+#include <cstdint>
+
+namespace fixed {
+
+// ============================================================================
+// Q16.16
+// ============================================================================
+using q16_t = int32_t;
+
+static constexpr int Q16_SHIFT = 16;
+static constexpr q16_t Q16_ONE = 1 << Q16_SHIFT;
+
+constexpr q16_t from_float(double value) {
+    return static_cast<q16_t>(value * Q16_ONE + (value >= 0 ? 0.5 : -0.5));
+}
+
+constexpr float to_float(q16_t value) {
+    return static_cast<float>(value) * (1.0f / Q16_ONE);
+}
+
+constexpr q16_t mul(q16_t a, q16_t b) {
+    return static_cast<q16_t>((static_cast<int64_t>(a) * b) >> Q16_SHIFT);
+}
+
+constexpr q16_t div(q16_t a, q16_t b) {
+    return static_cast<q16_t>((static_cast<int64_t>(a) << Q16_SHIFT) / b);
+}
+
+// ============================================================================
+// INTEGER SQUARE ROOT
+// ============================================================================
+// floor(sqrt(value)), bit-by-bit: no division, fixed iteration count
+constexpr uint32_t isqrt(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = uint64_t{1} << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+// ============================================================================
+// CONSTEXPR MATH (compile-time table generation only)
+// ============================================================================
+namespace cmath {
+
+static constexpr double LN2 = 0.69314718055994530942;
+
+constexpr double ln(double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    // x = m * 2^e with m in [0.5, 1)
+    int e = 0;
+    while (x >= 1.0) { x *= 0.5; e++; }
+    while (x < 0.5)  { x *= 2.0; e--; }
+
+    // ln(m) = 2 * atanh((m - 1) / (m + 1))
+    const double z = (x - 1.0) / (x + 1.0);
+    const double z2 = z * z;
+    double term = z;
+    double sum = 0.0;
+    for (int k = 1; k < 64; k += 2) {
+        sum += term / k;
+        term *= z2;
+    }
+    return 2.0 * sum + e * LN2;
+}
+
+constexpr double exp(double x) {
+    // x = n * ln2 + r, |r| <= ln2 / 2
+    const int n = static_cast<int>(x / LN2 + (x >= 0 ? 0.5 : -0.5));
+    const double r = x - n * LN2;
+
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 30; ++k) {
+        term *= r / k;
+        sum += term;
+    }
+    for (int i = 0; i < n; ++i) sum *= 2.0;
+    for (int i = 0; i > n; --i) sum *= 0.5;
+    return sum;
+}
+
+constexpr double pow(double base, double exponent) {
+    return exp(exponent * ln(base));
+}
+
+} // namespace cmath
+
+} // namespace fixed
@@ -0,0 +1,376 @@
+#pragma once
+
+/**
+ * @file config_store.h
+ * @brief Versioned key/value calibration store in on-board flash
+ *
+ * The store owns the last STORE_SECTORS sectors of flash and writes one
+ * 256-byte page per commit. Each page is a complete snapshot:
+ *
+ *   [magic u32][schema u16][length u16][sequence u32][crc16 u16][pad u16]
+ *   [key u16][len u8][pad u8][value, padded to 4] ...
+ *
+ * Commits append to the next erased page, so every page in the region is
+ * written once before the oldest sector is erased and reused (wear is spread
+ * across STORE_SECTORS * 16 pages). At boot the newest page whose CRC and
+ * schema check out is selected, and get()/find() read values straight out of
+ * the XIP-mapped flash: no copy of the store is made unless set() stages an
+ * update.
+ *
+ * Flash writes go through flash_safe_execute(), which parks the other core;
+ * Core 0 registers for that in main() with flash_safe_execute_core_init().
+ *
+ * Example Usage:
+ *
+ *   config::Store::init();
+ *   float scale;
+ *   if (config::Store::get(config::Key::HX711Scale, scale)) { ... }
+ *
+ *   config::Store::set(config::Key::HX711Scale, 33358.0f);
+ *   config::Store::commit();
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+// Flash sectors reserved at the end of flash for the store
+#ifndef FLIGHT_CONFIG_SECTORS
+#define FLIGHT_CONFIG_SECTORS 4
+#endif
+
+namespace config {
+
+// Keys are stable across firmware versions; never renumber, only append
+enum class Key : uint16_t {
+    HX711Scale = 1,             // float, counts per lb
+    HX711Offset = 2,            // int32_t, tare counts
+    HX711Gain = 3,              // uint8_t, gain pulses
+    HX711Filter = 4,            // uint8_t, adc::LoadCellFilterMode
+    ACS770ZeroVolts = 16,       // float, added to the ADS1115 volts
+    ACS770AmpsPerVolt = 17,     // float
+    ADS1115Rate = 18,           // uint8_t, ADS1115::Rate
+    ICM20948Rate = 32,          // uint32_t, Hz
+    MS4525D0Rate = 33,          // uint32_t, Hz
+    ADS1115PollRate = 34,       // uint32_t, Hz
+};
+
+class Store {
+public:
+    static constexpr uint16_t SCHEMA_VERSION = 1;
+
+private:
+    static constexpr size_t STORE_SECTORS = FLIGHT_CONFIG_SECTORS;
+    static constexpr size_t PAGES_PER_SECTOR = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE;
+    static constexpr size_t PAGE_COUNT = STORE_SECTORS * PAGES_PER_SECTOR;
+    static constexpr uint32_t REGION_OFFSET = PICO_FLASH_SIZE_BYTES - STORE_SECTORS * FLASH_SECTOR_SIZE;
+    static constexpr uint32_t MAGIC = 0x47464346;      // "FCFG"
+    static constexpr uint32_t ERASED = 0xFFFFFFFF;
+    static constexpr uint32_t WRITE_TIMEOUT_MS = 500;
+    static_assert(STORE_SECTORS >= 2, "The active page must survive erasing the next sector");
+
+    struct PageHeader {
+        uint32_t magic;
+        uint16_t schema;
+        uint16_t length;        // Payload bytes after the header
+        uint32_t sequence;
+        uint16_t crc;           // CRC16 over schema..sequence and the payload
+        uint16_t reserved;
+    };
+    static_assert(sizeof(PageHeader) == 16);
+
+    struct EntryHeader {
+        uint16_t key;
+        uint8_t length;
+        uint8_t reserved;
+    };
+    static_assert(sizeof(EntryHeader) == 4);
+
+    static constexpr size_t PAYLOAD_CAPACITY = FLASH_PAGE_SIZE - sizeof(PageHeader);
+
+    struct State {
+        int32_t active_page = -1;       // Newest valid page, -1 when empty
+        uint32_t sequence = 0;
+        int32_t next_page = 0;          // Next erased page to program
+        bool staged = false;
+        alignas(4) uint8_t staging[FLASH_PAGE_SIZE]{};
+        bool initialized = false;
+    };
+
+    static State& state() {
+        static State instance;
+        return instance;
+    }
+
+    static const uint8_t* page_address(size_t page) {
+        return reinterpret_cast<const uint8_t*>(XIP_BASE + REGION_OFFSET + page * FLASH_PAGE_SIZE);
+    }
+
+    static const PageHeader* header_at(const uint8_t* page) {
+        return reinterpret_cast<const PageHeader*>(page);
+    }
+
+    static constexpr size_t padded(size_t length) {
+        return (length + 3) & ~size_t{3};
+    }
+
+    // CRC16-CCITT (0x1021, initial 0xFFFF), bit at a time: runs once per
+    // page at boot and commit, not worth a table
+    static uint16_t crc16_ccitt(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF) {
+        for (size_t i = 0; i < length; ++i) {
+            crc ^= static_cast<uint16_t>(data[i] << 8);
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    static uint16_t page_crc(const uint8_t* page) {
+        const PageHeader* header = header_at(page);
+        const size_t covered = offsetof(PageHeader, crc) - offsetof(PageHeader, schema);
+        const uint16_t crc = crc16_ccitt(page + offsetof(PageHeader, schema), covered);
+        return crc16_ccitt(page + sizeof(PageHeader), header->length, crc);
+    }
+
+    static bool page_valid(const uint8_t* page) {
+        const PageHeader* header = header_at(page);
+        return header->magic == MAGIC &&
+               header->schema == SCHEMA_VERSION &&
+               header->length <= PAYLOAD_CAPACITY &&
+               header->crc == page_crc(page);
+    }
+
+    static bool page_erased(const uint8_t* page) {
+        const uint32_t* words = reinterpret_cast<const uint32_t*>(page);
+        for (size_t i = 0; i < FLASH_PAGE_SIZE / sizeof(uint32_t); ++i) {
+            if (words[i] != ERASED) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Walk the entries of a page image, stop when `fn` returns true
+    template<typename Fn>
+    static const EntryHeader* find_entry(const uint8_t* page, Fn&& fn) {
+        const size_t length = header_at(page)->length;
+        size_t offset = 0;
+        while (offset + sizeof(EntryHeader) <= length) {
+            const auto* entry = reinterpret_cast<const EntryHeader*>(page + sizeof(PageHeader) + offset);
+            if (fn(*entry)) {
+                return entry;
+            }
+            offset += sizeof(EntryHeader) + padded(entry->length);
+        }
+        return nullptr;
+    }
+
+    // Image that reads resolve against: the staged copy once set() was called
+    static const uint8_t* current_image() {
+        State& s = state();
+        if (s.staged) {
+            return s.staging;
+        }
+        return s.active_page >= 0 ? page_address(s.active_page) : nullptr;
+    }
+
+    static void stage() {
+        State& s = state();
+        if (s.staged) {
+            return;
+        }
+        std::memset(s.staging, 0xFF, sizeof(s.staging));
+        if (s.active_page >= 0) {
+            std::memcpy(s.staging, page_address(s.active_page), sizeof(PageHeader) + header_at(page_address(s.active_page))->length);
+        } else {
+            PageHeader header{MAGIC, SCHEMA_VERSION, 0, 0, 0, 0xFFFF};
+            std::memcpy(s.staging, &header, sizeof(header));
+        }
+        s.staged = true;
+    }
+
+    static bool remove_staged(Key key) {
+        State& s = state();
+        auto* header = reinterpret_cast<PageHeader*>(s.staging);
+        const EntryHeader* entry = find_entry(s.staging, [key](const EntryHeader& e) {
+            return e.key == static_cast<uint16_t>(key);
+        });
+        if (!entry) {
+            return false;
+        }
+        uint8_t* start = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(entry));
+        const size_t size = sizeof(EntryHeader) + padded(entry->length);
+        uint8_t* end = s.staging + sizeof(PageHeader) + header->length;
+        std::memmove(start, start + size, end - start - size);
+        header->length -= size;
+        return true;
+    }
+
+    struct ProgramRequest {
+        uint32_t offset;
+        const uint8_t* data;
+        bool erase;
+    };
+
+    static void program_page(void* param) {
+        const auto* request = static_cast<const ProgramRequest*>(param);
+        if (request->erase) {
+            flash_range_erase(request->offset - request->offset % FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+        }
+        flash_range_program(request->offset, request->data, FLASH_PAGE_SIZE);
+    }
+
+public:
+    // Scan the region for the newest valid snapshot
+    static bool init() {
+        State& s = state();
+        s = State{};
+
+        int32_t first_erased = -1;
+        for (size_t page = 0; page < PAGE_COUNT; ++page) {
+            const uint8_t* address = page_address(page);
+            if (page_valid(address)) {
+                const uint32_t sequence = header_at(address)->sequence;
+                if (s.active_page < 0 || static_cast<int32_t>(sequence - s.sequence) > 0) {
+                    s.active_page = static_cast<int32_t>(page);
+                    s.sequence = sequence;
+                }
+            } else if (first_erased < 0 && page_erased(address)) {
+                first_erased = static_cast<int32_t>(page);
+            }
+        }
+
+        // Append after the newest page; wrap into the (to be erased) first sector
+        s.next_page = s.active_page >= 0 ? (s.active_page + 1) % PAGE_COUNT
+                                         : (first_erased >= 0 ? first_erased : 0);
+        s.initialized = true;
+
+        if (s.active_page >= 0) {
+            printf("Config: Loaded snapshot %lu (page %ld, %u bytes)\n",
+                   (unsigned long)s.sequence, (long)s.active_page, header_at(page_address(s.active_page))->length);
+        } else {
+            printf("Config: No stored configuration, using defaults\n");
+        }
+        return s.active_page >= 0;
+    }
+
+    // Zero-copy view of a value: points into XIP flash (or the staged page)
+    static std::span<const uint8_t> find(Key key) {
+        const uint8_t* image = current_image();
+        if (!image) {
+            return {};
+        }
+        const EntryHeader* entry = find_entry(image, [key](const EntryHeader& e) {
+            return e.key == static_cast<uint16_t>(key);
+        });
+        if (!entry) {
+            return {};
+        }
+        return {reinterpret_cast<const uint8_t*>(entry + 1), entry->length};
+    }
+
+    template<typename T>
+    static bool get(Key key, T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::span<const uint8_t> bytes = find(key);
+        if (bytes.size() != sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, bytes.data(), sizeof(T));
+        return true;
+    }
+
+    // Stage a value in RAM; nothing reaches flash until commit()
+    template<typename T>
+    static bool set(Key key, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        static_assert(sizeof(T) <= UINT8_MAX);
+
+        stage();
+        remove_staged(key);
+
+        State& s = state();
+        auto* header = reinterpret_cast<PageHeader*>(s.staging);
+        const size_t size = sizeof(EntryHeader) + padded(sizeof(T));
+        if (header->length + size > PAYLOAD_CAPACITY) {
+            printf("Config: Store full, cannot set key %u\n", static_cast<uint16_t>(key));
+            return false;
+        }
+
+        uint8_t* dest = s.staging + sizeof(PageHeader) + header->length;
+        EntryHeader entry{static_cast<uint16_t>(key), static_cast<uint8_t>(sizeof(T)), 0};
+        std::memcpy(dest, &entry, sizeof(entry));
+        std::memset(dest + sizeof(entry), 0, padded(sizeof(T)));
+        std::memcpy(dest + sizeof(entry), &value, sizeof(T));
+        header->length += size;
+        return true;
+    }
+
+    // Program the staged snapshot into the next page
+    static bool commit() {
+        State& s = state();
+        if (!s.initialized) {
+            printf("Config: Store not initialized\n");
+            return false;
+        }
+        if (!s.staged) {
+            return true;
+        }
+
+        auto* header = reinterpret_cast<PageHeader*>(s.staging);
+        header->magic = MAGIC;
+        header->schema = SCHEMA_VERSION;
+        header->sequence = s.sequence + 1;
+        header->reserved = 0xFFFF;
+        header->crc = page_crc(s.staging);
+
+        // A dirty page mid-sector (torn write, foreign data) cannot be erased
+        // alone without losing its neighbours: move on to a fresh sector
+        uint32_t page = s.next_page;
+        bool erase = false;
+        if (!page_erased(page_address(page))) {
+            if (page % PAGES_PER_SECTOR != 0) {
+                page = ((page / PAGES_PER_SECTOR + 1) * PAGES_PER_SECTOR) % PAGE_COUNT;
+            }
+            erase = true;
+        }
+        ProgramRequest request{
+            static_cast<uint32_t>(REGION_OFFSET + page * FLASH_PAGE_SIZE),
+            s.staging,
+            erase,
+        };
+
+        int result = flash_safe_execute(&Store::program_page, &request, WRITE_TIMEOUT_MS);
+        if (result != PICO_OK) {
+            printf("Config: Flash write failed (%d)\n", result);
+            return false;
+        }
+        if (!page_valid(page_address(page))) {
+            printf("Config: Verify failed at page %lu\n", (unsigned long)page);
+            return false;
+        }
+
+        // Erasing a sector also drops the pages after `page` in it; they were older
+        s.active_page = static_cast<int32_t>(page);
+        s.sequence = header->sequence;
+        s.next_page = (page + 1) % PAGE_COUNT;
+        s.staged = false;
+        printf("Config: Saved snapshot %lu to page %lu\n", (unsigned long)s.sequence, (unsigned long)page);
+        return true;
+    }
+
+    // Drop staged changes
+    static void discard() { state().staged = false; }
+
+    static bool has_snapshot() { return state().active_page >= 0; }
+    static uint32_t sequence() { return state().sequence; }
+};
+
+} // namespace config
@@ -9,6 +9,7 @@
 namespace ftl {
 namespace messages {
     MessagePoolType g_message_pool;
+    BulkPoolType g_bulk_pool;
 }
 }
 
@@ -67,7 +68,7 @@ void poll() {
         return;
     }
     
-    // All UART processing (RX DMA, state machine, multicore FIFO, TX queue)
+    // All UART processing (RX DMA, state machine, Core 1 ring, TX queue)
     ftl::uart::poll();
 }
 
@@ -85,11 +86,11 @@ MessageHandle get_msg() {
     return ftl::uart::get_message();
 }
 
-bool send_msg(std::span<const uint8_t> payload) {
+bool send_msg(std::span<const uint8_t> payload, ftl_config::TxClass tx_class) {
     if (!g_is_initialized || payload.empty()) {
         return false;
     }
-    return ftl::uart::send_message(payload);
+    return ftl::uart::send_message(payload, tx_class);
 }
 
 bool send_msg(std::string_view message) {
@@ -99,6 +100,70 @@ bool send_msg(std::string_view message) {
     return ftl::uart::send_message(message);
 }
 
+bool send_msg(MessageHandle&& message) {
+    if (!g_is_initialized || !message) {
+        return false;
+    }
+    return ftl::uart::send_message(std::move(message));
+}
+
+bool send_msg_reliable(std::span<const uint8_t> payload) {
+    if (!g_is_initialized || payload.empty()) {
+        return false;
+    }
+    return ftl::uart::send_reliable(payload);
+}
+
+bool send_msg_reliable(MessageHandle&& message) {
+    if (!g_is_initialized || !message) {
+        return false;
+    }
+    return ftl::uart::send_reliable(std::move(message));
+}
+
+bool is_reliable_tx_ready() {
+    return g_is_initialized && ftl::uart::is_reliable_tx_ready();
+}
+
+bool send_bulk(std::span<const uint8_t> data) {
+    if (!g_is_initialized) {
+        return false;
+    }
+    return ftl::uart::send_bulk(data);
+}
+
+bool send_bulk(uint32_t length, BulkReader reader) {
+    if (!g_is_initialized) {
+        return false;
+    }
+    return ftl::uart::send_bulk(length, std::move(reader));
+}
+
+bool is_bulk_tx_busy() {
+    if (!g_is_initialized) {
+        return false;
+    }
+    return ftl::uart::is_bulk_tx_busy();
+}
+
+bool has_bulk_msg() {
+    if (!g_is_initialized) {
+        return false;
+    }
+    return ftl::uart::has_bulk_message();
+}
+
+BulkMessage get_bulk_msg() {
+    if (!g_is_initialized) {
+        return BulkMessage{};
+    }
+    return ftl::uart::get_bulk_message();
+}
+
+void set_bulk_stream_handler(BulkStreamHandler handler) {
+    ftl::uart::set_bulk_stream_handler(std::move(handler));
+}
+
 bool is_tx_ready() {
     if (!g_is_initialized) {
         return true;
@@ -120,10 +185,17 @@ void get_stats(uint32_t& total_bytes_rx, uint32_t& total_messages_rx,
     crc_errors = stats.crc_errors;
     framing_errors = stats.framing_errors;
     
-    // Note: messages_queued and pool_allocated are internal implementation
-    // details not exposed by the refactored UART public API
+    pool_allocated = static_cast<uint32_t>(messages::g_message_pool.get_allocated_count());
+    
+    // Note: messages_queued is an internal implementation detail not
+    // exposed by the refactored UART public API
     messages_queued = 0;
-    pool_allocated = 0;
+}
+
+void get_pool_stats(uint32_t& allocated, uint32_t& peak_allocated, uint32_t& spills) {
+    allocated = static_cast<uint32_t>(messages::g_message_pool.get_allocated_count());
+    peak_allocated = static_cast<uint32_t>(messages::g_message_pool.get_peak_allocated_count());
+    spills = static_cast<uint32_t>(messages::g_message_pool.get_spill_count());
 }
 
 void get_tx_stats(uint32_t& total_queued, uint32_t& total_sent,
@@ -138,6 +210,83 @@ void get_tx_stats(uint32_t& total_queued, uint32_t& total_sent,
     peak_queue_depth = stats.peak_queue_depth;
 }
 
+void get_tx_line_stats(uint32_t& total_bytes_sent, uint32_t& bytes_per_second,
+                       uint32_t& line_utilization_permille, uint32_t& back_to_back_frames) {
+    auto stats = ftl::uart::get_tx_statistics();
+    
+    total_bytes_sent = stats.total_bytes_sent;
+    bytes_per_second = stats.bytes_per_second;
+    line_utilization_permille = stats.line_utilization_permille;
+    back_to_back_frames = stats.back_to_back_frames;
+}
+
+void get_tx_batch_stats(uint32_t& batch_frames, uint32_t& batched_messages) {
+    auto stats = ftl::uart::get_tx_statistics();
+    
+    batch_frames = stats.batch_frames;
+    batched_messages = stats.batched_messages;
+}
+
+void set_batch_flush_us(uint32_t flush_us) {
+    ftl::uart::set_batch_flush_us(flush_us);
+}
+
+void get_bulk_stats(uint32_t& messages_sent, uint32_t& messages_received,
+                    uint32_t& fragments_received, uint32_t& timeouts, uint32_t& dropped) {
+    auto stats = ftl::uart::get_bulk_statistics();
+    
+    messages_sent = stats.messages_sent;
+    messages_received = stats.messages_received;
+    fragments_received = stats.fragments_received;
+    timeouts = stats.timeouts;
+    dropped = stats.dropped;
+}
+
+void get_tx_class_stats(ftl_config::TxClass tx_class, uint32_t& messages_sent,
+                        uint32_t& messages_dropped, uint32_t& messages_coalesced,
+                        uint32_t& peak_queue_depth, uint32_t& average_latency_us,
+                        uint32_t& max_latency_us) {
+    auto stats = ftl::uart::get_tx_class_statistics(tx_class);
+    
+    messages_sent = stats.messages_sent;
+    messages_dropped = stats.messages_dropped;
+    messages_coalesced = stats.messages_coalesced;
+    peak_queue_depth = stats.peak_queue_depth;
+    average_latency_us = stats.average_latency_us;
+    max_latency_us = stats.max_latency_us;
+}
+
+void get_reliable_stats(uint32_t& messages_sent, uint32_t& retransmits,
+                        uint32_t& messages_failed, uint32_t& duplicates, uint32_t& srtt_us) {
+    auto stats = ftl::uart::get_reliable_statistics();
+    
+    messages_sent = stats.messages_sent;
+    retransmits = stats.retransmits;
+    messages_failed = stats.messages_failed;
+    duplicates = stats.duplicates;
+    srtt_us = stats.srtt_us;
+}
+
+void get_flow_control_stats(uint32_t& stalls, uint32_t& stalled_us,
+                            uint32_t& rx_overflow_drops, uint32_t& credits_available) {
+    auto stats = ftl::uart::get_flow_control_statistics();
+    
+    stalls = stats.stalls;
+    stalled_us = stats.stalled_us;
+    credits_available = stats.credits_available;
+    rx_overflow_drops = ftl::uart::get_rx_statistics().overflow_drops;
+}
+
+void get_link_stats(uint32_t& baud_rate, uint32_t& trials_failed,
+                    uint32_t& fallbacks, uint32_t& error_permille) {
+    auto stats = ftl::uart::get_link_statistics();
+    
+    baud_rate = g_is_initialized ? stats.baud_rate : ftl_config::BAUD_RATE;
+    trials_failed = stats.trials_failed;
+    fallbacks = stats.fallbacks + stats.silence_resets;
+    error_permille = stats.error_permille;
+}
+
 uint32_t get_tx_queue_count() {
     auto stats = ftl::uart::get_tx_statistics();
     return stats.current_queue_depth;
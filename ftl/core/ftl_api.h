@@ -5,6 +5,7 @@
 #include <span>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string_view>
 
 /**
@@ -20,8 +21,14 @@
  * - CRC16 error detection
  * - Source ID tracking
  * - Zero-copy message access via reference-counted handles
- * - Fixed-size pool allocation (no heap fragmentation)
+ * - Fixed-size pool allocation in size classes (no heap fragmentation)
  * - Non-blocking TX queue (messages queued and sent during poll())
+ * - Optional batching of small messages into shared frames
+ * - Bulk transfers beyond one frame, fragmented and reassembled or streamed
+ * - Per-message reliable delivery with ACKs and retransmission
+ * - TX priority classes with per-class drop policy
+ * - Optional credit-based flow control: TX holds frames the peer has no room for
+ * - Optional baud rate negotiation up from BAUD_RATE, falling back when frames go bad
  * 
  * Usage pattern:
  * 1. Call ftl::initialize() once at startup
@@ -33,9 +40,14 @@
 namespace ftl {
 
 // Type aliases for the message pool
-using MessagePoolType = MessagePool<ftl_config::MAX_MESSAGE_SIZE, ftl_config::MESSAGE_POOL_SIZE>;
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
 using PoolHandle = MessagePoolType::Handle;
 
+// Type aliases for the bulk (multi-frame) message pool
+using BulkPoolType = MessagePool<ftl_config::BULK_MAX_MESSAGE_SIZE, ftl_config::BULK_POOL_SIZE, ftl_config::BULK_POOL_ZERO_BYTES>;
+using BulkHandle = BulkPoolType::Handle;
+
 /**
  * @brief Structure for parsed message data
  */
@@ -80,7 +92,7 @@ public:
     const uint8_t* data() const {
         const uint8_t* ptr = get_raw_ptr();
         if (!ptr) return nullptr;
-        return ptr + 2;
+        return ptr + ftl_config::SLOT_PAYLOAD_OFFSET;
     }
     
     /**
@@ -98,7 +110,7 @@ public:
     uint8_t length() const {
         const uint8_t* ptr = get_raw_ptr();
         if (!ptr) return 0;
-        return ptr[0];  // First byte is length
+        return ptr[ftl_config::SLOT_LENGTH_OFFSET];
     }
     
     /**
@@ -108,7 +120,7 @@ public:
     uint8_t source_id() const {
         const uint8_t* ptr = get_raw_ptr();
         if (!ptr) return 0;
-        return ptr[1];  // Second byte is source ID
+        return ptr[ftl_config::SLOT_SOURCE_OFFSET];
     }
     
     /**
@@ -118,9 +130,9 @@ public:
     uint16_t crc16() const {
         const uint8_t* ptr = get_raw_ptr();
         if (!ptr) return 0;
-        uint8_t len = ptr[0];
-        // CRC is stored after payload: ptr[2 + len] and ptr[2 + len + 1]
-        return (static_cast<uint16_t>(ptr[2 + len]) << 8) | ptr[2 + len + 1];
+        // CRC is stored right after the payload
+        const uint8_t* crc = ptr + ftl_config::SLOT_PAYLOAD_OFFSET + ptr[ftl_config::SLOT_LENGTH_OFFSET];
+        return (static_cast<uint16_t>(crc[0]) << 8) | crc[1];
     }
     
     /**
@@ -155,6 +167,14 @@ public:
         return static_cast<bool>(handle_);
     }
     
+    /**
+     * @brief Give up ownership of the pool slot without releasing it
+     * @return Raw pool handle; the caller becomes responsible for releasing it
+     */
+    PoolHandle detach() {
+        return handle_.detach();
+    }
+    
     /**
      * @brief Get complete message data structure
      * @return MessageData structure with all fields
@@ -163,16 +183,77 @@ public:
         MessageData msg{};
         const uint8_t* ptr = get_raw_ptr();
         if (ptr) {
-            msg.length = ptr[0];
-            msg.source_id = ptr[1];
-            msg.payload = ptr + 2;
-            msg.crc16 = (static_cast<uint16_t>(ptr[2 + msg.length]) << 8) | 
-                        ptr[2 + msg.length + 1];
+            msg.length = ptr[ftl_config::SLOT_LENGTH_OFFSET];
+            msg.source_id = ptr[ftl_config::SLOT_SOURCE_OFFSET];
+            msg.payload = ptr + ftl_config::SLOT_PAYLOAD_OFFSET;
+            msg.crc16 = (static_cast<uint16_t>(msg.payload[msg.length]) << 8) |
+                        msg.payload[msg.length + 1];
         }
         return msg;
     }
 };
 
+/**
+ * @brief A reassembled bulk message, held in a bulk pool buffer
+ * 
+ * Move-only like MessageHandle; the buffer returns to the bulk pool when the
+ * handle goes out of scope.
+ */
+class BulkMessage {
+private:
+    MsgHandle<BulkPoolType> handle_;
+    uint32_t length_ = 0;
+    uint8_t source_id_ = 0;
+
+public:
+    BulkMessage() = default;
+
+    BulkMessage(MsgHandle<BulkPoolType>&& h, uint32_t length, uint8_t source_id)
+        : handle_(std::move(h)), length_(length), source_id_(source_id) {}
+
+    BulkMessage(BulkMessage&&) = default;
+    BulkMessage& operator=(BulkMessage&&) = default;
+    BulkMessage(const BulkMessage&) = delete;
+    BulkMessage& operator=(const BulkMessage&) = delete;
+
+    const uint8_t* data() const {
+        return handle_ ? handle_.template operator-><uint8_t>() : nullptr;
+    }
+
+    uint32_t length() const { return handle_ ? length_ : 0; }
+    uint8_t source_id() const { return source_id_; }
+
+    std::span<const uint8_t> span() const {
+        return std::span<const uint8_t>(data(), length());
+    }
+
+    explicit operator bool() const { return static_cast<bool>(handle_); }
+    bool is_valid() const { return static_cast<bool>(handle_); }
+};
+
+/**
+ * @brief One fragment of an incoming bulk transfer, for stream handlers
+ * 
+ * Fragments of a transfer arrive in order starting at offset 0; `data` is
+ * only valid during the call. A transfer that loses a fragment, times out or
+ * is restarted by the sender is abandoned: the handler gets one more call
+ * with `aborted` set, empty `data` and `offset` at the first byte not
+ * delivered, and should discard what it has of that transfer.
+ */
+struct BulkFragment {
+    uint8_t source_id;
+    uint8_t message_id;
+    uint32_t offset;
+    std::span<const uint8_t> data;
+    bool last;
+    bool aborted = false;
+};
+
+// Fills `dest` with the transfer bytes starting at `offset`; returns the
+// number written (1..dest.size()), or 0 to abort the transfer
+using BulkReader = std::function<size_t(uint32_t offset, std::span<uint8_t> dest)>;
+using BulkStreamHandler = std::function<void(const BulkFragment&)>;
+
 /**
  * @brief Initialize UART hardware and DMA subsystem
  * 
@@ -217,6 +298,7 @@ MessageHandle get_msg();
  * @brief Queue a message for transmission (non-blocking)
  * 
  * @param payload Payload data to transmit (max 248 bytes)
+ * @param tx_class Priority class; see ftl_config::TX_DROP_POLICY for what a full queue does
  * @return true if queued successfully, false if queue full or data too large
  * 
  * Message is queued and will be transmitted during the next poll() call.
@@ -227,7 +309,7 @@ MessageHandle get_msg();
  * - CRC16 of payload
  * - End delimiter (0xDEFA)
  */
-bool send_msg(std::span<const uint8_t> payload);
+bool send_msg(std::span<const uint8_t> payload, ftl_config::TxClass tx_class = ftl_config::TxClass::Normal);
 
 /**
  * @brief Queue a string message for transmission (non-blocking)
@@ -237,6 +319,98 @@ bool send_msg(std::span<const uint8_t> payload);
  */
 bool send_msg(std::string_view message);
 
+/**
+ * @brief Queue an already-built message for transmission (non-blocking)
+ * 
+ * @param message Handle from a generated Builder; consumed on success or failure
+ * @return true if queued successfully, false if queue full or handle invalid
+ * 
+ * Goes through the TX queue of the class set by `priority:` in messages.yaml.
+ * 
+ * The frame is finished around the payload in the message's own pool slot and
+ * DMA reads it from there, so the payload is never copied.
+ */
+bool send_msg(MessageHandle&& message);
+
+/**
+ * @brief Queue a message for acknowledged delivery (non-blocking, either core)
+ * 
+ * @param payload Payload data to transmit (max RELIABLE_MAX_PAYLOAD bytes)
+ * @return true if accepted, false if RELIABLE_BACKLOG messages are already
+ *         waiting behind a full window, the pool is empty or the data is too large
+ * 
+ * The pool slot is held until the receiver acknowledges the message and is
+ * retransmitted from poll() when an ACK is overdue or a selective ACK shows
+ * it missing. The receiver drops duplicates and delivers reliable messages
+ * in order through the usual get_msg(). After RELIABLE_MAX_RETRIES
+ * retransmissions the message is dropped and counted as failed.
+ */
+bool send_msg_reliable(std::span<const uint8_t> payload);
+
+/**
+ * @brief Queue an already-built message for acknowledged delivery (non-blocking, either core)
+ * 
+ * @param message Handle from a generated Builder; consumed on success or failure
+ * @return true if accepted, see send_msg_reliable(std::span)
+ * 
+ * Messages marked `reliable: true` in messages.yaml are sent this way by the
+ * generated Dispatcher.
+ */
+bool send_msg_reliable(MessageHandle&& message);
+
+/**
+ * @brief Check if the reliable backlog has room for another message
+ */
+bool is_reliable_tx_ready();
+
+/**
+ * @brief Queue a payload of any size up to BULK_MAX_MESSAGE_SIZE (non-blocking, Core 0)
+ * 
+ * @param data Payload; copied into a bulk pool buffer
+ * @return true if accepted, false if a bulk transfer is already in progress,
+ *         no bulk buffer is free, or the payload is empty or too large
+ * 
+ * Fragments are fed into the TX queue during poll(), leaving room for
+ * ordinary messages, and are reassembled by the receiver.
+ */
+bool send_bulk(std::span<const uint8_t> data);
+
+/**
+ * @brief Queue a bulk transfer whose bytes are pulled on demand (non-blocking, Core 0)
+ * 
+ * @param length Total transfer length (max BULK_MAX_MESSAGE_SIZE)
+ * @param reader Called from poll() to write each fragment's data straight
+ *        into its frame; may be asked for the same offset again
+ * @return true if accepted, false if a bulk transfer is already in progress
+ */
+bool send_bulk(uint32_t length, BulkReader reader);
+
+/**
+ * @brief Check if a bulk transfer is still being sent
+ */
+bool is_bulk_tx_busy();
+
+/**
+ * @brief Check if a reassembled bulk message is available
+ */
+bool has_bulk_msg();
+
+/**
+ * @brief Retrieve the next reassembled bulk message
+ * 
+ * @return BulkMessage, or an invalid one if none is available
+ */
+BulkMessage get_bulk_msg();
+
+/**
+ * @brief Receive bulk transfers fragment by fragment instead of reassembling
+ * 
+ * @param handler Called from poll() for every fragment of transfers that
+ *        start while it is set, and once more with `aborted` if one of them
+ *        is dropped; pass nullptr to go back to reassembly
+ */
+void set_bulk_stream_handler(BulkStreamHandler handler);
+
 /**
  * @brief Check if transmitter is ready to accept more messages
  * 
@@ -265,6 +439,18 @@ void get_stats(uint32_t& total_bytes_rx, uint32_t& total_messages_rx,
                uint32_t& messages_queued, uint32_t& pool_allocated,
                uint32_t& crc_errors, uint32_t& framing_errors);
 
+/**
+ * @brief Get message pool occupancy
+ * 
+ * Slots come in MESSAGE_POOL_SLOT_SIZES classes. A steadily rising spill
+ * count means a class runs out and its messages take larger slots.
+ * 
+ * @param allocated Slots in use now, all classes
+ * @param peak_allocated Most slots ever in use at once
+ * @param spills Slots taken from a larger class because the fitting one was empty
+ */
+void get_pool_stats(uint32_t& allocated, uint32_t& peak_allocated, uint32_t& spills);
+
 /**
  * @brief Get TX statistics about message queuing and transmission
  * 
@@ -278,6 +464,102 @@ void get_tx_stats(uint32_t& total_queued, uint32_t& total_sent,
                   uint32_t& queue_full_drops, uint32_t& current_queue_depth,
                   uint32_t& peak_queue_depth);
 
+/**
+ * @brief Get TX line throughput since initialization
+ * 
+ * @param total_bytes_sent Total frame bytes handed to the UART
+ * @param bytes_per_second Average TX throughput
+ * @param line_utilization_permille Share of time a frame was on the wire (1000 = never idle)
+ * @param back_to_back_frames Frames started straight from the previous frame's completion
+ */
+void get_tx_line_stats(uint32_t& total_bytes_sent, uint32_t& bytes_per_second,
+                       uint32_t& line_utilization_permille, uint32_t& back_to_back_frames);
+
+/**
+ * @brief Get TX batching counters since initialization
+ * 
+ * @param batch_frames Frames that carried more than one message
+ * @param batched_messages Messages sent inside those frames; divided by
+ *        batch_frames this is the batching ratio
+ */
+void get_tx_batch_stats(uint32_t& batch_frames, uint32_t& batched_messages);
+
+/**
+ * @brief Set the batching flush deadline (ftl_config::BATCH_ENABLED builds)
+ * 
+ * @param flush_us Longest a message waits for others to share its frame;
+ *        0 only packs messages that are already queued together
+ */
+void set_batch_flush_us(uint32_t flush_us);
+
+/**
+ * @brief Get bulk transfer counters since initialization
+ * 
+ * @param messages_sent Bulk transfers fully queued for TX
+ * @param messages_received Bulk transfers completed on RX
+ * @param fragments_received Fragment frames received
+ * @param timeouts Incomplete RX transfers reclaimed after BULK_REASSEMBLY_TIMEOUT_US
+ * @param dropped Fragments discarded (out of sequence, too large, or no buffer)
+ */
+void get_bulk_stats(uint32_t& messages_sent, uint32_t& messages_received,
+                    uint32_t& fragments_received, uint32_t& timeouts, uint32_t& dropped);
+
+/**
+ * @brief Get counters for one TX priority class since initialization
+ * 
+ * @param tx_class Class to report
+ * @param messages_sent Messages handed to the TX DMA
+ * @param messages_dropped Messages refused or pushed out of the full queue
+ * @param messages_coalesced Queued messages replaced by a newer one of the same type
+ * @param peak_queue_depth Peak depth of this class's queue
+ * @param average_latency_us Mean time from queueing to the TX DMA
+ * @param max_latency_us Longest time from queueing to the TX DMA
+ */
+void get_tx_class_stats(ftl_config::TxClass tx_class, uint32_t& messages_sent,
+                        uint32_t& messages_dropped, uint32_t& messages_coalesced,
+                        uint32_t& peak_queue_depth, uint32_t& average_latency_us,
+                        uint32_t& max_latency_us);
+
+/**
+ * @brief Get reliable delivery counters since initialization
+ * 
+ * @param messages_sent Messages accepted by send_msg_reliable()
+ * @param retransmits Frames sent again after a timeout or selective ACK
+ * @param messages_failed Messages dropped after RELIABLE_MAX_RETRIES
+ * @param duplicates Received messages dropped as already delivered
+ * @param srtt_us Smoothed round-trip time; the retransmit timeout follows it
+ */
+void get_reliable_stats(uint32_t& messages_sent, uint32_t& retransmits,
+                        uint32_t& messages_failed, uint32_t& duplicates, uint32_t& srtt_us);
+
+/**
+ * @brief Get flow control counters since initialization
+ * 
+ * Stalls are frames this end held until the peer had room for them; overflow
+ * drops are frames this end lost because its own RX queue or pool was full.
+ * 
+ * @param stalls Times TX was held for want of credit
+ * @param stalled_us Total time TX was held
+ * @param rx_overflow_drops Received frames evicted from the full RX queue or without a pool slot
+ * @param credits_available Frames the peer can take now (0 if it sends no credits)
+ */
+void get_flow_control_stats(uint32_t& stalls, uint32_t& stalled_us,
+                            uint32_t& rx_overflow_drops, uint32_t& credits_available);
+
+/**
+ * @brief Get the negotiated line rate and link quality counters
+ * 
+ * The rate stays at BAUD_RATE until a peer answers; crc_errors and
+ * framing_errors from get_stats() count the bad frames behind fallbacks.
+ * 
+ * @param baud_rate Rate the UART is running at now
+ * @param trials_failed Faster rates tried and given up on
+ * @param fallbacks Steps down after too many bad frames, or after silence
+ * @param error_permille Bad frames per thousand in the last quality window
+ */
+void get_link_stats(uint32_t& baud_rate, uint32_t& trials_failed,
+                    uint32_t& fallbacks, uint32_t& error_permille);
+
 /**
  * @brief Get current number of messages in TX queue
  * 
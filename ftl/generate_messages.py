@@ -5,7 +5,7 @@ Generates C++ message types, views, and builders from YAML schema
 
 Now supports:
 - Primitive types (uint8_t, float, etc.)
-- String types (length-prefixed)
+- String types (length-prefixed, last field only)
 - Array types (uint32_t[5], float[10], etc.)
 """
 
@@ -17,6 +17,14 @@ from jinja2 import Environment, FileSystemLoader
 from dataclasses import dataclass
 from typing import List, Optional
 
+# Wire sizes of the primitive field types
+TYPE_SIZES = {
+    'uint8_t': 1, 'int8_t': 1, 'bool': 1,
+    'uint16_t': 2, 'int16_t': 2,
+    'uint32_t': 4, 'int32_t': 4, 'float': 4,
+    'uint64_t': 8, 'int64_t': 8, 'double': 8,
+}
+
 @dataclass
 class Field:
     """Represents a message field"""
@@ -26,6 +34,7 @@ class Field:
     is_array: bool = False
     array_size: int = 0
     element_type: str = ""
+    offset: int = 0  # From the start of the payload, set by Message.layout()
     
     @classmethod
     def from_yaml(cls, field_def: dict) -> 'Field':
@@ -46,6 +55,8 @@ class Field:
         if array_match:
             element_type = array_match.group(1)
             array_size = int(array_match.group(2))
+            if element_type not in TYPE_SIZES:
+                raise ValueError(f"{name}: unknown array element type '{element_type}'")
             return cls(
                 type=type_str,
                 name=name,
@@ -55,6 +66,8 @@ class Field:
             )
         
         # Regular primitive type
+        if type_str not in TYPE_SIZES:
+            raise ValueError(f"{name}: unknown type '{type_str}'")
         return cls(
             type=type_str,
             name=name
@@ -79,28 +92,21 @@ class Field:
         return self.type
     
     @property
-    def size_expr(self) -> str:
-        """Get size expression for serialization"""
+    def struct_type(self) -> str:
+        """Get C++ type for the field's member of the packed Fields struct"""
+        if self.is_array:
+            return f"std::array<{self.element_type}, {self.array_size}>"
+        return self.type
+    
+    @property
+    def size(self) -> Optional[int]:
+        """Wire size in bytes, None for a string"""
         if self.is_string:
-            return f"(1 + {self.name}.size())"  # length byte + data
-        
+            return None
         if self.is_array:
-            size_map = {
-                'uint8_t': '1', 'int8_t': '1', 'bool': '1',
-                'uint16_t': '2', 'int16_t': '2',
-                'uint32_t': '4', 'int32_t': '4', 'float': '4',
-                'uint64_t': '8', 'int64_t': '8', 'double': '8',
-            }
-            element_size = size_map.get(self.element_type, f"sizeof({self.element_type})")
-            return f"({element_size} * {self.array_size})"
-        
-        size_map = {
-            'uint8_t': '1', 'int8_t': '1', 'bool': '1',
-            'uint16_t': '2', 'int16_t': '2',
-            'uint32_t': '4', 'int32_t': '4', 'float': '4',
-            'uint64_t': '8', 'int64_t': '8', 'double': '8',
-        }
-        return size_map.get(self.type, f"sizeof({self.type})")
+            return TYPE_SIZES[self.element_type] * self.array_size
+        return TYPE_SIZES[self.type]
+    
 
 @dataclass
 class Message:
@@ -108,38 +114,50 @@ class Message:
     name: str
     fields: List[Field]
     type_id: int
+    reliable: bool = False  # Sent with acknowledgement and retransmission
+    priority: str = "Normal"  # ftl_config::TxClass enumerator
+    
+    def layout(self):
+        """Assign each field its payload offset. Fixed-size fields come first,
+        at offsets known here; a string may only be the last field."""
+        offset = 1  # message type byte
+        for index, field in enumerate(self.fields):
+            if field.is_string and index != len(self.fields) - 1:
+                raise ValueError(f"{self.name}: string '{field.name}' must be the last field")
+            field.offset = offset
+            if not field.is_string:
+                offset += field.size
+    
+    @property
+    def fixed_size(self) -> int:
+        """Type byte and fixed-size fields: the shortest valid payload"""
+        return 1 + sum(field.size for field in self.fields if not field.is_string)
+    
+    @property
+    def is_fixed(self) -> bool:
+        """True when every field has a fixed size"""
+        return not any(field.is_string for field in self.fields)
+    
+    @property
+    def tail(self) -> Optional[Field]:
+        """The variable-length field at the end, if any"""
+        return None if self.is_fixed else self.fields[-1]
     
     @property
     def max_size(self) -> str:
         """Calculate maximum message size"""
-        fixed_size = 1  # message type byte
-        has_variable = False
-        
-        for field in self.fields:
-            if field.is_string:
-                has_variable = True
-                fixed_size += 1  # just the length byte for sizing
-            elif field.is_array:
-                size_map = {
-                    'uint8_t': 1, 'int8_t': 1, 'bool': 1,
-                    'uint16_t': 2, 'int16_t': 2,
-                    'uint32_t': 4, 'int32_t': 4, 'float': 4,
-                    'uint64_t': 8, 'int64_t': 8, 'double': 8,
-                }
-                element_size = size_map.get(field.element_type, 4)
-                fixed_size += element_size * field.array_size
-            else:
-                size_map = {
-                    'uint8_t': 1, 'int8_t': 1, 'bool': 1,
-                    'uint16_t': 2, 'int16_t': 2,
-                    'uint32_t': 4, 'int32_t': 4, 'float': 4,
-                    'uint64_t': 8, 'int64_t': 8, 'double': 8,
-                }
-                fixed_size += size_map.get(field.type, 4)
-        
-        if has_variable:
-            return f"{fixed_size} + string_data"  # Comment for clarity
-        return str(fixed_size)
+        if self.is_fixed:
+            return str(self.fixed_size)
+        return f"{self.fixed_size + 1} + string_data"  # Length byte for the string
+    
+    @property
+    def max_payload_size(self) -> Optional[int]:
+        """Largest encoded payload in bytes, None if a string leaves it open"""
+        return self.fixed_size if self.is_fixed else None
+
+
+# messages.yaml `priority:` values and the TX classes they select
+TX_CLASSES = {'control': 'Control', 'normal': 'Normal', 'telemetry': 'Telemetry', 'stream': 'Stream'}
 
 
 def parse_yaml(yaml_path: Path) -> List[Message]:
@@ -151,11 +169,20 @@ def parse_yaml(yaml_path: Path) -> List[Message]:
     for idx, msg_def in enumerate(data['messages']):
         fields = [Field.from_yaml(field_def) for field_def in msg_def['fields']]
         
-        messages.append(Message(
+        priority = str(msg_def.get('priority', 'normal')).lower()
+        if priority not in TX_CLASSES:
+            raise ValueError(f"{msg_def['name']}: unknown priority '{priority}' "
+                             f"(expected one of {', '.join(TX_CLASSES)})")
+        
+        message = Message(
             name=msg_def['name'],
             fields=fields,
-            type_id=idx
-        ))
+            type_id=idx,
+            reliable=bool(msg_def.get('reliable', False)),
+            priority=TX_CLASSES[priority]
+        )
+        message.layout()
+        messages.append(message)
     
     return messages
 
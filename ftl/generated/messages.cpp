@@ -188,7 +188,7 @@ bool Dispatcher::send_msg_remote_log(uint32_t timestamp, std::string_view remote
         .build();
     
     if (msg.is_valid()) {
-        return ftl::send_msg(msg.span());
+        return ftl::send_msg_reliable(std::move(msg));  // Held in its slot until acknowledged
     }
     return false;
 }
@@ -201,7 +201,7 @@ bool Dispatcher::send_msg_system_state(uint8_t state_id, bool is_active, uint32_
         .build();
     
     if (msg.is_valid()) {
-        return ftl::send_msg(msg.span());
+        return ftl::send_msg(std::move(msg));  // Sent from the builder's own slot
     }
     return false;
 }
@@ -213,7 +213,7 @@ bool Dispatcher::send_msg_sensor_hx711(uint32_t timestamp, std::span<const uint3
         .build();
     
     if (msg.is_valid()) {
-        return ftl::send_msg(msg.span());
+        return ftl::send_msg(std::move(msg));  // Sent from the builder's own slot
     }
     return false;
 }
@@ -229,7 +229,7 @@ bool Dispatcher::send_msg_sensor_ads1115(uint32_t timestamp, float raw_1, float
         .build();
     
     if (msg.is_valid()) {
-        return ftl::send_msg(msg.span());
+        return ftl::send_msg(std::move(msg));  // Sent from the builder's own slot
     }
     return false;
 }
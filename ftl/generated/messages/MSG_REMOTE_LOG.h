@@ -29,6 +29,14 @@ public:
     using View = MSG_REMOTE_LOG_View;
     using Builder = MSG_REMOTE_LOG_Builder;
     static constexpr MessageType TYPE = MessageType::MSG_REMOTE_LOG;
+    static constexpr bool RELIABLE = true;
+    static constexpr ftl_config::TxClass TX_CLASS = ftl_config::TxClass::Normal;
+
+    // Payload layout, fixed at generation time: [TYPE], then each field at
+    // its offset; remote_printf runs to the end of the payload
+    static constexpr size_t TIMESTAMP_OFFSET = 1;
+    static constexpr size_t REMOTE_PRINTF_OFFSET = 5;
+    static constexpr size_t FIXED_SIZE = 5;   // Shortest valid payload
 };
 
 /**
@@ -50,14 +58,13 @@ private:
 public:
     static constexpr MessageType TYPE = MessageType::MSG_REMOTE_LOG;
     
-    // Field accessors
+    // Field accessors. parse_MSG_REMOTE_LOG() checked the payload holds every
+    // fixed-size field, so each of those is a single load at a constant offset.
     uint32_t timestamp() const {
-        size_t offset = 1;  // Skip message type byte
-        return detail::read_primitive<uint32_t>(data_, offset);
+        return detail::load<uint32_t>(data_ + MSG_REMOTE_LOG::TIMESTAMP_OFFSET);
     }
     std::string_view remote_printf() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 4;
+        size_t offset = MSG_REMOTE_LOG::REMOTE_PRINTF_OFFSET;
         return detail::read_string(data_, offset, length_);
     }
     
@@ -78,23 +85,41 @@ private:
     size_t offset_;
     bool valid_;
     
+    // Reliable messages leave room for the link header sent in front of them
+    static constexpr size_t PAYLOAD_END = detail::RELIABLE_SLOT_PAYLOAD_END;
+
+    // Slot for the largest encoding; the pool takes it from the smallest size
+    // class that fits. Strings have no bound short of a full frame.
+    static constexpr size_t SLOT_SIZE = ftl_config::MAX_MESSAGE_SIZE;
+    static_assert(SLOT_SIZE <= ftl_config::MAX_MESSAGE_SIZE, "MSG_REMOTE_LOG does not fit in a frame");
+    static_assert(ftl_config::SLOT_PAYLOAD_OFFSET + MSG_REMOTE_LOG::FIXED_SIZE <= PAYLOAD_END,
+                  "MSG_REMOTE_LOG fixed-size fields must fit in the payload");
+
+    // Slot address of a payload offset
+    static constexpr size_t at(size_t payload_offset) {
+        return ftl_config::SLOT_PAYLOAD_OFFSET + payload_offset;
+    }
+    
     ftl::MessagePoolType& get_pool() {
         return get_message_pool();
     }
 
 public:
     MSG_REMOTE_LOG_Builder() 
-        : handle_(get_pool().acquire())
+        : handle_(get_pool().acquire(SLOT_SIZE))
         , data_(nullptr)
-        , offset_(3)  // Start after [LENGTH][SOURCE][TYPE]
+        , offset_(at(MSG_REMOTE_LOG::FIXED_SIZE))  // End of the fixed-size fields
         , valid_(handle_ != ftl::MessagePoolType::INVALID)
     {
         if (valid_) {
             data_ = get_pool().get_ptr<uint8_t>(handle_);
             if (data_) {
-                // Buffer layout: [LENGTH][SOURCE][TYPE][FIELDS...]
-                // Length and Source will be filled in build()
-                data_[2] = static_cast<uint8_t>(MessageType::MSG_REMOTE_LOG);
+                // Buffer layout: [START][LENGTH][SOURCE][TYPE][FIELDS...][CRC][END]
+                // Length and Source are filled in build(), the rest by the transport
+                data_[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(ftl_config::TxClass::Normal);
+                data_[ftl_config::SLOT_PAYLOAD_OFFSET] = static_cast<uint8_t>(MessageType::MSG_REMOTE_LOG);
+                // Fields are written at fixed offsets in any order; unset ones go out as zero
+                std::memset(&data_[at(1)], 0, MSG_REMOTE_LOG::FIXED_SIZE - 1);
             } else {
                 valid_ = false;
             }
@@ -123,17 +148,17 @@ public:
     
     MSG_REMOTE_LOG_Builder& timestamp(uint32_t value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(uint32_t) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_REMOTE_LOG::TIMESTAMP_OFFSET)], value);
         }
         return *this;
     }
+    // Replaces any earlier value; the payload ends after it
     MSG_REMOTE_LOG_Builder& remote_printf(std::string_view value) {
         if (valid_ && data_) {
-            if (!detail::write_string(data_, offset_, ftl_config::MAX_PAYLOAD_SIZE, value)) {
+            size_t offset = at(MSG_REMOTE_LOG::REMOTE_PRINTF_OFFSET);
+            if (detail::write_string(data_, offset, PAYLOAD_END, value)) {
+                offset_ = offset;
+            } else {
                 valid_ = false;
             }
         }
@@ -153,13 +178,13 @@ public:
             return ftl::MessageHandle{};
         }
         
-        // Calculate payload length: offset - 2 (skip LENGTH and SOURCE bytes)
-        uint8_t payload_length = static_cast<uint8_t>(offset_ - 2);
+        // Calculate payload length: everything after the header headroom
+        uint8_t payload_length = static_cast<uint8_t>(offset_ - ftl_config::SLOT_PAYLOAD_OFFSET);
         
-        // Set buffer header: [LENGTH][SOURCE][TYPE][FIELDS...]
-        data_[0] = payload_length;                      // Payload length
-        data_[1] = ftl::get_my_source_id();        // Source ID
-        // data_[2] already set to message type in constructor
+        // Set buffer header: [START][LENGTH][SOURCE][TYPE][FIELDS...]
+        data_[ftl_config::SLOT_LENGTH_OFFSET] = payload_length;          // Payload length
+        data_[ftl_config::SLOT_SOURCE_OFFSET] = ftl::get_my_source_id(); // Source ID
+        // Message type already set in constructor
         
         // Create MessageHandle with the raw handle
         auto msg_handle = ftl::MessageHandle(
@@ -187,7 +212,7 @@ inline MessageResult<MSG_REMOTE_LOG_View> parse_MSG_REMOTE_LOG(const ftl::Messag
     const uint8_t* data = handle.data();
     uint8_t length = handle.length();
     
-    if (length < 1) {
+    if (length < MSG_REMOTE_LOG::FIXED_SIZE) {
         return std::unexpected(MessageError::BUFFER_TOO_SMALL);
     }
     
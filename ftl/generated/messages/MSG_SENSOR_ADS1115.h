@@ -29,6 +29,30 @@ public:
     using View = MSG_SENSOR_ADS1115_View;
     using Builder = MSG_SENSOR_ADS1115_Builder;
     static constexpr MessageType TYPE = MessageType::MSG_SENSOR_ADS1115;
+    static constexpr bool RELIABLE = false;
+    static constexpr ftl_config::TxClass TX_CLASS = ftl_config::TxClass::Telemetry;
+
+    // Payload layout, fixed at generation time: [TYPE], then each field at
+    // its offset
+    static constexpr size_t TIMESTAMP_OFFSET = 1;
+    static constexpr size_t RAW_1_OFFSET = 5;
+    static constexpr size_t RAW_2_OFFSET = 9;
+    static constexpr size_t RAW_3_OFFSET = 13;
+    static constexpr size_t RAW_4_OFFSET = 17;
+    static constexpr size_t RAW_5_OFFSET = 21;
+    static constexpr size_t FIXED_SIZE = 25;   // Shortest valid payload
+
+    // Every field in one copy, packed exactly as on the wire after [TYPE]
+    struct [[gnu::packed]] Fields {
+        uint32_t timestamp;
+        float raw_1;
+        float raw_2;
+        float raw_3;
+        float raw_4;
+        float raw_5;
+    };
+    static_assert(1 + sizeof(Fields) == FIXED_SIZE && std::is_trivially_copyable_v<Fields>,
+                  "MSG_SENSOR_ADS1115::Fields must match the wire layout");
 };
 
 /**
@@ -50,45 +74,30 @@ private:
 public:
     static constexpr MessageType TYPE = MessageType::MSG_SENSOR_ADS1115;
     
-    // Field accessors
+    // Field accessors. parse_MSG_SENSOR_ADS1115() checked the payload holds every
+    // fixed-size field, so each of those is a single load at a constant offset.
     uint32_t timestamp() const {
-        size_t offset = 1;  // Skip message type byte
-        return detail::read_primitive<uint32_t>(data_, offset);
+        return detail::load<uint32_t>(data_ + MSG_SENSOR_ADS1115::TIMESTAMP_OFFSET);
     }
     float raw_1() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 4;
-        return detail::read_primitive<float>(data_, offset);
+        return detail::load<float>(data_ + MSG_SENSOR_ADS1115::RAW_1_OFFSET);
     }
     float raw_2() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 4;
-        offset += 4;
-        return detail::read_primitive<float>(data_, offset);
+        return detail::load<float>(data_ + MSG_SENSOR_ADS1115::RAW_2_OFFSET);
     }
     float raw_3() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 4;
-        offset += 4;
-        offset += 4;
-        return detail::read_primitive<float>(data_, offset);
+        return detail::load<float>(data_ + MSG_SENSOR_ADS1115::RAW_3_OFFSET);
     }
     float raw_4() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 4;
-        offset += 4;
-        offset += 4;
-        offset += 4;
-        return detail::read_primitive<float>(data_, offset);
+        return detail::load<float>(data_ + MSG_SENSOR_ADS1115::RAW_4_OFFSET);
     }
     float raw_5() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 4;
-        offset += 4;
-        offset += 4;
-        offset += 4;
-        offset += 4;
-        return detail::read_primitive<float>(data_, offset);
+        return detail::load<float>(data_ + MSG_SENSOR_ADS1115::RAW_5_OFFSET);
+    }
+    
+    // All fields in one copy
+    MSG_SENSOR_ADS1115::Fields read_all() const {
+        return detail::load<MSG_SENSOR_ADS1115::Fields>(data_ + 1);
     }
     
     // Get message type
@@ -108,23 +117,40 @@ private:
     size_t offset_;
     bool valid_;
     
+    static constexpr size_t PAYLOAD_END = detail::SLOT_PAYLOAD_END;
+
+    // Slot for the largest encoding; the pool takes it from the smallest size
+    // class that fits. Strings have no bound short of a full frame.
+    static constexpr size_t SLOT_SIZE = ftl_config::slot_size_for(MSG_SENSOR_ADS1115::FIXED_SIZE);
+    static_assert(SLOT_SIZE <= ftl_config::MAX_MESSAGE_SIZE, "MSG_SENSOR_ADS1115 does not fit in a frame");
+    static_assert(ftl_config::SLOT_PAYLOAD_OFFSET + MSG_SENSOR_ADS1115::FIXED_SIZE <= PAYLOAD_END,
+                  "MSG_SENSOR_ADS1115 fixed-size fields must fit in the payload");
+
+    // Slot address of a payload offset
+    static constexpr size_t at(size_t payload_offset) {
+        return ftl_config::SLOT_PAYLOAD_OFFSET + payload_offset;
+    }
+    
     ftl::MessagePoolType& get_pool() {
         return get_message_pool();
     }
 
 public:
     MSG_SENSOR_ADS1115_Builder() 
-        : handle_(get_pool().acquire())
+        : handle_(get_pool().acquire(SLOT_SIZE))
         , data_(nullptr)
-        , offset_(3)  // Start after [LENGTH][SOURCE][TYPE]
+        , offset_(at(MSG_SENSOR_ADS1115::FIXED_SIZE))  // End of the fixed-size fields
         , valid_(handle_ != ftl::MessagePoolType::INVALID)
     {
         if (valid_) {
             data_ = get_pool().get_ptr<uint8_t>(handle_);
             if (data_) {
-                // Buffer layout: [LENGTH][SOURCE][TYPE][FIELDS...]
-                // Length and Source will be filled in build()
-                data_[2] = static_cast<uint8_t>(MessageType::MSG_SENSOR_ADS1115);
+                // Buffer layout: [START][LENGTH][SOURCE][TYPE][FIELDS...][CRC][END]
+                // Length and Source are filled in build(), the rest by the transport
+                data_[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(ftl_config::TxClass::Telemetry);
+                data_[ftl_config::SLOT_PAYLOAD_OFFSET] = static_cast<uint8_t>(MessageType::MSG_SENSOR_ADS1115);
+                // Fields are written at fixed offsets in any order; unset ones go out as zero
+                std::memset(&data_[at(1)], 0, MSG_SENSOR_ADS1115::FIXED_SIZE - 1);
             } else {
                 valid_ = false;
             }
@@ -153,61 +179,45 @@ public:
     
     MSG_SENSOR_ADS1115_Builder& timestamp(uint32_t value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(uint32_t) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SENSOR_ADS1115::TIMESTAMP_OFFSET)], value);
         }
         return *this;
     }
     MSG_SENSOR_ADS1115_Builder& raw_1(float value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(float) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SENSOR_ADS1115::RAW_1_OFFSET)], value);
         }
         return *this;
     }
     MSG_SENSOR_ADS1115_Builder& raw_2(float value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(float) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SENSOR_ADS1115::RAW_2_OFFSET)], value);
         }
         return *this;
     }
     MSG_SENSOR_ADS1115_Builder& raw_3(float value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(float) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SENSOR_ADS1115::RAW_3_OFFSET)], value);
         }
         return *this;
     }
     MSG_SENSOR_ADS1115_Builder& raw_4(float value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(float) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SENSOR_ADS1115::RAW_4_OFFSET)], value);
         }
         return *this;
     }
     MSG_SENSOR_ADS1115_Builder& raw_5(float value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(float) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SENSOR_ADS1115::RAW_5_OFFSET)], value);
+        }
+        return *this;
+    }
+    
+    // All fields in one copy
+    MSG_SENSOR_ADS1115_Builder& write_all(const MSG_SENSOR_ADS1115::Fields& fields) {
+        if (valid_ && data_) {
+            detail::store(&data_[at(1)], fields);
         }
         return *this;
     }
@@ -225,13 +235,13 @@ public:
             return ftl::MessageHandle{};
         }
         
-        // Calculate payload length: offset - 2 (skip LENGTH and SOURCE bytes)
-        uint8_t payload_length = static_cast<uint8_t>(offset_ - 2);
+        // Calculate payload length: everything after the header headroom
+        uint8_t payload_length = static_cast<uint8_t>(offset_ - ftl_config::SLOT_PAYLOAD_OFFSET);
         
-        // Set buffer header: [LENGTH][SOURCE][TYPE][FIELDS...]
-        data_[0] = payload_length;                      // Payload length
-        data_[1] = ftl::get_my_source_id();        // Source ID
-        // data_[2] already set to message type in constructor
+        // Set buffer header: [START][LENGTH][SOURCE][TYPE][FIELDS...]
+        data_[ftl_config::SLOT_LENGTH_OFFSET] = payload_length;          // Payload length
+        data_[ftl_config::SLOT_SOURCE_OFFSET] = ftl::get_my_source_id(); // Source ID
+        // Message type already set in constructor
         
         // Create MessageHandle with the raw handle
         auto msg_handle = ftl::MessageHandle(
@@ -259,7 +269,7 @@ inline MessageResult<MSG_SENSOR_ADS1115_View> parse_MSG_SENSOR_ADS1115(const ftl
     const uint8_t* data = handle.data();
     uint8_t length = handle.length();
     
-    if (length < 1) {
+    if (length < MSG_SENSOR_ADS1115::FIXED_SIZE) {
         return std::unexpected(MessageError::BUFFER_TOO_SMALL);
     }
     
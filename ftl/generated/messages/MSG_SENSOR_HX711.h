@@ -29,6 +29,22 @@ public:
     using View = MSG_SENSOR_HX711_View;
     using Builder = MSG_SENSOR_HX711_Builder;
     static constexpr MessageType TYPE = MessageType::MSG_SENSOR_HX711;
+    static constexpr bool RELIABLE = false;
+    static constexpr ftl_config::TxClass TX_CLASS = ftl_config::TxClass::Stream;
+
+    // Payload layout, fixed at generation time: [TYPE], then each field at
+    // its offset
+    static constexpr size_t TIMESTAMP_OFFSET = 1;
+    static constexpr size_t SAMPLES_OFFSET = 5;
+    static constexpr size_t FIXED_SIZE = 45;   // Shortest valid payload
+
+    // Every field in one copy, packed exactly as on the wire after [TYPE]
+    struct [[gnu::packed]] Fields {
+        uint32_t timestamp;
+        std::array<uint32_t, 10> samples;
+    };
+    static_assert(1 + sizeof(Fields) == FIXED_SIZE && std::is_trivially_copyable_v<Fields>,
+                  "MSG_SENSOR_HX711::Fields must match the wire layout");
 };
 
 /**
@@ -50,15 +66,18 @@ private:
 public:
     static constexpr MessageType TYPE = MessageType::MSG_SENSOR_HX711;
     
-    // Field accessors
+    // Field accessors. parse_MSG_SENSOR_HX711() checked the payload holds every
+    // fixed-size field, so each of those is a single load at a constant offset.
     uint32_t timestamp() const {
-        size_t offset = 1;  // Skip message type byte
-        return detail::read_primitive<uint32_t>(data_, offset);
+        return detail::load<uint32_t>(data_ + MSG_SENSOR_HX711::TIMESTAMP_OFFSET);
     }
     std::span<const uint32_t> samples() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 4;
-        return detail::read_array<uint32_t, 10>(data_, offset, length_);
+        return detail::array_at<uint32_t, 10>(data_ + MSG_SENSOR_HX711::SAMPLES_OFFSET);
+    }
+    
+    // All fields in one copy
+    MSG_SENSOR_HX711::Fields read_all() const {
+        return detail::load<MSG_SENSOR_HX711::Fields>(data_ + 1);
     }
     
     // Get message type
@@ -78,23 +97,40 @@ private:
     size_t offset_;
     bool valid_;
     
+    static constexpr size_t PAYLOAD_END = detail::SLOT_PAYLOAD_END;
+
+    // Slot for the largest encoding; the pool takes it from the smallest size
+    // class that fits. Strings have no bound short of a full frame.
+    static constexpr size_t SLOT_SIZE = ftl_config::slot_size_for(MSG_SENSOR_HX711::FIXED_SIZE);
+    static_assert(SLOT_SIZE <= ftl_config::MAX_MESSAGE_SIZE, "MSG_SENSOR_HX711 does not fit in a frame");
+    static_assert(ftl_config::SLOT_PAYLOAD_OFFSET + MSG_SENSOR_HX711::FIXED_SIZE <= PAYLOAD_END,
+                  "MSG_SENSOR_HX711 fixed-size fields must fit in the payload");
+
+    // Slot address of a payload offset
+    static constexpr size_t at(size_t payload_offset) {
+        return ftl_config::SLOT_PAYLOAD_OFFSET + payload_offset;
+    }
+    
     ftl::MessagePoolType& get_pool() {
         return get_message_pool();
     }
 
 public:
     MSG_SENSOR_HX711_Builder() 
-        : handle_(get_pool().acquire())
+        : handle_(get_pool().acquire(SLOT_SIZE))
         , data_(nullptr)
-        , offset_(3)  // Start after [LENGTH][SOURCE][TYPE]
+        , offset_(at(MSG_SENSOR_HX711::FIXED_SIZE))  // End of the fixed-size fields
         , valid_(handle_ != ftl::MessagePoolType::INVALID)
     {
         if (valid_) {
             data_ = get_pool().get_ptr<uint8_t>(handle_);
             if (data_) {
-                // Buffer layout: [LENGTH][SOURCE][TYPE][FIELDS...]
-                // Length and Source will be filled in build()
-                data_[2] = static_cast<uint8_t>(MessageType::MSG_SENSOR_HX711);
+                // Buffer layout: [START][LENGTH][SOURCE][TYPE][FIELDS...][CRC][END]
+                // Length and Source are filled in build(), the rest by the transport
+                data_[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(ftl_config::TxClass::Stream);
+                data_[ftl_config::SLOT_PAYLOAD_OFFSET] = static_cast<uint8_t>(MessageType::MSG_SENSOR_HX711);
+                // Fields are written at fixed offsets in any order; unset ones go out as zero
+                std::memset(&data_[at(1)], 0, MSG_SENSOR_HX711::FIXED_SIZE - 1);
             } else {
                 valid_ = false;
             }
@@ -123,18 +159,16 @@ public:
     
     MSG_SENSOR_HX711_Builder& timestamp(uint32_t value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(uint32_t) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SENSOR_HX711::TIMESTAMP_OFFSET)], value);
         }
         return *this;
     }
     // Accept std::span<const uint32_t>
     MSG_SENSOR_HX711_Builder& samples(std::span<const uint32_t> values) {
         if (valid_ && data_) {
-            if (!detail::write_array<uint32_t, 10>(data_, offset_, ftl_config::MAX_PAYLOAD_SIZE, values)) {
+            if (values.size() == 10) {
+                std::memcpy(&data_[at(MSG_SENSOR_HX711::SAMPLES_OFFSET)], values.data(), 40);
+            } else {
                 valid_ = false;
             }
         }
@@ -146,6 +180,14 @@ public:
         return samples(std::span<const uint32_t>(values.data(), 10));
     }
     
+    // All fields in one copy
+    MSG_SENSOR_HX711_Builder& write_all(const MSG_SENSOR_HX711::Fields& fields) {
+        if (valid_ && data_) {
+            detail::store(&data_[at(1)], fields);
+        }
+        return *this;
+    }
+    
     /**
      * @brief Build and return MessageHandle
      * 
@@ -159,13 +201,13 @@ public:
             return ftl::MessageHandle{};
         }
         
-        // Calculate payload length: offset - 2 (skip LENGTH and SOURCE bytes)
-        uint8_t payload_length = static_cast<uint8_t>(offset_ - 2);
+        // Calculate payload length: everything after the header headroom
+        uint8_t payload_length = static_cast<uint8_t>(offset_ - ftl_config::SLOT_PAYLOAD_OFFSET);
         
-        // Set buffer header: [LENGTH][SOURCE][TYPE][FIELDS...]
-        data_[0] = payload_length;                      // Payload length
-        data_[1] = ftl::get_my_source_id();        // Source ID
-        // data_[2] already set to message type in constructor
+        // Set buffer header: [START][LENGTH][SOURCE][TYPE][FIELDS...]
+        data_[ftl_config::SLOT_LENGTH_OFFSET] = payload_length;          // Payload length
+        data_[ftl_config::SLOT_SOURCE_OFFSET] = ftl::get_my_source_id(); // Source ID
+        // Message type already set in constructor
         
         // Create MessageHandle with the raw handle
         auto msg_handle = ftl::MessageHandle(
@@ -193,7 +235,7 @@ inline MessageResult<MSG_SENSOR_HX711_View> parse_MSG_SENSOR_HX711(const ftl::Me
     const uint8_t* data = handle.data();
     uint8_t length = handle.length();
     
-    if (length < 1) {
+    if (length < MSG_SENSOR_HX711::FIXED_SIZE) {
         return std::unexpected(MessageError::BUFFER_TOO_SMALL);
     }
     
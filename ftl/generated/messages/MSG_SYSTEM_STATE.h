@@ -29,6 +29,24 @@ public:
     using View = MSG_SYSTEM_STATE_View;
     using Builder = MSG_SYSTEM_STATE_Builder;
     static constexpr MessageType TYPE = MessageType::MSG_SYSTEM_STATE;
+    static constexpr bool RELIABLE = false;
+    static constexpr ftl_config::TxClass TX_CLASS = ftl_config::TxClass::Control;
+
+    // Payload layout, fixed at generation time: [TYPE], then each field at
+    // its offset
+    static constexpr size_t STATE_ID_OFFSET = 1;
+    static constexpr size_t IS_ACTIVE_OFFSET = 2;
+    static constexpr size_t UPTIME_MS_OFFSET = 3;
+    static constexpr size_t FIXED_SIZE = 7;   // Shortest valid payload
+
+    // Every field in one copy, packed exactly as on the wire after [TYPE]
+    struct [[gnu::packed]] Fields {
+        uint8_t state_id;
+        bool is_active;
+        uint32_t uptime_ms;
+    };
+    static_assert(1 + sizeof(Fields) == FIXED_SIZE && std::is_trivially_copyable_v<Fields>,
+                  "MSG_SYSTEM_STATE::Fields must match the wire layout");
 };
 
 /**
@@ -50,21 +68,21 @@ private:
 public:
     static constexpr MessageType TYPE = MessageType::MSG_SYSTEM_STATE;
     
-    // Field accessors
+    // Field accessors. parse_MSG_SYSTEM_STATE() checked the payload holds every
+    // fixed-size field, so each of those is a single load at a constant offset.
     uint8_t state_id() const {
-        size_t offset = 1;  // Skip message type byte
-        return detail::read_primitive<uint8_t>(data_, offset);
+        return detail::load<uint8_t>(data_ + MSG_SYSTEM_STATE::STATE_ID_OFFSET);
     }
     bool is_active() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 1;
-        return detail::read_primitive<bool>(data_, offset);
+        return detail::load<bool>(data_ + MSG_SYSTEM_STATE::IS_ACTIVE_OFFSET);
     }
     uint32_t uptime_ms() const {
-        size_t offset = 1;  // Skip message type byte
-        offset += 1;
-        offset += 1;
-        return detail::read_primitive<uint32_t>(data_, offset);
+        return detail::load<uint32_t>(data_ + MSG_SYSTEM_STATE::UPTIME_MS_OFFSET);
+    }
+    
+    // All fields in one copy
+    MSG_SYSTEM_STATE::Fields read_all() const {
+        return detail::load<MSG_SYSTEM_STATE::Fields>(data_ + 1);
     }
     
     // Get message type
@@ -84,23 +102,40 @@ private:
     size_t offset_;
     bool valid_;
     
+    static constexpr size_t PAYLOAD_END = detail::SLOT_PAYLOAD_END;
+
+    // Slot for the largest encoding; the pool takes it from the smallest size
+    // class that fits. Strings have no bound short of a full frame.
+    static constexpr size_t SLOT_SIZE = ftl_config::slot_size_for(MSG_SYSTEM_STATE::FIXED_SIZE);
+    static_assert(SLOT_SIZE <= ftl_config::MAX_MESSAGE_SIZE, "MSG_SYSTEM_STATE does not fit in a frame");
+    static_assert(ftl_config::SLOT_PAYLOAD_OFFSET + MSG_SYSTEM_STATE::FIXED_SIZE <= PAYLOAD_END,
+                  "MSG_SYSTEM_STATE fixed-size fields must fit in the payload");
+
+    // Slot address of a payload offset
+    static constexpr size_t at(size_t payload_offset) {
+        return ftl_config::SLOT_PAYLOAD_OFFSET + payload_offset;
+    }
+    
     ftl::MessagePoolType& get_pool() {
         return get_message_pool();
     }
 
 public:
     MSG_SYSTEM_STATE_Builder() 
-        : handle_(get_pool().acquire())
+        : handle_(get_pool().acquire(SLOT_SIZE))
         , data_(nullptr)
-        , offset_(3)  // Start after [LENGTH][SOURCE][TYPE]
+        , offset_(at(MSG_SYSTEM_STATE::FIXED_SIZE))  // End of the fixed-size fields
         , valid_(handle_ != ftl::MessagePoolType::INVALID)
     {
         if (valid_) {
             data_ = get_pool().get_ptr<uint8_t>(handle_);
             if (data_) {
-                // Buffer layout: [LENGTH][SOURCE][TYPE][FIELDS...]
-                // Length and Source will be filled in build()
-                data_[2] = static_cast<uint8_t>(MessageType::MSG_SYSTEM_STATE);
+                // Buffer layout: [START][LENGTH][SOURCE][TYPE][FIELDS...][CRC][END]
+                // Length and Source are filled in build(), the rest by the transport
+                data_[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(ftl_config::TxClass::Control);
+                data_[ftl_config::SLOT_PAYLOAD_OFFSET] = static_cast<uint8_t>(MessageType::MSG_SYSTEM_STATE);
+                // Fields are written at fixed offsets in any order; unset ones go out as zero
+                std::memset(&data_[at(1)], 0, MSG_SYSTEM_STATE::FIXED_SIZE - 1);
             } else {
                 valid_ = false;
             }
@@ -129,31 +164,27 @@ public:
     
     MSG_SYSTEM_STATE_Builder& state_id(uint8_t value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(uint8_t) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SYSTEM_STATE::STATE_ID_OFFSET)], value);
         }
         return *this;
     }
     MSG_SYSTEM_STATE_Builder& is_active(bool value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(bool) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SYSTEM_STATE::IS_ACTIVE_OFFSET)], value);
         }
         return *this;
     }
     MSG_SYSTEM_STATE_Builder& uptime_ms(uint32_t value) {
         if (valid_ && data_) {
-            if (offset_ + sizeof(uint32_t) <= ftl_config::MAX_PAYLOAD_SIZE) {
-                detail::write_primitive(data_, offset_, value);
-            } else {
-                valid_ = false;
-            }
+            detail::store(&data_[at(MSG_SYSTEM_STATE::UPTIME_MS_OFFSET)], value);
+        }
+        return *this;
+    }
+    
+    // All fields in one copy
+    MSG_SYSTEM_STATE_Builder& write_all(const MSG_SYSTEM_STATE::Fields& fields) {
+        if (valid_ && data_) {
+            detail::store(&data_[at(1)], fields);
         }
         return *this;
     }
@@ -171,13 +202,13 @@ public:
             return ftl::MessageHandle{};
         }
         
-        // Calculate payload length: offset - 2 (skip LENGTH and SOURCE bytes)
-        uint8_t payload_length = static_cast<uint8_t>(offset_ - 2);
+        // Calculate payload length: everything after the header headroom
+        uint8_t payload_length = static_cast<uint8_t>(offset_ - ftl_config::SLOT_PAYLOAD_OFFSET);
         
-        // Set buffer header: [LENGTH][SOURCE][TYPE][FIELDS...]
-        data_[0] = payload_length;                      // Payload length
-        data_[1] = ftl::get_my_source_id();        // Source ID
-        // data_[2] already set to message type in constructor
+        // Set buffer header: [START][LENGTH][SOURCE][TYPE][FIELDS...]
+        data_[ftl_config::SLOT_LENGTH_OFFSET] = payload_length;          // Payload length
+        data_[ftl_config::SLOT_SOURCE_OFFSET] = ftl::get_my_source_id(); // Source ID
+        // Message type already set in constructor
         
         // Create MessageHandle with the raw handle
         auto msg_handle = ftl::MessageHandle(
@@ -205,7 +236,7 @@ inline MessageResult<MSG_SYSTEM_STATE_View> parse_MSG_SYSTEM_STATE(const ftl::Me
     const uint8_t* data = handle.data();
     uint8_t length = handle.length();
     
-    if (length < 1) {
+    if (length < MSG_SYSTEM_STATE::FIXED_SIZE) {
         return std::unexpected(MessageError::BUFFER_TOO_SMALL);
     }
     
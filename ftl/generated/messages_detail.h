@@ -7,6 +7,7 @@
 #include <string_view>
 #include <span>
 #include <array>
+#include <type_traits>
 #include <functional>
 #include <expected>
 
@@ -32,6 +33,9 @@ enum class MessageType : uint8_t {
     INVALID = 0xFF
 };
 
+static_assert(static_cast<uint8_t>(MessageType::MSG_SENSOR_ADS1115) < ftl_config::LINK_MESSAGE_TYPE_BASE,
+              "Message type IDs from LINK_MESSAGE_TYPE_BASE up are reserved for link-layer frames");
+
 const char* message_type_name(MessageType type);
 
 // =============================================================================
@@ -61,20 +65,22 @@ ftl::MessagePoolType& get_message_pool();
 
 namespace detail {
 
-// Read primitive types with memcpy (handles alignment)
+// Builders write at slot offsets; the payload starts after the frame headroom
+constexpr size_t SLOT_PAYLOAD_END = ftl_config::SLOT_PAYLOAD_OFFSET + ftl_config::MAX_PAYLOAD_SIZE;
+constexpr size_t RELIABLE_SLOT_PAYLOAD_END = ftl_config::SLOT_PAYLOAD_OFFSET + ftl_config::RELIABLE_MAX_PAYLOAD;
+
+// Fields sit at constant offsets that need not be aligned; memcpy of a
+// fixed size compiles to a single load or store
 template<typename T>
-inline T read_primitive(const uint8_t* data, size_t& offset) {
+inline T load(const uint8_t* data) {
     T value;
-    std::memcpy(&value, data + offset, sizeof(T));
-    offset += sizeof(T);
+    std::memcpy(&value, data, sizeof(T));
     return value;
 }
 
-// Write primitive types with memcpy
 template<typename T>
-inline void write_primitive(uint8_t* data, size_t& offset, T value) {
-    std::memcpy(data + offset, &value, sizeof(T));
-    offset += sizeof(T);
+inline void store(uint8_t* data, const T& value) {
+    std::memcpy(data, &value, sizeof(T));
 }
 
 // Read length-prefixed string
@@ -101,40 +107,10 @@ inline bool write_string(uint8_t* data, size_t& offset, size_t max_len, std::str
     return true;
 }
 
-// Read fixed-size array as span (zero-copy view)
-template<typename T, size_t N>
-inline std::span<const T> read_array(const uint8_t* data, size_t& offset, size_t max_len) {
-    constexpr size_t array_bytes = sizeof(T) * N;
-    
-    if (offset + array_bytes > max_len) {
-        return {};  // Return empty span on error
-    }
-    
-    // Cast to properly aligned pointer and create span
-    const T* array_ptr = reinterpret_cast<const T*>(data + offset);
-    offset += array_bytes;
-    
-    return std::span<const T>(array_ptr, N);
-}
-
-// Write fixed-size array from span
-template<typename T, size_t N>
-inline bool write_array(uint8_t* data, size_t& offset, size_t max_len, std::span<const T> values) {
-    constexpr size_t array_bytes = sizeof(T) * N;
-    
-    // Validate size matches
-    if (values.size() != N) return false;
-    if (offset + array_bytes > max_len) return false;
-    
-    std::memcpy(data + offset, values.data(), array_bytes);
-    offset += array_bytes;
-    return true;
-}
-
-// Write fixed-size array from std::array
+// Fixed-size array as span (zero-copy view)
 template<typename T, size_t N>
-inline bool write_array(uint8_t* data, size_t& offset, size_t max_len, const std::array<T, N>& values) {
-    return write_array<T, N>(data, offset, max_len, std::span<const T>(values.data(), N));
+inline std::span<const T> array_at(const uint8_t* data) {
+    return std::span<const T>(reinterpret_cast<const T*>(data), N);
 }
 
 } // namespace detail
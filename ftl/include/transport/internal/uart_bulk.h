@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ftl.settings"
+#include "util/allocator.h"
+#include <cstdint>
+#include <functional>
+#include <span>
+
+namespace ftl {
+
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
+using PoolHandle = MessagePoolType::Handle;
+using BulkPoolType = MessagePool<ftl_config::BULK_MAX_MESSAGE_SIZE, ftl_config::BULK_POOL_SIZE, ftl_config::BULK_POOL_ZERO_BYTES>;
+using BulkHandle = BulkPoolType::Handle;
+
+class BulkMessage;
+struct BulkFragment;
+
+namespace uart {
+namespace internal_bulk {
+
+struct Statistics {
+    uint32_t messages_sent;
+    uint32_t fragments_sent;
+    uint32_t messages_received;
+    uint32_t fragments_received;
+    uint32_t timeouts;
+    uint32_t dropped;
+};
+
+using Reader = std::function<size_t(uint32_t offset, std::span<uint8_t> dest)>;
+using StreamHandler = std::function<void(const BulkFragment&)>;
+
+void initialize(uint8_t source_id);
+
+// TX (Core 0): one transfer at a time, fed into the TX queue by process_tx()
+bool send(std::span<const uint8_t> data);
+bool send(uint32_t length, Reader reader);
+bool is_tx_busy();
+void process_tx();
+
+// RX: takes ownership of fragment frames; false for anything else
+bool accept_fragment(PoolHandle handle);
+void process_timeouts();
+void set_stream_handler(StreamHandler handler);
+bool has_message();
+BulkMessage get_message();
+
+Statistics get_statistics();
+
+} // namespace internal_bulk
+} // namespace uart
+} // namespace ftl
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ftl.settings"
+#include "util/allocator.h"
+#include <cstdint>
+
+namespace ftl {
+
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
+using PoolHandle = MessagePoolType::Handle;
+
+namespace uart {
+namespace internal_credit {
+
+struct Statistics {
+    uint32_t updates_sent;
+    uint32_t updates_received;
+    uint32_t stalls;
+    uint32_t stalled_us;
+    uint32_t credits_available;
+    bool peer_flow_controlled;
+};
+
+void initialize(uint8_t source_id);
+
+// TX (Core 0): counts one frame about to go to the DMA ring; false, and
+// nothing counted, while the peer has no room for it
+bool try_consume();
+
+// TX (Core 0): a credit frame due now, or INVALID. It is sent ahead of the
+// TX queues and without taking a credit.
+PoolHandle take_update();
+
+// RX: takes ownership of credit frames; false for anything else, which is
+// counted as a frame received
+bool accept(PoolHandle handle);
+
+Statistics get_statistics();
+
+} // namespace internal_credit
+} // namespace uart
+} // namespace ftl
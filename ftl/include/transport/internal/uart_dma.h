@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ftl.settings"
+#include "util/cqueue.h"
+#include "util/crc_engine.h"
 #include <array>
 #include <atomic>
 #include <cstdint>
@@ -14,6 +16,16 @@ namespace ftl_internal {
 
 class DmaController {
 public:
+    // Runs in the TX DMA completion interrupt with the tag passed to queue_write()
+    using TxCompleteCallback = void (*)(uint8_t tag);
+
+    struct TxLineStats {
+        uint32_t frames_sent;
+        uint32_t bytes_sent;
+        uint32_t back_to_back_frames;  // Started from the IRQ with no idle gap
+        uint64_t busy_us;              // Time with a transfer in flight
+    };
+
     DmaController() = default;
     ~DmaController() = default;
 
@@ -23,46 +35,78 @@ public:
     DmaController& operator=(DmaController&&) = delete;
 
     void init(uart_inst_t* uart_inst);
-    void process_rx_dma();
 
+    // RX ring: DMA writes straight into it and wraps in hardware. The consumer
+    // works at offsets from its read index and consumes whole frames at once.
     size_t get_bytes_available() const;
-    size_t read_from_circular_buffer(std::span<uint8_t> buffer);
-
-    bool write_data(std::span<const uint8_t> data);
-    bool is_write_busy();
+    std::span<const uint8_t> rx_contiguous() const;   // From the read index up to the write index or ring end
+    uint8_t rx_peek(size_t offset) const;
+    void rx_copy(size_t offset, uint8_t* dest, size_t length) const;
+    bool rx_find(uint8_t value, size_t& offset) const;  // First `value` from the read index, across the wrap
+    void rx_consume(size_t length);
+
+    void set_tx_complete_callback(TxCompleteCallback callback);
+
+    // Queue `length` bytes to be DMA'd straight from `frame`, which must stay
+    // untouched until the completion callback runs for `tag`. Starts at once
+    // if the line is idle, otherwise the completion IRQ chains it.
+    bool queue_write(const uint8_t* frame, size_t length, uint8_t tag);
+    bool can_queue_write() const;
+    bool is_write_busy() const;
+    size_t get_writes_pending() const;     // Queued plus the one on the wire
+    TxLineStats get_tx_line_stats() const;
+
+    // Nothing queued, nothing in flight and the UART has shifted out its last
+    // bit, so the baud rate can change without corrupting a frame
+    bool is_tx_idle() const;
+    uint32_t set_baud_rate(uint32_t baud_rate);   // Returns the rate actually set
+
+    // Frame CRC backend (DMA sniffer when a channel is free)
+    crc16::Engine& crc_engine() { return crc_engine_; }
 
 private:
     uart_inst_t* uart_instance_ = nullptr;
     uint32_t uart_dreq_tx_ = 0;  // TX DMA request signal
     uint32_t uart_dreq_rx_ = 0;  // RX DMA request signal
 
-    int dma_rx_chan_a_ = -1;
-    int dma_rx_chan_b_ = -1;
+    int dma_rx_chan_ = -1;
+    int dma_rx_reload_chan_ = -1;   // Re-arms dma_rx_chan_ after every lap of the ring
     int dma_tx_chan_ = -1;
 
-    alignas(4) volatile uint8_t rx_dma_buffer_a_[ftl_config::RX_DMA_CHUNK_SIZE]{};
-    alignas(4) volatile uint8_t rx_dma_buffer_b_[ftl_config::RX_DMA_CHUNK_SIZE]{};
+    static constexpr uint32_t RX_RING_MASK = ftl_config::RX_CIRCULAR_BUFFER_SIZE - 1;
 
-    std::atomic<uint32_t> rx_dma_a_read_pos_{0};
-    std::atomic<uint32_t> rx_dma_b_read_pos_{0};
-    
-    std::atomic<uint32_t> current_active_rx_dma_{0};
+    // DMA ring wrap requires natural alignment of the buffer
+    alignas(ftl_config::RX_CIRCULAR_BUFFER_SIZE) std::array<uint8_t, ftl_config::RX_CIRCULAR_BUFFER_SIZE> rx_ring_{};
+    uint32_t rx_reload_count_ = ftl_config::RX_CIRCULAR_BUFFER_SIZE;
+    uint32_t rx_read_idx_ = 0;
 
-    std::array<uint8_t, ftl_config::RX_CIRCULAR_BUFFER_SIZE> rx_circular_buffer_{};
-    std::atomic<uint32_t> rx_circ_write_idx_{0};  // DMA writes here
-    std::atomic<uint32_t> rx_circ_read_idx_{0};   // Application reads here
+    uint32_t rx_write_idx() const;
 
-    alignas(4) std::array<uint8_t, ftl_config::TX_BUFFER_SIZE> tx_buffer_{};
+    struct TxDescriptor {
+        const uint8_t* frame;
+        uint16_t length;
+        uint8_t tag;
+    };
+
+    // Producer: poll() on Core 0; consumer: the completion IRQ (also Core 0),
+    // or poll() itself when the line is idle and the IRQ cannot fire
+    CircularQueue<TxDescriptor, ftl_config::TX_DESCRIPTOR_RING_SIZE, true> tx_ring_;
     std::atomic<bool> tx_busy_{false};
+    TxDescriptor tx_current_{};
+    TxCompleteCallback tx_complete_ = nullptr;
+
+    // Written only by whoever starts/completes a transfer; readers use the
+    // sequence counter to get a consistent snapshot
+    std::atomic<uint32_t> tx_stats_seq_{0};
+    TxLineStats tx_stats_{};
+    uint64_t tx_busy_since_us_ = 0;
 
-    void setup_rx_dma_channel(int channel, volatile uint8_t* buffer, int chain_to_channel);
-    void transfer_to_circular_buffer(volatile uint8_t* dma_buffer, uint32_t start_idx, uint32_t count);
+    crc16::Engine crc_engine_;
 
-    uint32_t get_active_dma_bytes_available() const;
+    static DmaController* tx_irq_instance_;
+    static void tx_dma_irq_handler();
 
-    void check_active_dma_buffer();
-    void check_for_dma_buffer_swap();
-    void check_for_dma_stall();
+    void start_next_write(bool back_to_back);
 };
 
 } // namespace ftl_internal
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ftl.settings"
+#include "util/allocator.h"
+#include <cstdint>
+
+namespace ftl_internal {
+    class DmaController;
+}
+
+namespace ftl {
+
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
+using PoolHandle = MessagePoolType::Handle;
+
+namespace uart {
+namespace internal_link {
+
+struct Statistics {
+    uint32_t baud_rate;
+    uint8_t rate_index;             // Into LINK_BAUD_RATES
+    bool peer_seen;
+    uint32_t trials;
+    uint32_t trials_failed;
+    uint32_t fallbacks;
+    uint32_t silence_resets;
+    uint32_t error_permille;        // Bad frames in the last quality window
+};
+
+void initialize(uint8_t source_id);
+
+// Core 0, before the TX queue: negotiation timers and the quality window.
+// Changes the rate once the line has drained.
+void process(ftl_internal::DmaController& dma_controller);
+
+// TX (Core 0): the next link frame to send, or INVALID. Link frames go out
+// ahead of everything else and without taking a credit.
+PoolHandle take_frame();
+
+// TX (Core 0): true while a rate change is in progress; only link frames go out
+bool is_tx_paused();
+
+// RX: takes ownership of link frames; false for anything else, which is
+// counted as a good frame for the quality window
+bool accept(PoolHandle handle);
+
+Statistics get_statistics();
+
+} // namespace internal_link
+} // namespace uart
+} // namespace ftl
@@ -6,7 +6,8 @@
 
 namespace ftl {
 
-using MessagePoolType = MessagePool<ftl_config::MAX_MESSAGE_SIZE, ftl_config::MESSAGE_POOL_SIZE>;
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
 using PoolHandle = MessagePoolType::Handle;
 
 namespace uart {
@@ -14,14 +15,25 @@ namespace internal_multicore {
 
 struct Statistics {
     uint32_t core1_messages_sent;      // Messages sent from Core 1
-    uint32_t core1_fifo_full_drops;    // Drops due to FIFO full
+    uint32_t core1_ring_full_drops;    // Drops due to ring full
+    uint32_t core1_doorbells;          // Doorbells rung on Core 0
     uint32_t core0_messages_received;  // Messages processed on Core 0
     uint32_t core0_tx_queue_drops;     // Drops due to Core 0 TX queue full
+    uint32_t core0_reliable_drops;     // Reliable messages rejected on Core 0
 };
 
 void initialize();
+
+// Core 1: hands an owned slot to Core 0; false, and the slot still owned by
+// the caller, if it cannot
 bool send_from_core1(PoolHandle handle, uint8_t length);
-void process_fifo_messages();
+
+// Core 1: as above, for a message Core 0 passes to internal_reliable::send()
+bool send_reliable_from_core1(PoolHandle handle);
+
+// Core 0: moves everything Core 1 has handed over into the TX queues
+void process_core1_messages();
+
 Statistics get_statistics();
 bool is_core1_ready();
 
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ftl.settings"
+#include "util/allocator.h"
+#include <cstdint>
+
+namespace ftl {
+
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
+using PoolHandle = MessagePoolType::Handle;
+
+namespace uart {
+namespace internal_reliable {
+
+struct Statistics {
+    uint32_t messages_sent;
+    uint32_t retransmits;
+    uint32_t messages_acked;
+    uint32_t messages_failed;
+    uint32_t messages_delivered;
+    uint32_t duplicates;
+    uint32_t out_of_order;
+    uint32_t srtt_us;
+    uint32_t rto_us;
+};
+
+// Hands a received message, header stripped, on to the RX queue
+using Deliver = void (*)(PoolHandle handle);
+
+void initialize(uint8_t source_id);
+
+// TX (Core 0): takes ownership of a slot holding an ordinary message and
+// keeps it until acknowledged. While the window is full it waits in the
+// backlog; false if that is full too or the message is too long.
+bool send(PoolHandle handle);
+bool is_tx_ready();     // Backlog has room
+
+// Retransmit timers and delayed ACKs; before the TX queue is processed
+void process();
+
+// RX: takes ownership of reliable frames; false for anything else
+bool accept(PoolHandle handle, Deliver deliver);
+
+Statistics get_statistics();
+
+} // namespace internal_reliable
+} // namespace uart
+} // namespace ftl
@@ -10,7 +10,8 @@ namespace ftl_internal {
 
 namespace ftl {
 
-using MessagePoolType = MessagePool<ftl_config::MAX_MESSAGE_SIZE, ftl_config::MESSAGE_POOL_SIZE>;
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
 using PoolHandle = MessagePoolType::Handle;
 
 class MessageHandle;
@@ -23,6 +24,9 @@ struct Statistics {
     uint32_t total_messages_received;
     uint32_t crc_errors;
     uint32_t framing_errors;
+    uint32_t overflow_drops;        // Evicted from a full queue or without a pool slot
+    uint32_t batch_frames;          // Batch frames unpacked
+    uint32_t batched_messages;      // Messages delivered out of them
 };
 
 void initialize();
@@ -12,7 +12,8 @@ namespace ftl_internal {
 
 namespace ftl {
 
-using MessagePoolType = MessagePool<ftl_config::MAX_MESSAGE_SIZE, ftl_config::MESSAGE_POOL_SIZE>;
+using MessagePoolType = SlabPool<ftl_config::MESSAGE_POOL_SLOT_SIZES, ftl_config::MESSAGE_POOL_SLOT_COUNTS,
+                                 ftl_config::MESSAGE_POOL_ZERO_BYTES>;
 using PoolHandle = MessagePoolType::Handle;
 
 namespace uart {
@@ -24,21 +25,61 @@ struct Statistics {
     uint32_t queue_full_drops;
     uint32_t current_queue_depth;
     uint32_t peak_queue_depth;
+
+    // Line counters since initialize(); utilization is time with a transfer
+    // in flight, so 1000 means the wire never idled
+    uint32_t total_bytes_sent = 0;
+    uint32_t back_to_back_frames = 0;
+    uint32_t bytes_per_second = 0;
+    uint32_t line_utilization_permille = 0;
+
+    // Frames carrying more than one message, and the messages they carried
+    uint32_t batch_frames = 0;
+    uint32_t batched_messages = 0;
+};
+
+// Per priority class; latency is from enqueue to the descriptor ring
+struct ClassStatistics {
+    uint32_t messages_queued;
+    uint32_t messages_sent;
+    uint32_t messages_dropped;
+    uint32_t messages_coalesced;
+    uint32_t current_queue_depth;
+    uint32_t peak_queue_depth;
+    uint32_t average_latency_us;
+    uint32_t max_latency_us;
 };
 
-void initialize(uint8_t source_id);
+void initialize(uint8_t source_id, ftl_internal::DmaController& dma_controller);
 
-PoolHandle acquire_and_fill_message(std::span<const uint8_t> payload);
+// The slot is the smallest class that holds the frame plus `reserve` bytes,
+// kept for a header that goes in front of the payload later
+PoolHandle acquire_and_fill_message(std::span<const uint8_t> payload,
+                                    ftl_config::TxClass tx_class = ftl_config::TxClass::Normal,
+                                    size_t reserve = 0);
 
+// `handle` if its slot holds `slot_size` bytes; otherwise the header and
+// payload move to a slot that does and `handle` is released. INVALID, with
+// `handle` untouched, when no such slot is free.
+PoolHandle grow_slot(PoolHandle handle, size_t slot_size);
+
+// Takes over `handle`: it is queued, or released when its class refuses it
 bool enqueue_message_on_core0(PoolHandle handle);
 void process_tx_queue(ftl_internal::DmaController& dma_controller);
+void set_batch_flush_us(uint32_t flush_us);
+
+// Undoes the framing on a slot whose frame has been sent, so the payload can
+// be changed and the slot queued again
+void restore_payload_in_place(uint8_t* slot);
 
 bool is_ready();
 uint8_t get_source_id();
 
 Statistics get_statistics();
+ClassStatistics get_class_statistics(ftl_config::TxClass tx_class);
 bool is_queue_empty();
 uint32_t get_queue_count();
+uint32_t get_class_queue_count(ftl_config::TxClass tx_class);
 
 } // namespace internal_tx
 } // namespace uart
@@ -1,6 +1,7 @@
 #pragma once
 #include "ftl.settings"
 #include <cstdint>
+#include <functional>
 #include <span>
 #include <string_view>
 
@@ -10,6 +11,11 @@ typedef struct uart_inst uart_inst_t;
 namespace ftl {
 
 class MessageHandle;
+class BulkMessage;
+struct BulkFragment;
+
+using BulkReader = std::function<size_t(uint32_t offset, std::span<uint8_t> dest)>;
+using BulkStreamHandler = std::function<void(const BulkFragment&)>;
 
 namespace uart {
 
@@ -19,6 +25,12 @@ struct TxStatistics {
     uint32_t queue_full_drops;
     uint32_t current_queue_depth;
     uint32_t peak_queue_depth;
+    uint32_t total_bytes_sent;          // Bytes handed to the UART
+    uint32_t back_to_back_frames;       // Frames chained with no idle gap
+    uint32_t bytes_per_second;          // Average since initialization
+    uint32_t line_utilization_permille; // Time with TX in flight, 1000 = saturated
+    uint32_t batch_frames;              // Frames carrying more than one message
+    uint32_t batched_messages;          // Messages sent inside those frames
 };
 
 struct RxStatistics {
@@ -26,13 +38,70 @@ struct RxStatistics {
     uint32_t total_messages_received;
     uint32_t crc_errors;
     uint32_t framing_errors;
+    uint32_t overflow_drops;           // Evicted from the full RX queue or without a pool slot
+    uint32_t batch_frames;             // Batch frames unpacked
+    uint32_t batched_messages;         // Messages delivered out of them
+};
+
+struct BulkStatistics {
+    uint32_t messages_sent;            // Transfers fully queued for TX
+    uint32_t fragments_sent;
+    uint32_t messages_received;        // Transfers completed on RX
+    uint32_t fragments_received;
+    uint32_t timeouts;                 // Incomplete RX transfers reclaimed
+    uint32_t dropped;                  // Fragments out of sequence, too large or without a buffer
+};
+
+struct ReliableStatistics {
+    uint32_t messages_sent;            // Accepted into the send window
+    uint32_t retransmits;
+    uint32_t messages_acked;
+    uint32_t messages_failed;          // Dropped after RELIABLE_MAX_RETRIES
+    uint32_t messages_delivered;       // Received and passed on in order
+    uint32_t duplicates;               // Received again and dropped
+    uint32_t out_of_order;             // Received ahead of a gap and held
+    uint32_t srtt_us;                  // Smoothed round-trip time
+    uint32_t rto_us;                   // Current retransmit timeout
+};
+
+struct TxClassStatistics {
+    uint32_t messages_queued;
+    uint32_t messages_sent;            // Handed to the TX DMA
+    uint32_t messages_dropped;         // Refused or pushed out of a full queue
+    uint32_t messages_coalesced;       // Replaced a queued message of the same type
+    uint32_t current_queue_depth;
+    uint32_t peak_queue_depth;
+    uint32_t average_latency_us;       // Queued until handed to the TX DMA
+    uint32_t max_latency_us;
+};
+
+struct FlowControlStatistics {
+    uint32_t updates_sent;             // Credit frames sent
+    uint32_t updates_received;
+    uint32_t stalls;                   // Times TX held frames for want of credit
+    uint32_t stalled_us;               // Total time TX was held
+    uint32_t credits_available;        // Frames the peer can take now
+    bool peer_flow_controlled;         // Peer sends credits; false means frames go unchecked
+};
+
+struct LinkStatistics {
+    uint32_t baud_rate;                // Rate the UART is running at now
+    uint8_t rate_index;                // Committed entry in LINK_BAUD_RATES
+    bool peer_seen;                    // Peer takes part in negotiation
+    uint32_t trials;                   // Rates tried
+    uint32_t trials_failed;            // Tried and went back
+    uint32_t fallbacks;                // Stepped down for bad frames
+    uint32_t silence_resets;           // Went back to BAUD_RATE hearing nothing
+    uint32_t error_permille;           // Bad frames in the last quality window
 };
 
 struct MulticoreStatistics {
     uint32_t core1_messages_sent;      // Messages sent from Core 1
-    uint32_t core1_fifo_full_drops;    // Drops due to FIFO full
+    uint32_t core1_ring_full_drops;    // Drops due to the Core 1 ring full
+    uint32_t core1_doorbells;          // Doorbells rung, one per empty ring filled
     uint32_t core0_messages_received;  // Messages processed on Core 0
     uint32_t core0_tx_queue_drops;     // Drops due to Core 0 TX queue full
+    uint32_t core0_reliable_drops;     // Reliable messages rejected on Core 0
 };
 
 /**
@@ -56,9 +125,10 @@ void initialize(uart_inst_t* uart_inst, uint8_t source_id);
  * 
  * Must be called repeatedly from Core 0's main loop.
  * This function:
- * - Processes incoming DMA data through the RX state machine
- * - Processes messages from Core 1's FIFO
- * - Processes the Core 0 TX queue and starts new DMA sends
+ * - Scans the RX DMA ring for complete, CRC-checked frames
+ * - Drains messages handed over by Core 1
+ * - Runs reliable delivery retransmit and ACK timers
+ * - Processes the Core 0 TX queues, highest priority class first, and starts new DMA sends
  * 
  * @pre Must be called from Core 0 only
  */
@@ -69,14 +139,16 @@ void poll();
  * 
  * This is the unified send function that works from any core.
  * - If called from Core 0: Enqueues the message to the TX queue
- * - If called from Core 1: Pushes the message to the inter-core FIFO
+ * - If called from Core 1: Hands the message to Core 0 through a shared ring
  * 
  * Non-blocking. Returns immediately with success/failure status.
  * 
  * @param payload Message payload (max ftl_config::MAX_PAYLOAD_SIZE bytes)
- * @return true if queued, false if queue/FIFO is full or payload invalid
+ * @param tx_class TX queue the message goes through
+ * @return true if queued, false if queue/ring is full or payload invalid
  */
-bool send_message(std::span<const uint8_t> payload);
+bool send_message(std::span<const uint8_t> payload,
+                  ftl_config::TxClass tx_class = ftl_config::TxClass::Normal);
 
 /**
  * @brief Send a string message (Core-safe)
@@ -84,10 +156,76 @@ bool send_message(std::span<const uint8_t> payload);
  * Convenience wrapper for text messages.
  * 
  * @param message String message to send
- * @return true if queued, false if queue/FIFO is full
+ * @return true if queued, false if queue/ring is full
  */
 bool send_message(std::string_view message);
 
+/**
+ * @brief Send a message already laid out in a pool slot (Core-safe)
+ * 
+ * Takes ownership of the slot; it is released once the TX DMA has read it,
+ * or immediately if it cannot be queued.
+ * 
+ * @param message Built message handle
+ * @return true if queued, false if queue/ring is full or the handle is invalid
+ */
+bool send_message(MessageHandle&& message);
+
+/**
+ * @brief Send a message with acknowledgement and retransmission
+ * 
+ * The message is numbered and kept in its pool slot until the other end
+ * acknowledges it, resent on timeout or a selective-ACK gap, and delivered
+ * there exactly once and in order with other reliable messages. While the
+ * send window is full it waits in a backlog of RELIABLE_BACKLOG messages.
+ * From Core 1 the slot is handed to Core 0 through its own ring.
+ * 
+ * @param payload Message payload (max ftl_config::RELIABLE_MAX_PAYLOAD bytes)
+ * @return false if the backlog or ring is full, the pool is empty or the payload invalid
+ */
+bool send_reliable(std::span<const uint8_t> payload);
+
+/**
+ * @brief Send a built message reliably; see send_reliable()
+ * 
+ * Takes ownership of the slot, which must hold at most RELIABLE_MAX_PAYLOAD bytes.
+ */
+bool send_reliable(MessageHandle&& message);
+
+bool is_reliable_tx_ready();
+
+/**
+ * @brief Start a bulk transfer of up to BULK_MAX_MESSAGE_SIZE bytes (Core 0 only)
+ * 
+ * The payload is copied into a bulk pool buffer and sent as fragment frames,
+ * a few per poll(), so ordinary messages keep flowing alongside it.
+ * 
+ * @param data Payload
+ * @return false if a transfer is in progress, no bulk buffer is free, or
+ *         the payload is empty or too large
+ */
+bool send_bulk(std::span<const uint8_t> data);
+
+/**
+ * @brief Start a bulk transfer that reads its data on demand (Core 0 only)
+ * 
+ * @param length Total length in bytes
+ * @param reader Writes the bytes at an offset into each fragment as it is built
+ * @return false if a transfer is in progress or the length is invalid
+ */
+bool send_bulk(uint32_t length, BulkReader reader);
+
+bool is_bulk_tx_busy();
+bool has_bulk_message();
+BulkMessage get_bulk_message();
+
+/**
+ * @brief Hand incoming bulk fragments to `handler` instead of reassembling
+ * 
+ * Applies to transfers that start while it is set; nullptr restores reassembly.
+ */
+void set_bulk_stream_handler(BulkStreamHandler handler);
+
 /**
  * @brief Check if a fully-formed message is available
  * 
@@ -105,10 +243,25 @@ bool has_message();
  */
 MessageHandle get_message();
 
+/**
+ * @brief Set how long TX holds an open batch for more messages
+ * 
+ * Only used with ftl_config::BATCH_ENABLED. 0 packs only what is already
+ * queued when the TX queue is processed.
+ * 
+ * @param flush_us Deadline from the first message of a batch, in microseconds
+ */
+void set_batch_flush_us(uint32_t flush_us);
+
 bool is_tx_ready();
 bool is_core1_tx_ready();
 TxStatistics get_tx_statistics();
+TxClassStatistics get_tx_class_statistics(ftl_config::TxClass tx_class);
 RxStatistics get_rx_statistics();
+BulkStatistics get_bulk_statistics();
+ReliableStatistics get_reliable_statistics();
+FlowControlStatistics get_flow_control_statistics();
+LinkStatistics get_link_statistics();
 MulticoreStatistics get_multicore_statistics();
 
 } // namespace uart
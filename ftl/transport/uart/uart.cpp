@@ -3,6 +3,10 @@
 #include "internal/uart_tx.h"
 #include "internal/uart_rx.h"
 #include "internal/uart_multicore.h"
+#include "internal/uart_bulk.h"
+#include "internal/uart_reliable.h"
+#include "internal/uart_credit.h"
+#include "internal/uart_link.h"
 #include "core/ftl_api.h"
 
 #include "pico/stdlib.h"
@@ -36,12 +40,18 @@ void initialize(uart_inst_t* uart_inst, uint8_t source_id) {
     g_dma_controller.init(uart_inst);
     
     internal_rx::initialize();
-    internal_tx::initialize(source_id);
+    internal_tx::initialize(source_id, g_dma_controller);
     internal_multicore::initialize();
+    internal_bulk::initialize(source_id);
+    internal_reliable::initialize(source_id);
+    internal_credit::initialize(source_id);
+    internal_link::initialize(source_id);
     
     g_is_initialized = true;
     
-    printf("UART transport initialized on Core %u (ID: %u)\n", g_init_core, source_id);
+    printf("UART transport initialized on Core %u (ID: %u, CRC: %s, framing: %s)\n", g_init_core, source_id,
+           crc16::Engine::backend_name(g_dma_controller.crc_engine().backend()),
+           ftl_config::FRAMING == ftl_config::Framing::Cobs ? "cobs" : "delimited");
 }
 
 void poll() {
@@ -49,22 +59,63 @@ void poll() {
         return;
     }
 
-    // 1. Process RX DMA buffers
-    g_dma_controller.process_rx_dma();
-    
-    // 2. Feed new bytes into the RX state machine
+    // 1. Scan the RX DMA ring for complete frames
     internal_rx::process(g_dma_controller);
+    internal_bulk::process_timeouts();
     
-    // 3. Process Core 1 -> Core 0 FIFO messages
+    // 2. Drain the Core 1 -> Core 0 ring
     //    This directly enqueues handles to the TX queue
-    internal_multicore::process_fifo_messages();
+    internal_multicore::process_core1_messages();
+    
+    // 3. Feed the next fragments of a bulk transfer into the TX queue
+    internal_bulk::process_tx();
+    
+    // 4. Resend unacknowledged reliable messages and flush delayed ACKs
+    internal_reliable::process();
+    
+    // 5. Baud rate negotiation and link-quality fallback
+    internal_link::process(g_dma_controller);
     
-    // 4. Process Core 0 TX queue
-    //    This dequeues handles and starts DMA transfers
+    // 6. Process Core 0 TX queue
+    //    This sends link frames and any due credit update, then dequeues
+    //    handles and starts DMA transfers while the peer has room for them
     internal_tx::process_tx_queue(g_dma_controller);
 }
 
-bool send_message(std::span<const uint8_t> payload) {
+namespace {
+
+// Hands an owned slot to the TX queue (Core 0) or the shared ring (Core 1)
+bool send_handle(PoolHandle handle, uint8_t length) {
+    if (get_core_num() == g_init_core) {
+        // --- Core 0 Path ---
+        // Directly enqueue the handle to the TX queue
+        return internal_tx::enqueue_message_on_core0(handle);
+    } else {
+        // --- Core 1 Path ---
+        // Send the handle via the shared ring
+        bool success = internal_multicore::send_from_core1(handle, length);
+        if (!success) {
+            ftl::messages::g_message_pool.release(handle);
+        }
+        return success;
+    }
+}
+
+// As above for reliable messages; Core 0 numbers them in either case
+bool send_reliable_handle(PoolHandle handle) {
+    if (get_core_num() == g_init_core) {
+        return internal_reliable::send(handle);
+    }
+    bool success = internal_multicore::send_reliable_from_core1(handle);
+    if (!success) {
+        ftl::messages::g_message_pool.release(handle);
+    }
+    return success;
+}
+
+} // anonymous namespace
+
+bool send_message(std::span<const uint8_t> payload, ftl_config::TxClass tx_class) {
     if (!g_is_initialized) {
         return false;
     }
@@ -73,25 +124,27 @@ bool send_message(std::span<const uint8_t> payload) {
         return false;
     }
 
-    PoolHandle handle = internal_tx::acquire_and_fill_message(payload);
+    PoolHandle handle = internal_tx::acquire_and_fill_message(payload, tx_class);
     if (handle == MessagePoolType::INVALID) {
         return false; // Pool empty
     }
 
-    if (get_core_num() == g_init_core) {
-        // --- Core 0 Path ---
-        // Directly enqueue the handle to the TX queue
-        return internal_tx::enqueue_message_on_core0(handle);
-    } else {
-        // --- Core 1 Path ---
-        // Send the handle via the FIFO
-        bool success = internal_multicore::send_from_core1(handle, 
-                                                           static_cast<uint8_t>(payload.size()));
-        if (!success) {
-            ftl::messages::g_message_pool.release(handle);
-        }
-        return success;
+    return send_handle(handle, static_cast<uint8_t>(payload.size()));
+}
+
+bool send_message(MessageHandle&& message) {
+    if (!g_is_initialized || !message) {
+        return false;
+    }
+
+    const uint8_t length = message.length();
+    PoolHandle handle = message.detach();
+    if (length == 0 || length > ftl_config::MAX_PAYLOAD_SIZE) {
+        ftl::messages::g_message_pool.release(handle);
+        return false;
     }
+
+    return send_handle(handle, length);
 }
 
 bool send_message(std::string_view message) {
@@ -101,6 +154,71 @@ bool send_message(std::string_view message) {
     });
 }
 
+bool send_reliable(std::span<const uint8_t> payload) {
+    if (!g_is_initialized) {
+        return false;
+    }
+
+    if (payload.empty() || payload.size() > ftl_config::RELIABLE_MAX_PAYLOAD) {
+        return false;
+    }
+
+    PoolHandle handle = internal_tx::acquire_and_fill_message(payload, ftl_config::TxClass::Normal,
+                                                              ftl_config::RELIABLE_HEADER_SIZE);
+    if (handle == MessagePoolType::INVALID) {
+        return false; // Pool empty
+    }
+
+    return send_reliable_handle(handle);
+}
+
+bool send_reliable(MessageHandle&& message) {
+    if (!g_is_initialized || !message) {
+        return false;
+    }
+    return send_reliable_handle(message.detach());
+}
+
+bool is_reliable_tx_ready() {
+    return g_is_initialized && internal_reliable::is_tx_ready();
+}
+
+bool send_bulk(std::span<const uint8_t> data) {
+    if (!g_is_initialized || get_core_num() != g_init_core) {
+        return false;
+    }
+    return internal_bulk::send(data);
+}
+
+bool send_bulk(uint32_t length, BulkReader reader) {
+    if (!g_is_initialized || get_core_num() != g_init_core) {
+        return false;
+    }
+    return internal_bulk::send(length, std::move(reader));
+}
+
+bool is_bulk_tx_busy() {
+    return g_is_initialized && internal_bulk::is_tx_busy();
+}
+
+bool has_bulk_message() {
+    if (!g_is_initialized) {
+        return false;
+    }
+    return internal_bulk::has_message();
+}
+
+BulkMessage get_bulk_message() {
+    if (!g_is_initialized) {
+        return BulkMessage{};
+    }
+    return internal_bulk::get_message();
+}
+
+void set_bulk_stream_handler(BulkStreamHandler handler) {
+    internal_bulk::set_stream_handler(std::move(handler));
+}
+
 bool has_message() {
     if (!g_is_initialized) {
         return false;
@@ -115,6 +233,10 @@ MessageHandle get_message() {
     return internal_rx::get_message();
 }
 
+void set_batch_flush_us(uint32_t flush_us) {
+    internal_tx::set_batch_flush_us(flush_us);
+}
+
 bool is_tx_ready() {
     if (!g_is_initialized) {
         return false;
@@ -140,7 +262,31 @@ TxStatistics get_tx_statistics() {
         internal_stats.total_messages_sent,
         internal_stats.queue_full_drops,
         internal_stats.current_queue_depth,
-        internal_stats.peak_queue_depth
+        internal_stats.peak_queue_depth,
+        internal_stats.total_bytes_sent,
+        internal_stats.back_to_back_frames,
+        internal_stats.bytes_per_second,
+        internal_stats.line_utilization_permille,
+        internal_stats.batch_frames,
+        internal_stats.batched_messages
+    };
+}
+
+TxClassStatistics get_tx_class_statistics(ftl_config::TxClass tx_class) {
+    if (!g_is_initialized) {
+        return TxClassStatistics{};
+    }
+    
+    auto internal_stats = internal_tx::get_class_statistics(tx_class);
+    return TxClassStatistics{
+        internal_stats.messages_queued,
+        internal_stats.messages_sent,
+        internal_stats.messages_dropped,
+        internal_stats.messages_coalesced,
+        internal_stats.current_queue_depth,
+        internal_stats.peak_queue_depth,
+        internal_stats.average_latency_us,
+        internal_stats.max_latency_us
     };
 }
 
@@ -154,7 +300,79 @@ RxStatistics get_rx_statistics() {
         internal_stats.total_bytes_received,
         internal_stats.total_messages_received,
         internal_stats.crc_errors,
-        internal_stats.framing_errors
+        internal_stats.framing_errors,
+        internal_stats.overflow_drops,
+        internal_stats.batch_frames,
+        internal_stats.batched_messages
+    };
+}
+
+BulkStatistics get_bulk_statistics() {
+    if (!g_is_initialized) {
+        return BulkStatistics{};
+    }
+    
+    auto internal_stats = internal_bulk::get_statistics();
+    return BulkStatistics{
+        internal_stats.messages_sent,
+        internal_stats.fragments_sent,
+        internal_stats.messages_received,
+        internal_stats.fragments_received,
+        internal_stats.timeouts,
+        internal_stats.dropped
+    };
+}
+
+ReliableStatistics get_reliable_statistics() {
+    if (!g_is_initialized) {
+        return ReliableStatistics{};
+    }
+    
+    auto internal_stats = internal_reliable::get_statistics();
+    return ReliableStatistics{
+        internal_stats.messages_sent,
+        internal_stats.retransmits,
+        internal_stats.messages_acked,
+        internal_stats.messages_failed,
+        internal_stats.messages_delivered,
+        internal_stats.duplicates,
+        internal_stats.out_of_order,
+        internal_stats.srtt_us,
+        internal_stats.rto_us
+    };
+}
+
+FlowControlStatistics get_flow_control_statistics() {
+    if (!g_is_initialized) {
+        return FlowControlStatistics{};
+    }
+    
+    auto internal_stats = internal_credit::get_statistics();
+    return FlowControlStatistics{
+        internal_stats.updates_sent,
+        internal_stats.updates_received,
+        internal_stats.stalls,
+        internal_stats.stalled_us,
+        internal_stats.credits_available,
+        internal_stats.peer_flow_controlled
+    };
+}
+
+LinkStatistics get_link_statistics() {
+    if (!g_is_initialized) {
+        return LinkStatistics{};
+    }
+    
+    auto internal_stats = internal_link::get_statistics();
+    return LinkStatistics{
+        internal_stats.baud_rate,
+        internal_stats.rate_index,
+        internal_stats.peer_seen,
+        internal_stats.trials,
+        internal_stats.trials_failed,
+        internal_stats.fallbacks,
+        internal_stats.silence_resets,
+        internal_stats.error_permille
     };
 }
 
@@ -166,9 +384,11 @@ MulticoreStatistics get_multicore_statistics() {
     auto internal_stats = internal_multicore::get_statistics();
     return MulticoreStatistics{
         internal_stats.core1_messages_sent,
-        internal_stats.core1_fifo_full_drops,
+        internal_stats.core1_ring_full_drops,
+        internal_stats.core1_doorbells,
         internal_stats.core0_messages_received,
-        internal_stats.core0_tx_queue_drops
+        internal_stats.core0_tx_queue_drops,
+        internal_stats.core0_reliable_drops
     };
 }
 
@@ -0,0 +1,328 @@
+#include "internal/uart_bulk.h"
+#include "internal/uart_tx.h"
+#include "core/ftl_api.h"
+#include "util/cqueue.h"
+#include "pico/stdlib.h"
+#include "pico/printf.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ftl {
+namespace messages {
+    extern MessagePoolType g_message_pool;
+    extern BulkPoolType g_bulk_pool;
+}
+
+namespace uart {
+namespace internal_bulk {
+
+namespace {
+
+// Fragments only take half the Normal TX queue so ordinary messages still get in
+constexpr uint32_t TX_QUEUE_SHARE = ftl_config::TX_QUEUE_DEPTH / 2;
+
+struct TxTransfer {
+    Reader reader;
+    BulkHandle buffer = BulkPoolType::INVALID;     // Owned copy for send(span)
+    uint32_t length = 0;
+    uint32_t offset = 0;
+    uint8_t message_id = 0;
+    bool active = false;
+};
+
+// One incoming transfer, keyed by sender and message id
+struct Reassembly {
+    BulkHandle buffer = BulkPoolType::INVALID;     // INVALID when streaming
+    uint32_t expected_offset = 0;
+    uint64_t updated_us = 0;
+    uint8_t source_id = 0;
+    uint8_t message_id = 0;
+    bool streaming = false;
+    bool active = false;
+};
+
+struct Completed {
+    BulkHandle buffer;
+    uint32_t length;
+    uint8_t source_id;
+};
+
+uint8_t g_source_id = 0;
+TxTransfer g_tx;
+uint8_t g_next_message_id = 0;
+
+Reassembly g_reassembly[ftl_config::BULK_POOL_SIZE];
+CircularQueue<Completed, ftl_config::BULK_POOL_SIZE, false> g_completed;
+StreamHandler g_stream_handler;
+
+// Statistics
+uint32_t g_messages_sent = 0;
+uint32_t g_fragments_sent = 0;
+uint32_t g_messages_received = 0;
+uint32_t g_fragments_received = 0;
+uint32_t g_timeouts = 0;
+uint32_t g_dropped = 0;
+
+void finish_tx() {
+    if (g_tx.buffer != BulkPoolType::INVALID) {
+        messages::g_bulk_pool.release(g_tx.buffer);
+    }
+    g_tx = TxTransfer{};
+}
+
+// Drops a partial transfer; a stream handler hears about it so it can
+// discard the fragments it already has
+void abandon(Reassembly& entry) {
+    if (entry.buffer != BulkPoolType::INVALID) {
+        messages::g_bulk_pool.release(entry.buffer);
+    }
+    if (entry.streaming && g_stream_handler) {
+        g_stream_handler(BulkFragment{entry.source_id, entry.message_id, entry.expected_offset, {}, false, true});
+    }
+    entry = Reassembly{};
+}
+
+Reassembly* find_reassembly(uint8_t source_id, uint8_t message_id) {
+    for (auto& entry : g_reassembly) {
+        if (entry.active && entry.source_id == source_id && entry.message_id == message_id) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+Reassembly* start_reassembly(uint8_t source_id, uint8_t message_id) {
+    for (auto& entry : g_reassembly) {
+        if (entry.active) {
+            continue;
+        }
+        entry.streaming = static_cast<bool>(g_stream_handler);
+        if (!entry.streaming) {
+            entry.buffer = messages::g_bulk_pool.acquire();
+            if (entry.buffer == BulkPoolType::INVALID) {
+                return nullptr;
+            }
+        }
+        entry.source_id = source_id;
+        entry.message_id = message_id;
+        entry.expected_offset = 0;
+        entry.active = true;
+        return &entry;
+    }
+    return nullptr;
+}
+
+void complete(Reassembly& entry) {
+    g_messages_received++;
+    if (entry.streaming) {
+        entry = Reassembly{};
+        return;
+    }
+
+    // Keep the newest: a full queue drops its oldest message like the RX queue
+    Completed done{entry.buffer, entry.expected_offset, entry.source_id};
+    if (!g_completed.enqueue(done)) {
+        Completed oldest;
+        if (g_completed.dequeue(oldest)) {
+            messages::g_bulk_pool.release(oldest.buffer);
+        }
+        g_completed.enqueue(done);
+    }
+    entry = Reassembly{};
+}
+
+} // anonymous namespace
+
+void initialize(uint8_t source_id) {
+    g_source_id = source_id;
+    g_tx = TxTransfer{};
+    for (auto& entry : g_reassembly) {
+        entry = Reassembly{};
+    }
+    g_completed.clear();
+    g_messages_sent = 0;
+    g_fragments_sent = 0;
+    g_messages_received = 0;
+    g_fragments_received = 0;
+    g_timeouts = 0;
+    g_dropped = 0;
+}
+
+bool send(std::span<const uint8_t> data) {
+    if (g_tx.active || data.empty() || data.size() > ftl_config::BULK_MAX_MESSAGE_SIZE) {
+        return false;
+    }
+
+    BulkHandle buffer = messages::g_bulk_pool.acquire();
+    if (buffer == BulkPoolType::INVALID) {
+        return false;
+    }
+    std::memcpy(messages::g_bulk_pool.get_ptr<uint8_t>(buffer), data.data(), data.size());
+
+    const bool queued = send(static_cast<uint32_t>(data.size()), [buffer](uint32_t offset, std::span<uint8_t> dest) {
+        std::memcpy(dest.data(), messages::g_bulk_pool.get_ptr<uint8_t>(buffer) + offset, dest.size());
+        return dest.size();
+    });
+    if (!queued) {
+        messages::g_bulk_pool.release(buffer);
+        return false;
+    }
+    g_tx.buffer = buffer;
+    return true;
+}
+
+bool send(uint32_t length, Reader reader) {
+    if (g_tx.active || length == 0 || length > ftl_config::BULK_MAX_MESSAGE_SIZE || !reader) {
+        return false;
+    }
+
+    g_tx.reader = std::move(reader);
+    g_tx.length = length;
+    g_tx.offset = 0;
+    g_tx.message_id = g_next_message_id++;
+    g_tx.active = true;
+    return true;
+}
+
+bool is_tx_busy() {
+    return g_tx.active;
+}
+
+void process_tx() {
+    while (g_tx.active && internal_tx::get_class_queue_count(ftl_config::TxClass::Normal) < TX_QUEUE_SHARE) {
+        const size_t chunk = std::min<size_t>(ftl_config::FRAGMENT_MAX_DATA, g_tx.length - g_tx.offset);
+        PoolHandle handle = messages::g_message_pool.acquire(
+            ftl_config::slot_size_for(ftl_config::FRAGMENT_HEADER_SIZE + chunk));
+        if (handle == MessagePoolType::INVALID) {
+            return;
+        }
+        uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+        uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+
+        // The reader writes straight into the frame's data area
+        const size_t written = g_tx.reader(g_tx.offset, {payload + ftl_config::FRAGMENT_HEADER_SIZE, chunk});
+        if (written == 0 || written > chunk) {
+            printf("Bulk TX aborted at offset %lu\n", static_cast<unsigned long>(g_tx.offset));
+            messages::g_message_pool.release(handle);
+            finish_tx();
+            return;
+        }
+
+        const bool last = g_tx.offset + written == g_tx.length;
+        payload[0] = ftl_config::FRAGMENT_MESSAGE_TYPE;
+        payload[1] = g_tx.message_id;
+        payload[2] = last ? ftl_config::FRAGMENT_FLAG_LAST : 0;
+        payload[3] = g_tx.offset & 0xFF;
+        payload[4] = (g_tx.offset >> 8) & 0xFF;
+        slot[ftl_config::SLOT_LENGTH_OFFSET] = static_cast<uint8_t>(ftl_config::FRAGMENT_HEADER_SIZE + written);
+        slot[ftl_config::SLOT_SOURCE_OFFSET] = g_source_id;
+
+        // Releases the slot on failure; the same offset is read again next poll
+        if (!internal_tx::enqueue_message_on_core0(handle)) {
+            return;
+        }
+
+        g_fragments_sent++;
+        g_tx.offset += written;
+        if (last) {
+            g_messages_sent++;
+            finish_tx();
+        }
+    }
+}
+
+bool accept_fragment(PoolHandle handle) {
+    const uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    const uint8_t length = slot[ftl_config::SLOT_LENGTH_OFFSET];
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    if (length <= ftl_config::FRAGMENT_HEADER_SIZE || payload[0] != ftl_config::FRAGMENT_MESSAGE_TYPE) {
+        return false;
+    }
+
+    const uint8_t source_id = slot[ftl_config::SLOT_SOURCE_OFFSET];
+    const uint8_t message_id = payload[1];
+    const bool last = payload[2] & ftl_config::FRAGMENT_FLAG_LAST;
+    const uint32_t offset = payload[3] | (static_cast<uint32_t>(payload[4]) << 8);
+    const std::span<const uint8_t> data{payload + ftl_config::FRAGMENT_HEADER_SIZE,
+                                        length - ftl_config::FRAGMENT_HEADER_SIZE};
+    g_fragments_received++;
+
+    Reassembly* entry = find_reassembly(source_id, message_id);
+    if (entry && offset == 0) {
+        abandon(*entry);    // Sender restarted this id
+        entry = nullptr;
+    }
+    if (!entry && offset == 0) {
+        entry = start_reassembly(source_id, message_id);
+    }
+
+    if (!entry || offset != entry->expected_offset || offset + data.size() > ftl_config::BULK_MAX_MESSAGE_SIZE) {
+        // Lost a fragment, joined mid-transfer or out of buffers: the rest
+        // of this transfer is dropped until the sender starts a new one
+        if (entry) {
+            abandon(*entry);
+        }
+        g_dropped++;
+        messages::g_message_pool.release(handle);
+        return true;
+    }
+
+    if (entry->streaming) {
+        if (g_stream_handler) {
+            g_stream_handler(BulkFragment{source_id, message_id, offset, data, last});
+        }
+    } else {
+        std::memcpy(messages::g_bulk_pool.get_ptr<uint8_t>(entry->buffer) + offset, data.data(), data.size());
+    }
+    entry->expected_offset += data.size();
+    entry->updated_us = time_us_64();
+    messages::g_message_pool.release(handle);
+
+    if (last) {
+        complete(*entry);
+    }
+    return true;
+}
+
+void process_timeouts() {
+    const uint64_t now = time_us_64();
+    for (auto& entry : g_reassembly) {
+        if (entry.active && now - entry.updated_us > ftl_config::BULK_REASSEMBLY_TIMEOUT_US) {
+            printf("Bulk RX timeout: source 0x%02X id %u at offset %lu\n", entry.source_id, entry.message_id,
+                   static_cast<unsigned long>(entry.expected_offset));
+            abandon(entry);
+            g_timeouts++;
+        }
+    }
+}
+
+void set_stream_handler(StreamHandler handler) {
+    g_stream_handler = std::move(handler);
+}
+
+bool has_message() {
+    return !g_completed.is_empty();
+}
+
+BulkMessage get_message() {
+    Completed done;
+    if (!g_completed.dequeue(done)) {
+        return BulkMessage{};
+    }
+    return BulkMessage(MsgHandle<BulkPoolType>(messages::g_bulk_pool, done.buffer), done.length, done.source_id);
+}
+
+Statistics get_statistics() {
+    return Statistics{
+        g_messages_sent,
+        g_fragments_sent,
+        g_messages_received,
+        g_fragments_received,
+        g_timeouts,
+        g_dropped
+    };
+}
+
+} // namespace internal_bulk
+} // namespace uart
+} // namespace ftl
@@ -0,0 +1,208 @@
+#include "internal/uart_credit.h"
+#include "internal/uart_rx.h"
+#include "pico/stdlib.h"
+#include <algorithm>
+
+namespace ftl {
+namespace messages {
+    extern MessagePoolType g_message_pool;
+}
+
+namespace uart {
+namespace internal_credit {
+
+namespace {
+
+// Credit frame fields, from the start of the payload
+constexpr size_t FLAGS = 1;
+constexpr size_t SENT = 2;
+constexpr size_t LIMIT = 3;
+
+uint8_t g_source_id = 0;
+
+// Kept for credit frames, so an update never waits for a free pool slot
+PoolHandle g_update_handle = MessagePoolType::INVALID;
+
+// Sender: frames counted by try_consume() and the peer's latest LIMIT
+uint8_t g_sent = 0;
+uint8_t g_peer_limit = 0;
+bool g_peer_seen = false;
+uint64_t g_peer_updated_us = 0;
+bool g_stalled = false;
+uint64_t g_stalled_since_us = 0;
+
+// Receiver: frames from the peer so far and the LIMIT last sent back
+uint8_t g_received = 0;
+uint8_t g_advertised_limit = 0;
+uint64_t g_advertised_us = 0;
+bool g_update_requested = false;
+
+// Statistics
+uint32_t g_updates_sent = 0;
+uint32_t g_updates_received = 0;
+uint32_t g_stalls = 0;
+uint64_t g_stalled_us = 0;
+
+bool peer_flow_controlled(uint64_t now) {
+    return g_peer_seen && now - g_peer_updated_us < ftl_config::CREDIT_PEER_TIMEOUT_US;
+}
+
+// Frames the peer can still take; zero or less once we have sent up to LIMIT
+int credits() {
+    return static_cast<int8_t>(g_peer_limit - g_sent);
+}
+
+// Frames this end can take before one is evicted from the RX queue. Pool
+// slots are not counted: both ends stalled with their pools full of queued
+// TX would otherwise wait on each other for good. A frame that finds no slot
+// is dropped and counted like an eviction.
+uint8_t free_room() {
+    constexpr uint32_t QUEUE_CAPACITY = ftl_config::MESSAGE_QUEUE_DEPTH - 1;
+    return static_cast<uint8_t>(QUEUE_CAPACITY - std::min(internal_rx::get_queue_count(), QUEUE_CAPACITY));
+}
+
+void end_stall(uint64_t now) {
+    if (g_stalled) {
+        g_stalled_us += now - g_stalled_since_us;
+        g_stalled = false;
+    }
+}
+
+} // anonymous namespace
+
+void initialize(uint8_t source_id) {
+    g_source_id = source_id;
+    if constexpr (ftl_config::FLOW_CONTROL_ENABLED) {
+        g_update_handle = messages::g_message_pool.acquire(ftl_config::slot_size_for(ftl_config::CREDIT_PAYLOAD_SIZE));
+    }
+    g_sent = 0;
+    g_peer_limit = 0;
+    g_peer_seen = false;
+    g_stalled = false;
+    g_received = 0;
+    g_advertised_limit = 0;
+    g_advertised_us = 0;
+    g_update_requested = true;      // Tell the peer we take part straight away
+    g_updates_sent = 0;
+    g_updates_received = 0;
+    g_stalls = 0;
+    g_stalled_us = 0;
+}
+
+bool try_consume() {
+    if constexpr (!ftl_config::FLOW_CONTROL_ENABLED) {
+        return true;
+    }
+
+    const uint64_t now = time_us_64();
+    if (peer_flow_controlled(now) && credits() <= 0) {
+        if (!g_stalled) {
+            // Our count goes out with the next update, so a peer that
+            // restarted or missed frames can resync and grant credit
+            g_stalled = true;
+            g_stalled_since_us = now;
+            g_stalls++;
+            g_update_requested = true;
+        }
+        return false;
+    }
+
+    end_stall(now);
+    g_sent++;
+    return true;
+}
+
+PoolHandle take_update() {
+    if constexpr (!ftl_config::FLOW_CONTROL_ENABLED) {
+        return MessagePoolType::INVALID;
+    }
+
+    const uint64_t now = time_us_64();
+    const uint8_t limit = static_cast<uint8_t>(g_received + free_room());
+    const uint32_t interval = g_stalled ? ftl_config::CREDIT_STALL_RETRY_US : ftl_config::CREDIT_UPDATE_US;
+    const bool due = g_update_requested || now - g_advertised_us >= interval ||
+                     static_cast<int8_t>(limit - g_advertised_limit) >= ftl_config::CREDIT_UPDATE_THRESHOLD;
+    if (!due) {
+        return MessagePoolType::INVALID;
+    }
+
+    // The TX completion drops the extra reference; until then the previous
+    // update is still on the wire and this one waits for the next poll
+    const PoolHandle handle = g_update_handle;
+    if (handle == MessagePoolType::INVALID || messages::g_message_pool.get_ref_count(handle) != 1 ||
+        !messages::g_message_pool.add_ref(handle)) {
+        return MessagePoolType::INVALID;
+    }
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    slot[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(ftl_config::TxClass::Control);
+    slot[ftl_config::SLOT_LENGTH_OFFSET] = ftl_config::CREDIT_PAYLOAD_SIZE;
+    slot[ftl_config::SLOT_SOURCE_OFFSET] = g_source_id;
+    payload[0] = ftl_config::CREDIT_MESSAGE_TYPE;
+    payload[FLAGS] = g_stalled ? ftl_config::CREDIT_FLAG_STALLED : 0;
+    payload[SENT] = g_sent;
+    payload[LIMIT] = limit;
+
+    g_advertised_limit = limit;
+    g_advertised_us = now;
+    g_update_requested = false;
+    g_updates_sent++;
+    return handle;
+}
+
+bool accept(PoolHandle handle) {
+    const uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const bool is_credit = slot[ftl_config::SLOT_LENGTH_OFFSET] == ftl_config::CREDIT_PAYLOAD_SIZE &&
+                           payload[0] == ftl_config::CREDIT_MESSAGE_TYPE;
+
+    // A peer built with flow control still sends credit frames; they are
+    // dropped here rather than handed to the application
+    if constexpr (!ftl_config::FLOW_CONTROL_ENABLED) {
+        if (is_credit) {
+            messages::g_message_pool.release(handle);
+        }
+        return is_credit;
+    }
+
+    if (!is_credit) {
+        g_received++;
+        return false;
+    }
+
+    // Everything the peer sent before this frame has arrived or never will.
+    // A count that disagrees means lost frames or a restarted peer, and the
+    // peer needs a LIMIT based on its own count. A stalled peer gets a reply
+    // only with room to give, so two full ends don't keep answering each other.
+    if (payload[SENT] != g_received) {
+        g_received = payload[SENT];
+        g_update_requested = true;
+    } else if ((payload[FLAGS] & ftl_config::CREDIT_FLAG_STALLED) && free_room() > 0) {
+        g_update_requested = true;
+    }
+    g_peer_limit = payload[LIMIT];
+    g_peer_seen = true;
+    g_peer_updated_us = time_us_64();
+    g_updates_received++;
+
+    messages::g_message_pool.release(handle);
+    return true;
+}
+
+Statistics get_statistics() {
+    const uint64_t now = time_us_64();
+    const bool flow_controlled = peer_flow_controlled(now);
+    const uint64_t stalled_us = g_stalled_us + (g_stalled ? now - g_stalled_since_us : 0);
+    return Statistics{
+        g_updates_sent,
+        g_updates_received,
+        g_stalls,
+        static_cast<uint32_t>(stalled_us),
+        flow_controlled ? static_cast<uint32_t>(std::max(credits(), 0)) : 0,
+        flow_controlled
+    };
+}
+
+} // namespace internal_credit
+} // namespace uart
+} // namespace ftl
@@ -1,20 +1,31 @@
 #include "internal/uart_dma.h"
 
 #include "pico/printf.h"
+#include "pico/time.h"
 #include "hardware/uart.h"
 #include "hardware/dma.h"
+#include "hardware/irq.h"
 #include <algorithm>
+#include <bit>
 #include <cstring>
 
 namespace ftl_internal {
 
+namespace {
+
+constexpr uint RX_RING_BITS = std::countr_zero(ftl_config::RX_CIRCULAR_BUFFER_SIZE);  // log2(size)
+
+} // anonymous namespace
+
+DmaController* DmaController::tx_irq_instance_ = nullptr;
+
 void DmaController::init(uart_inst_t* uart_inst) {
     uart_instance_ = uart_inst;
     uart_dreq_tx_ = uart_get_dreq(uart_instance_, true);   // TX DREQ
     uart_dreq_rx_ = uart_get_dreq(uart_instance_, false);  // RX DREQ
 
-    dma_rx_chan_a_ = dma_claim_unused_channel(true);
-    dma_rx_chan_b_ = dma_claim_unused_channel(true);
+    dma_rx_chan_ = dma_claim_unused_channel(true);
+    dma_rx_reload_chan_ = dma_claim_unused_channel(true);
     dma_tx_chan_ = dma_claim_unused_channel(true);
 
     dma_channel_config tx_cfg = dma_channel_get_default_config(dma_tx_chan_);
@@ -22,218 +33,212 @@ void DmaController::init(uart_inst_t* uart_inst) {
     channel_config_set_read_increment(&tx_cfg, true);   // Read from buffer
     channel_config_set_write_increment(&tx_cfg, false); // Write to fixed UART register
     channel_config_set_dreq(&tx_cfg, uart_dreq_tx_);
-    dma_channel_set_config(dma_tx_chan_, &tx_cfg, false);
-
-    setup_rx_dma_channel(dma_rx_chan_a_, rx_dma_buffer_a_, dma_rx_chan_b_);
-    setup_rx_dma_channel(dma_rx_chan_b_, rx_dma_buffer_b_, dma_rx_chan_a_);
-
-    rx_dma_a_read_pos_.store(0, std::memory_order_relaxed);
-    rx_dma_b_read_pos_.store(0, std::memory_order_relaxed);
-    rx_circ_write_idx_.store(0, std::memory_order_relaxed);
-    rx_circ_read_idx_.store(0, std::memory_order_relaxed);
+    dma_channel_configure(dma_tx_chan_, &tx_cfg,
+                          &uart_get_hw(uart_instance_)->dr,    // Fixed UART data register
+                          nullptr,                             // Frame set per transfer
+                          0,
+                          false);
+
+    // Completion interrupt hands the frame's pool slot back
+    tx_irq_instance_ = this;
+    dma_irqn_set_channel_enabled(ftl_config::TX_DMA_IRQ_INDEX, dma_tx_chan_, true);
+    irq_add_shared_handler(dma_get_irq_num(ftl_config::TX_DMA_IRQ_INDEX), &DmaController::tx_dma_irq_handler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(dma_get_irq_num(ftl_config::TX_DMA_IRQ_INDEX), true);
+
+    // RX data channel: one lap of the ring per run, writes wrap in hardware
+    dma_channel_config rx_cfg = dma_channel_get_default_config(dma_rx_chan_);
+    channel_config_set_transfer_data_size(&rx_cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&rx_cfg, false);  // Read from fixed UART register
+    channel_config_set_write_increment(&rx_cfg, true);  // Write to ring
+    channel_config_set_ring(&rx_cfg, true, RX_RING_BITS);
+    channel_config_set_dreq(&rx_cfg, uart_dreq_rx_);
+    channel_config_set_chain_to(&rx_cfg, dma_rx_reload_chan_);
+    dma_channel_configure(dma_rx_chan_, &rx_cfg,
+                          rx_ring_.data(),
+                          &uart_get_hw(uart_instance_)->dr,
+                          ftl_config::RX_CIRCULAR_BUFFER_SIZE,
+                          false);
+
+    // Reload channel: rewrite the data channel's count and retrigger it; the
+    // write address carries on from where the ring wrapped, so RX never stops
+    dma_channel_config reload_cfg = dma_channel_get_default_config(dma_rx_reload_chan_);
+    channel_config_set_transfer_data_size(&reload_cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&reload_cfg, false);
+    channel_config_set_write_increment(&reload_cfg, false);
+    dma_channel_configure(dma_rx_reload_chan_, &reload_cfg,
+                          &dma_hw->ch[dma_rx_chan_].al1_transfer_count_trig,
+                          &rx_reload_count_,
+                          1,
+                          false);
+
+    crc_engine_.init(crc16::Backend::DmaSniffer);
+
+    rx_read_idx_ = 0;
     tx_busy_.store(false, std::memory_order_relaxed);
-    current_active_rx_dma_.store(0, std::memory_order_relaxed);
+    tx_ring_.clear();
+    tx_stats_ = TxLineStats{};
 
-    dma_channel_start(dma_rx_chan_a_);
+    dma_channel_start(dma_rx_chan_);
 }
 
-void DmaController::process_rx_dma() {
-    check_active_dma_buffer();
-    check_for_dma_buffer_swap();
-    check_for_dma_stall();
+uint32_t DmaController::rx_write_idx() const {
+    const uintptr_t write_addr = dma_channel_hw_addr(dma_rx_chan_)->write_addr;
+    // Everything the DMA wrote before this point is visible to the reads below
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return static_cast<uint32_t>(write_addr - reinterpret_cast<uintptr_t>(rx_ring_.data())) & RX_RING_MASK;
 }
 
 size_t DmaController::get_bytes_available() const {
-    const uint32_t write_idx = rx_circ_write_idx_.load(std::memory_order_acquire);
-    const uint32_t read_idx = rx_circ_read_idx_.load(std::memory_order_relaxed);
-    return (write_idx - read_idx) & (ftl_config::RX_CIRCULAR_BUFFER_SIZE - 1);
+    return (rx_write_idx() - rx_read_idx_) & RX_RING_MASK;
 }
 
-size_t DmaController::read_from_circular_buffer(std::span<uint8_t> buffer) {
-    uint32_t read_idx = rx_circ_read_idx_.load(std::memory_order_relaxed);
-    const uint32_t write_idx = rx_circ_write_idx_.load(std::memory_order_acquire);
-
-    const size_t available = (write_idx - read_idx) & (ftl_config::RX_CIRCULAR_BUFFER_SIZE - 1);
-    const size_t bytes_to_read = std::min(available, buffer.size());
+std::span<const uint8_t> DmaController::rx_contiguous() const {
+    const uint32_t write_idx = rx_write_idx();
+    const uint32_t end = write_idx >= rx_read_idx_ ? write_idx : ftl_config::RX_CIRCULAR_BUFFER_SIZE;
+    return {rx_ring_.data() + rx_read_idx_, end - rx_read_idx_};
+}
 
-    for (size_t i = 0; i < bytes_to_read; ++i) {
-        buffer[i] = rx_circular_buffer_[read_idx];
-        read_idx = (read_idx + 1) & (ftl_config::RX_CIRCULAR_BUFFER_SIZE - 1);
-    }
+uint8_t DmaController::rx_peek(size_t offset) const {
+    return rx_ring_[(rx_read_idx_ + offset) & RX_RING_MASK];
+}
 
-    rx_circ_read_idx_.store(read_idx, std::memory_order_release);
-    return bytes_to_read;
+void DmaController::rx_copy(size_t offset, uint8_t* dest, size_t length) const {
+    const uint32_t start = (rx_read_idx_ + offset) & RX_RING_MASK;
+    const size_t first = std::min<size_t>(length, ftl_config::RX_CIRCULAR_BUFFER_SIZE - start);
+    std::memcpy(dest, rx_ring_.data() + start, first);
+    std::memcpy(dest + first, rx_ring_.data(), length - first);
 }
 
-bool DmaController::write_data(std::span<const uint8_t> data) {
-    if(data.size() > ftl_config::TX_BUFFER_SIZE) {
-        return false;
+bool DmaController::rx_find(uint8_t value, size_t& offset) const {
+    const uint32_t write_idx = rx_write_idx();
+    const uint32_t first_end = write_idx >= rx_read_idx_ ? write_idx : ftl_config::RX_CIRCULAR_BUFFER_SIZE;
+
+    const uint8_t* first = rx_ring_.data() + rx_read_idx_;
+    if (const void* hit = std::memchr(first, value, first_end - rx_read_idx_)) {
+        offset = static_cast<const uint8_t*>(hit) - first;
+        return true;
     }
-    
-    uint32_t loop_counter = 0;
-    while(true) {
-        if (!is_write_busy()) 
-            break;
-        loop_counter++;
-        if(loop_counter > 1000) {
-            printf("TX DMA busy timeout\n");
-            return false;
-        }  
+    if (write_idx < rx_read_idx_) {
+        if (const void* hit = std::memchr(rx_ring_.data(), value, write_idx)) {
+            offset = (first_end - rx_read_idx_) + (static_cast<const uint8_t*>(hit) - rx_ring_.data());
+            return true;
+        }
     }
+    return false;
+}
 
-    memcpy(tx_buffer_.data(), data.data(), data.size());
-
-    tx_busy_.store(true, std::memory_order_relaxed);
-
-    dma_channel_set_read_addr(dma_tx_chan_, tx_buffer_.data(), false);
-    dma_channel_set_write_addr(dma_tx_chan_, &uart_get_hw(uart_instance_)->dr, false);
-    dma_channel_set_trans_count(dma_tx_chan_, data.size(), true); // Start transfer
+void DmaController::rx_consume(size_t length) {
+    rx_read_idx_ = (rx_read_idx_ + length) & RX_RING_MASK;
+}
 
-    return true;
+void DmaController::set_tx_complete_callback(TxCompleteCallback callback) {
+    tx_complete_ = callback;
 }
 
-bool DmaController::is_write_busy() {
-    if (!tx_busy_.load(std::memory_order_relaxed)) {
+bool DmaController::queue_write(const uint8_t* frame, size_t length, uint8_t tag) {
+    if (frame == nullptr || length == 0 || length > ftl_config::MAX_MESSAGE_SIZE) {
         return false;
     }
 
-    if (!dma_channel_is_busy(dma_tx_chan_)) {
-        tx_busy_.store(false, std::memory_order_relaxed);
+    if (!tx_ring_.enqueue(TxDescriptor{frame, static_cast<uint16_t>(length), tag})) {
         return false;
     }
 
+    // Idle line: nothing is in flight, so the IRQ cannot race us for the ring.
+    // If a transfer is in flight, its completion IRQ picks this one up.
+    if (!tx_busy_.load(std::memory_order_acquire)) {
+        start_next_write(false);
+    }
     return true;
 }
 
-void DmaController::setup_rx_dma_channel(int channel, volatile uint8_t* buffer, int chain_to_channel) {
-    dma_channel_config cfg = dma_channel_get_default_config(channel);
-    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
-    channel_config_set_read_increment(&cfg, false);  // Read from fixed UART register
-    channel_config_set_write_increment(&cfg, true);  // Write to buffer
-    channel_config_set_dreq(&cfg, uart_dreq_rx_);
-    channel_config_set_chain_to(&cfg, chain_to_channel);  // Chain to other buffer when done
+bool DmaController::can_queue_write() const {
+    return !tx_ring_.is_full();
+}
 
-    dma_channel_configure(
-        channel,
-        &cfg,
-        (void*)buffer,                          // Destination buffer
-        &uart_get_hw(uart_instance_)->dr,      // Source: UART data register
-        ftl_config::RX_DMA_CHUNK_SIZE,        // Transfer count
-        false                                   // Don't start yet
-    );
+bool DmaController::is_write_busy() const {
+    return tx_busy_.load(std::memory_order_acquire);
 }
 
-void DmaController::transfer_to_circular_buffer(volatile uint8_t* dma_buffer, uint32_t start_idx, uint32_t count) {
-    uint32_t write_idx = rx_circ_write_idx_.load(std::memory_order_acquire);
-    uint32_t read_idx = rx_circ_read_idx_.load(std::memory_order_acquire);
+size_t DmaController::get_writes_pending() const {
+    return tx_ring_.count() + (tx_busy_.load(std::memory_order_acquire) ? 1 : 0);
+}
 
-    for (uint32_t i = 0; i < count; ++i) {
-        const uint8_t byte = dma_buffer[start_idx + i];
-        const uint32_t next_write_idx = (write_idx + 1) & (ftl_config::RX_CIRCULAR_BUFFER_SIZE - 1);
+bool DmaController::is_tx_idle() const {
+    return tx_ring_.is_empty() && !tx_busy_.load(std::memory_order_acquire) &&
+           !(uart_get_hw(uart_instance_)->fr & UART_UARTFR_BUSY_BITS);
+}
 
-        if (next_write_idx == read_idx) {
-            printf("RX circular buffer overflow - dropping oldest data");
-            read_idx = (read_idx + 1) & (ftl_config::RX_CIRCULAR_BUFFER_SIZE - 1);
-        }
+uint32_t DmaController::set_baud_rate(uint32_t baud_rate) {
+    return uart_set_baudrate(uart_instance_, baud_rate);
+}
 
-        rx_circular_buffer_[write_idx] = byte;
-        write_idx = next_write_idx;
+DmaController::TxLineStats DmaController::get_tx_line_stats() const {
+    TxLineStats stats;
+    uint32_t seq;
+    bool busy;
+    uint64_t busy_since;
+    do {
+        seq = tx_stats_seq_.load(std::memory_order_acquire);
+        stats = tx_stats_;
+        busy = tx_busy_.load(std::memory_order_relaxed);
+        busy_since = tx_busy_since_us_;
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1) || seq != tx_stats_seq_.load(std::memory_order_relaxed));
+
+    // Count the transfer in progress up to now
+    if (busy) {
+        stats.busy_us += time_us_64() - busy_since;
     }
-
-    rx_circ_write_idx_.store(write_idx, std::memory_order_release);
-    rx_circ_read_idx_.store(read_idx, std::memory_order_release);
+    return stats;
 }
 
-uint32_t DmaController::get_active_dma_bytes_available() const {
-    const bool is_chan_a_active = (current_active_rx_dma_.load(std::memory_order_relaxed) == 0);
-    const int active_channel = is_chan_a_active ? dma_rx_chan_a_ : dma_rx_chan_b_;
-
-    const uint32_t remaining_transfers = dma_channel_hw_addr(active_channel)->transfer_count;
-    const uint32_t transferred = ftl_config::RX_DMA_CHUNK_SIZE - remaining_transfers;
+void DmaController::start_next_write(bool back_to_back) {
+    TxDescriptor next;
+    const bool have_next = tx_ring_.dequeue(next);
 
-    const uint32_t already_read_pos = is_chan_a_active ?
-                                      rx_dma_a_read_pos_.load(std::memory_order_acquire) :
-                                      rx_dma_b_read_pos_.load(std::memory_order_acquire);
-
-    if (transferred > already_read_pos) {
-        return transferred - already_read_pos;
+    tx_stats_seq_.fetch_add(1, std::memory_order_acq_rel);
+    const uint64_t now = time_us_64();
+    if (have_next && !back_to_back) {
+        tx_busy_since_us_ = now;
+    } else if (!have_next && back_to_back) {
+        tx_stats_.busy_us += now - tx_busy_since_us_;
     }
-    return 0;
-}
+    if (have_next && back_to_back) {
+        tx_stats_.back_to_back_frames++;
+    }
+    tx_stats_seq_.fetch_add(1, std::memory_order_release);
 
-void DmaController::check_active_dma_buffer() {
-    const uint32_t available = get_active_dma_bytes_available();
-    if (available == 0) {
+    if (!have_next) {
+        tx_busy_.store(false, std::memory_order_release);
         return;
     }
 
-    if (current_active_rx_dma_.load(std::memory_order_relaxed) == 0) {
-        const uint32_t read_pos = rx_dma_a_read_pos_.load(std::memory_order_relaxed);
-        transfer_to_circular_buffer(rx_dma_buffer_a_, read_pos, available);
-        rx_dma_a_read_pos_.store(read_pos + available, std::memory_order_release);
-    } else {
-        const uint32_t read_pos = rx_dma_b_read_pos_.load(std::memory_order_relaxed);
-        transfer_to_circular_buffer(rx_dma_buffer_b_, read_pos, available);
-        rx_dma_b_read_pos_.store(read_pos + available, std::memory_order_release);
-    }
+    tx_current_ = next;
+    tx_busy_.store(true, std::memory_order_release);
+    dma_channel_transfer_from_buffer_now(dma_tx_chan_, next.frame, next.length);
 }
 
-void DmaController::check_for_dma_buffer_swap() {
-    const bool is_chan_a_active = (current_active_rx_dma_.load(std::memory_order_relaxed) == 0);
-    const int active_channel = is_chan_a_active ? dma_rx_chan_a_ : dma_rx_chan_b_;
-    const int inactive_channel = is_chan_a_active ? dma_rx_chan_b_ : dma_rx_chan_a_;
-
-    if (dma_channel_is_busy(inactive_channel) && !dma_channel_is_busy(active_channel)) {        
-        if (is_chan_a_active) {
-            const uint32_t read_pos = rx_dma_a_read_pos_.load(std::memory_order_relaxed);
-            if (read_pos < ftl_config::RX_DMA_CHUNK_SIZE) {
-                transfer_to_circular_buffer(rx_dma_buffer_a_, read_pos, 
-                                           ftl_config::RX_DMA_CHUNK_SIZE - read_pos);
-            }
-            
-            rx_dma_a_read_pos_.store(0, std::memory_order_relaxed);
-            dma_channel_set_write_addr(dma_rx_chan_a_, (void*)rx_dma_buffer_a_, false);
-            dma_channel_set_trans_count(dma_rx_chan_a_, ftl_config::RX_DMA_CHUNK_SIZE, false);
-        } else {
-            const uint32_t read_pos = rx_dma_b_read_pos_.load(std::memory_order_relaxed);
-            if (read_pos < ftl_config::RX_DMA_CHUNK_SIZE) {
-                transfer_to_circular_buffer(rx_dma_buffer_b_, read_pos, 
-                                           ftl_config::RX_DMA_CHUNK_SIZE - read_pos);
-            }
-            
-            rx_dma_b_read_pos_.store(0, std::memory_order_relaxed);
-            dma_channel_set_write_addr(dma_rx_chan_b_, (void*)rx_dma_buffer_b_, false);
-            dma_channel_set_trans_count(dma_rx_chan_b_, ftl_config::RX_DMA_CHUNK_SIZE, false);
-        }
-
-        current_active_rx_dma_.store(1 - current_active_rx_dma_.load(std::memory_order_relaxed), 
-                                    std::memory_order_relaxed);
+void DmaController::tx_dma_irq_handler() {
+    DmaController* self = tx_irq_instance_;
+    if (self == nullptr || !dma_irqn_get_channel_status(ftl_config::TX_DMA_IRQ_INDEX, self->dma_tx_chan_)) {
+        return;
     }
-}
+    dma_irqn_acknowledge_channel(ftl_config::TX_DMA_IRQ_INDEX, self->dma_tx_chan_);
 
-void DmaController::check_for_dma_stall() {
-    if (!dma_channel_is_busy(dma_rx_chan_a_) && !dma_channel_is_busy(dma_rx_chan_b_)) {
-        printf("DMA stall detected - recovering");
-        
-        const uint32_t read_pos_a = rx_dma_a_read_pos_.load(std::memory_order_relaxed);
-        if (read_pos_a < ftl_config::RX_DMA_CHUNK_SIZE) {
-            transfer_to_circular_buffer(rx_dma_buffer_a_, read_pos_a, 
-                                       ftl_config::RX_DMA_CHUNK_SIZE - read_pos_a);
-        }
-        
-        const uint32_t read_pos_b = rx_dma_b_read_pos_.load(std::memory_order_relaxed);
-        if (read_pos_b < ftl_config::RX_DMA_CHUNK_SIZE) {
-            transfer_to_circular_buffer(rx_dma_buffer_b_, read_pos_b, 
-                                       ftl_config::RX_DMA_CHUNK_SIZE - read_pos_b);
-        }
+    const TxDescriptor done = self->tx_current_;
+
+    // Restart the channel before anything else so the UART FIFO never drains
+    self->start_next_write(true);
 
-        rx_dma_a_read_pos_.store(0, std::memory_order_relaxed);
-        rx_dma_b_read_pos_.store(0, std::memory_order_relaxed);
-        current_active_rx_dma_.store(0, std::memory_order_relaxed);
+    self->tx_stats_seq_.fetch_add(1, std::memory_order_acq_rel);
+    self->tx_stats_.frames_sent++;
+    self->tx_stats_.bytes_sent += done.length;
+    self->tx_stats_seq_.fetch_add(1, std::memory_order_release);
 
-        setup_rx_dma_channel(dma_rx_chan_a_, rx_dma_buffer_a_, dma_rx_chan_b_);
-        setup_rx_dma_channel(dma_rx_chan_b_, rx_dma_buffer_b_, dma_rx_chan_a_);
-        dma_channel_start(dma_rx_chan_a_);
+    if (self->tx_complete_) {
+        self->tx_complete_(done.tag);
     }
 }
 
@@ -0,0 +1,461 @@
+#include "internal/uart_link.h"
+#include "internal/uart_dma.h"
+#include "internal/uart_rx.h"
+#include "util/cqueue.h"
+#include "pico/stdlib.h"
+#include <algorithm>
+
+namespace ftl {
+namespace messages {
+    extern MessagePoolType g_message_pool;
+}
+
+namespace uart {
+namespace internal_link {
+
+namespace {
+
+// Link frame fields, from the start of the payload
+constexpr size_t OP = 1;
+constexpr size_t INDEX = 2;
+constexpr size_t ARGS = 3;
+constexpr uint8_t FRAME_SIZE = ARGS + 2;
+
+enum class Op : uint8_t {
+    Hello = 0,      // [current rate] [highest rate]
+    Propose,        // [next rate]
+    Accept,         // [next rate]
+    Probe,          // [rate] [seq] [pattern up to MAX_PAYLOAD_SIZE]
+    Report,         // [rate] [probes received] [bad frames]
+    Commit,         // [rate]
+    Fallback,       // [lower rate], or a failed trial's committed rate
+};
+
+enum class State : uint8_t {
+    Idle,           // At the committed rate
+    Proposing,      // Leader: waiting for ACCEPT
+    Switching,      // Waiting for the line to drain before changing rate
+    Trial,          // At the proposed rate until COMMIT or timeout
+};
+
+constexpr uint8_t TOP_INDEX = ftl_config::LINK_BAUD_RATE_COUNT - 1;
+
+// Lets the follower finish its own switch before the first probe arrives
+constexpr uint32_t PROBE_GUARD_US = 1000;
+
+using LinkQueue = CircularQueue<PoolHandle, 8, false>;
+LinkQueue g_link_queue;
+
+uint8_t g_source_id = 0;
+uint32_t g_baud_rate = ftl_config::BAUD_RATE;
+
+State g_state = State::Idle;
+uint8_t g_index = 0;                // Committed rate
+uint8_t g_target = 0;               // Rate being switched to
+bool g_commit_on_switch = false;    // Fallbacks and resets skip the trial
+uint64_t g_deadline_us = 0;
+uint64_t g_proposed_us = 0;
+uint8_t g_attempts = 0;
+
+// Leader: earliest next PROPOSE, and the highest rate to try until a
+// failed rate may be tried again
+uint64_t g_next_step_us = 0;
+uint8_t g_ceiling = TOP_INDEX;
+uint64_t g_ceiling_until_us = 0;
+
+// Peer, from its HELLO; the lower source ID leads
+bool g_peer_seen = false;
+bool g_leader = false;
+uint8_t g_peer_top = 0;
+uint64_t g_heard_us = 0;
+uint64_t g_hello_us = 0;
+
+// Trial
+uint64_t g_trial_start_us = 0;
+bool g_probes_sent = false;
+uint8_t g_probes_received = 0;
+uint32_t g_errors_at_switch = 0;
+
+// Quality window
+uint64_t g_window_start_us = 0;
+uint32_t g_window_good = 0;
+uint32_t g_window_errors_at_start = 0;
+uint32_t g_error_permille = 0;
+
+// Statistics
+uint32_t g_trials = 0;
+uint32_t g_trials_failed = 0;
+uint32_t g_fallbacks = 0;
+uint32_t g_silence_resets = 0;
+
+uint32_t rx_errors() {
+    const auto stats = internal_rx::get_statistics();
+    return stats.crc_errors + stats.framing_errors;
+}
+
+// Queues a link frame; dropped without a free slot, which the timeouts cover
+void queue_frame(Op op, uint8_t index, uint8_t arg0 = 0, uint8_t arg1 = 0) {
+    const uint8_t length = op == Op::Probe ? ftl_config::MAX_PAYLOAD_SIZE : FRAME_SIZE;
+    const PoolHandle handle = messages::g_message_pool.acquire(ftl_config::slot_size_for(length));
+    if (handle == MessagePoolType::INVALID) {
+        return;
+    }
+
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    slot[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(ftl_config::TxClass::Control);
+    slot[ftl_config::SLOT_LENGTH_OFFSET] = length;
+    slot[ftl_config::SLOT_SOURCE_OFFSET] = g_source_id;
+    payload[0] = ftl_config::LINK_MESSAGE_TYPE;
+    payload[OP] = static_cast<uint8_t>(op);
+    payload[INDEX] = index;
+    payload[ARGS] = arg0;
+    payload[ARGS + 1] = arg1;
+
+    // Probes fill the frame with a changing bit pattern
+    for (size_t i = FRAME_SIZE; i < length; i++) {
+        payload[i] = static_cast<uint8_t>(i * 37 + arg0);
+    }
+
+    if (!g_link_queue.enqueue(handle)) {
+        messages::g_message_pool.release(handle);
+    }
+}
+
+void queue_probes() {
+    for (uint8_t seq = 0; seq < ftl_config::LINK_PROBE_FRAMES; seq++) {
+        queue_frame(Op::Probe, g_target, seq);
+    }
+}
+
+void start_window(uint64_t now) {
+    g_window_start_us = now;
+    g_window_good = 0;
+    g_window_errors_at_start = rx_errors();
+}
+
+// Rates from `index` up are left alone for LINK_RETRY_US
+void limit_rate(uint8_t index, uint64_t now) {
+    g_ceiling = index > 0 ? index - 1 : 0;
+    g_ceiling_until_us = now + ftl_config::LINK_RETRY_US;
+}
+
+void begin_switch(uint8_t index, bool commit) {
+    g_target = index;
+    g_commit_on_switch = commit;
+    g_state = State::Switching;
+}
+
+void commit(uint64_t now) {
+    g_index = g_target;
+    g_state = State::Idle;
+    g_heard_us = now;
+    g_next_step_us = now + ftl_config::LINK_STEP_DELAY_US;
+    start_window(now);
+}
+
+// Back to the committed rate
+void fail_trial(uint64_t now) {
+    g_trials_failed++;
+    limit_rate(g_target, now);
+    begin_switch(g_index, true);
+}
+
+bool peer_recent(uint64_t now) {
+    return g_peer_seen && now - g_heard_us < ftl_config::LINK_SILENCE_US;
+}
+
+void process_trial(uint64_t now) {
+    if (g_leader) {
+        if (!g_probes_sent && now - g_trial_start_us >= PROBE_GUARD_US) {
+            queue_probes();
+            g_probes_sent = true;
+        }
+    } else if (!g_probes_sent && (g_probes_received == ftl_config::LINK_PROBE_FRAMES ||
+                                  now - g_trial_start_us >= ftl_config::LINK_TRIAL_TIMEOUT_US / 4)) {
+        // Our probes, then what we made of the leader's
+        queue_probes();
+        const uint32_t errors = std::min<uint32_t>(rx_errors() - g_errors_at_switch, 0xFF);
+        queue_frame(Op::Report, g_target, g_probes_received, static_cast<uint8_t>(errors));
+        g_probes_sent = true;
+    }
+
+    if (now >= g_deadline_us) {
+        fail_trial(now);
+    }
+}
+
+// Falls back a rate when too many frames in the window were bad
+void check_quality(uint64_t now) {
+    if (now - g_window_start_us < ftl_config::LINK_QUALITY_WINDOW_US) {
+        return;
+    }
+
+    const uint32_t errors = rx_errors() - g_window_errors_at_start;
+    const uint32_t total = errors + g_window_good;
+    g_error_permille = total > 0 ? errors * 1000 / total : 0;
+    start_window(now);
+
+    if (g_index > 0 && errors >= ftl_config::LINK_FALLBACK_MIN_ERRORS &&
+        g_error_permille > ftl_config::LINK_FALLBACK_ERROR_PERMILLE) {
+        // Sent twice as the line is known to be bad; silence covers the rest
+        g_fallbacks++;
+        limit_rate(g_index, now);
+        queue_frame(Op::Fallback, g_index - 1);
+        queue_frame(Op::Fallback, g_index - 1);
+        begin_switch(g_index - 1, true);
+    }
+}
+
+void handle_frame(const uint8_t* payload, uint8_t peer_id, uint64_t now) {
+    const Op op = static_cast<Op>(payload[OP]);
+    const uint8_t index = payload[INDEX];
+    if (index > TOP_INDEX) {
+        return;
+    }
+
+    g_peer_seen = true;
+    g_leader = g_source_id < peer_id;
+    g_heard_us = now;
+
+    // The leader only says HELLO or PROPOSE at a trial rate once it has
+    // committed, so a follower whose COMMITs were lost commits here
+    if (!g_leader && g_state == State::Trial && (op == Op::Hello || op == Op::Propose)) {
+        commit(now);
+    }
+
+    switch (op) {
+    case Op::Hello:
+        g_peer_top = std::min(payload[ARGS], TOP_INDEX);
+        break;
+
+    case Op::Propose:
+        if (!g_leader && g_state == State::Idle && index != g_index) {
+            queue_frame(Op::Accept, index);
+            begin_switch(index, false);
+        }
+        break;
+
+    case Op::Accept:
+        if (g_leader && g_state == State::Proposing && index == g_target) {
+            begin_switch(index, false);
+        }
+        break;
+
+    case Op::Probe:
+        if (g_state == State::Trial && index == g_target) {
+            g_probes_received++;
+        }
+        break;
+
+    case Op::Report:
+        if (g_leader && g_state == State::Trial && index == g_target) {
+            const bool good = payload[ARGS] == ftl_config::LINK_PROBE_FRAMES &&
+                              payload[ARGS + 1] <= ftl_config::LINK_PROBE_MAX_ERRORS &&
+                              g_probes_received == ftl_config::LINK_PROBE_FRAMES &&
+                              rx_errors() - g_errors_at_switch <= ftl_config::LINK_PROBE_MAX_ERRORS;
+            if (good) {
+                queue_frame(Op::Commit, index);
+                queue_frame(Op::Commit, index);
+                commit(now);
+            } else {
+                // Tells the follower to go back now rather than at its deadline
+                queue_frame(Op::Fallback, g_index);
+                queue_frame(Op::Fallback, g_index);
+                fail_trial(now);
+            }
+        }
+        break;
+
+    case Op::Commit:
+        if (!g_leader && g_state == State::Trial && index == g_target) {
+            commit(now);
+        }
+        break;
+
+    case Op::Fallback:
+        if (!g_leader && g_state == State::Trial && index == g_index) {
+            fail_trial(now);
+        } else if ((g_state == State::Idle || g_state == State::Proposing) && index < g_index) {
+            g_fallbacks++;
+            limit_rate(g_index, now);
+            begin_switch(index, true);
+        }
+        break;
+    }
+}
+
+} // anonymous namespace
+
+void initialize(uint8_t source_id) {
+    g_source_id = source_id;
+    g_link_queue.clear();
+    g_baud_rate = ftl_config::BAUD_RATE;
+    g_state = State::Idle;
+    g_index = 0;
+    g_ceiling = TOP_INDEX;
+    g_next_step_us = 0;
+    g_peer_seen = false;
+    g_leader = false;
+    g_peer_top = 0;
+
+    const uint64_t now = time_us_64();
+    g_hello_us = now - ftl_config::LINK_KEEPALIVE_US;   // Say HELLO straight away
+    g_heard_us = now;
+    start_window(now);
+    g_error_permille = 0;
+    g_trials = 0;
+    g_trials_failed = 0;
+    g_fallbacks = 0;
+    g_silence_resets = 0;
+}
+
+void process(ftl_internal::DmaController& dma_controller) {
+    if constexpr (!ftl_config::LINK_NEGOTIATION_ENABLED) {
+        return;
+    }
+
+    const uint64_t now = time_us_64();
+    if (g_ceiling < TOP_INDEX && now >= g_ceiling_until_us) {
+        g_ceiling = TOP_INDEX;
+    }
+
+    switch (g_state) {
+    case State::Switching:
+        // Link frames for the old rate go out first; the peer has stopped
+        // sending, so nothing arrives half at one rate and half at the other
+        if (!g_link_queue.is_empty() || !dma_controller.is_tx_idle()) {
+            return;
+        }
+        g_baud_rate = dma_controller.set_baud_rate(ftl_config::LINK_BAUD_RATES[g_target]);
+        if (g_commit_on_switch) {
+            commit(now);
+            return;
+        }
+        g_state = State::Trial;
+        g_trials++;
+        g_trial_start_us = now;
+        g_deadline_us = now + (g_leader ? ftl_config::LINK_TRIAL_TIMEOUT_US / 2 : ftl_config::LINK_TRIAL_TIMEOUT_US);
+        g_probes_sent = false;
+        g_probes_received = 0;
+        g_errors_at_switch = rx_errors();
+        return;
+
+    case State::Trial:
+        process_trial(now);
+        return;
+
+    case State::Proposing:
+        if (now >= g_deadline_us) {
+            if (g_attempts >= ftl_config::LINK_PROPOSE_RETRIES) {
+                // A peer heard in time to answer a PROPOSE turned the rate
+                // down; one that was quiet (a cut line after a silence reset)
+                // says nothing about the rate, so only the step delay applies
+                if (g_heard_us >= g_proposed_us && now - g_heard_us >= ftl_config::LINK_RESPONSE_TIMEOUT_US) {
+                    g_trials_failed++;
+                    limit_rate(g_target, now);
+                } else {
+                    g_next_step_us = now + ftl_config::LINK_STEP_DELAY_US;
+                }
+                g_state = State::Idle;
+                return;
+            }
+            queue_frame(Op::Propose, g_target);
+            g_attempts++;
+            g_deadline_us = now + ftl_config::LINK_RESPONSE_TIMEOUT_US;
+        }
+        return;
+
+    case State::Idle:
+        break;
+    }
+
+    if (now - g_hello_us >= ftl_config::LINK_KEEPALIVE_US) {
+        queue_frame(Op::Hello, g_index, TOP_INDEX);
+        g_hello_us = now;
+    }
+
+    // Nothing heard at this rate: both ends give up on it and meet at BAUD_RATE
+    if (g_index > 0 && now - g_heard_us >= ftl_config::LINK_SILENCE_US) {
+        g_silence_resets++;
+        limit_rate(g_index, now);
+        begin_switch(0, true);
+        return;
+    }
+
+    check_quality(now);
+
+    if (g_state == State::Idle && g_leader && peer_recent(now) && now >= g_next_step_us &&
+        g_index < std::min(g_peer_top, g_ceiling)) {
+        g_target = g_index + 1;
+        queue_frame(Op::Propose, g_target);
+        g_attempts = 1;
+        g_proposed_us = now;
+        g_deadline_us = now + ftl_config::LINK_RESPONSE_TIMEOUT_US;
+        g_state = State::Proposing;
+    }
+}
+
+PoolHandle take_frame() {
+    if constexpr (!ftl_config::LINK_NEGOTIATION_ENABLED) {
+        return MessagePoolType::INVALID;
+    }
+
+    PoolHandle handle;
+    return g_link_queue.dequeue(handle) ? handle : MessagePoolType::INVALID;
+}
+
+bool is_tx_paused() {
+    if constexpr (!ftl_config::LINK_NEGOTIATION_ENABLED) {
+        return false;
+    }
+    return g_state != State::Idle;
+}
+
+bool accept(PoolHandle handle) {
+    const uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const uint8_t length = slot[ftl_config::SLOT_LENGTH_OFFSET];
+    const bool is_link = length >= FRAME_SIZE && payload[0] == ftl_config::LINK_MESSAGE_TYPE;
+
+    // A peer built with negotiation still says HELLO at BAUD_RATE; without
+    // an answer it never proposes a rate, and its frames go no further
+    if constexpr (!ftl_config::LINK_NEGOTIATION_ENABLED) {
+        if (is_link) {
+            messages::g_message_pool.release(handle);
+        }
+        return is_link;
+    }
+
+    g_window_good++;
+
+    if (!is_link) {
+        g_heard_us = time_us_64();
+        return false;
+    }
+
+    // Our own frames looped back are not a peer
+    const uint8_t peer_id = slot[ftl_config::SLOT_SOURCE_OFFSET];
+    if (peer_id != g_source_id) {
+        handle_frame(payload, peer_id, time_us_64());
+    }
+    messages::g_message_pool.release(handle);
+    return true;
+}
+
+Statistics get_statistics() {
+    return Statistics{
+        g_baud_rate,
+        g_index,
+        g_peer_seen,
+        g_trials,
+        g_trials_failed,
+        g_fallbacks,
+        g_silence_resets,
+        g_error_permille
+    };
+}
+
+} // namespace internal_link
+} // namespace uart
+} // namespace ftl
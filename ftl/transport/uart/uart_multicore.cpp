@@ -1,8 +1,12 @@
 #include "internal/uart_multicore.h"
 #include "internal/uart_tx.h"
+#include "internal/uart_reliable.h"
 #include "core/ftl_api.h"
+#include "util/cqueue.h"
+#include "pico/stdlib.h"
 #include "pico/multicore.h"
 #include "pico/printf.h"
+#include "hardware/irq.h"
 
 namespace ftl {
 namespace messages {
@@ -14,32 +18,44 @@ namespace internal_multicore {
 
 namespace {
 
+// Producer: Core 1 in send_from_core1(); consumer: Core 0 in poll()
+CircularQueue<PoolHandle, ftl_config::CORE1_RING_SIZE, true> g_core1_ring;
+// Reliable messages, which wait here while Core 0's backlog is full
+CircularQueue<PoolHandle, ftl_config::CORE1_RING_SIZE, true> g_core1_reliable_ring;
+int g_doorbell = -1;
+
 // Statistics
 uint32_t g_core1_sent = 0;
-uint32_t g_core1_fifo_drops = 0;
+uint32_t g_core1_ring_drops = 0;
+uint32_t g_core1_doorbells = 0;
 uint32_t g_core0_received = 0;
 uint32_t g_core0_tx_queue_drops = 0;
+uint32_t g_core0_reliable_drops = 0;
 
 bool g_is_initialized = false;
 
-/**
- * @brief FIFO message format
- * 
- * We send two 32-bit words through the FIFO:
- * Word 0: [pool_handle (8 bits)] [payload_length (8 bits)] [reserved (16 bits)]
- * Word 1: [magic (32 bits)] = 0x46544C4D (for validation)
- */
-constexpr uint32_t FIFO_MAGIC = 0x46544C;  // "FTL" in ASCII
-
-inline void pack_fifo_message(uint32_t& word, uint8_t handle) {
-    word = static_cast<uint32_t>(FIFO_MAGIC << 8 | handle);
+// Only wakes Core 0; poll() finds the handles whether or not it rang
+void doorbell_irq_handler() {
+    if (multicore_doorbell_is_set_current_core(g_doorbell)) {
+        multicore_doorbell_clear_current_core(g_doorbell);
+    }
 }
 
-inline bool unpack_fifo_message(uint32_t word, uint8_t& handle) {
-    if ((word >> 8) != FIFO_MAGIC) {
-        return false;  // Invalid magic
+template<typename Ring>
+bool hand_over(Ring& ring, PoolHandle handle) {
+    // Core 0 only needs waking for the first handle; a drain that races
+    // this check is still followed by the next poll()
+    const bool was_empty = g_core1_ring.is_empty() && g_core1_reliable_ring.is_empty();
+    if (!ring.enqueue(handle)) {
+        g_core1_ring_drops++;
+        return false;
+    }
+    g_core1_sent++;
+
+    if (was_empty) {
+        multicore_doorbell_set_other_core(g_doorbell);
+        g_core1_doorbells++;
     }
-    handle = static_cast<uint8_t>(word & 0xFF);
     return true;
 }
 
@@ -50,12 +66,19 @@ void initialize() {
         return;
     }
     
-    // Nothing special needed - Pico SDK initializes FIFO automatically
-    // Just clear statistics
+    g_core1_ring.clear();
+    g_core1_reliable_ring.clear();
     g_core1_sent = 0;
-    g_core1_fifo_drops = 0;
+    g_core1_ring_drops = 0;
+    g_core1_doorbells = 0;
     g_core0_received = 0;
     g_core0_tx_queue_drops = 0;
+    g_core0_reliable_drops = 0;
+
+    // Rung by Core 1, taken on this core (Core 0)
+    g_doorbell = multicore_doorbell_claim_unused(1u << get_core_num(), true);
+    irq_add_shared_handler(SIO_IRQ_BELL, &doorbell_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(SIO_IRQ_BELL, true);
     
     g_is_initialized = true;
     
@@ -71,59 +94,62 @@ bool send_from_core1(PoolHandle handle, uint8_t length) {
         return false;
     }
     
-    uint32_t word;
-    pack_fifo_message(word, handle);
-    
-    if (multicore_fifo_wready()) {
-        multicore_fifo_push_blocking(word); 
-        g_core1_sent++;
-        return true;
-    } else {
-        g_core1_fifo_drops++;
+    return hand_over(g_core1_ring, handle);
+}
+
+bool send_reliable_from_core1(PoolHandle handle) {
+    if (!g_is_initialized || handle == MessagePoolType::INVALID) {
         return false;
     }
+    return hand_over(g_core1_reliable_ring, handle);
 }
 
-void process_fifo_messages() {
+void process_core1_messages() {
     if (!g_is_initialized) {
         return;
     }
     
-    while (multicore_fifo_rvalid()) {
-        uint32_t word = multicore_fifo_pop_blocking();
-                       
-        uint8_t handle;
-        if (!unpack_fifo_message(word, handle)) {
-            printf("Multicore FIFO: Invalid magic (0x%08X)\n", word);
-            continue;
-        }
-        
+    g_core1_ring.drain([](PoolHandle handle) {
         if (!messages::g_message_pool.is_valid(handle)) {
-            printf("Multicore FIFO: Invalid handle %u\n", handle);
-            continue;
+            printf("Multicore: Invalid handle %u\n", handle);
+            return;
         }
         
+        // A refused handle has already been released by the TX queue
         if (internal_tx::enqueue_message_on_core0(handle)) {
             g_core0_received++;
         } else {
-            messages::g_message_pool.release(handle);
             g_core0_tx_queue_drops++;
             printf("Multicore: Core 0 TX queue full, dropping message\n");
         }
+    });
+
+    // Left in the ring, in order, until the reliable backlog has room
+    PoolHandle handle;
+    while (internal_reliable::is_tx_ready() && g_core1_reliable_ring.peek(handle)) {
+        g_core1_reliable_ring.dequeue(handle);
+        if (internal_reliable::send(handle)) {
+            g_core0_received++;
+        } else {
+            g_core0_reliable_drops++;
+            printf("Multicore: Reliable message from Core 1 rejected\n");
+        }
     }
 }
 
 Statistics get_statistics() {
     return Statistics{
         g_core1_sent,
-        g_core1_fifo_drops,
+        g_core1_ring_drops,
+        g_core1_doorbells,
         g_core0_received,
-        g_core0_tx_queue_drops
+        g_core0_tx_queue_drops,
+        g_core0_reliable_drops
     };
 }
 
 bool is_core1_ready() {
-    return multicore_fifo_wready();
+    return !g_core1_ring.is_full();
 }
 
 } // namespace internal_multicore
@@ -0,0 +1,490 @@
+#include "internal/uart_reliable.h"
+#include "internal/uart_tx.h"
+#include "util/misc.h"
+#include "pico/stdlib.h"
+#include "pico/rand.h"
+#include "pico/printf.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ftl {
+namespace messages {
+    extern MessagePoolType g_message_pool;
+}
+
+namespace uart {
+namespace internal_reliable {
+
+namespace {
+
+constexpr size_t WINDOW = ftl_config::RELIABLE_WINDOW;
+constexpr size_t BACKLOG = ftl_config::RELIABLE_BACKLOG;
+constexpr size_t HEADER_SIZE = ftl_config::RELIABLE_HEADER_SIZE;
+
+// Header fields, from the start of the payload
+constexpr size_t FLAGS = 1;
+constexpr size_t EPOCH = 2;       // 2 bytes, big-endian
+constexpr size_t SEQ = 4;
+constexpr size_t BASE = 5;
+constexpr size_t ACK = 6;
+constexpr size_t SACK = 7;
+
+struct TxEntry {
+    PoolHandle handle = MessagePoolType::INVALID;   // Held until acknowledged
+    uint64_t sent_us = 0;
+    uint8_t transmissions = 0;
+    uint8_t tx_class = 0;       // Framing overwrites it in the slot
+};
+
+uint8_t g_source_id = 0;
+
+// Sender: sequence numbers base..next-1 are in flight, each in
+// g_tx_window[seq % WINDOW]
+uint16_t g_epoch = 0;
+uint8_t g_snd_base = 0;
+uint8_t g_snd_next = 0;
+TxEntry g_tx_window[WINDOW];
+
+// Messages accepted while the window was full, oldest at g_backlog_head;
+// they take sequence numbers only once they enter the window
+PoolHandle g_backlog[BACKLOG];
+uint8_t g_backlog_head = 0;
+uint8_t g_backlog_count = 0;
+
+// Retransmit timeout (RFC 6298): smoothed RTT and its variation, sampled
+// only from messages sent once (Karn), backed off while samples are missing
+uint32_t g_srtt_us = 0;
+uint32_t g_rttvar_us = 0;
+uint32_t g_rto_us = ftl_config::RELIABLE_RTO_INITIAL_US;
+bool g_rtt_valid = false;
+
+// Receiver: rcv_next is the next message to deliver; later ones within the
+// window wait in g_rx_window[seq % WINDOW]
+bool g_rcv_synced = false;
+uint16_t g_rcv_epoch = 0;
+uint8_t g_rcv_next = 0;
+PoolHandle g_rx_window[WINDOW];
+bool g_ack_pending = false;
+uint64_t g_ack_due_us = 0;
+
+// Statistics
+uint32_t g_messages_sent = 0;
+uint32_t g_retransmits = 0;
+uint32_t g_messages_acked = 0;
+uint32_t g_messages_failed = 0;
+uint32_t g_messages_delivered = 0;
+uint32_t g_duplicates = 0;
+uint32_t g_out_of_order = 0;
+
+static_assert(256 % WINDOW == 0, "Window slots must stay put across sequence wrap");
+
+// Steps from `from` forward to `to` in 8-bit sequence space
+uint8_t seq_distance(uint8_t from, uint8_t to) {
+    return static_cast<uint8_t>(to - from);
+}
+
+// Bit i set when message rcv_next + 1 + i is waiting out of order
+uint8_t selective_acks() {
+    uint8_t sack = 0;
+    for (size_t i = 0; i + 1 < WINDOW; ++i) {
+        if (g_rx_window[(g_rcv_next + 1 + i) % WINDOW] != MessagePoolType::INVALID) {
+            sack |= 1u << i;
+        }
+    }
+    return sack;
+}
+
+// Fills in the header at the front of the payload with the current ACK state
+void write_header(uint8_t* slot, uint8_t flags, uint8_t seq) {
+    uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    payload[0] = ftl_config::RELIABLE_MESSAGE_TYPE;
+    payload[EPOCH] = static_cast<uint8_t>(g_epoch >> 8);
+    payload[EPOCH + 1] = static_cast<uint8_t>(g_epoch);
+    payload[SEQ] = seq;
+    payload[BASE] = g_snd_base;
+    if (g_rcv_synced) {
+        flags |= ftl_config::RELIABLE_FLAG_ACK;
+        payload[ACK] = static_cast<uint8_t>(g_rcv_next - 1);
+        payload[SACK] = selective_acks();
+        g_ack_pending = false;
+    }
+    payload[FLAGS] = flags;
+}
+
+void schedule_ack(uint64_t now, bool immediate) {
+    if (!g_ack_pending) {
+        g_ack_pending = true;
+        g_ack_due_us = now + ftl_config::RELIABLE_ACK_DELAY_US;
+    }
+    if (immediate) {
+        g_ack_due_us = now;
+    }
+}
+
+// Queues the message with sequence number `seq` for (re)transmission. The
+// window keeps its own reference, so the slot survives the TX completion.
+void transmit(uint8_t seq, uint64_t now) {
+    TxEntry& entry = g_tx_window[seq % WINDOW];
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(entry.handle);
+
+    // A slot that has been on the wire holds a finished frame
+    if (entry.transmissions > 0) {
+        internal_tx::restore_payload_in_place(slot);
+        slot[ftl_config::SLOT_TX_CLASS_OFFSET] = entry.tx_class;
+    }
+    write_header(slot, ftl_config::RELIABLE_FLAG_DATA, seq);
+    entry.sent_us = now;
+    entry.transmissions++;
+
+    // A failed enqueue drops only the extra reference; the timer retries
+    if (messages::g_message_pool.add_ref(entry.handle)) {
+        internal_tx::enqueue_message_on_core0(entry.handle);
+    }
+}
+
+void send_ack(uint64_t now) {
+    PoolHandle handle = messages::g_message_pool.acquire(ftl_config::slot_size_for(HEADER_SIZE));
+    if (handle == MessagePoolType::INVALID) {
+        return;     // Still pending, try again next poll
+    }
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    slot[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(ftl_config::TxClass::Control);
+    slot[ftl_config::SLOT_LENGTH_OFFSET] = HEADER_SIZE;
+    slot[ftl_config::SLOT_SOURCE_OFFSET] = g_source_id;
+    write_header(slot, 0, g_snd_next);
+
+    if (!internal_tx::enqueue_message_on_core0(handle)) {
+        schedule_ack(now, true);
+    }
+}
+
+void update_rto(uint32_t sample_us) {
+    if (!g_rtt_valid) {
+        g_srtt_us = sample_us;
+        g_rttvar_us = sample_us / 2;
+        g_rtt_valid = true;
+    } else {
+        const uint32_t deviation = g_srtt_us > sample_us ? g_srtt_us - sample_us : sample_us - g_srtt_us;
+        g_rttvar_us = (3 * g_rttvar_us + deviation) / 4;
+        g_srtt_us = (7 * g_srtt_us + sample_us) / 8;
+    }
+    g_rto_us = std::clamp(g_srtt_us + 4 * g_rttvar_us, ftl_config::RELIABLE_RTO_MIN_US,
+                          ftl_config::RELIABLE_RTO_MAX_US);
+}
+
+// Frees an acknowledged (or abandoned) message's slot
+void retire(TxEntry& entry) {
+    messages::g_message_pool.release(entry.handle);
+    entry = TxEntry{};
+}
+
+void acknowledge(uint8_t seq, uint64_t now) {
+    TxEntry& entry = g_tx_window[seq % WINDOW];
+    if (entry.handle == MessagePoolType::INVALID) {
+        return;
+    }
+    if (entry.transmissions == 1) {
+        update_rto(static_cast<uint32_t>(now - entry.sent_us));
+    }
+    g_messages_acked++;
+    retire(entry);
+}
+
+void advance_base() {
+    while (g_snd_base != g_snd_next && g_tx_window[g_snd_base % WINDOW].handle == MessagePoolType::INVALID) {
+        g_snd_base++;
+    }
+}
+
+// Cumulative ACK up to `ack`, then the SACK bits above it. A hole under a
+// SACKed message is resent at once rather than after the timeout, at most
+// once per round trip.
+void on_ack(uint8_t ack, uint8_t sack, uint64_t now) {
+    const uint8_t in_flight = seq_distance(g_snd_base, g_snd_next);
+    const uint8_t covered = seq_distance(g_snd_base, static_cast<uint8_t>(ack + 1));
+    if (covered <= in_flight) {
+        for (uint8_t i = 0; i < covered; ++i) {
+            acknowledge(static_cast<uint8_t>(g_snd_base + i), now);
+        }
+    }
+
+    bool hole = false;
+    for (uint8_t i = 0; i < 8; ++i) {
+        const uint8_t seq = static_cast<uint8_t>(ack + 2 + i);
+        if ((sack & (1u << i)) && seq_distance(g_snd_base, seq) < in_flight) {
+            acknowledge(seq, now);
+            hole = true;
+        }
+    }
+    advance_base();
+
+    const uint8_t missing = static_cast<uint8_t>(ack + 1);
+    if (hole && seq_distance(g_snd_base, missing) < seq_distance(g_snd_base, g_snd_next)) {
+        TxEntry& entry = g_tx_window[missing % WINDOW];
+        const uint32_t guard_us = g_rtt_valid ? g_srtt_us : ftl_config::RELIABLE_RTO_MIN_US;
+        if (entry.handle != MessagePoolType::INVALID && now - entry.sent_us >= guard_us &&
+            messages::g_message_pool.get_ref_count(entry.handle) == 1) {
+            g_retransmits++;
+            transmit(missing, now);
+        }
+    }
+}
+
+// Strips the header so the slot reads like any received message
+void strip_header(uint8_t* slot) {
+    uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const uint8_t length = slot[ftl_config::SLOT_LENGTH_OFFSET] - HEADER_SIZE;
+    std::memmove(payload, payload + HEADER_SIZE, length);
+    slot[ftl_config::SLOT_LENGTH_OFFSET] = length;
+
+    const uint16_t crc = crc16::calculate(payload, length);
+    payload[length] = (crc >> 8) & 0xFF;
+    payload[length + 1] = crc & 0xFF;
+}
+
+bool window_full() {
+    return seq_distance(g_snd_base, g_snd_next) >= WINDOW;
+}
+
+// Numbers a prepared message and sends it for the first time
+void start(PoolHandle handle) {
+    const uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    const uint8_t seq = g_snd_next++;
+    g_tx_window[seq % WINDOW] = TxEntry{handle, 0, 0, slot[ftl_config::SLOT_TX_CLASS_OFFSET]};
+    transmit(seq, time_us_64());
+}
+
+// Moves backlogged messages into the window as it opens
+void start_backlog() {
+    while (g_backlog_count > 0 && !window_full()) {
+        start(g_backlog[g_backlog_head]);
+        g_backlog_head = static_cast<uint8_t>((g_backlog_head + 1) % BACKLOG);
+        g_backlog_count--;
+    }
+}
+
+void deliver_in_order(Deliver deliver) {
+    for (;;) {
+        PoolHandle& next = g_rx_window[g_rcv_next % WINDOW];
+        if (next == MessagePoolType::INVALID) {
+            return;
+        }
+        deliver(next);
+        next = MessagePoolType::INVALID;
+        g_messages_delivered++;
+        g_rcv_next++;
+    }
+}
+
+// The sender will never resend anything before `base`: stop waiting for it
+void advance_to(uint8_t base, Deliver deliver) {
+    const uint8_t skipped = seq_distance(g_rcv_next, base);
+    if (skipped >= 128) {
+        return;     // Stale base from a reordered or repeated frame
+    }
+    for (uint8_t i = 0; i < skipped; ++i) {
+        PoolHandle& waiting = g_rx_window[g_rcv_next % WINDOW];
+        if (waiting != MessagePoolType::INVALID) {
+            deliver(waiting);
+            waiting = MessagePoolType::INVALID;
+            g_messages_delivered++;
+        }
+        g_rcv_next++;
+    }
+    deliver_in_order(deliver);
+}
+
+} // anonymous namespace
+
+void initialize(uint8_t source_id) {
+    g_source_id = source_id;
+
+    // A fresh epoch tells the other end to drop whatever it expected from
+    // before a restart
+    g_epoch = static_cast<uint16_t>(get_rand_32());
+    g_snd_base = 0;
+    g_snd_next = 0;
+    for (auto& entry : g_tx_window) {
+        entry = TxEntry{};
+    }
+    g_backlog_head = 0;
+    g_backlog_count = 0;
+    g_srtt_us = 0;
+    g_rttvar_us = 0;
+    g_rto_us = ftl_config::RELIABLE_RTO_INITIAL_US;
+    g_rtt_valid = false;
+
+    g_rcv_synced = false;
+    g_rcv_next = 0;
+    for (auto& handle : g_rx_window) {
+        handle = MessagePoolType::INVALID;
+    }
+    g_ack_pending = false;
+
+    g_messages_sent = 0;
+    g_retransmits = 0;
+    g_messages_acked = 0;
+    g_messages_failed = 0;
+    g_messages_delivered = 0;
+    g_duplicates = 0;
+    g_out_of_order = 0;
+}
+
+bool send(PoolHandle handle) {
+    const uint8_t* queued = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    const uint8_t length = queued ? queued[ftl_config::SLOT_LENGTH_OFFSET] : 0;
+    if (length == 0 || length > ftl_config::RELIABLE_MAX_PAYLOAD || !is_tx_ready()) {
+        messages::g_message_pool.release(handle);
+        return false;
+    }
+
+    // The header goes in front of the payload, which may need a larger slot
+    const PoolHandle grown = internal_tx::grow_slot(handle, ftl_config::slot_size_for(length + HEADER_SIZE));
+    if (grown == MessagePoolType::INVALID) {
+        messages::g_message_pool.release(handle);
+        return false;
+    }
+    handle = grown;
+
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    if (!slot) {
+        messages::g_message_pool.release(handle);
+        return false;
+    }
+    uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    std::memmove(payload + HEADER_SIZE, payload, length);
+    slot[ftl_config::SLOT_LENGTH_OFFSET] = static_cast<uint8_t>(length + HEADER_SIZE);
+
+    g_messages_sent++;
+    if (g_backlog_count > 0 || window_full()) {
+        // Behind earlier messages, so the order is kept
+        g_backlog[(g_backlog_head + g_backlog_count) % BACKLOG] = handle;
+        g_backlog_count++;
+    } else {
+        start(handle);
+    }
+    return true;
+}
+
+bool is_tx_ready() {
+    return g_backlog_count < BACKLOG;
+}
+
+void process() {
+    const uint64_t now = time_us_64();
+
+    // Timeouts: resend, or give up and move the window past the message.
+    // Slots still queued or on the wire wait for their TX completion.
+    bool backed_off = false;
+    bool gave_up = false;
+    for (uint8_t seq = g_snd_base; seq != g_snd_next; ++seq) {
+        TxEntry& entry = g_tx_window[seq % WINDOW];
+        if (entry.handle == MessagePoolType::INVALID ||
+            messages::g_message_pool.get_ref_count(entry.handle) > 1 ||
+            now - entry.sent_us < g_rto_us) {
+            continue;
+        }
+
+        if (entry.transmissions > ftl_config::RELIABLE_MAX_RETRIES) {
+            printf("Reliable message %u dropped after %u attempts\n", seq, entry.transmissions);
+            retire(entry);
+            g_messages_failed++;
+            gave_up = true;
+            continue;
+        }
+        if (!backed_off) {
+            g_rto_us = std::min(2 * g_rto_us, ftl_config::RELIABLE_RTO_MAX_US);
+            backed_off = true;
+        }
+        g_retransmits++;
+        transmit(seq, now);
+    }
+
+    if (gave_up) {
+        advance_base();
+        // Carry the new base to the receiver now, so it stops waiting
+        schedule_ack(now, true);
+    }
+    start_backlog();
+
+    if (g_ack_pending && now >= g_ack_due_us) {
+        send_ack(now);
+    }
+}
+
+bool accept(PoolHandle handle, Deliver deliver) {
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    const uint8_t length = slot[ftl_config::SLOT_LENGTH_OFFSET];
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    if (length < HEADER_SIZE || payload[0] != ftl_config::RELIABLE_MESSAGE_TYPE) {
+        return false;
+    }
+
+    const uint8_t flags = payload[FLAGS];
+    const uint8_t seq = payload[SEQ];
+    const uint64_t now = time_us_64();
+
+    if (flags & ftl_config::RELIABLE_FLAG_ACK) {
+        on_ack(payload[ACK], payload[SACK], now);
+    }
+
+    const uint16_t epoch = static_cast<uint16_t>((payload[EPOCH] << 8) | payload[EPOCH + 1]);
+    if (!g_rcv_synced || epoch != g_rcv_epoch) {
+        // First frame from this sender, or it restarted: deliver what was
+        // waiting from before and start at its window
+        if (g_rcv_synced) {
+            advance_to(static_cast<uint8_t>(g_rcv_next + WINDOW), deliver);
+        }
+        g_rcv_synced = true;
+        g_rcv_epoch = epoch;
+        g_rcv_next = payload[BASE];
+    } else {
+        advance_to(payload[BASE], deliver);
+    }
+
+    if (!(flags & ftl_config::RELIABLE_FLAG_DATA) || length == HEADER_SIZE) {
+        messages::g_message_pool.release(handle);
+        return true;
+    }
+
+    const uint8_t offset = seq_distance(g_rcv_next, seq);
+    PoolHandle& waiting = g_rx_window[seq % WINDOW];
+    if (offset >= WINDOW || waiting != MessagePoolType::INVALID) {
+        // Already delivered or buffered (our ACK was lost), or beyond the
+        // window: drop it and tell the sender where we are
+        g_duplicates++;
+        messages::g_message_pool.release(handle);
+        schedule_ack(now, true);
+        return true;
+    }
+
+    strip_header(slot);
+    waiting = handle;
+    if (offset == 0) {
+        deliver_in_order(deliver);
+        schedule_ack(now, selective_acks() != 0);
+    } else {
+        // A gap: ACK straight away so the SACK triggers a fast retransmit
+        g_out_of_order++;
+        schedule_ack(now, true);
+    }
+    return true;
+}
+
+Statistics get_statistics() {
+    return Statistics{
+        g_messages_sent,
+        g_retransmits,
+        g_messages_acked,
+        g_messages_failed,
+        g_messages_delivered,
+        g_duplicates,
+        g_out_of_order,
+        g_srtt_us,
+        g_rto_us
+    };
+}
+
+} // namespace internal_reliable
+} // namespace uart
+} // namespace ftl
@@ -1,7 +1,12 @@
 #include "internal/uart_rx.h"
 #include "internal/uart_dma.h"
+#include "internal/uart_bulk.h"
+#include "internal/uart_credit.h"
+#include "internal/uart_link.h"
+#include "internal/uart_reliable.h"
 #include "core/ftl_api.h"
 #include "util/allocator.h"
+#include "util/cobs.h"
 #include "util/cqueue.h"
 #include "util/misc.h"
 #include <cstring>
@@ -19,248 +24,333 @@ namespace internal_rx {
 
 namespace {
 
-constexpr size_t READ_CHUNK_SIZE = 64;
-constexpr size_t MSG_LENGTH_OFFSET = 0;
-constexpr size_t MSG_SOURCE_OFFSET = 1;
-constexpr size_t MSG_PAYLOAD_OFFSET = 2;
-
-enum class State {
-    WAIT_START_1,
-    WAIT_START_2,
-    READ_LENGTH,
-    READ_SOURCE,
-    READ_PAYLOAD,
-    READ_CRC_HIGH,
-    READ_CRC_LOW,
-    WAIT_END_1,
-    WAIT_END_2
-};
+constexpr uint8_t START_HIGH = (ftl_config::START_DELIMITER >> 8) & 0xFF;
+constexpr uint8_t START_LOW = ftl_config::START_DELIMITER & 0xFF;
+constexpr uint8_t END_HIGH = (ftl_config::END_DELIMITER >> 8) & 0xFF;
+constexpr uint8_t END_LOW = ftl_config::END_DELIMITER & 0xFF;
+
+// Wire frames and pool slots share one layout, so a frame is copied as is
+constexpr size_t HEADER_SIZE = ftl_config::SLOT_PAYLOAD_OFFSET;
+constexpr size_t TRAILER_SIZE = ftl_config::SLOT_TRAILER_SIZE;
 
 CircularQueue<PoolHandle, ftl_config::MESSAGE_QUEUE_DEPTH, false> g_handle_queue;
 
-State g_rx_state = State::WAIT_START_1;
-PoolHandle g_current_rx_handle = MessagePoolType::INVALID;
-uint8_t g_expected_length = 0;
-uint8_t g_bytes_received = 0;
-uint16_t g_received_crc = 0;
+// Batch frame being handed out one message at a time by get_message()
+PoolHandle g_batch_handle = MessagePoolType::INVALID;
+size_t g_batch_cursor = 0;
 
 uint32_t g_total_bytes_received = 0;
 uint32_t g_total_messages_received = 0;
 uint32_t g_crc_errors = 0;
 uint32_t g_framing_errors = 0;
+uint32_t g_overflow_drops = 0;
+uint32_t g_batch_frames = 0;
+uint32_t g_batched_messages = 0;
 
-uint8_t* get_rx_buffer_ptr() {
-    if (g_current_rx_handle == MessagePoolType::INVALID) {
-        return nullptr;
-    }
-    return messages::g_message_pool.get_ptr<uint8_t>(g_current_rx_handle);
+void consume(ftl_internal::DmaController& dma_controller, size_t length) {
+    dma_controller.rx_consume(length);
+    g_total_bytes_received += length;
 }
 
-void reset_state() {
-    if (g_current_rx_handle != MessagePoolType::INVALID) {
-        messages::g_message_pool.release(g_current_rx_handle);
-        g_current_rx_handle = MessagePoolType::INVALID;
+// Drops bytes up to the next candidate start delimiter; false if none yet
+bool seek_start(ftl_internal::DmaController& dma_controller) {
+    for (;;) {
+        const auto chunk = dma_controller.rx_contiguous();
+        if (chunk.empty()) {
+            return false;
+        }
+
+        const void* hit = std::memchr(chunk.data(), START_HIGH, chunk.size());
+        if (hit) {
+            consume(dma_controller, static_cast<const uint8_t*>(hit) - chunk.data());
+            return true;
+        }
+        consume(dma_controller, chunk.size());
     }
-    g_rx_state = State::WAIT_START_1;
-    g_expected_length = 0;
-    g_bytes_received = 0;
-    g_received_crc = 0;
 }
 
-bool validate_and_enqueue_message() {
-    uint8_t* ptr = get_rx_buffer_ptr();
-    if (!ptr) {
-        reset_state();
-        return false;
-    }
-    
-    uint8_t payload_length = ptr[MSG_LENGTH_OFFSET];
-    uint16_t calculated_crc = crc16::calculate(&ptr[MSG_PAYLOAD_OFFSET], payload_length);
-    
-    if (calculated_crc != g_received_crc) {
-        printf("CRC error: expected 0x%04X, got 0x%04X", calculated_crc, g_received_crc);
-        g_crc_errors++;
-        reset_state();
-        return false;
-    }
-    
-    ptr[MSG_PAYLOAD_OFFSET + payload_length] = (g_received_crc >> 8) & 0xFF;
-    ptr[MSG_PAYLOAD_OFFSET + payload_length + 1] = g_received_crc & 0xFF;
-    
-    if (!g_handle_queue.enqueue(g_current_rx_handle)) {
+void push_message(PoolHandle handle) {
+    if (!g_handle_queue.enqueue(handle)) {
         PoolHandle old_handle;
         if (g_handle_queue.dequeue(old_handle)) {
             messages::g_message_pool.release(old_handle);
+            g_overflow_drops++;
         }
         
-        if (!g_handle_queue.enqueue(g_current_rx_handle)) {
+        if (!g_handle_queue.enqueue(handle)) {
             printf("Failed to enqueue message");
-            reset_state();
-            return false;
+            messages::g_message_pool.release(handle);
+            g_overflow_drops++;
+            return;
         }
     }
     
     g_total_messages_received++;
-    
-    g_current_rx_handle = MessagePoolType::INVALID;
-    g_rx_state = State::WAIT_START_1;
-    g_expected_length = 0;
-    g_bytes_received = 0;
-    g_received_crc = 0;
-    
-    return true;
 }
 
-void process_byte(uint8_t byte) {
-    switch (g_rx_state) {
-        case State::WAIT_START_1:
-            if (byte == ((ftl_config::START_DELIMITER >> 8) & 0xFF)) {
-                g_rx_state = State::WAIT_START_2;
-            }
-            break;
-            
-        case State::WAIT_START_2:
-            if (byte == (ftl_config::START_DELIMITER & 0xFF)) {
-                g_current_rx_handle = messages::g_message_pool.acquire();
-                if (g_current_rx_handle == MessagePoolType::INVALID) {
-                    printf("Pool exhausted - cannot start message");
-                    g_rx_state = State::WAIT_START_1;
-                } else {
-                    g_rx_state = State::READ_LENGTH;
-                }
-            } else if (byte == ((ftl_config::START_DELIMITER >> 8) & 0xFF)) {
-                g_rx_state = State::WAIT_START_2;
-            } else {
-                g_rx_state = State::WAIT_START_1;
-            }
-            break;
-            
-        case State::READ_LENGTH:
-            if (byte == 0 || byte > ftl_config::MAX_PAYLOAD_SIZE) {
-                printf("Invalid length: %d", byte);
-                g_framing_errors++;
-                reset_state();
-            } else {
-                g_expected_length = byte;
-                uint8_t* ptr = get_rx_buffer_ptr();
-                if (ptr) {
-                    ptr[MSG_LENGTH_OFFSET] = byte;
-                    g_rx_state = State::READ_SOURCE;
-                } else {
-                    reset_state();
-                }
-            }
-            break;
-            
-        case State::READ_SOURCE:
-            {
-                uint8_t* ptr = get_rx_buffer_ptr();
-                if (ptr) {
-                    ptr[MSG_SOURCE_OFFSET] = byte;
-                    g_bytes_received = 0;
-                    g_rx_state = State::READ_PAYLOAD;
-                } else {
-                    reset_state();
-                }
-            }
-            break;
-            
-        case State::READ_PAYLOAD:
-            {
-                uint8_t* ptr = get_rx_buffer_ptr();
-                if (ptr) {
-                    ptr[MSG_PAYLOAD_OFFSET + g_bytes_received] = byte;
-                    g_bytes_received++;
-                    
-                    if (g_bytes_received >= g_expected_length) {
-                        g_rx_state = State::READ_CRC_HIGH;
-                    }
-                } else {
-                    reset_state();
-                }
-            }
-            break;
-            
-        case State::READ_CRC_HIGH:
-            g_received_crc = static_cast<uint16_t>(byte) << 8;
-            g_rx_state = State::READ_CRC_LOW;
-            break;
-            
-        case State::READ_CRC_LOW:
-            g_received_crc |= byte;
-            g_rx_state = State::WAIT_END_1;
-            break;
-            
-        case State::WAIT_END_1:
-            if (byte == ((ftl_config::END_DELIMITER >> 8) & 0xFF)) {
-                g_rx_state = State::WAIT_END_2;
-            } else {
-                printf("Expected 0xDE, got 0x%02X", byte);
-                g_framing_errors++;
-                reset_state();
-            }
-            break;
-            
-        case State::WAIT_END_2:
-            if (byte == (ftl_config::END_DELIMITER & 0xFF)) {
-                validate_and_enqueue_message();
-            } else {
-                printf("Expected 0xFA, got 0x%02X", byte);
+void enqueue_message(PoolHandle handle) {
+    // Link frames drive rate negotiation and, like credit frames, are not
+    // counted against this end's credit; every other frame is. Bulk fragments
+    // go to reassembly instead of the queue, and reliable frames through the
+    // receive window, which pushes them in order.
+    if (internal_link::accept(handle) || internal_credit::accept(handle) || internal_bulk::accept_fragment(handle) ||
+        internal_reliable::accept(handle, &push_message)) {
+        return;
+    }
+    push_message(handle);
+}
+
+// Copies the complete frame at the read index into a pool slot and checks it.
+// Returns the number of bytes to consume.
+size_t take_frame(ftl_internal::DmaController& dma_controller, uint8_t payload_length) {
+    const size_t frame_size = HEADER_SIZE + payload_length + TRAILER_SIZE;
+
+    // The length byte picks the smallest slot class that holds the frame
+    PoolHandle handle = messages::g_message_pool.acquire(frame_size);
+    if (handle == MessagePoolType::INVALID) {
+        printf("Pool exhausted - dropping message");
+        g_overflow_drops++;
+        return frame_size;
+    }
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+
+    dma_controller.rx_copy(0, slot, frame_size);
+
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const uint16_t received_crc = (static_cast<uint16_t>(payload[payload_length]) << 8) | payload[payload_length + 1];
+    const uint16_t calculated_crc = dma_controller.crc_engine().calculate(payload, payload_length);
+
+    if (calculated_crc != received_crc) {
+        printf("CRC error: expected 0x%04X, got 0x%04X", calculated_crc, received_crc);
+        g_crc_errors++;
+        messages::g_message_pool.release(handle);
+        return frame_size;
+    }
+
+    enqueue_message(handle);
+    return frame_size;
+}
+
+// Frame scanner: memchr to the start delimiter, validate the header and end
+// delimiter in place, then move the whole frame into a slot in one copy.
+// Incomplete frames stay in the ring until the next poll.
+void process_delimited(ftl_internal::DmaController& dma_controller) {
+    while (seek_start(dma_controller)) {
+        const size_t available = dma_controller.get_bytes_available();
+        if (available < 2) {
+            return;
+        }
+        if (dma_controller.rx_peek(1) != START_LOW) {
+            consume(dma_controller, 1);
+            continue;
+        }
+
+        if (available < HEADER_SIZE) {
+            return;
+        }
+        const uint8_t payload_length = dma_controller.rx_peek(ftl_config::SLOT_LENGTH_OFFSET);
+        if (payload_length == 0 || payload_length > ftl_config::MAX_PAYLOAD_SIZE) {
+            printf("Invalid length: %d", payload_length);
+            g_framing_errors++;
+            consume(dma_controller, 1);
+            continue;
+        }
+
+        const size_t frame_size = HEADER_SIZE + payload_length + TRAILER_SIZE;
+        if (available < frame_size) {
+            return;
+        }
+        if (dma_controller.rx_peek(frame_size - 2) != END_HIGH ||
+            dma_controller.rx_peek(frame_size - 1) != END_LOW) {
+            printf("Missing end delimiter");
+            g_framing_errors++;
+            consume(dma_controller, 1);
+            continue;
+        }
+
+        consume(dma_controller, take_frame(dma_controller, payload_length));
+    }
+}
+
+// Copies one COBS frame (delimiter stripped) into a slot, decodes it in place
+// and checks it. The caller consumes the frame and its delimiter either way.
+void take_cobs_frame(ftl_internal::DmaController& dma_controller, size_t encoded_length) {
+    const size_t payload_length = encoded_length - ftl_config::COBS_MIN_FRAME_SIZE + 1;
+
+    PoolHandle handle = messages::g_message_pool.acquire(ftl_config::slot_size_for(payload_length));
+    if (handle == MessagePoolType::INVALID) {
+        printf("Pool exhausted - dropping message");
+        g_overflow_drops++;
+        return;
+    }
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+
+    // Decoding leaves length, source, payload and CRC at the usual slot offsets
+    dma_controller.rx_copy(0, &slot[ftl_config::SLOT_COBS_OFFSET], encoded_length);
+
+    if (!cobs::decode_in_place(&slot[ftl_config::SLOT_COBS_OFFSET], encoded_length) ||
+        slot[ftl_config::SLOT_LENGTH_OFFSET] != payload_length) {
+        printf("Invalid COBS frame");
+        g_framing_errors++;
+        messages::g_message_pool.release(handle);
+        return;
+    }
+
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const uint16_t received_crc = (static_cast<uint16_t>(payload[payload_length]) << 8) | payload[payload_length + 1];
+    const uint16_t calculated_crc = dma_controller.crc_engine().calculate(payload, payload_length);
+
+    if (calculated_crc != received_crc) {
+        printf("CRC error: expected 0x%04X, got 0x%04X", calculated_crc, received_crc);
+        g_crc_errors++;
+        messages::g_message_pool.release(handle);
+        return;
+    }
+
+    enqueue_message(handle);
+}
+
+// COBS scanner: every frame ends at the next zero byte, so each step is one
+// memchr and a frame is taken, or rejected, as a unit. Garbage costs at most
+// the bytes up to the next delimiter. Incomplete frames stay in the ring.
+void process_cobs(ftl_internal::DmaController& dma_controller) {
+    for (;;) {
+        size_t encoded_length = 0;
+        if (!dma_controller.rx_find(cobs::DELIMITER, encoded_length)) {
+            // No delimiter in more than a frame's worth of bytes: none of it
+            // can be the start of a valid frame
+            const size_t available = dma_controller.get_bytes_available();
+            if (available > ftl_config::COBS_MAX_FRAME_SIZE) {
+                printf("Missing COBS delimiter");
                 g_framing_errors++;
-                reset_state();
+                consume(dma_controller, available);
             }
-            break;
+            return;
+        }
+
+        if (encoded_length == 0) {
+            consume(dma_controller, 1);     // Idle delimiter
+            continue;
+        }
+        if (encoded_length < ftl_config::COBS_MIN_FRAME_SIZE || encoded_length > ftl_config::COBS_MAX_FRAME_SIZE) {
+            printf("Invalid COBS length: %d", static_cast<int>(encoded_length));
+            g_framing_errors++;
+        } else {
+            take_cobs_frame(dma_controller, encoded_length);
+        }
+        consume(dma_controller, encoded_length + 1);
     }
 }
 
-void process_data(ftl_internal::DmaController& dma_controller) {
-    uint8_t read_buffer[READ_CHUNK_SIZE];
-    size_t bytes_read = dma_controller.read_from_circular_buffer(
-        std::span<uint8_t>{read_buffer, READ_CHUNK_SIZE}
-    );
-    
-    if (bytes_read == 0) {
-        return;
+// A batch type byte followed by items that exactly fill the payload; anything
+// else is delivered as an ordinary message
+bool is_batch(const uint8_t* slot) {
+    const size_t length = slot[ftl_config::SLOT_LENGTH_OFFSET];
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    if (length < 3 || payload[0] != ftl_config::BATCH_MESSAGE_TYPE) {
+        return false;
     }
-    
-    g_total_bytes_received += bytes_read;
-    
-    for (size_t i = 0; i < bytes_read; i++) {
-        process_byte(read_buffer[i]);
+
+    size_t pos = 1;
+    while (pos < length) {
+        const size_t item_length = payload[pos];
+        if (item_length == 0 || pos + 1 + item_length > length) {
+            return false;
+        }
+        pos += 1 + item_length;
     }
+    return true;
+}
+
+// Copies the next item of the open batch into a slot of its own, laid out
+// like a received frame; releases the batch after its last item
+MessageHandle next_batched_message() {
+    const uint8_t* batch = messages::g_message_pool.get_ptr<uint8_t>(g_batch_handle);
+    const uint8_t* payload = &batch[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const uint8_t item_length = payload[g_batch_cursor];
+    const uint8_t* item = &payload[g_batch_cursor + 1];
+
+    MessageHandle message;
+    PoolHandle handle = messages::g_message_pool.acquire(ftl_config::slot_size_for(item_length));
+    if (handle != MessagePoolType::INVALID) {
+        uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+        slot[ftl_config::SLOT_LENGTH_OFFSET] = item_length;
+        slot[ftl_config::SLOT_SOURCE_OFFSET] = batch[ftl_config::SLOT_SOURCE_OFFSET];
+        std::memcpy(&slot[ftl_config::SLOT_PAYLOAD_OFFSET], item, item_length);
+
+        const uint16_t crc = crc16::calculate(item, item_length);
+        slot[ftl_config::SLOT_PAYLOAD_OFFSET + item_length] = (crc >> 8) & 0xFF;
+        slot[ftl_config::SLOT_PAYLOAD_OFFSET + item_length + 1] = crc & 0xFF;
+
+        message = MessageHandle(MsgHandle<MessagePoolType>(messages::g_message_pool, handle));
+        g_batched_messages++;
+    } else {
+        printf("Pool exhausted - dropping batched message");
+        g_overflow_drops++;
+    }
+
+    g_batch_cursor += 1 + item_length;
+    if (g_batch_cursor >= batch[ftl_config::SLOT_LENGTH_OFFSET]) {
+        messages::g_message_pool.release(g_batch_handle);
+        g_batch_handle = MessagePoolType::INVALID;
+    }
+    return message;
 }
 
 } // anonymous namespace
 
 void initialize() {
-    reset_state();
     g_handle_queue.clear();
     g_total_bytes_received = 0;
     g_total_messages_received = 0;
     g_crc_errors = 0;
     g_framing_errors = 0;
+    g_overflow_drops = 0;
+    g_batch_handle = MessagePoolType::INVALID;
+    g_batch_cursor = 0;
+    g_batch_frames = 0;
+    g_batched_messages = 0;
 }
 
 void process(ftl_internal::DmaController& dma_controller) {
-    process_data(dma_controller);
+    if constexpr (ftl_config::FRAMING == ftl_config::Framing::Cobs) {
+        process_cobs(dma_controller);
+    } else {
+        process_delimited(dma_controller);
+    }
 }
 
 bool has_message() {
-    return !g_handle_queue.is_empty();
+    return g_batch_handle != MessagePoolType::INVALID || !g_handle_queue.is_empty();
 }
 
 MessageHandle get_message() {
-    if (g_handle_queue.is_empty()) {
-        return MessageHandle{};
-    }
-    
-    PoolHandle handle;
-    if (!g_handle_queue.dequeue(handle)) {
-        return MessageHandle{};
+    // Batches stay whole in the queue and are unpacked here, so a frame of
+    // many small messages needs one queue entry and one extra slot at a time
+    for (;;) {
+        if (g_batch_handle != MessagePoolType::INVALID) {
+            MessageHandle message = next_batched_message();
+            if (message) {
+                return message;
+            }
+            continue;
+        }
+
+        PoolHandle handle;
+        if (!g_handle_queue.dequeue(handle)) {
+            return MessageHandle{};
+        }
+
+        if (is_batch(messages::g_message_pool.get_ptr<uint8_t>(handle))) {
+            g_batch_handle = handle;
+            g_batch_cursor = 1;
+            g_batch_frames++;
+            continue;
+        }
+
+        MsgHandle<MessagePoolType> msg_handle(messages::g_message_pool, handle);
+        return MessageHandle(std::move(msg_handle));
     }
-    
-    MsgHandle<MessagePoolType> msg_handle(messages::g_message_pool, handle);
-    return MessageHandle(std::move(msg_handle));
 }
 
 Statistics get_statistics() {
@@ -268,18 +358,15 @@ Statistics get_statistics() {
         g_total_bytes_received,
         g_total_messages_received,
         g_crc_errors,
-        g_framing_errors
+        g_framing_errors,
+        g_overflow_drops,
+        g_batch_frames,
+        g_batched_messages
     };
 }
 
 uint32_t get_pool_allocated_count() {
-    uint32_t count = 0;
-    for (size_t i = 0; i < ftl_config::MESSAGE_POOL_SIZE; i++) {
-        if (messages::g_message_pool.is_valid(static_cast<PoolHandle>(i))) {
-            count++;
-        }
-    }
-    return count;
+    return static_cast<uint32_t>(messages::g_message_pool.get_allocated_count());
 }
 
 uint32_t get_queue_count() {
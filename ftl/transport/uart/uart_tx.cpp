@@ -1,11 +1,17 @@
 #include "internal/uart_tx.h"
 #include "internal/uart_dma.h"
+#include "internal/uart_credit.h"
+#include "internal/uart_link.h"
 #include "core/ftl_api.h"
 #include "util/allocator.h"
+#include "util/cobs.h"
 #include "util/cqueue.h"
 #include "util/misc.h"
 #include "pico/stdlib.h"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <iterator>
 
 namespace ftl {
 namespace messages {
@@ -17,69 +23,284 @@ namespace internal_tx {
 
 namespace {
 
-CircularQueue<PoolHandle, ftl_config::TX_QUEUE_DEPTH, false> g_tx_queue;
-PoolHandle g_current_tx_handle = MessagePoolType::INVALID;
+using ftl_config::TxClass;
+using ftl_config::DropPolicy;
 
+using TxQueue = CircularQueue<PoolHandle, ftl_config::TX_QUEUE_DEPTH, false>;
+
+// One queue per class, indexed by TxClass, served in this order
+TxQueue g_tx_queues[ftl_config::TX_CLASS_COUNT];
+constexpr TxClass SERVICE_ORDER[] = {TxClass::Control, TxClass::Normal, TxClass::Telemetry, TxClass::Stream};
+
+struct ClassCounters {
+    uint32_t queued = 0;
+    uint32_t sent = 0;
+    uint32_t dropped = 0;
+    uint32_t coalesced = 0;
+    uint32_t peak_depth = 0;
+    uint64_t total_latency_us = 0;
+    uint32_t max_latency_us = 0;
+};
+
+ClassCounters g_class_counters[ftl_config::TX_CLASS_COUNT];
+
+// When each slot's message entered its class queue
+uint32_t g_queued_us[ftl_config::MESSAGE_POOL_SIZE];
+
+ftl_internal::DmaController* g_dma_controller = nullptr;
 uint8_t g_source_id = 0;
 
+// Open batch: the first message's own slot, turned into a batch frame in
+// place when a second message joins
+PoolHandle g_batch_handle = MessagePoolType::INVALID;
+size_t g_batch_class = 0;
+uint8_t g_batch_count = 0;
+uint64_t g_batch_opened_us = 0;
+uint32_t g_batch_flush_us = ftl_config::BATCH_FLUSH_US;
+
+// Messages carried by the frame in flight from each slot
+uint8_t g_frame_messages[ftl_config::MESSAGE_POOL_SIZE];
+
 // Statistics
 uint32_t g_total_queued = 0;
-uint32_t g_total_sent = 0;
+std::atomic<uint32_t> g_total_sent{0};     // Bumped from the DMA completion IRQ
 uint32_t g_queue_full_drops = 0;
 uint32_t g_peak_queue_depth = 0;
+uint64_t g_stats_start_us = 0;
+uint32_t g_batch_frames = 0;
+uint32_t g_batched_messages = 0;
+
+static_assert(ftl_config::COBS_MAX_FRAME_SIZE - 1 <= cobs::MAX_BLOCK,
+              "COBS frame must encode as a single block");
+static_assert(std::size(SERVICE_ORDER) == ftl_config::TX_CLASS_COUNT, "Every class must be served");
 
-bool build_frame(PoolHandle handle, uint8_t* frame_buffer, size_t& frame_size) {
-    uint8_t* payload_ptr = messages::g_message_pool.get_ptr<uint8_t>(handle);
-    if (!payload_ptr) {
+// Queue index for the class stored in the slot; unknown values are Normal
+size_t class_of(const uint8_t* slot) {
+    const uint8_t tx_class = slot[ftl_config::SLOT_TX_CLASS_OFFSET];
+    return tx_class < ftl_config::TX_CLASS_COUNT ? tx_class : static_cast<size_t>(TxClass::Normal);
+}
+
+// Swaps `handle` in for a queued message of the same type and source, which
+// is dropped; `handle` keeps that message's place and its queued time.
+// Link-layer frames are never merged.
+bool coalesce(TxQueue& queue, PoolHandle handle, const uint8_t* slot) {
+    const uint8_t type = slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const uint8_t source_id = slot[ftl_config::SLOT_SOURCE_OFFSET];
+    if (type >= ftl_config::LINK_MESSAGE_TYPE_BASE) {
         return false;
     }
-    
-    uint8_t payload_length = payload_ptr[0];
-    
-    if (payload_length > ftl_config::MAX_PAYLOAD_SIZE) {
+
+    PoolHandle* queued = queue.find_if([&](PoolHandle candidate) {
+        const uint8_t* other = messages::g_message_pool.get_ptr<uint8_t>(candidate);
+        return other[ftl_config::SLOT_PAYLOAD_OFFSET] == type && other[ftl_config::SLOT_SOURCE_OFFSET] == source_id;
+    });
+    if (!queued) {
         return false;
     }
-    
-    size_t idx = 0;
-    
-    frame_buffer[idx++] = (ftl_config::START_DELIMITER >> 8) & 0xFF;
-    frame_buffer[idx++] = ftl_config::START_DELIMITER & 0xFF;
-    frame_buffer[idx++] = payload_length;
-    frame_buffer[idx++] = payload_ptr[1];
-    
-    memcpy(&frame_buffer[idx], &payload_ptr[2], payload_length);
-    
-    uint16_t crc = crc16::calculate(&payload_ptr[2], payload_length);
-    idx += payload_length;
-    
-    frame_buffer[idx++] = (crc >> 8) & 0xFF;
-    frame_buffer[idx++] = crc & 0xFF;
-    
-    frame_buffer[idx++] = (ftl_config::END_DELIMITER >> 8) & 0xFF;
-    frame_buffer[idx++] = ftl_config::END_DELIMITER & 0xFF;
-    
-    frame_size = idx;
+    g_queued_us[handle] = g_queued_us[*queued];
+    messages::g_message_pool.release(*queued);
+    *queued = handle;
+    return true;
+}
+
+// Takes the head of a class queue for sending
+PoolHandle take_from(size_t tx_class) {
+    PoolHandle handle = MessagePoolType::INVALID;
+    g_tx_queues[tx_class].dequeue(handle);
+
+    ClassCounters& counters = g_class_counters[tx_class];
+    const uint32_t latency_us = time_us_32() - g_queued_us[handle];
+    counters.sent++;
+    counters.total_latency_us += latency_us;
+    counters.max_latency_us = std::max(counters.max_latency_us, latency_us);
+    return handle;
+}
+
+// Highest class with a message that may go to the descriptor ring now.
+// Lower classes wait while TX_LOW_PRIORITY_IN_FLIGHT frames are pending, so
+// a Control message never has more than that many ahead of it.
+bool next_class(const ftl_internal::DmaController& dma_controller, size_t& tx_class) {
+    for (TxClass candidate : SERVICE_ORDER) {
+        const size_t index = static_cast<size_t>(candidate);
+        if (g_tx_queues[index].is_empty()) {
+            continue;
+        }
+        if (candidate != TxClass::Control &&
+            dma_controller.get_writes_pending() >= ftl_config::TX_LOW_PRIORITY_IN_FLIGHT) {
+            return false;
+        }
+        tx_class = index;
+        return true;
+    }
+    return false;
+}
+
+// Writes the delimiters and CRC around the payload already in the slot
+// headroom (or COBS-encodes it in place); returns the frame, empty if the
+// slot is not sendable
+std::span<const uint8_t> finish_frame_in_place(uint8_t* slot, crc16::Engine& crc_engine) {
+    const uint8_t payload_length = slot[ftl_config::SLOT_LENGTH_OFFSET];
+    if (payload_length == 0 || payload_length > ftl_config::MAX_PAYLOAD_SIZE) {
+        return {};
+    }
+
+    const uint8_t* payload = &slot[ftl_config::SLOT_PAYLOAD_OFFSET];
+    const uint16_t crc = crc_engine.calculate(payload, payload_length);
+
+    uint8_t* trailer = &slot[ftl_config::SLOT_PAYLOAD_OFFSET + payload_length];
+    trailer[0] = (crc >> 8) & 0xFF;
+    trailer[1] = crc & 0xFF;
+
+    if constexpr (ftl_config::FRAMING == ftl_config::Framing::Cobs) {
+        // Length, source, payload and CRC are one block behind the code byte
+        const size_t block_length = ftl_config::LENGTH_SIZE + ftl_config::SOURCE_ID_SIZE + payload_length + ftl_config::CRC_SIZE;
+        uint8_t* frame = &slot[ftl_config::SLOT_COBS_OFFSET];
+        const size_t encoded_length = cobs::encode_in_place(frame, block_length);
+        frame[encoded_length] = cobs::DELIMITER;
+        return {frame, encoded_length + 1};
+    } else {
+        slot[0] = (ftl_config::START_DELIMITER >> 8) & 0xFF;
+        slot[1] = ftl_config::START_DELIMITER & 0xFF;
+        trailer[2] = (ftl_config::END_DELIMITER >> 8) & 0xFF;
+        trailer[3] = ftl_config::END_DELIMITER & 0xFF;
+        return {slot, ftl_config::SLOT_PAYLOAD_OFFSET + payload_length + ftl_config::SLOT_TRAILER_SIZE};
+    }
+}
+
+// TX DMA completion interrupt: the frame has left the slot
+void on_tx_complete(uint8_t handle) {
+    const uint8_t count = g_frame_messages[handle];
+    messages::g_message_pool.release(handle);
+    g_total_sent.fetch_add(count, std::memory_order_relaxed);
+}
+
+// Frames the slot and hands it to the DMA ring; the caller has checked
+// can_queue_write(). The slot is released here if it cannot be sent.
+void send_slot(ftl_internal::DmaController& dma_controller, PoolHandle handle, uint8_t message_count) {
+    uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    if (!slot) {
+        messages::g_message_pool.release(handle);
+        return;
+    }
+    const auto frame = finish_frame_in_place(slot, dma_controller.crc_engine());
+
+    // Set before queue_write(): the completion IRQ reads it
+    g_frame_messages[handle] = message_count;
+    if (frame.empty() || !dma_controller.queue_write(frame.data(), frame.size(), handle)) {
+        messages::g_message_pool.release(handle);
+    }
+}
+
+// Link-layer frames (fragments, other batches) always travel on their own
+bool batch_accepts(const uint8_t* slot) {
+    return slot[ftl_config::SLOT_LENGTH_OFFSET] <= ftl_config::BATCH_MAX_ITEM_SIZE &&
+           slot[ftl_config::SLOT_PAYLOAD_OFFSET] < ftl_config::LINK_MESSAGE_TYPE_BASE;
+}
+
+// Whether a message of `length` bytes still fits in the open batch. The
+// batch starts in its first message's slot, which moves to a full-size one
+// when the next message would not fit.
+bool batch_has_room(uint8_t length) {
+    const uint8_t* batch = messages::g_message_pool.get_ptr<uint8_t>(g_batch_handle);
+    const size_t used = batch[ftl_config::SLOT_LENGTH_OFFSET] + (g_batch_count == 1 ? 2 : 0);
+    const size_t needed = used + 1 + length;
+    if (needed > ftl_config::MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+    if (ftl_config::slot_size_for(needed) <= messages::g_message_pool.capacity(g_batch_handle)) {
+        return true;
+    }
+
+    const PoolHandle grown = grow_slot(g_batch_handle, ftl_config::MAX_MESSAGE_SIZE);
+    if (grown == MessagePoolType::INVALID) {
+        return false;
+    }
+    g_batch_handle = grown;
     return true;
 }
 
+// Adds the message in `slot` to the open batch (or opens one with it).
+// Takes ownership of `handle`.
+void batch_add(PoolHandle handle, uint8_t* slot, size_t tx_class) {
+    if (g_batch_handle == MessagePoolType::INVALID) {
+        g_batch_handle = handle;
+        g_batch_class = tx_class;
+        g_batch_count = 1;
+        g_batch_opened_us = time_us_64();
+        return;
+    }
+
+    uint8_t* batch = messages::g_message_pool.get_ptr<uint8_t>(g_batch_handle);
+    uint8_t* payload = &batch[ftl_config::SLOT_PAYLOAD_OFFSET];
+    uint8_t& batch_length = batch[ftl_config::SLOT_LENGTH_OFFSET];
+
+    if (g_batch_count == 1) {
+        // Second message: prefix the first with the batch type and its length
+        std::memmove(payload + 2, payload, batch_length);
+        payload[0] = ftl_config::BATCH_MESSAGE_TYPE;
+        payload[1] = batch_length;
+        batch_length += 2;
+    }
+
+    const uint8_t length = slot[ftl_config::SLOT_LENGTH_OFFSET];
+    payload[batch_length] = length;
+    std::memcpy(&payload[batch_length + 1], &slot[ftl_config::SLOT_PAYLOAD_OFFSET], length);
+    batch_length += 1 + length;
+    g_batch_count++;
+
+    messages::g_message_pool.release(handle);
+}
+
+// Sends the open batch; a lone message goes out as itself
+void batch_flush(ftl_internal::DmaController& dma_controller) {
+    if (g_batch_count > 1) {
+        g_batch_frames++;
+        g_batched_messages += g_batch_count;
+    }
+    send_slot(dma_controller, g_batch_handle, g_batch_count);
+    g_batch_handle = MessagePoolType::INVALID;
+    g_batch_count = 0;
+}
+
+// The open batch counts as one queued entry until it is sent
+uint32_t pending_count() {
+    uint32_t count = g_batch_handle != MessagePoolType::INVALID ? 1 : 0;
+    for (const auto& queue : g_tx_queues) {
+        count += queue.count();
+    }
+    return count;
+}
+
 } // anonymous namespace
 
-void initialize(uint8_t source_id) {
+void initialize(uint8_t source_id, ftl_internal::DmaController& dma_controller) {
     g_source_id = source_id;
-    g_tx_queue.clear();
-    g_current_tx_handle = MessagePoolType::INVALID;
+    for (auto& queue : g_tx_queues) {
+        queue.clear();
+    }
+    for (auto& counters : g_class_counters) {
+        counters = ClassCounters{};
+    }
     g_total_queued = 0;
-    g_total_sent = 0;
+    g_total_sent.store(0, std::memory_order_relaxed);
     g_queue_full_drops = 0;
     g_peak_queue_depth = 0;
+    g_stats_start_us = time_us_64();
+    g_batch_handle = MessagePoolType::INVALID;
+    g_batch_count = 0;
+    g_batch_frames = 0;
+    g_batched_messages = 0;
+
+    g_dma_controller = &dma_controller;
+    dma_controller.set_tx_complete_callback(&on_tx_complete);
 }
 
-PoolHandle acquire_and_fill_message(std::span<const uint8_t> payload) {
+PoolHandle acquire_and_fill_message(std::span<const uint8_t> payload, TxClass tx_class, size_t reserve) {
     if (payload.empty() || payload.size() > ftl_config::MAX_PAYLOAD_SIZE) {
         return MessagePoolType::INVALID;
     }
 
-    PoolHandle handle = messages::g_message_pool.acquire();
+    PoolHandle handle = messages::g_message_pool.acquire(ftl_config::slot_size_for(payload.size() + reserve));
     if (handle == MessagePoolType::INVALID) {
         return MessagePoolType::INVALID;
     }
@@ -90,70 +311,160 @@ PoolHandle acquire_and_fill_message(std::span<const uint8_t> payload) {
         return MessagePoolType::INVALID;
     }
     
-    buffer[0] = static_cast<uint8_t>(payload.size());
-    buffer[1] = g_source_id;
-    memcpy(&buffer[2], payload.data(), payload.size());
+    buffer[ftl_config::SLOT_TX_CLASS_OFFSET] = static_cast<uint8_t>(tx_class);
+    buffer[ftl_config::SLOT_LENGTH_OFFSET] = static_cast<uint8_t>(payload.size());
+    buffer[ftl_config::SLOT_SOURCE_OFFSET] = g_source_id;
+    memcpy(&buffer[ftl_config::SLOT_PAYLOAD_OFFSET], payload.data(), payload.size());
     
     return handle;
 }
 
+PoolHandle grow_slot(PoolHandle handle, size_t slot_size) {
+    if (messages::g_message_pool.capacity(handle) >= slot_size) {
+        return handle;
+    }
+
+    const PoolHandle grown = messages::g_message_pool.acquire(slot_size);
+    if (grown == MessagePoolType::INVALID) {
+        return MessagePoolType::INVALID;
+    }
+    const uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    uint8_t* target = messages::g_message_pool.get_ptr<uint8_t>(grown);
+    std::memcpy(target, slot, ftl_config::SLOT_PAYLOAD_OFFSET + slot[ftl_config::SLOT_LENGTH_OFFSET]);
+    messages::g_message_pool.release(handle);
+    return grown;
+}
+
 bool enqueue_message_on_core0(PoolHandle handle) {
     if (handle == MessagePoolType::INVALID) {
         return false;
     }
 
-    if (!g_tx_queue.enqueue(handle)) {
+    const uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+    const size_t tx_class = class_of(slot);
+    const DropPolicy policy = ftl_config::TX_DROP_POLICY[tx_class];
+    TxQueue& queue = g_tx_queues[tx_class];
+    ClassCounters& counters = g_class_counters[tx_class];
+
+    if (policy == DropPolicy::CoalesceLatest && coalesce(queue, handle, slot)) {
+        counters.queued++;
+        counters.coalesced++;
+        g_total_queued++;
+        return true;
+    }
+
+    if (queue.is_full() && policy != DropPolicy::DropNewest) {
+        PoolHandle oldest;
+        if (queue.dequeue(oldest)) {
+            messages::g_message_pool.release(oldest);
+            counters.dropped++;
+            g_queue_full_drops++;
+        }
+    }
+
+    g_queued_us[handle] = time_us_32();
+    if (!queue.enqueue(handle)) {
         messages::g_message_pool.release(handle);
+        counters.dropped++;
         g_queue_full_drops++;
         return false;
     }
     
+    counters.queued++;
+    counters.peak_depth = std::max<uint32_t>(counters.peak_depth, queue.count());
     g_total_queued++;
-    uint32_t current_depth = g_tx_queue.count();
-    if (current_depth > g_peak_queue_depth) {
-        g_peak_queue_depth = current_depth;
-    }
+    g_peak_queue_depth = std::max(g_peak_queue_depth, pending_count());
     
     return true;
 }
 
 void process_tx_queue(ftl_internal::DmaController& dma_controller) {
-    if (g_current_tx_handle != MessagePoolType::INVALID) {
-        if (!dma_controller.is_write_busy()) {
-            messages::g_message_pool.release(g_current_tx_handle);
-            g_current_tx_handle = MessagePoolType::INVALID;
-            g_total_sent++;
-        } else {
-            return;
+    // Link frames go ahead of everything, and while the rate is changing
+    // nothing else goes out at all
+    while (dma_controller.can_queue_write()) {
+        const PoolHandle link = internal_link::take_frame();
+        if (link == MessagePoolType::INVALID) {
+            break;
         }
+        send_slot(dma_controller, link, 0);
     }
-    
-    if (g_tx_queue.is_empty()) {
+    if (internal_link::is_tx_paused()) {
         return;
     }
-    
-    PoolHandle handle;
-    if (!g_tx_queue.dequeue(handle)) {
-        return;
+
+    // A due credit update goes first and needs no credit itself, so two ends
+    // that have both run out can never hold each other's updates back
+    if (dma_controller.can_queue_write()) {
+        const PoolHandle update = internal_credit::take_update();
+        if (update != MessagePoolType::INVALID) {
+            send_slot(dma_controller, update, 0);
+        }
     }
-    
-    uint8_t frame_buffer[ftl_config::MAX_MESSAGE_SIZE];
-    size_t frame_size;
-    
-    if (!build_frame(handle, frame_buffer, frame_size)) {
-        messages::g_message_pool.release(handle);
-        return;
+
+    // Frame what the descriptor ring can take, highest class first; the
+    // completion IRQ starts each frame as the previous one finishes and
+    // releases its slot. Small messages collect in the open batch instead,
+    // which holds one class and is sent ahead of any other message of a class
+    // below Control, so the order on the wire is kept within each class.
+    // Every frame takes a credit, and without one everything stays queued.
+    size_t tx_class;
+    while (dma_controller.can_queue_write() && next_class(dma_controller, tx_class)) {
+        PoolHandle handle = MessagePoolType::INVALID;
+        if (!g_tx_queues[tx_class].peek(handle)) {
+            break;
+        }
+        uint8_t* slot = messages::g_message_pool.get_ptr<uint8_t>(handle);
+
+        if constexpr (ftl_config::BATCH_ENABLED) {
+            if (tx_class != static_cast<size_t>(TxClass::Control)) {
+                const bool joins = slot && batch_accepts(slot);
+                if (g_batch_handle != MessagePoolType::INVALID &&
+                    (!joins || g_batch_class != tx_class || !batch_has_room(slot[ftl_config::SLOT_LENGTH_OFFSET]))) {
+                    if (!internal_credit::try_consume()) {
+                        return;
+                    }
+                    batch_flush(dma_controller);
+                    continue;
+                }
+                if (joins) {
+                    handle = take_from(tx_class);
+                    batch_add(handle, slot, tx_class);
+                    continue;
+                }
+            }
+        }
+
+        if (!internal_credit::try_consume()) {
+            return;
+        }
+        send_slot(dma_controller, take_from(tx_class), 1);
     }
-    
-    if (dma_controller.write_data(std::span<const uint8_t>{frame_buffer, frame_size})) {
-        g_current_tx_handle = handle;
-    } else {
-        messages::g_message_pool.release(handle);
+
+    if constexpr (ftl_config::BATCH_ENABLED) {
+        if (g_batch_handle != MessagePoolType::INVALID && dma_controller.can_queue_write() &&
+            dma_controller.get_writes_pending() < ftl_config::TX_LOW_PRIORITY_IN_FLIGHT &&
+            time_us_64() - g_batch_opened_us >= g_batch_flush_us && internal_credit::try_consume()) {
+            batch_flush(dma_controller);
+        }
+    }
+}
+
+void set_batch_flush_us(uint32_t flush_us) {
+    g_batch_flush_us = flush_us;
+}
+
+void restore_payload_in_place(uint8_t* slot) {
+    // Delimited framing never touches the payload; COBS rewrote its zeros,
+    // but not the length byte, which can't be zero
+    if constexpr (ftl_config::FRAMING == ftl_config::Framing::Cobs) {
+        const size_t block_length = ftl_config::LENGTH_SIZE + ftl_config::SOURCE_ID_SIZE +
+                                    slot[ftl_config::SLOT_LENGTH_OFFSET] + ftl_config::CRC_SIZE;
+        cobs::decode_in_place(&slot[ftl_config::SLOT_COBS_OFFSET], block_length + 1);
     }
 }
 
 bool is_ready() {
-    return !g_tx_queue.is_full();
+    return !g_tx_queues[static_cast<size_t>(TxClass::Normal)].is_full();
 }
 
 uint8_t get_source_id() {
@@ -161,21 +472,60 @@ uint8_t get_source_id() {
 }
 
 Statistics get_statistics() {
-    return Statistics{
+    Statistics stats{
         g_total_queued,
-        g_total_sent,
+        g_total_sent.load(std::memory_order_relaxed),
         g_queue_full_drops,
-        g_tx_queue.count(),
+        pending_count(),
         g_peak_queue_depth
     };
+    stats.batch_frames = g_batch_frames;
+    stats.batched_messages = g_batched_messages;
+
+    if (g_dma_controller) {
+        const auto line = g_dma_controller->get_tx_line_stats();
+        const uint64_t elapsed_us = time_us_64() - g_stats_start_us;
+
+        stats.total_bytes_sent = line.bytes_sent;
+        stats.back_to_back_frames = line.back_to_back_frames;
+        if (elapsed_us > 0) {
+            stats.bytes_per_second = static_cast<uint32_t>(uint64_t{line.bytes_sent} * 1000000 / elapsed_us);
+            stats.line_utilization_permille = static_cast<uint32_t>(line.busy_us * 1000 / elapsed_us);
+        }
+    }
+    return stats;
+}
+
+ClassStatistics get_class_statistics(TxClass tx_class) {
+    const size_t index = static_cast<size_t>(tx_class);
+    if (index >= ftl_config::TX_CLASS_COUNT) {
+        return ClassStatistics{};
+    }
+
+    const ClassCounters& counters = g_class_counters[index];
+    return ClassStatistics{
+        counters.queued,
+        counters.sent,
+        counters.dropped,
+        counters.coalesced,
+        g_tx_queues[index].count(),
+        counters.peak_depth,
+        counters.sent ? static_cast<uint32_t>(counters.total_latency_us / counters.sent) : 0,
+        counters.max_latency_us
+    };
+}
+
+uint32_t get_class_queue_count(TxClass tx_class) {
+    const size_t index = static_cast<size_t>(tx_class);
+    return index < ftl_config::TX_CLASS_COUNT ? g_tx_queues[index].count() : 0;
 }
 
 bool is_queue_empty() {
-    return g_tx_queue.is_empty();
+    return pending_count() == 0;
 }
 
 uint32_t get_queue_count() {
-    return g_tx_queue.count();
+    return pending_count();
 }
 
 } // namespace internal_tx
@@ -7,63 +7,173 @@
 #include <cstring>
 #include <concepts>
 
-template<size_t ObjectSize = 32, size_t MaxObjects = 255>
-    requires (ObjectSize > 0) && (MaxObjects <= 255) && ((ObjectSize % 4) == 0)
-class MessagePool {
+// Reference-counted objects in one or more size classes, safe to use from
+// both cores and from interrupts. Class c holds Counts[c] objects of
+// Sizes[c] bytes; handles number the objects of all classes in order, so a
+// handle says nothing about its class and any handle fits a uint8_t. Each
+// class keeps a lock-free free list threaded through next_free, so acquire
+// and release cost the same however full the pool is.
+// acquire(size) takes from the smallest class that holds `size` bytes and
+// moves up a class when that one is empty. The first ZeroBytes bytes of an
+// object are cleared on acquire; the rest holds whatever the previous owner
+// left.
+template<auto Sizes, auto Counts, size_t ZeroBytes>
+    requires (Sizes.size() > 0) && (Sizes.size() == Counts.size())
+class SlabPool {
+    static constexpr size_t CLASS_COUNT = Sizes.size();
+
+    static constexpr size_t sum_counts() {
+        size_t total = 0;
+        for (size_t count : Counts) total += count;
+        return total;
+    }
+
+    static constexpr size_t sum_bytes() {
+        size_t total = 0;
+        for (size_t c = 0; c < CLASS_COUNT; ++c) total += Sizes[c] * Counts[c];
+        return total;
+    }
+
+    static constexpr bool valid_sizes() {
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            if (Sizes[c] == 0 || Sizes[c] % 4 != 0 || (c > 0 && Sizes[c] <= Sizes[c - 1])) return false;
+        }
+        return ZeroBytes <= Sizes[0];
+    }
+
 public:
     using Handle = std::uint8_t;
-    
-    static constexpr size_t TOTAL_SIZE = ObjectSize * MaxObjects;
+
+    static constexpr size_t MAX_OBJECTS = sum_counts();
+    static constexpr size_t MAX_OBJECT_SIZE = Sizes[CLASS_COUNT - 1];
+    static constexpr size_t TOTAL_SIZE = sum_bytes();
     static constexpr std::uint8_t STATE_FREE = 0x00;
-    static constexpr std::uint8_t STATE_ALLOCATING = 0xFF;
     static constexpr Handle INVALID = 0xFF;
     static constexpr std::uint8_t MAX_REF_COUNT = 8;
-    
+
+    static_assert(MAX_OBJECTS <= 255, "Handles must fit a uint8_t with 0xFF left for INVALID");
+    static_assert(valid_sizes(), "Class sizes must be ascending multiples of 4, ZeroBytes within the smallest");
+
 private:
+    struct Layout {
+        std::array<uint32_t, MAX_OBJECTS> offset{};     // Into memory_pool
+        std::array<uint8_t, MAX_OBJECTS> size_class{};
+        std::array<Handle, CLASS_COUNT> first{};        // Lowest handle of each class
+    };
+
+    static constexpr Layout LAYOUT = [] {
+        Layout layout;
+        size_t h = 0;
+        uint32_t offset = 0;
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            layout.first[c] = static_cast<Handle>(h);
+            for (size_t i = 0; i < Counts[c]; ++i, ++h) {
+                layout.offset[h] = offset;
+                layout.size_class[h] = static_cast<uint8_t>(c);
+                offset += Sizes[c];
+            }
+        }
+        return layout;
+    }();
+
     alignas(4) std::array<uint8_t, TOTAL_SIZE> memory_pool{};
-    std::array<std::atomic<uint8_t>, MaxObjects> ref_counts{};
-    std::atomic<uint8_t> next_hint{0};
+    std::array<std::atomic<uint8_t>, MAX_OBJECTS> ref_counts{};
+
+    // Head of each class's free list: [tag (24 bits)][handle (8 bits)]. The
+    // tag changes with every pop and push, so a CAS against a head that was
+    // popped and pushed back in between fails instead of linking a stale next.
+    std::array<std::atomic<Handle>, MAX_OBJECTS> next_free{};
+    std::array<std::atomic<uint32_t>, CLASS_COUNT> free_heads{};
+
+    std::atomic<uint8_t> allocated{0};
+    std::atomic<uint8_t> peak_allocated{0};
+    std::atomic<uint32_t> spills{0};
+
+    static constexpr uint32_t pack_head(uint32_t head, Handle h) {
+        return (((head >> 8) + 1) << 8) | h;
+    }
+
+    Handle pop_free(size_t size_class) {
+        std::atomic<uint32_t>& free_head = free_heads[size_class];
+        uint32_t head = free_head.load(std::memory_order_acquire);
+        while (true) {
+            const Handle h = static_cast<Handle>(head & 0xFF);
+            if (h == INVALID) {
+                return INVALID;
+            }
+            const uint32_t next = pack_head(head, next_free[h].load(std::memory_order_relaxed));
+            if (free_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+                return h;
+            }
+        }
+    }
+
+    void push_free(Handle h) {
+        std::atomic<uint32_t>& free_head = free_heads[LAYOUT.size_class[h]];
+        uint32_t head = free_head.load(std::memory_order_relaxed);
+        do {
+            next_free[h].store(static_cast<Handle>(head & 0xFF), std::memory_order_relaxed);
+        } while (!free_head.compare_exchange_weak(head, pack_head(head, h),
+                                                  std::memory_order_release, std::memory_order_relaxed));
+    }
 
     void* get_raw_ptr(Handle h) {
-        return &memory_pool[h * ObjectSize];
+        return &memory_pool[LAYOUT.offset[h]];
     }
     
     const void* get_raw_ptr(Handle h) const {
-        return &memory_pool[h * ObjectSize];
+        return &memory_pool[LAYOUT.offset[h]];
     }
 
 public:
-    MessagePool() noexcept = default;
+    SlabPool() noexcept {
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            const size_t first = LAYOUT.first[c];
+            const size_t end = first + Counts[c];
+            for (size_t i = first; i < end; ++i) {
+                next_free[i].store(i + 1 < end ? static_cast<Handle>(i + 1) : INVALID, std::memory_order_relaxed);
+            }
+            free_heads[c].store(Counts[c] > 0 ? first : INVALID, std::memory_order_release);
+        }
+    }
     
-    MessagePool(const MessagePool&) = delete;
-    MessagePool& operator=(const MessagePool&) = delete;
-    MessagePool(MessagePool&&) = delete;
-    MessagePool& operator=(MessagePool&&) = delete;
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+    SlabPool(SlabPool&&) = delete;
+    SlabPool& operator=(SlabPool&&) = delete;
     
-    Handle acquire() {
-        std::uint8_t start = next_hint.load(std::memory_order_relaxed);
-        
-        for (std::uint8_t attempts = 0; attempts < MaxObjects; ++attempts) {
-            std::uint8_t idx = (start + attempts) % MaxObjects;
-            std::uint8_t expected = STATE_FREE;
-            
-            if (ref_counts[idx].compare_exchange_strong(expected, STATE_ALLOCATING,
-                    std::memory_order_acq_rel, std::memory_order_acquire)) {
-                
-                std::memset(get_raw_ptr(idx), 0, ObjectSize);
-                        
-                std::atomic_thread_fence(std::memory_order_release);
-                ref_counts[idx].store(1, std::memory_order_release);
-                next_hint.store((idx + 1) % MaxObjects, std::memory_order_relaxed);
-                
-                return idx;
-            }
+    // An object of at least `size` bytes, or INVALID
+    Handle acquire(size_t size = MAX_OBJECT_SIZE) {
+        size_t size_class = 0;
+        while (size_class < CLASS_COUNT && Sizes[size_class] < size) {
+            size_class++;
+        }
+
+        Handle idx = INVALID;
+        for (size_t c = size_class; c < CLASS_COUNT && idx == INVALID; ++c) {
+            idx = pop_free(c);
+        }
+        if (idx == INVALID) {
+            return INVALID;
+        }
+        if (LAYOUT.size_class[idx] != size_class) {
+            spills.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if constexpr (ZeroBytes > 0) {
+            std::memset(get_raw_ptr(idx), 0, ZeroBytes);
+        }
+        ref_counts[idx].store(1, std::memory_order_release);
+
+        const uint8_t in_use = allocated.fetch_add(1, std::memory_order_relaxed) + 1;
+        uint8_t peak = peak_allocated.load(std::memory_order_relaxed);
+        while (in_use > peak && !peak_allocated.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
         }
-        return INVALID;
+        return idx;
     }
     
     bool add_ref(Handle h) {
-        if (h >= MaxObjects) return false;
+        if (h >= MAX_OBJECTS) return false;
         
         std::uint8_t count = ref_counts[h].load(std::memory_order_acquire);
         
@@ -77,7 +187,7 @@ public:
     }
     
     bool release(Handle h) {
-        if (h >= MaxObjects) return false;
+        if (h >= MAX_OBJECTS) return false;
         
         std::uint8_t count = ref_counts[h].load(std::memory_order_acquire);
         
@@ -85,16 +195,21 @@ public:
             std::uint8_t new_count = count - 1;
             if (ref_counts[h].compare_exchange_weak(count, new_count,
                     std::memory_order_acq_rel, std::memory_order_acquire)) {
-                return new_count == STATE_FREE;
+                if (new_count != STATE_FREE) {
+                    return false;
+                }
+                allocated.fetch_sub(1, std::memory_order_relaxed);
+                push_free(h);
+                return true;
             }
         }
         return false;
     }
     
     template<typename T = void>
-    requires (sizeof(T) <= ObjectSize || std::same_as<T, void>)
+    requires (sizeof(T) <= MAX_OBJECT_SIZE || std::same_as<T, void>)
     T* get_ptr(Handle h) {
-        if (h >= MaxObjects) return nullptr;
+        if (h >= MAX_OBJECTS) return nullptr;
         
         std::uint8_t count = ref_counts[h].load(std::memory_order_acquire);
         if (count > 0 && count <= MAX_REF_COUNT) {
@@ -108,9 +223,9 @@ public:
     }
     
     template<typename T = void>
-    requires (sizeof(T) <= ObjectSize || std::same_as<T, void>)
+    requires (sizeof(T) <= MAX_OBJECT_SIZE || std::same_as<T, void>)
     const T* get_ptr(Handle h) const {
-        if (h >= MaxObjects) return nullptr;
+        if (h >= MAX_OBJECTS) return nullptr;
         
         std::uint8_t count = ref_counts[h].load(std::memory_order_acquire);
         if (count > 0 && count <= MAX_REF_COUNT) {
@@ -124,18 +239,41 @@ public:
     }
     
     bool is_valid(Handle h) const {
-        if (h >= MaxObjects) return false;
+        if (h >= MAX_OBJECTS) return false;
         std::uint8_t count = ref_counts[h].load(std::memory_order_acquire);
         return count > 0 && count <= MAX_REF_COUNT;
     }
     
     uint8_t get_ref_count(Handle h) const {
-        if (h >= MaxObjects) return 0;
+        if (h >= MAX_OBJECTS) return 0;
         std::uint8_t count = ref_counts[h].load(std::memory_order_acquire);
         return (count > 0 && count <= MAX_REF_COUNT) ? count : 0;
     }
+
+    // Bytes usable in the object, 0 for an invalid handle
+    size_t capacity(Handle h) const {
+        return h < MAX_OBJECTS ? Sizes[LAYOUT.size_class[h]] : 0;
+    }
+
+    // Objects in use now, and the most ever in use at once
+    size_t get_allocated_count() const {
+        return allocated.load(std::memory_order_relaxed);
+    }
+
+    size_t get_peak_allocated_count() const {
+        return peak_allocated.load(std::memory_order_relaxed);
+    }
+
+    // Acquires served from a larger class because the fitting one was empty
+    size_t get_spill_count() const {
+        return spills.load(std::memory_order_relaxed);
+    }
 };
 
+// A pool of one size class
+template<size_t ObjectSize = 32, size_t MaxObjects = 255, size_t ZeroBytes = ObjectSize>
+using MessagePool = SlabPool<std::array<size_t, 1>{ObjectSize}, std::array<size_t, 1>{MaxObjects}, ZeroBytes>;
+
 template<typename Pool>
 class MsgHandle {
 private:
@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @file cobs.h
+ * @brief In-place Consistent Overhead Byte Stuffing for short blocks
+ *
+ * COBS removes every 0x00 from a block so that a single zero can delimit
+ * frames on the wire: each zero in the data becomes the distance to the next
+ * one, and a code byte in front gives the distance to the first. No byte of
+ * an encoded frame can be mistaken for the delimiter, so a receiver that
+ * loses sync drops to the next zero and is back in step.
+ *
+ * Blocks are limited to MAX_BLOCK bytes, so no distance ever reaches 0xFF
+ * (the "254 bytes without a zero" code) and the encoded block is exactly one
+ * byte longer than the data. Both directions only rewrite the code bytes in
+ * place; the data never moves.
+ *
+ *   block[0]            code: distance to the first zero (or the end)
+ *   block[1..length]    data, each zero replaced by the distance to the next
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cobs {
+
+constexpr uint8_t DELIMITER = 0x00;
+constexpr size_t MAX_BLOCK = 253;   // Largest data length with single-byte distances below 0xFF
+
+// Encodes block[1..length] in place and writes the code byte to block[0].
+// Returns the encoded length (length + 1), without the delimiter.
+inline size_t encode_in_place(uint8_t* block, size_t length) {
+    uint8_t distance = 1;
+    for (size_t i = length; i > 0; --i) {
+        if (block[i] == DELIMITER) {
+            block[i] = distance;
+            distance = 1;
+        } else {
+            distance++;
+        }
+    }
+    block[0] = distance;
+    return length + 1;
+}
+
+// Decodes an encoded block of `length` bytes (delimiter stripped) in place;
+// the data is left at block[1..length-1]. False if the codes don't chain
+// exactly to the end of the block, which is how corruption usually shows.
+inline bool decode_in_place(uint8_t* block, size_t length) {
+    if (length == 0 || length > MAX_BLOCK + 1) {
+        return false;
+    }
+
+    size_t i = 0;
+    for (;;) {
+        const uint8_t code = block[i];
+        if (code == DELIMITER || i + code > length) {
+            return false;
+        }
+        if (i > 0) {
+            block[i] = DELIMITER;
+        }
+        i += code;
+        if (i == length) {
+            return true;
+        }
+    }
+}
+
+} // namespace cobs
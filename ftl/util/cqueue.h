@@ -77,6 +77,21 @@ public:
         return true;
     }
     
+    // Hands every item queued so far to fn(item), oldest first, and frees
+    // them all with one index update. Consumer's side only.
+    template<typename Fn>
+    size_t drain(Fn fn) {
+        uint8_t current_head = head_.get_relaxed();
+        const uint8_t current_tail = tail_.get_ordered();
+        size_t drained = 0;
+        for (; current_head != current_tail; current_head = (current_head + 1) & MASK) {
+            fn(buffer_[current_head]);
+            drained++;
+        }
+        head_.set_ordered(current_head);
+        return drained;
+    }
+
     bool peek(T& item) const {
         uint8_t current_head = head_.get_relaxed();
         uint8_t current_tail = tail_.get_ordered();
@@ -89,6 +104,20 @@ public:
         return true;
     }
     
+    // First queued item, oldest first, for which pred(item) holds; nullptr if
+    // none. The item may be replaced in place. Owner's side only: not safe
+    // against a concurrent dequeue.
+    template<typename Pred>
+    T* find_if(Pred pred) {
+        uint8_t current_tail = tail_.get_ordered();
+        for (uint8_t i = head_.get_relaxed(); i != current_tail; i = (i + 1) & MASK) {
+            if (pred(buffer_[i])) {
+                return &buffer_[i];
+            }
+        }
+        return nullptr;
+    }
+
     bool is_empty() const {
         uint8_t h = head_.get_relaxed();
         uint8_t t = tail_.get_ordered();
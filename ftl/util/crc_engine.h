@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file crc_engine.h
+ * @brief CRC-16-CCITT backends for FTL frames
+ *
+ * Same polynomial (0x1021), seed (0xFFFF) and bit order as crc16::calculate,
+ * so every backend produces identical frames on the wire.
+ *
+ *   Bytewise    Reference table loop, one lookup per byte.
+ *   Slice4      crc16::calculate, four table lookups per 32 bits.
+ *   DmaSniffer  A DMA channel reads the buffer into a dummy word while the
+ *               DMA sniffer accumulates the CRC; the CPU only sets it up and
+ *               waits roughly one clock per byte.
+ *
+ * init() claims a DMA channel for the sniffer and checks it against the
+ * software result; if either fails the engine stays on Slice4.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "util/misc.h"
+
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "pico/time.h"
+
+namespace crc16 {
+
+enum class Backend : uint8_t {
+    Bytewise,
+    Slice4,
+    DmaSniffer,
+};
+
+class Engine {
+private:
+    Backend backend_ = Backend::Slice4;
+    int channel_ = -1;
+    uint32_t sink_ = 0;     // DMA write target, never read
+
+    uint16_t sniff(const uint8_t* data, size_t length) {
+        dma_channel_config cfg = dma_channel_get_default_config(channel_);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+        channel_config_set_read_increment(&cfg, true);
+        channel_config_set_write_increment(&cfg, false);
+        channel_config_set_sniff_enable(&cfg, true);
+
+        dma_sniffer_set_data_accumulator(0xFFFF);
+        dma_sniffer_enable(channel_, DMA_SNIFF_CTRL_CALC_VALUE_CRC16, true);
+        dma_channel_configure(channel_, &cfg, &sink_, data, length, true);
+        dma_channel_wait_for_finish_blocking(channel_);
+
+        return static_cast<uint16_t>(dma_sniffer_get_data_accumulator());
+    }
+
+public:
+    Engine() = default;
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    ~Engine() { deinit(); }
+
+    bool init(Backend backend = Backend::DmaSniffer) {
+        deinit();
+        backend_ = backend;
+        if (backend != Backend::DmaSniffer) {
+            return true;
+        }
+
+        channel_ = dma_claim_unused_channel(false);
+        if (channel_ < 0) {
+            printf("CRC: No free DMA channel, using slice-by-4\n");
+            backend_ = Backend::Slice4;
+            return false;
+        }
+
+        static constexpr uint8_t CHECK[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+        if (sniff(CHECK, sizeof(CHECK)) != calculate_bytewise(CHECK, sizeof(CHECK))) {
+            printf("CRC: DMA sniffer mismatch, using slice-by-4\n");
+            deinit();
+            backend_ = Backend::Slice4;
+            return false;
+        }
+        return true;
+    }
+
+    void deinit() {
+        if (channel_ >= 0) {
+            dma_sniffer_disable();
+            dma_channel_unclaim(channel_);
+            channel_ = -1;
+        }
+        backend_ = Backend::Slice4;
+    }
+
+    uint16_t calculate(const uint8_t* data, size_t length) {
+        if (length == 0) {
+            return 0xFFFF;
+        }
+        switch (backend_) {
+            case Backend::Bytewise:   return calculate_bytewise(data, length);
+            case Backend::Slice4:     return crc16::calculate(data, length);
+            case Backend::DmaSniffer: return sniff(data, length);
+        }
+        return crc16::calculate(data, length);
+    }
+
+    Backend backend() const { return backend_; }
+
+    static const char* backend_name(Backend backend) {
+        switch (backend) {
+            case Backend::Bytewise:   return "bytewise";
+            case Backend::Slice4:     return "slice-by-4";
+            case Backend::DmaSniffer: return "dma-sniffer";
+        }
+        return "?";
+    }
+};
+
+/**
+ * @brief Print clk_sys cycles per byte for every available backend
+ *
+ * Runs each backend over the same `length`-byte buffer `iterations` times
+ * and checks they agree. Blocking; call from a console command or at boot.
+ */
+inline void print_benchmark(size_t length = 248, uint32_t iterations = 1000) {
+    static uint8_t buffer[256];
+    if (length == 0 || length > sizeof(buffer)) {
+        length = sizeof(buffer);
+    }
+    for (size_t i = 0; i < length; ++i) {
+        buffer[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    const uint32_t clk_hz = clock_get_hz(clk_sys);
+    const uint16_t expected = calculate_bytewise(buffer, length);
+
+    printf("CRC16 benchmark: %u bytes x %lu\n", (unsigned)length, (unsigned long)iterations);
+    for (Backend backend : {Backend::Bytewise, Backend::Slice4, Backend::DmaSniffer}) {
+        Engine engine;
+        if (!engine.init(backend) || engine.backend() != backend) {
+            printf("  %-12s unavailable\n", Engine::backend_name(backend));
+            continue;
+        }
+
+        uint16_t crc = 0;
+        const uint64_t start = time_us_64();
+        for (uint32_t i = 0; i < iterations; ++i) {
+            crc = engine.calculate(buffer, length);
+        }
+        const uint64_t elapsed_us = time_us_64() - start;
+
+        const uint64_t cycles = elapsed_us * clk_hz / 1000000u;
+        const uint32_t centicycles_per_byte = static_cast<uint32_t>(cycles * 100 / (uint64_t{iterations} * length));
+        printf("  %-12s %lu.%02lu cycles/byte%s\n", Engine::backend_name(backend),
+               (unsigned long)(centicycles_per_byte / 100), (unsigned long)(centicycles_per_byte % 100),
+               crc == expected ? "" : "  MISMATCH");
+    }
+}
+
+} // namespace crc16
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <cstdio>
@@ -46,7 +47,8 @@ constexpr uint16_t CRC16_TABLE[256] = {
     0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
 };
 
-inline uint16_t calculate(const uint8_t* data, size_t length) {
+// Reference byte-at-a-time loop
+inline uint16_t calculate_bytewise(const uint8_t* data, size_t length) {
     uint16_t crc = 0xFFFF;  // Initial value
     
     for (size_t i = 0; i < length; ++i) {
@@ -57,6 +59,45 @@ inline uint16_t calculate(const uint8_t* data, size_t length) {
     return crc;
 }
 
+namespace detail {
+
+// SLICE_TABLES[k][b]: CRC contribution of byte b followed by k zero bytes
+constexpr std::array<std::array<uint16_t, 256>, 4> make_slice_tables() {
+    std::array<std::array<uint16_t, 256>, 4> tables{};
+    for (size_t b = 0; b < 256; ++b) {
+        tables[0][b] = CRC16_TABLE[b];
+    }
+    for (size_t k = 1; k < 4; ++k) {
+        for (size_t b = 0; b < 256; ++b) {
+            const uint16_t prev = tables[k - 1][b];
+            tables[k][b] = static_cast<uint16_t>((prev << 8) ^ CRC16_TABLE[prev >> 8]);
+        }
+    }
+    return tables;
+}
+
+inline constexpr auto SLICE_TABLES = make_slice_tables();
+
+} // namespace detail
+
+// Slice-by-4: four independent lookups per 32 bits instead of a serial chain
+inline uint16_t calculate(const uint8_t* data, size_t length) {
+    const auto& t = detail::SLICE_TABLES;
+    uint16_t crc = 0xFFFF;  // Initial value
+
+    for (; length >= 4; length -= 4, data += 4) {
+        crc = t[3][((crc >> 8) ^ data[0]) & 0xFF] ^
+              t[2][(crc ^ data[1]) & 0xFF] ^
+              t[1][data[2]] ^
+              t[0][data[3]];
+    }
+    for (; length > 0; --length, ++data) {
+        crc = static_cast<uint16_t>((crc << 8) ^ t[0][((crc >> 8) ^ *data) & 0xFF]);
+    }
+    
+    return crc;
+}
+
 inline uint16_t calculate(std::span<const uint8_t> data) {
     return calculate(data.data(), data.size());
 }
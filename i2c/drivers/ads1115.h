@@ -45,7 +45,6 @@ private:
     Mux mux_config_{};
     Gain gain_config_{};
     Rate rate_config_{};
-    float voltage_per_bit_{};
     bool is_converting_ = false;
 
     uint16_t build_config(bool continuous) {
@@ -62,21 +61,22 @@ private:
         return config;
     }
 
-    float get_voltage_per_bit(Gain gain) {
-        float range_v;
+public:
+    // Volts per count for a PGA setting; compose with .then() for sensor units
+    static constexpr units::Scale scale_for(Gain gain) {
+        double range_v;
         switch(gain) {
-            case Gain::FS_6_144V: range_v = 6.144f; break;
-            case Gain::FS_4_096V: range_v = 4.096f; break;
-            case Gain::FS_2_048V: range_v = 2.048f; break;
-            case Gain::FS_1_024V: range_v = 1.024f; break;
-            case Gain::FS_0_512V: range_v = 0.512f; break;
-            case Gain::FS_0_256V: range_v = 0.256f; break;
-            default:              range_v = 6.144f;
+            case Gain::FS_6_144V: range_v = 6.144; break;
+            case Gain::FS_4_096V: range_v = 4.096; break;
+            case Gain::FS_2_048V: range_v = 2.048; break;
+            case Gain::FS_1_024V: range_v = 1.024; break;
+            case Gain::FS_0_512V: range_v = 0.512; break;
+            case Gain::FS_0_256V: range_v = 0.256; break;
+            default:              range_v = 6.144;
         }
-        return range_v / 32768.0f;
+        return units::Scale{range_v / 32768.0};
     }
 
-public:
     ADS1115() : I2CDriverBase() {
         data_.valid = false;
     }
@@ -103,7 +103,6 @@ public:
         mux_config_ = mux;
         gain_config_ = gain;
         rate_config_ = rate;
-        voltage_per_bit_ = get_voltage_per_bit(gain);
 
         if (was_converting) start();
     }
@@ -151,7 +150,6 @@ public:
         }
 
         data_.raw = utils::merge_bytes<int16_t>(read_buf[0], read_buf[1]);
-        data_.voltage = data_.raw * voltage_per_bit_;
         data_.valid = true;
         return true;
     }
@@ -159,6 +157,10 @@ public:
     const ads1115_data& get_data() const {
         return data_;
     }
+
+    units::Scale scale() const {
+        return scale_for(gain_config_);
+    }
 };
 
 } // namespace i2c::drivers
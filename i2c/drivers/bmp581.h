@@ -20,13 +20,8 @@ private:
 
     static constexpr uint8_t EXPECTED_CHIP_ID = 0x50; 
     static constexpr uint8_t RESET_COMMAND = 0xB6;
-    static constexpr float SEA_LEVEL_PRESSURE = 101325.0f;
     
-    bmp581_data data;
-    
-    float calculate_altitude(float pressure) {
-        return 44330.0f * (1.0f - powf(pressure / SEA_LEVEL_PRESSURE, 0.1903f));
-    }
+    bmp581_data data{};
 
 public:
     BMP581() : I2CDriverBase() {
@@ -88,14 +83,10 @@ public:
             return false;
         }
         
+        // 24-bit two's complement, sign-extended
         int32_t raw_temp = utils::merge_bytes<int32_t>(temp_data[2], temp_data[1], temp_data[0]);
-        data.temperature = raw_temp / 65536.0f;
-        
-        uint32_t raw_press = utils::merge_bytes<uint32_t>(press_data[2], press_data[1], press_data[0]);
-        data.pressure = raw_press / 64.0f;
-        
-        data.altitude = calculate_altitude(data.pressure);
-        
+        data.temperature_raw = (raw_temp << 8) >> 8;
+        data.pressure_raw = utils::merge_bytes<uint32_t>(press_data[2], press_data[1], press_data[0]);
         data.valid = true;
         
         return true;
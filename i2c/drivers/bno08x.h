@@ -0,0 +1,331 @@
+#pragma once
+
+#include "i2c/i2c_driver.h"
+
+#include <atomic>
+
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+extern "C" {
+#include "sh2.h"
+#include "sh2_err.h"
+#include "sh2_SensorValue.h"
+}
+
+namespace i2c::drivers {
+
+/**
+ * @brief BNO08x sensor hub over SH2/SHTP on the shared I2C bus
+ *
+ * The hub asserts INT (active low) when it has a report queued. A GPIO edge
+ * IRQ latches that with a timestamp; update() returns immediately without
+ * touching the bus unless INT is pending, then services SH2 once and hands
+ * every decoded report to the I2CDevice callback as one bno08x_data batch.
+ *
+ * The SH2 library keeps a single global session, so only one BNO08x is
+ * supported. Report rates must be changed while polling is stopped, since
+ * sh2_setSensorConfig() services the bus itself.
+ */
+class BNO08x : public I2CDriverBase<BNO08x> {
+public:
+    enum class Report : uint8_t {
+        RotationVector = SH2_ROTATION_VECTOR,
+        LinearAcceleration = SH2_LINEAR_ACCELERATION,
+        Gyroscope = SH2_GYROSCOPE_CALIBRATED,
+    };
+
+    static constexpr uint DEFAULT_INT_PIN = 14;
+    static constexpr uint DEFAULT_RST_PIN = 15;
+
+private:
+    static constexpr size_t REPORT_COUNT = 3;
+    static constexpr uint32_t RESET_PULSE_US = 10'000;
+    static constexpr uint32_t BOOT_TIMEOUT_US = 200'000;
+    static constexpr size_t SHTP_HEADER_LEN = 4;
+
+    struct ReportConfig {
+        Report report;
+        uint32_t rate_hz;
+    };
+
+    // sh2_Hal_t must be the first member: the HAL callbacks cast back to it
+    struct Hal {
+        sh2_Hal_t hal;
+        BNO08x* self;
+    };
+
+    Hal hal_{};
+    bno08x_data data_{};
+
+    uint int_pin_ = DEFAULT_INT_PIN;
+    uint rst_pin_ = DEFAULT_RST_PIN;
+
+    std::array<ReportConfig, REPORT_COUNT> reports_{{
+        {Report::RotationVector, 100},
+        {Report::LinearAcceleration, 100},
+        {Report::Gyroscope, 200},
+    }};
+
+    std::atomic<bool> int_pending_{false};
+    std::atomic<uint32_t> int_timestamp_us_{0};
+    std::atomic<bool> reset_seen_{false};
+    uint32_t dropped_values_ = 0;
+    uint32_t dropped_transfers_ = 0;
+
+    static inline BNO08x* irq_instance_ = nullptr;
+
+    // ========================================================================
+    // INT PIN
+    // ========================================================================
+    static void int_irq_handler() {
+        BNO08x* self = irq_instance_;
+        if (self && (gpio_get_irq_event_mask(self->int_pin_) & GPIO_IRQ_EDGE_FALL)) {
+            gpio_acknowledge_irq(self->int_pin_, GPIO_IRQ_EDGE_FALL);
+            self->int_timestamp_us_.store(time_us_32(), std::memory_order_relaxed);
+            self->int_pending_.store(true, std::memory_order_release);
+        }
+    }
+
+    bool int_asserted() const {
+        return int_pending_.load(std::memory_order_acquire) || !gpio_get(int_pin_);
+    }
+
+    // ========================================================================
+    // SH2 HAL
+    // ========================================================================
+    static BNO08x* from_hal(sh2_Hal_t* hal) {
+        return reinterpret_cast<Hal*>(hal)->self;
+    }
+
+    static int hal_open(sh2_Hal_t* hal) {
+        BNO08x* self = from_hal(hal);
+
+        // Hardware reset, then wait for the hub to assert INT with its adverts
+        gpio_put(self->rst_pin_, 0);
+        sleep_us(RESET_PULSE_US);
+        gpio_put(self->rst_pin_, 1);
+
+        uint32_t start = time_us_32();
+        while (gpio_get(self->int_pin_)) {
+            if (time_us_32() - start > BOOT_TIMEOUT_US) {
+                printf("%s: Timed out waiting for INT after reset\n", Traits::name);
+                return SH2_ERR_TIMEOUT;
+            }
+            sleep_us(100);
+        }
+        return SH2_OK;
+    }
+
+    static void hal_close(sh2_Hal_t* hal) {
+        BNO08x* self = from_hal(hal);
+        gpio_put(self->rst_pin_, 0);
+    }
+
+    static int hal_read(sh2_Hal_t* hal, uint8_t* buffer, unsigned len, uint32_t* t_us) {
+        BNO08x* self = from_hal(hal);
+
+        if (!self->int_asserted()) {
+            return 0;
+        }
+        self->int_pending_.store(false, std::memory_order_relaxed);
+
+        // Taken before the read: the hub may assert INT for its next
+        // transfer while this one is still on the bus
+        const uint32_t timestamp_us = self->int_timestamp_us_.load(std::memory_order_relaxed);
+
+        // SHTP over I2C: each read restarts at the header, so fetch the
+        // header for the length, then the whole transfer in one read.
+        uint8_t header[SHTP_HEADER_LEN];
+        if (i2c_read_blocking(self->i2c_instance, Traits::address, header, SHTP_HEADER_LEN, false) != SHTP_HEADER_LEN) {
+            return 0;
+        }
+
+        unsigned length = utils::merge_bytes<uint16_t>(header[1], header[0]) & 0x7FFF;
+        if (length == 0 || length == 0x7FFF) {
+            return 0;
+        }
+
+        // SH2 cannot hold a transfer longer than its buffer, and would parse
+        // the continuation the hub sends after a short read as a payload of
+        // its own. Drain both off the bus and drop them.
+        const bool continuation = (header[1] & 0x80) != 0;
+        if (continuation || length > len) {
+            i2c_read_blocking(self->i2c_instance, Traits::address, buffer, length > len ? len : length, false);
+            if (!continuation) {
+                self->dropped_transfers_++;
+            }
+            return 0;
+        }
+
+        int result = i2c_read_blocking(self->i2c_instance, Traits::address, buffer, length, false);
+        if (result != static_cast<int>(length)) {
+            return 0;
+        }
+
+        *t_us = timestamp_us;
+        return static_cast<int>(length);
+    }
+
+    static int hal_write(sh2_Hal_t* hal, uint8_t* buffer, unsigned len) {
+        BNO08x* self = from_hal(hal);
+        int result = i2c_write_blocking(self->i2c_instance, Traits::address, buffer, len, false);
+        return result == static_cast<int>(len) ? static_cast<int>(len) : 0;
+    }
+
+    static uint32_t hal_get_time_us(sh2_Hal_t* /*hal*/) {
+        return time_us_32();
+    }
+
+    // ========================================================================
+    // SH2 CALLBACKS
+    // ========================================================================
+    static void on_async_event(void* cookie, sh2_AsyncEvent_t* event) {
+        auto* self = static_cast<BNO08x*>(cookie);
+        if (event->eventId == SH2_RESET) {
+            self->reset_seen_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    static void on_sensor_event(void* cookie, sh2_SensorEvent_t* event) {
+        auto* self = static_cast<BNO08x*>(cookie);
+        bno08x_data& data = self->data_;
+
+        if (data.count >= bno08x_data::MAX_VALUES) {
+            self->dropped_values_++;
+            return;
+        }
+        if (sh2_decodeSensorEvent(&data.values[data.count], event) == SH2_OK) {
+            data.count++;
+        }
+    }
+
+    bool apply_report(const ReportConfig& config) {
+        sh2_SensorConfig_t sensor_config{};
+        sensor_config.reportInterval_us = config.rate_hz ? 1'000'000 / config.rate_hz : 0;
+
+        int status = sh2_setSensorConfig(static_cast<sh2_SensorId_t>(config.report), &sensor_config);
+        if (status != SH2_OK) {
+            printf("%s: Failed to configure report 0x%02X (%d)\n",
+                   Traits::name, static_cast<uint8_t>(config.report), status);
+            return false;
+        }
+        return true;
+    }
+
+    bool apply_reports() {
+        bool ok = true;
+        for (const auto& config : reports_) {
+            ok &= apply_report(config);
+        }
+        return ok;
+    }
+
+public:
+    BNO08x() : I2CDriverBase() {
+        data_.valid = false;
+    }
+
+    // Call before init() (I2CBus::add_device) to move the INT/RST pins
+    void set_pins(uint int_pin, uint rst_pin) {
+        int_pin_ = int_pin;
+        rst_pin_ = rst_pin;
+    }
+
+    bool init(i2c_inst_t* instance) {
+        i2c_instance = instance;
+
+        gpio_init(rst_pin_);
+        gpio_set_dir(rst_pin_, GPIO_OUT);
+        gpio_put(rst_pin_, 1);
+
+        gpio_init(int_pin_);
+        gpio_set_dir(int_pin_, GPIO_IN);
+        gpio_pull_up(int_pin_);
+
+        irq_instance_ = this;
+        gpio_add_raw_irq_handler(int_pin_, &BNO08x::int_irq_handler);
+        gpio_set_irq_enabled(int_pin_, GPIO_IRQ_EDGE_FALL, true);
+        irq_set_enabled(IO_IRQ_BANK0, true);
+
+        hal_.self = this;
+        hal_.hal.open = &BNO08x::hal_open;
+        hal_.hal.close = &BNO08x::hal_close;
+        hal_.hal.read = &BNO08x::hal_read;
+        hal_.hal.write = &BNO08x::hal_write;
+        hal_.hal.getTimeUs = &BNO08x::hal_get_time_us;
+
+        if (sh2_open(&hal_.hal, &BNO08x::on_async_event, this) != SH2_OK) {
+            printf("%s: Failed to open SH2 session\n", Traits::name);
+            return false;
+        }
+
+        sh2_ProductIds_t product_ids{};
+        if (sh2_getProdIds(&product_ids) != SH2_OK || product_ids.numEntries == 0) {
+            printf("%s: Failed to read product IDs\n", Traits::name);
+            sh2_close();
+            return false;
+        }
+
+        sh2_setSensorCallback(&BNO08x::on_sensor_event, this);
+
+        if (!apply_reports()) {
+            sh2_close();
+            return false;
+        }
+        reset_seen_.store(false, std::memory_order_relaxed);
+
+        initialized = true;
+        log_init_success();
+        return true;
+    }
+
+    bool update() {
+        data_.count = 0;
+        data_.valid = false;
+
+        if (!initialized) {
+            return false;
+        }
+
+        // The hub drops its sensor configuration on reset
+        if (reset_seen_.exchange(false, std::memory_order_relaxed)) {
+            printf("%s: Hub reset, re-enabling reports\n", Traits::name);
+            apply_reports();
+        }
+
+        if (!int_asserted()) {
+            return true;    // Nothing queued; no bus traffic
+        }
+
+        sh2_service();
+        data_.valid = data_.count > 0;
+        return true;
+    }
+
+    // Set a report rate in Hz (0 disables). Applied immediately when
+    // initialized; polling must be stopped.
+    bool set_report_rate(Report report, uint32_t rate_hz) {
+        for (auto& config : reports_) {
+            if (config.report == report) {
+                config.rate_hz = rate_hz;
+                return initialized ? apply_report(config) : true;
+            }
+        }
+        return false;
+    }
+
+    const bno08x_data& get_data() const {
+        return data_;
+    }
+
+    uint32_t get_dropped_values() const {
+        return dropped_values_;
+    }
+
+    uint32_t get_dropped_transfers() const {
+        return dropped_transfers_;
+    }
+};
+
+} // namespace i2c::drivers
@@ -13,18 +13,61 @@ private:
     static constexpr uint8_t REG_GYRO_CONFIG_1 = 0x01;
     static constexpr uint8_t REG_ACCEL_CONFIG = 0x14;
     static constexpr uint8_t REG_ACCEL_CONFIG_2 = 0x15;
+    static constexpr uint8_t REG_I2C_MST_STATUS = 0x17;
     static constexpr uint8_t REG_ACCEL_XOUT_H = 0x2D;
     static constexpr uint8_t REG_GYRO_XOUT_H = 0x33;
+    static constexpr uint8_t REG_TEMP_OUT_H = 0x39;
+    static constexpr uint8_t REG_EXT_SLV_SENS_DATA_00 = 0x3B;
     static constexpr uint8_t REG_BANK_SEL = 0x7F;
 
+    // Bank 3: internal I2C master
+    static constexpr uint8_t REG_I2C_MST_CTRL = 0x01;
+    static constexpr uint8_t REG_I2C_SLV0_ADDR = 0x03;
+    static constexpr uint8_t REG_I2C_SLV0_REG = 0x04;
+    static constexpr uint8_t REG_I2C_SLV0_CTRL = 0x05;
+    static constexpr uint8_t REG_I2C_SLV4_ADDR = 0x13;
+    static constexpr uint8_t REG_I2C_SLV4_REG = 0x14;
+    static constexpr uint8_t REG_I2C_SLV4_CTRL = 0x15;
+    static constexpr uint8_t REG_I2C_SLV4_DO = 0x16;
+    static constexpr uint8_t REG_I2C_SLV4_DI = 0x17;
+
+    static constexpr uint8_t USER_CTRL_I2C_MST_EN = 0x20;
+    static constexpr uint8_t USER_CTRL_I2C_MST_RST = 0x02;
+    static constexpr uint8_t I2C_MST_CLK_345KHZ = 0x07;
+    static constexpr uint8_t I2C_MST_P_NSR = 0x10;
+    static constexpr uint8_t I2C_SLV_EN = 0x80;
+    static constexpr uint8_t I2C_SLV_READ = 0x80;
+    static constexpr uint8_t I2C_SLV4_DONE = 0x40;
+    static constexpr uint8_t I2C_SLV4_NACK = 0x10;
+
+    // AK09916 magnetometer behind the internal I2C master
+    static constexpr uint8_t AK09916_ADDRESS = 0x0C;
+    static constexpr uint8_t AK09916_REG_WIA2 = 0x01;
+    static constexpr uint8_t AK09916_REG_ST1 = 0x10;
+    static constexpr uint8_t AK09916_REG_CNTL2 = 0x31;
+    static constexpr uint8_t AK09916_REG_CNTL3 = 0x32;
+    static constexpr uint8_t AK09916_EXPECTED_ID = 0x09;
+    static constexpr uint8_t AK09916_MODE_CONT_100HZ = 0x08;
+    static constexpr uint8_t AK09916_ST2_HOFL = 0x08;
+    static constexpr uint8_t AK09916_SRST = 0x01;
+
+    // ST1, HXL..HZH, TMPS, ST2: reading through ST2 releases the data latch
+    static constexpr uint8_t MAG_READ_LEN = 9;
+    // Accel (6) + gyro (6) + temp (2) + EXT_SLV_SENS_DATA (9), one burst
+    static constexpr size_t BURST_LEN = (REG_EXT_SLV_SENS_DATA_00 - REG_ACCEL_XOUT_H) + MAG_READ_LEN;
+    static constexpr uint32_t SLV4_TIMEOUT_US = 5'000;
+
     static constexpr uint8_t EXPECTED_CHIP_ID = 0xEA;
     static constexpr uint8_t ACCEL_RANGE = 2;
     static constexpr uint8_t GYRO_RANGE = 2;
-    static constexpr float ACCEL_SCALE = 8.0f * 9.81f / 32768.0f;
-    static constexpr float GYRO_SCALE = 1000.0f * 0.01745329f / 32768.0f;
 
-    icm20948_data data;
+    // Published scale descriptors must track the configured ranges
+    static_assert(icm20948_data::accel_scale.gain == (2 << ACCEL_RANGE) * units::GRAVITY / 32768.0);
+    static_assert(icm20948_data::gyro_scale.gain == (250 << GYRO_RANGE) * units::DEG_TO_RAD / 32768.0);
+
+    icm20948_data data{};
     uint8_t current_bank;
+    bool mag_present = false;
     
     bool select_bank(uint8_t bank) {
         if (current_bank == bank) {
@@ -38,6 +81,85 @@ private:
         return false;
     }
 
+    // Single AK09916 register transfer through slave 4; blocks until done.
+    // Leaves bank 3 selected.
+    bool mag_transfer(uint8_t reg, uint8_t* value, bool read) {
+        if (!select_bank(3) ||
+            !write_register(REG_I2C_SLV4_ADDR, AK09916_ADDRESS | (read ? I2C_SLV_READ : 0)) ||
+            !write_register(REG_I2C_SLV4_REG, reg) ||
+            (!read && !write_register(REG_I2C_SLV4_DO, *value)) ||
+            !write_register(REG_I2C_SLV4_CTRL, I2C_SLV_EN)) {
+            return false;
+        }
+
+        // SLV4_DONE lives in bank 0
+        if (!select_bank(0)) {
+            return false;
+        }
+        uint32_t start = time_us_32();
+        uint8_t status = 0;
+        do {
+            if (!read_register(REG_I2C_MST_STATUS, &status)) {
+                return false;
+            }
+            if (time_us_32() - start > SLV4_TIMEOUT_US) {
+                return false;
+            }
+        } while (!(status & I2C_SLV4_DONE));
+
+        if (status & I2C_SLV4_NACK) {
+            return false;
+        }
+        if (read) {
+            return select_bank(3) && read_register(REG_I2C_SLV4_DI, value);
+        }
+        return select_bank(3);
+    }
+
+    bool mag_write(uint8_t reg, uint8_t value) {
+        return mag_transfer(reg, &value, false);
+    }
+
+    bool mag_read(uint8_t reg, uint8_t* value) {
+        return mag_transfer(reg, value, true);
+    }
+
+    // Internal I2C master reads ST1..ST2 into EXT_SLV_SENS_DATA every sample
+    bool init_magnetometer() {
+        if (!select_bank(0) ||
+            !write_register(REG_USER_CTRL, USER_CTRL_I2C_MST_RST)) {
+            return false;
+        }
+        sleep_ms(1);
+        if (!write_register(REG_USER_CTRL, USER_CTRL_I2C_MST_EN)) {
+            return false;
+        }
+
+        if (!select_bank(3) ||
+            !write_register(REG_I2C_MST_CTRL, I2C_MST_CLK_345KHZ | I2C_MST_P_NSR)) {
+            return false;
+        }
+
+        uint8_t id = 0;
+        if (!mag_read(AK09916_REG_WIA2, &id) || id != AK09916_EXPECTED_ID) {
+            printf("%s: AK09916 not found (WIA2 0x%02X)\n", Traits::name, id);
+            return false;
+        }
+
+        if (!mag_write(AK09916_REG_CNTL3, AK09916_SRST)) {
+            return false;
+        }
+        sleep_ms(1);
+        if (!mag_write(AK09916_REG_CNTL2, AK09916_MODE_CONT_100HZ)) {
+            return false;
+        }
+
+        return select_bank(3) &&
+               write_register(REG_I2C_SLV0_ADDR, AK09916_ADDRESS | I2C_SLV_READ) &&
+               write_register(REG_I2C_SLV0_REG, AK09916_REG_ST1) &&
+               write_register(REG_I2C_SLV0_CTRL, I2C_SLV_EN | MAG_READ_LEN);
+    }
+
 public:
     ICM20948() : I2CDriverBase(), current_bank(0xFF) {
         data.valid = false;
@@ -90,6 +212,12 @@ public:
             return false;
         }
         
+        // Magnetometer is optional: accel/gyro keep working without it
+        mag_present = init_magnetometer();
+        if (!mag_present) {
+            printf("%s: Magnetometer unavailable, continuing 6-axis\n", Traits::name);
+        }
+
         if (!select_bank(0)) {
             printf("%s: Failed to return to bank 0\n", Traits::name);
             return false;
@@ -114,30 +242,25 @@ public:
             }
         }
         
-        // Read accel + gyro data (12 bytes)
-        uint8_t raw_data[12];
-        if (!read_registers(REG_ACCEL_XOUT_H, raw_data, 12)) {
+        // Accel, gyro, temperature and the magnetometer slave data in one burst
+        uint8_t raw_data[BURST_LEN];
+        if (!read_registers(REG_ACCEL_XOUT_H, raw_data, BURST_LEN)) {
             return false;
         }
         
-        // Parse accelerometer data (bytes 0-5)
-        int16_t accel_x_raw = utils::merge_bytes<int16_t>(raw_data[0], raw_data[1]);
-        int16_t accel_y_raw = utils::merge_bytes<int16_t>(raw_data[2], raw_data[3]);
-        int16_t accel_z_raw = utils::merge_bytes<int16_t>(raw_data[4], raw_data[5]);
-        
-        // Parse gyroscope data (bytes 6-11)
-        int16_t gyro_x_raw = utils::merge_bytes<int16_t>(raw_data[6], raw_data[7]);
-        int16_t gyro_y_raw = utils::merge_bytes<int16_t>(raw_data[8], raw_data[9]);
-        int16_t gyro_z_raw = utils::merge_bytes<int16_t>(raw_data[10], raw_data[11]);
-        
-        // Convert to SI units using compile-time scale factors
-        data.accel_x = accel_x_raw * ACCEL_SCALE;
-        data.accel_y = accel_y_raw * ACCEL_SCALE;
-        data.accel_z = accel_z_raw * ACCEL_SCALE;
-        
-        data.gyro_x = gyro_x_raw * GYRO_SCALE;
-        data.gyro_y = gyro_y_raw * GYRO_SCALE;
-        data.gyro_z = gyro_z_raw * GYRO_SCALE;
+        // Accel (bytes 0-5) then gyro (bytes 6-11), big-endian
+        for (int axis = 0; axis < 3; ++axis) {
+            data.accel[axis] = utils::merge_bytes<int16_t>(raw_data[axis * 2], raw_data[axis * 2 + 1]);
+            data.gyro[axis] = utils::merge_bytes<int16_t>(raw_data[6 + axis * 2], raw_data[7 + axis * 2]);
+        }
+        data.temperature = utils::merge_bytes<int16_t>(raw_data[12], raw_data[13]);
+
+        // AK09916 block: ST1, X/Y/Z little-endian, TMPS, ST2
+        const uint8_t* mag = &raw_data[REG_EXT_SLV_SENS_DATA_00 - REG_ACCEL_XOUT_H];
+        for (int axis = 0; axis < 3; ++axis) {
+            data.mag[axis] = utils::merge_bytes<int16_t>(mag[2 + axis * 2], mag[1 + axis * 2]);
+        }
+        data.mag_valid = mag_present && !(mag[8] & AK09916_ST2_HOFL);
         
         data.valid = true;
         
@@ -6,36 +6,13 @@ namespace i2c::drivers {
 
 class MS4525D0 : public I2CDriverBase<MS4525D0> {
 private:
-    // MS4525DO-DS5A1 (±5 inches H2O variant)
-    static constexpr float P_MIN = -5.0f;              // -5 inH2O
-    static constexpr float P_MAX = 5.0f;               // +5 inH2O
-    static constexpr float INH2O_TO_PA = 249.089f;     // Conversion factor
-    
-    // Transfer function constants (14-bit ADC)
-    static constexpr float OUTPUT_MIN = 0.1f * 16383.0f;   // 10% of 2^14-1
-    static constexpr float OUTPUT_SPAN = 0.8f * 16383.0f;  // 80% of 2^14-1
-    
-    // Temperature constants (11-bit)
-    static constexpr float TEMP_SCALE = 200.0f / 2047.0f;
-    static constexpr float TEMP_OFFSET = -50.0f;
-    
     // Status bits in first byte
     static constexpr uint8_t STATUS_MASK = 0xC0;
     static constexpr uint8_t STATUS_NORMAL = 0x00;
     static constexpr uint8_t STATUS_STALE = 0x80;
     static constexpr uint8_t STATUS_FAULT = 0xC0;
     
-    ms4525d0_data data;
-    
-    float calculate_pressure(uint16_t raw) {
-        float diff_press_inH2O = ((raw - OUTPUT_MIN) / OUTPUT_SPAN) * (P_MAX - P_MIN) + P_MIN;
-        return diff_press_inH2O * INH2O_TO_PA;
-    }
-    
-    float calculate_temperature(uint16_t raw) {
-        uint16_t temp_raw = raw >> 5;
-        return (temp_raw * TEMP_SCALE) + TEMP_OFFSET;
-    }
+    ms4525d0_data data{};
 
 public:
     MS4525D0() : I2CDriverBase() {
@@ -82,15 +59,10 @@ public:
             return false;
         }
         
-        // Extract 14-bit pressure value (first byte status bits masked, plus second byte)
-        uint16_t pressure_raw = ((raw_data[0] & 0x3F) << 8) | raw_data[1];
-        
-        // Extract 11-bit temperature value (last 5 bits of byte 2, plus byte 3)
-        uint16_t temp_raw = (raw_data[2] << 8) | raw_data[3];
-        
-        // Calculate values
-        data.pressure_pa = calculate_pressure(pressure_raw);
-        data.temperature_c = calculate_temperature(temp_raw);
+        // 14-bit pressure (status bits masked) and 11-bit temperature (top of bytes 2-3)
+        data.pressure_raw = ((raw_data[0] & 0x3F) << 8) | raw_data[1];
+        data.temperature_raw = ((raw_data[2] << 8) | raw_data[3]) >> 5;
+        data.status = status;   // Stale samples are passed on for the consumer to reject
         data.valid = true;
         
         return true;
@@ -13,7 +13,13 @@
 #include <concepts>
 #include <type_traits>
 
-#include <hardware\i2c.h>
+#include <hardware/i2c.h>
+
+#include "i2c_units.h"
+
+extern "C" {
+#include "sh2_SensorValue.h"
+}
 
 namespace i2c {
 
@@ -30,36 +36,73 @@ static constexpr uint32_t MAX_ERRORS = 10;
 // DRIVER FORWARD DECLARATIONS
 // ============================================================================
 namespace i2c::drivers {
+    // Drivers publish raw counts; the static Scale members convert on demand.
     class ICM20948;
     struct icm20948_data {
-        float accel_x;
-        float accel_y;
-        float accel_z;
-        float gyro_x;
-        float gyro_y;
-        float gyro_z;
+        int16_t accel[3];
+        int16_t gyro[3];
+        int16_t mag[3];             // AK09916 sensor frame
+        int16_t temperature;
+        bool mag_valid;             // Magnetometer present and not overflowed
         bool valid;
+
+        // ACCEL_CONFIG FS_SEL=2 (+/-8 g), GYRO_CONFIG_1 FS_SEL=2 (+/-1000 dps)
+        static constexpr units::Scale accel_scale{8.0 * units::GRAVITY / 32768.0};          // m/s^2
+        static constexpr units::Scale gyro_scale{1000.0 * units::DEG_TO_RAD / 32768.0};     // rad/s
+        static constexpr units::Scale mag_scale{0.15};                                      // uT
+        static constexpr units::Scale temperature_scale{1.0 / 333.87, 21.0};                // degC
+
+        float accel_mps2(int axis) const { return accel_scale.to_float(accel[axis]); }
+        float gyro_rads(int axis) const { return gyro_scale.to_float(gyro[axis]); }
+        float mag_ut(int axis) const { return mag_scale.to_float(mag[axis]); }
+        float temperature_c() const { return temperature_scale.to_float(temperature); }
     };
     
     class BMP581;
     struct bmp581_data {
-        float temperature;
-        float pressure;
-        float altitude;
+        int32_t temperature_raw;
+        uint32_t pressure_raw;
         bool valid;
+
+        static constexpr units::Scale temperature_scale{1.0 / 65536.0};    // degC
+        static constexpr units::Scale pressure_scale{1.0 / 64.0};          // Pa
+
+        float temperature_c() const { return temperature_scale.to_float(temperature_raw); }
+        float pressure_pa() const { return pressure_scale.to_float(static_cast<int32_t>(pressure_raw)); }
+        float altitude_m() const { return units::altitude_m(pressure_raw); }
     };
     
     class MS4525D0;
     struct ms4525d0_data {
-        float pressure_pa;
-        float temperature_c;
+        uint16_t pressure_raw;      // 14-bit
+        uint16_t temperature_raw;   // 11-bit
+        uint8_t status;             // Status bits 7:6 of the first byte (0 normal, 0x80 stale)
         bool valid;
+
+        // MS4525DO-DS5A1 (+/-5 inH2O), output type A: 10%..90% of 2^14-1
+        static constexpr units::Scale pressure_scale{
+            10.0 * units::INH2O_TO_PA / (0.8 * 16383.0),
+            -0.1 * 16383.0 * 10.0 * units::INH2O_TO_PA / (0.8 * 16383.0) - 5.0 * units::INH2O_TO_PA};   // Pa
+        static constexpr units::Scale temperature_scale{200.0 / 2047.0, -50.0};                        // degC
+
+        float pressure_pa() const { return pressure_scale.to_float(pressure_raw); }
+        float temperature_c() const { return temperature_scale.to_float(temperature_raw); }
+        int32_t pressure_mpa() const { return pressure_scale.then(1000.0).to_fixed<0>(pressure_raw); }
+        float airspeed_mps() const { return units::airspeed_mm_s(pressure_mpa()) * 0.001f; }
     };
 
     class ADS1115;
     struct ads1115_data {
         int16_t raw;
-        float voltage;
+        bool valid;
+    };
+
+    // Decoded SH2 reports delivered by one service of the sensor hub
+    class BNO08x;
+    struct bno08x_data {
+        static constexpr size_t MAX_VALUES = 8;
+        std::array<sh2_SensorValue_t, MAX_VALUES> values;
+        uint8_t count;
         bool valid;
     };
 }
@@ -92,7 +135,7 @@ template<>
 struct DeviceTraits<i2c::drivers::MS4525D0> {
     static constexpr uint8_t address = 0x58;
     static constexpr const char* name = "MS4525D0";
-    static constexpr uint32_t default_poll_rate = 500;  // 50Hz for airspeed
+    static constexpr uint32_t default_poll_rate = 500;  // Full-rate airspeed pipeline
     using data_type = drivers::ms4525d0_data;
 };
 
@@ -104,4 +147,12 @@ struct DeviceTraits<i2c::drivers::ADS1115> {
     using data_type = drivers::ads1115_data;
 };
 
+template<>
+struct DeviceTraits<i2c::drivers::BNO08x> {
+    static constexpr uint8_t address = 0x4A; // SA0 low
+    static constexpr const char* name = "BNO08x";
+    static constexpr uint32_t default_poll_rate = 400; // INT check; bus traffic only when asserted
+    using data_type = drivers::bno08x_data;
+};
+
 } // namespace i2c
\ No newline at end of file
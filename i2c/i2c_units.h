@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * @file i2c_units.h
+ * @brief Compile-time scale descriptors and integer conversion kernels
+ *
+ * Drivers publish raw integer samples; each data type carries a constexpr
+ * Scale describing how to turn a raw count into engineering units. Consumers
+ * convert lazily, only the fields they actually use, either to float or to
+ * fixed point with a precomputed integer multiplier.
+ *
+ * Example Usage:
+ *
+ *   void on_imu(const icm20948_data& d) {
+ *       float az = d.accel_scale.to_float(d.accel[2]);             // m/s^2
+ *       fixed::q16_t gz = d.gyro_scale.to_fixed<16>(d.gyro[2]);    // rad/s, Q16.16
+ *   }
+ *
+ *   int32_t alt_mm = i2c::units::altitude_mm(baro.pressure_raw);
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/fixed_point.h"
+
+namespace i2c::units {
+
+static constexpr double GRAVITY = 9.80665;                      // m/s^2
+static constexpr double DEG_TO_RAD = 0.017453292519943295;
+static constexpr double INH2O_TO_PA = 249.089;
+static constexpr double SEA_LEVEL_PRESSURE = 101325.0;          // Pa
+static constexpr uint32_t SEA_LEVEL_DENSITY_G_M3 = 1225;        // ISA, g/m^3
+
+// ============================================================================
+// SCALE DESCRIPTOR
+// ============================================================================
+// value = raw * gain + offset
+struct Scale {
+    double gain;
+    double offset = 0.0;
+
+    constexpr float to_float(int32_t raw) const {
+        return static_cast<float>(raw) * static_cast<float>(gain) + static_cast<float>(offset);
+    }
+
+    // Fixed point with `Frac` fractional bits, single 64-bit multiply
+    template<int Frac>
+    constexpr int32_t to_fixed(int32_t raw) const {
+        constexpr int EXTRA = 16;
+        const int64_t mult = round_to_int(gain * static_cast<double>(int64_t{1} << (Frac + EXTRA)));
+        const int64_t bias = round_to_int(offset * static_cast<double>(int64_t{1} << (Frac + EXTRA)));
+        return static_cast<int32_t>((raw * mult + bias) >> EXTRA);
+    }
+
+    // Compose a further affine step applied to this scale's output
+    constexpr Scale then(double k, double b = 0.0) const {
+        return Scale{gain * k, offset * k + b};
+    }
+
+private:
+    static constexpr int64_t round_to_int(double value) {
+        return static_cast<int64_t>(value + (value >= 0 ? 0.5 : -0.5));
+    }
+};
+
+// ============================================================================
+// ALTITUDE (table-driven barometric formula)
+// ============================================================================
+namespace detail {
+
+// Input is BMP581 raw pressure: Pa in Q6 (1/64 Pa)
+static constexpr int PRESSURE_FRAC_BITS = 6;
+static constexpr uint32_t ALT_PMIN_PA = 30'000;                 // ~9.2 km
+static constexpr uint32_t ALT_PMAX_PA = 110'000;                // ~ -760 m
+static constexpr int ALT_STEP_SHIFT = 9;                        // 512 Pa per entry
+static constexpr int ALT_INDEX_SHIFT = ALT_STEP_SHIFT + PRESSURE_FRAC_BITS;
+static constexpr size_t ALT_ENTRIES = ((ALT_PMAX_PA - ALT_PMIN_PA) >> ALT_STEP_SHIFT) + 2;
+
+struct AltitudeTable {
+    int32_t mm[ALT_ENTRIES];
+};
+
+constexpr AltitudeTable make_altitude_table() {
+    AltitudeTable table{};
+    for (size_t i = 0; i < ALT_ENTRIES; ++i) {
+        const double p = ALT_PMIN_PA + static_cast<double>(i << ALT_STEP_SHIFT);
+        const double h = 44330.0 * (1.0 - fixed::cmath::pow(p / SEA_LEVEL_PRESSURE, 0.1903));
+        table.mm[i] = static_cast<int32_t>(h * 1000.0 + (h >= 0 ? 0.5 : -0.5));
+    }
+    return table;
+}
+
+inline constexpr AltitudeTable ALTITUDE_TABLE = make_altitude_table();
+
+} // namespace detail
+
+// Pressure altitude in mm from raw Q6 pressure; linear interpolation between
+// 512 Pa entries is within 0.02 m near sea level and 0.2 m at 30 kPa.
+constexpr int32_t altitude_mm(uint32_t pressure_q6) {
+    using namespace detail;
+    constexpr uint32_t MIN_Q6 = ALT_PMIN_PA << PRESSURE_FRAC_BITS;
+    constexpr uint32_t MAX_Q6 = ALT_PMAX_PA << PRESSURE_FRAC_BITS;
+    constexpr uint32_t FRAC_MASK = (1u << ALT_INDEX_SHIFT) - 1;
+
+    if (pressure_q6 < MIN_Q6) pressure_q6 = MIN_Q6;
+    if (pressure_q6 > MAX_Q6) pressure_q6 = MAX_Q6;
+
+    const uint32_t offset = pressure_q6 - MIN_Q6;
+    const uint32_t index = offset >> ALT_INDEX_SHIFT;
+    const int64_t frac = offset & FRAC_MASK;
+
+    const int32_t h0 = ALTITUDE_TABLE.mm[index];
+    const int32_t h1 = ALTITUDE_TABLE.mm[index + 1];
+    return h0 + static_cast<int32_t>(((h1 - h0) * frac) >> ALT_INDEX_SHIFT);
+}
+
+constexpr float altitude_m(uint32_t pressure_q6) {
+    return altitude_mm(pressure_q6) * 0.001f;
+}
+
+// ============================================================================
+// AIRSPEED
+// ============================================================================
+// v = sqrt(2 * dp / rho), dp in mPa, rho in g/m^3, result in mm/s.
+// Defaults to ISA sea-level density (indicated airspeed).
+constexpr uint32_t airspeed_mm_s(int32_t dp_mpa, uint32_t rho_g_m3 = SEA_LEVEL_DENSITY_G_M3) {
+    if (dp_mpa <= 0 || rho_g_m3 == 0) {
+        return 0;
+    }
+    return fixed::isqrt(uint64_t{2'000'000} * static_cast<uint64_t>(dp_mpa) / rho_g_m3);
+}
+
+} // namespace i2c::units
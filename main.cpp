@@ -2,6 +2,7 @@
 #include "pico/stdio.h"
 #include "pico/multicore.h"
 #include "pico/bootrom.h"
+#include "pico/flash.h"
 #include "hardware/resets.h"
 
 #include "app/Core0Controller.h"
@@ -28,6 +29,8 @@ int main() {
 
     printf("System: Initializing Core 0...\n");
     if (core0_controller.init()) {
+        // Let Core 1 park this core while it writes the config store
+        flash_safe_execute_core_init();
         printf("System: Launching Core 1...\n");
         multicore_launch_core1(core1_entry);
         sleep_ms(10);
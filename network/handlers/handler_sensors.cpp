@@ -11,13 +11,17 @@ namespace network::handlers {
         if (g_shared_state.session_active.load()) {
             len = snprintf(body, sizeof(body),
                 "{"
-                "\"airspeed\":{\"value\":%.2f,\"unit\":\"m/s\"},"
+                "\"airspeed\":{\"value\":%.2f,\"ias\":%.2f,\"dp\":%.1f,\"unit\":\"m/s\"},"
                 "\"force\":{\"value\":%.2f,\"unit\":\"N\"},"
                 "\"power\":{\"value\":%.2f,\"unit\":\"W\"},"
                 "\"accel\":{\"x\":%.2f,\"y\":%.2f,\"z\":%.2f,\"unit\":\"m/s²\"},"
-                "\"gyro\":{\"x\":%.3f,\"y\":%.3f,\"z\":%.3f,\"unit\":\"rad/s\"}"
+                "\"gyro\":{\"x\":%.3f,\"y\":%.3f,\"z\":%.3f,\"unit\":\"rad/s\"},"
+                "\"attitude\":{\"roll\":%.2f,\"pitch\":%.2f,\"yaw\":%.2f,\"unit\":\"deg\"},"
+                "\"quaternion\":{\"w\":%.4f,\"x\":%.4f,\"y\":%.4f,\"z\":%.4f}"
                 "}",
                 g_shared_state.airspeed.load(),
+                g_shared_state.airspeed_ias.load(),
+                g_shared_state.dynamic_pressure.load(),
                 g_shared_state.force_value.load(),
                 g_shared_state.power.load(),
                 g_shared_state.accel_x.load(),
@@ -25,7 +29,14 @@ namespace network::handlers {
                 g_shared_state.accel_z.load(),
                 g_shared_state.gyro_x.load(),
                 g_shared_state.gyro_y.load(),
-                g_shared_state.gyro_z.load());
+                g_shared_state.gyro_z.load(),
+                g_shared_state.roll.load(),
+                g_shared_state.pitch.load(),
+                g_shared_state.yaw.load(),
+                g_shared_state.quat_w.load(),
+                g_shared_state.quat_x.load(),
+                g_shared_state.quat_y.load(),
+                g_shared_state.quat_z.load());
         } else {
             len = snprintf(body, sizeof(body),
                 "{"
@@ -33,13 +44,15 @@ namespace network::handlers {
                 "\"force\":\"%s\","
                 "\"power\":\"%s\","
                 "\"accel\":\"%s\","
-                "\"gyro\":\"%s\""
+                "\"gyro\":\"%s\","
+                "\"attitude\":\"%s\""
                 "}",
                 g_shared_state.airspeed_ready.load() ? "READY" : "FAILED",
                 g_shared_state.force_sensor_ready.load() ? "READY" : "FAILED",
                 g_shared_state.power_ready.load() ? "READY" : "FAILED",
                 g_shared_state.accel_ready.load() ? "READY" : "FAILED",
-                g_shared_state.gyro_ready.load() ? "READY" : "FAILED");
+                g_shared_state.gyro_ready.load() ? "READY" : "FAILED",
+                g_shared_state.attitude_ready.load() ? "READY" : "FAILED");
         }
 
         if (len > 0 && static_cast<size_t>(len) < sizeof(body)) {
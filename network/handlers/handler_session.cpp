@@ -19,6 +19,8 @@ namespace network::handlers {
         bool expected = true;
         if (g_shared_state.session_active.compare_exchange_strong(expected, false)) {
             g_shared_state.airspeed.store(0.0f);
+            g_shared_state.airspeed_ias.store(0.0f);
+            g_shared_state.dynamic_pressure.store(0.0f);
             g_shared_state.force_value.store(0.0f);
             g_shared_state.power.store(0.0f);
             g_shared_state.accel_x.store(0.0f);
@@ -27,6 +29,9 @@ namespace network::handlers {
             g_shared_state.gyro_x.store(0.0f);
             g_shared_state.gyro_y.store(0.0f);
             g_shared_state.gyro_z.store(0.0f);
+            g_shared_state.roll.store(0.0f);
+            g_shared_state.pitch.store(0.0f);
+            g_shared_state.yaw.store(0.0f);
             g_shared_state.session_start_time.store(0);
             SendJsonResponse(conn, "{\"status\":\"stopped\"}");
         } else {
@@ -20,9 +20,12 @@ namespace network::handlers {
         std::atomic<bool> power_ready{false};
         std::atomic<bool> accel_ready{false};
         std::atomic<bool> gyro_ready{false};
+        std::atomic<bool> attitude_ready{false};
 
         // Sensor values (only valid when session is active)
-        std::atomic<float> airspeed{0.0f};          // m/s
+        std::atomic<float> airspeed{0.0f};          // m/s, true airspeed
+        std::atomic<float> airspeed_ias{0.0f};      // m/s, indicated
+        std::atomic<float> dynamic_pressure{0.0f};  // Pa
         std::atomic<float> force_value{0.0f};       // N
         std::atomic<float> power{0.0f};             // W
         std::atomic<float> accel_x{0.0f};           // m/s²
@@ -31,6 +34,15 @@ namespace network::handlers {
         std::atomic<float> gyro_x{0.0f};            // rad/s
         std::atomic<float> gyro_y{0.0f};            // rad/s
         std::atomic<float> gyro_z{0.0f};            // rad/s
+
+        // Attitude estimate (AHRS on Core 1)
+        std::atomic<float> roll{0.0f};              // deg
+        std::atomic<float> pitch{0.0f};             // deg
+        std::atomic<float> yaw{0.0f};               // deg
+        std::atomic<float> quat_w{1.0f};
+        std::atomic<float> quat_x{0.0f};
+        std::atomic<float> quat_y{0.0f};
+        std::atomic<float> quat_z{0.0f};
     };
 
     inline SharedState g_shared_state{};
@@ -0,0 +1,182 @@
+#include "adc_sim.h"
+
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include "hardware/adc.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+
+namespace {
+
+adc_hw_t g_adc_registers{};
+
+} // anonymous namespace
+
+adc_hw_t* const adc_hw = &g_adc_registers;
+
+namespace sim::adc {
+
+namespace {
+
+constexpr unsigned int INPUT_COUNT = 5;
+constexpr size_t FIFO_DEPTH = 4;
+constexpr uint64_t ADC_CLOCK_HZ = 48'000'000;
+constexpr uint64_t CYCLES_PER_US = ADC_CLOCK_HZ / 1'000'000;
+constexpr double CONVERSION_CYCLES = 96.0;
+constexpr double REFERENCE_VOLTS = 3.3;
+
+struct State {
+    bool running = false;
+    bool fifo_enabled = false;
+    unsigned int input = 0;
+    unsigned int round_robin = 0;
+    double period_cycles = CONVERSION_CYCLES;
+    double next_cycle = 0.0;        // ADC clock cycle the next result is ready at
+};
+
+State g_state{};
+std::array<Waveform, INPUT_COUNT> g_inputs{};
+std::deque<uint16_t> g_fifo;
+std::vector<Conversion> g_history;
+Stats g_stats{};
+
+uint16_t convert(unsigned int input, double t_s) {
+    const double code = std::round(g_inputs[input](t_s) / REFERENCE_VOLTS * 4096.0);
+    return static_cast<uint16_t>(std::clamp(code, 0.0, 4095.0));
+}
+
+// Next input in the round-robin mask after the current one, wrapping
+unsigned int next_input(unsigned int input, unsigned int mask) {
+    for (unsigned int step = 1; step <= INPUT_COUNT; ++step) {
+        const unsigned int candidate = (input + step) % INPUT_COUNT;
+        if (mask & (1u << candidate)) {
+            return candidate;
+        }
+    }
+    return input;
+}
+
+void advance_to_us(uint64_t target_us) {
+    if (target_us > sim::now_us()) {
+        sim::run_for(target_us - sim::now_us());
+    }
+}
+
+void conversion_done() {
+    const uint16_t code = convert(g_state.input, g_state.next_cycle / ADC_CLOCK_HZ);
+    g_history.push_back(Conversion{static_cast<uint8_t>(g_state.input), code});
+    g_stats.conversions++;
+    adc_hw->result = code;
+
+    if (g_state.fifo_enabled) {
+        if (g_fifo.size() < FIFO_DEPTH) {
+            g_fifo.push_back(code);
+        } else {
+            g_stats.fifo_overflows++;
+        }
+        sim::uart::pump_dma();
+    }
+    if (g_state.round_robin) {
+        g_state.input = next_input(g_state.input, g_state.round_robin);
+    }
+}
+
+} // anonymous namespace
+
+void reset() {
+    g_adc_registers = adc_hw_t{};
+    g_state = State{};
+    g_inputs.fill(Waveform{});
+    g_fifo.clear();
+    g_history.clear();
+    g_stats = Stats{};
+}
+
+void set_input(unsigned int input, Waveform volts) {
+    if (input < INPUT_COUNT) {
+        g_inputs[input] = std::move(volts);
+    }
+}
+
+void run(uint64_t duration_us) {
+    const uint64_t end_us = sim::now_us() + duration_us;
+    const double end_cycle = static_cast<double>(end_us * CYCLES_PER_US);
+
+    while (g_state.running && g_state.next_cycle <= end_cycle) {
+        advance_to_us(static_cast<uint64_t>(g_state.next_cycle) / CYCLES_PER_US);
+        if (!g_state.running) {
+            break;              // Stopped by a timer callback
+        }
+        conversion_done();
+        g_state.next_cycle += g_state.period_cycles;
+    }
+    advance_to_us(end_us);
+}
+
+const std::vector<Conversion>& history() { return g_history; }
+
+Stats stats() { return g_stats; }
+
+bool is_fifo(uintptr_t address) {
+    return address == reinterpret_cast<uintptr_t>(&adc_hw->fifo);
+}
+
+bool take_fifo(uint32_t& value) {
+    if (g_fifo.empty()) {
+        return false;
+    }
+    value = g_fifo.front();
+    g_fifo.pop_front();
+    return true;
+}
+
+} // namespace sim::adc
+
+// ============================================================================
+// PICO SDK SHIMS
+// ============================================================================
+using sim::adc::g_state;
+
+void adc_init() {
+    g_state = sim::adc::State{};
+    sim::adc::g_fifo.clear();
+}
+
+void adc_gpio_init(unsigned int /*gpio*/) {}
+
+void adc_select_input(unsigned int input) {
+    g_state.input = input % sim::adc::INPUT_COUNT;
+}
+
+unsigned int adc_get_selected_input() {
+    return g_state.input;
+}
+
+void adc_set_round_robin(unsigned int input_mask) {
+    g_state.round_robin = input_mask & ((1u << sim::adc::INPUT_COUNT) - 1);
+}
+
+void adc_set_temp_sensor_enabled(bool /*enable*/) {}
+
+void adc_set_clkdiv(float clkdiv) {
+    g_state.period_cycles = std::max(sim::adc::CONVERSION_CYCLES, 1.0 + clkdiv);
+}
+
+void adc_fifo_setup(bool en, bool /*dreq_en*/, uint16_t /*dreq_thresh*/, bool /*err_in_fifo*/, bool /*byte_shift*/) {
+    g_state.fifo_enabled = en;
+}
+
+void adc_fifo_drain() {
+    sim::adc::g_fifo.clear();
+}
+
+void adc_run(bool run) {
+    if (run && !g_state.running) {
+        g_state.next_cycle = static_cast<double>(sim::now_us() * sim::adc::CYCLES_PER_US) + g_state.period_cycles;
+    }
+    g_state.running = run;
+}
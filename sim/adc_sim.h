@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file adc_sim.h
+ * @brief Host-side model of the on-chip ADC for running adc/native_adc.h
+ *
+ * Backs the hardware/adc.h shim in sim/include/:
+ * - Each input follows a Waveform in volts at the pin, converted to 12 bits
+ *   against a 3.3 V reference and clamped to the code range.
+ * - While adc_run() is on, run() advances virtual time one conversion at a
+ *   time: every 1 + clkdiv cycles of the 48 MHz ADC clock, never faster than
+ *   the 96 cycles a conversion takes. With a round-robin mask set, the input
+ *   steps to the next one in the mask after every conversion, as on the
+ *   RP2350.
+ * - Results go into the 4-deep FIFO, which a DMA channel paced by DREQ_ADC
+ *   drains (see uart_sim.h). A result arriving with the FIFO full is lost.
+ * - Every conversion is recorded, so a bench can check what the consumer made
+ *   of each one.
+ *
+ * Example Usage:
+ *
+ *   sim::adc::set_input(0, sim::Waveform::sine(1.0, 50.0, 1.65));
+ *   adc::NativeADC capture;
+ *   capture.init({.input_mask = 0b0001});
+ *   sim::adc::run(1000);                      // 1 ms of conversions
+ *   capture.process();
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "waveform.h"
+
+namespace sim::adc {
+
+struct Conversion {
+    uint8_t input;
+    uint16_t code;
+};
+
+struct Stats {
+    uint64_t conversions = 0;
+    uint64_t fifo_overflows = 0;    // Results lost with the FIFO full
+};
+
+// Stop conversions, clear the FIFO, the recorded conversions, the counters and
+// every input waveform. Call after sim::uart::reset(), which frees the DMA.
+void reset();
+
+// Volts at ADC input `input` (4 is the temperature sensor).
+void set_input(unsigned int input, Waveform volts);
+
+// Advance virtual time by `duration_us`, converting as the ADC clock runs.
+// Repeating timers fire as time passes (see sim::run_for()).
+void run(uint64_t duration_us);
+
+// Every conversion since reset(), oldest first.
+const std::vector<Conversion>& history();
+
+Stats stats();
+
+// DMA side: true if `address` is the FIFO register, and the oldest result in
+// the FIFO if there is one.
+bool is_fifo(uintptr_t address);
+bool take_fifo(uint32_t& value);
+
+} // namespace sim::adc
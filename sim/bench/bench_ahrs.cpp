@@ -0,0 +1,252 @@
+/**
+ * @file bench_ahrs.cpp
+ * @brief Accuracy and per-update cost of the AHRS filters on the host
+ *
+ * Runs the same pipeline as Core 1: ICM20948 model -> driver polled by
+ * I2CDevice -> ahrs::Estimator::push() -> process() every 1 ms loop.
+ *
+ * The IMU input is either a synthetic trajectory with known truth (default)
+ * or a recorded trace:
+ *
+ *   bench_ahrs [--csv imu.csv] [--seconds N]
+ *
+ * CSV columns: t_s, ax, ay, az (m/s^2), gx, gy, gz (rad/s)[, roll, pitch (deg)].
+ * Without truth columns only cost and final attitude are reported.
+ *
+ * Cost is host nanoseconds per filter update. The run fails (exit 1) when the
+ * mean exceeds ahrs::Config::cycle_budget interpreted as nanoseconds, a loose
+ * bound that flags regressions; on target the Estimator counts real cycles.
+ */
+
+#include "i2c.h"
+#include "ahrs/ahrs.h"
+
+#include "i2c_sim.h"
+#include "models/icm20948_model.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double TRUTH_RATE_HZ = 10'000.0;
+constexpr double SETTLE_S = 5.0;
+constexpr double RAD_TO_DEG = 57.29577951308232;
+
+struct Trajectory {
+    std::vector<ahrs::Quaternion> q;    // Body to world, at TRUTH_RATE_HZ
+    std::vector<ahrs::Vec3> gyro;       // rad/s, body frame
+    bool has_truth = true;
+
+    size_t index(double t) const {
+        auto i = static_cast<size_t>(t * TRUTH_RATE_HZ);
+        return i < q.size() ? i : q.size() - 1;
+    }
+};
+
+// Specific force of a stationary-in-translation body: world +Z gravity reaction
+ahrs::Vec3 gravity_in_body(const ahrs::Quaternion& q) {
+    const double g = i2c::units::GRAVITY;
+    return ahrs::Vec3{
+        static_cast<float>(2.0 * (q.x * q.z - q.w * q.y) * g),
+        static_cast<float>(2.0 * (q.w * q.x + q.y * q.z) * g),
+        static_cast<float>((q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z) * g),
+    };
+}
+
+// Smooth roll/pitch/yaw manoeuvres integrated from body rates
+Trajectory make_synthetic(double seconds) {
+    Trajectory traj;
+    const size_t count = static_cast<size_t>(seconds * TRUTH_RATE_HZ) + 1;
+    traj.q.reserve(count);
+    traj.gyro.reserve(count);
+
+    ahrs::Quaternion q{};
+    const double dt = 1.0 / TRUTH_RATE_HZ;
+    for (size_t i = 0; i < count; ++i) {
+        const double t = i * dt;
+        const ahrs::Vec3 w{
+            static_cast<float>(0.8 * std::sin(2.0 * M_PI * 0.20 * t)),
+            static_cast<float>(0.5 * std::sin(2.0 * M_PI * 0.13 * t + 1.0)),
+            static_cast<float>(0.3 * std::cos(2.0 * M_PI * 0.05 * t)),
+        };
+        traj.q.push_back(q);
+        traj.gyro.push_back(w);
+
+        const double h = 0.5 * dt;
+        ahrs::Quaternion n{
+            static_cast<float>(q.w + (-q.x * w.x - q.y * w.y - q.z * w.z) * h),
+            static_cast<float>(q.x + ( q.w * w.x + q.y * w.z - q.z * w.y) * h),
+            static_cast<float>(q.y + ( q.w * w.y - q.x * w.z + q.z * w.x) * h),
+            static_cast<float>(q.z + ( q.w * w.z + q.x * w.y - q.y * w.x) * h),
+        };
+        n.normalize();
+        q = n;
+    }
+    return traj;
+}
+
+Trajectory load_csv(const char* path, double seconds) {
+    Trajectory traj;
+    traj.has_truth = true;
+
+    sim::Waveform columns[9];
+    for (int c = 0; c < 9; ++c) {
+        columns[c] = sim::Waveform::from_csv(path, c + 1);
+    }
+
+    // Truth columns are optional: a trace without them reads as all zero
+    bool any_truth = false;
+    const size_t count = static_cast<size_t>(seconds * TRUTH_RATE_HZ) + 1;
+    for (size_t i = 0; i < count; ++i) {
+        const double t = i / TRUTH_RATE_HZ;
+        const double roll = columns[6](t) / RAD_TO_DEG;
+        const double pitch = columns[7](t) / RAD_TO_DEG;
+        any_truth |= roll != 0.0 || pitch != 0.0;
+        traj.q.push_back(ahrs::Quaternion::from_euler(ahrs::Euler{
+            static_cast<float>(roll), static_cast<float>(pitch), 0.0f}));
+        traj.gyro.push_back(ahrs::Vec3{
+            static_cast<float>(columns[3](t)), static_cast<float>(columns[4](t)), static_cast<float>(columns[5](t))});
+    }
+    traj.has_truth = any_truth;
+
+    // Accel comes straight from the trace rather than from truth
+    return traj;
+}
+
+struct Result {
+    uint32_t updates;
+    double rms_roll_deg;
+    double rms_pitch_deg;
+    double mean_ns;
+    uint32_t max_ns;
+    uint32_t overruns;
+    ahrs::Euler final;
+};
+
+Result run(const Trajectory& traj, const char* csv, ahrs::FilterType filter,
+           uint32_t rate_hz, double seconds, uint32_t seed) {
+    sim::reset();
+    i2c_init(i2c0, i2c::DEFAULT_BUS_SPEED);
+
+    sim::ICM20948Model imu;
+    if (csv) {
+        for (int axis = 0; axis < 3; ++axis) {
+            imu.accel[axis] = sim::Waveform::from_csv(csv, axis + 1);
+        }
+    } else {
+        for (int axis = 0; axis < 3; ++axis) {
+            imu.accel[axis] = sim::Waveform([&traj, axis](double t) {
+                const ahrs::Vec3 f = gravity_in_body(traj.q[traj.index(t)]);
+                return static_cast<double>(axis == 0 ? f.x : axis == 1 ? f.y : f.z);
+            }).with_noise(0.05, seed + axis);
+        }
+    }
+    const double bias[3] = {0.004, -0.003, 0.002};
+    for (int axis = 0; axis < 3; ++axis) {
+        imu.gyro[axis] = sim::Waveform([&traj, axis, b = csv ? 0.0 : bias[axis]](double t) {
+            const ahrs::Vec3& w = traj.gyro[traj.index(t)];
+            return (axis == 0 ? w.x : axis == 1 ? w.y : w.z) + b;
+        }).with_noise(csv ? 0.0 : 0.005, seed + 10 + axis);
+    }
+    sim::bus(i2c0).attach(imu);
+
+    ahrs::Estimator estimator(ahrs::Config{.filter = filter, .sample_rate_hz = rate_hz});
+
+    i2c::I2CDevice<i2c::drivers::ICM20948> device;
+    device.init(i2c0);
+    const uint64_t start_us = sim::now_us();
+    device.set_callback([&](const i2c::drivers::icm20948_data& d) { estimator.push(d); });
+    device.set_poll_rate(rate_hz);
+    device.start_polling();
+
+    Result result{};
+    double sum_roll = 0.0, sum_pitch = 0.0;
+    uint32_t error_samples = 0;
+    uint64_t filter_ns = 0;
+
+    const uint64_t end_us = start_us + static_cast<uint64_t>(seconds * 1e6);
+    while (sim::now_us() < end_us) {
+        sim::run_for(1000);     // Core 1 loop period
+
+        const uint32_t t0 = cycles::now();
+        const size_t drained = estimator.process();
+        filter_ns += cycles::now() - t0;
+
+        const double t = (sim::now_us() - start_us) * 1e-6;
+        if (drained > 0 && traj.has_truth && t > SETTLE_S) {
+            const ahrs::Euler est = estimator.attitude().euler;
+            const ahrs::Euler ref = traj.q[traj.index(estimator.attitude().timestamp_us * 1e-6)].to_euler();
+            const double dr = std::remainder(est.roll - ref.roll, 2.0 * M_PI);
+            const double dp = est.pitch - ref.pitch;
+            sum_roll += dr * dr;
+            sum_pitch += dp * dp;
+            error_samples++;
+        }
+    }
+    device.stop_polling();
+
+    const ahrs::Stats stats = estimator.stats();
+    result.updates = stats.updates;
+    result.max_ns = stats.max_cycles;
+    result.overruns = stats.budget_overruns;
+    result.mean_ns = stats.updates ? static_cast<double>(filter_ns) / stats.updates : 0.0;
+    result.rms_roll_deg = error_samples ? std::sqrt(sum_roll / error_samples) * RAD_TO_DEG : NAN;
+    result.rms_pitch_deg = error_samples ? std::sqrt(sum_pitch / error_samples) * RAD_TO_DEG : NAN;
+    result.final = estimator.attitude().euler;
+    return result;
+}
+
+const char* filter_name(ahrs::FilterType filter) {
+    switch (filter) {
+        case ahrs::FilterType::Complementary: return "complementary";
+        case ahrs::FilterType::Madgwick:      return "madgwick";
+        case ahrs::FilterType::Mahony:        return "mahony";
+    }
+    return "?";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    const char* csv = nullptr;
+    double seconds = 60.0;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--csv") && i + 1 < argc) csv = argv[++i];
+        else if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = std::atof(argv[++i]);
+    }
+
+    const Trajectory traj = csv ? load_csv(csv, seconds + 1.0) : make_synthetic(seconds + 1.0);
+    const uint32_t budget_ns = ahrs::Config{}.cycle_budget;
+
+    std::vector<std::string> rows;
+    bool over_budget = false;
+
+    for (uint32_t rate : {200u, 500u, 1000u}) {
+        for (auto filter : {ahrs::FilterType::Complementary, ahrs::FilterType::Madgwick, ahrs::FilterType::Mahony}) {
+            const Result r = run(traj, csv, filter, rate, seconds, 1);
+            over_budget |= r.mean_ns > budget_ns;
+
+            char line[160];
+            snprintf(line, sizeof(line), "%-14s %6u %8u %10.3f %10.3f %9.1f %8u %8u %8.1f %8.1f %8.1f",
+                     filter_name(filter), rate, r.updates, r.rms_roll_deg, r.rms_pitch_deg,
+                     r.mean_ns, r.max_ns, r.overruns,
+                     r.final.roll * RAD_TO_DEG, r.final.pitch * RAD_TO_DEG, r.final.yaw * RAD_TO_DEG);
+            rows.emplace_back(line);
+        }
+    }
+
+    printf("\nAHRS benchmark: %s, %.0f s\n", csv ? csv : "synthetic trajectory", seconds);
+    printf("%-14s %6s %8s %10s %10s %9s %8s %8s %8s %8s %8s\n",
+           "filter", "rate", "updates", "roll_rms", "pitch_rms", "mean_ns", "max_ns", "over", "roll", "pitch", "yaw");
+    printf("------------------------------------------------------------------------------------------------------\n");
+    for (const auto& row : rows) {
+        printf("%s\n", row.c_str());
+    }
+    printf("Budget: %u ns mean per update -> %s\n", budget_ns, over_budget ? "FAIL" : "ok");
+
+    return over_budget ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file bench_airspeed.cpp
+ * @brief Accuracy and per-sample cost of the MS4525D0 airspeed pipeline
+ *
+ * Runs the same path as Core 1: MS4525D0 model -> driver polled by I2CDevice
+ * at 500 Hz -> airspeed::Pipeline::process() in the poll callback.
+ *
+ * The model sees a known airspeed profile plus a sensor zero offset and
+ * noise. The first second is at rest so the session-start zero calibration
+ * can remove the offset. Air is at 35 C so TAS must read above IAS by
+ * sqrt(rho0 / rho).
+ *
+ *   bench_airspeed [--seconds N] [--seed S]
+ *
+ * The "slow" rows stretch the sensor conversion period past the poll period
+ * so every other read is stale and must be rejected.
+ */
+
+#include "i2c.h"
+#include "airspeed/airspeed.h"
+
+#include "i2c_sim.h"
+#include "models/ms4525d0_model.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double REST_S = 1.0;
+constexpr double SETTLE_S = 2.0;
+constexpr double ZERO_OFFSET_PA = 25.0;
+constexpr double NOISE_PA = 3.0;
+constexpr double AIR_TEMPERATURE_C = 35.0;
+constexpr double RHO0 = 1.225;
+
+double true_ias(double t) {
+    return t < REST_S ? 0.0 : 15.0 + 5.0 * std::sin(2.0 * M_PI * 0.2 * (t - REST_S));
+}
+
+double expected_tas_ratio() {
+    const double rho = i2c::units::SEA_LEVEL_PRESSURE / (287.05 * (AIR_TEMPERATURE_C + 273.15));
+    return std::sqrt(RHO0 / rho);
+}
+
+struct Result {
+    uint32_t published;
+    uint32_t stale;
+    int32_t zero_offset_mpa;
+    double rms_ias;
+    double tas_ratio;
+    double mean_ns;
+};
+
+Result run(airspeed::FilterType filter, uint32_t conversion_period_us, double seconds, uint32_t seed) {
+    sim::reset();
+    i2c_init(i2c0, i2c::DEFAULT_BUS_SPEED);
+
+    sim::MS4525D0Model pitot;
+    pitot.conversion_period_us = conversion_period_us;
+    pitot.temperature = sim::Waveform::constant(AIR_TEMPERATURE_C);
+    pitot.differential_pressure = sim::Waveform([](double t) {
+        const double v = true_ias(t);
+        return 0.5 * RHO0 * v * v + ZERO_OFFSET_PA;
+    }).with_noise(NOISE_PA, seed);
+    sim::bus(i2c0).attach(pitot);
+
+    airspeed::Pipeline pipeline(airspeed::Config{.filter = filter});
+    pipeline.begin_zero();
+
+    i2c::I2CDevice<i2c::drivers::MS4525D0> device;
+    device.init(i2c0);
+    const uint64_t start_us = sim::now_us();
+
+    Result result{};
+    double sum_sq = 0.0, sum_ratio = 0.0;
+    uint32_t error_samples = 0;
+    uint64_t process_ns = 0;
+    uint32_t calls = 0;
+
+    device.set_callback([&](const i2c::drivers::ms4525d0_data& d) {
+        const auto t0 = std::chrono::steady_clock::now();
+        const bool published = pipeline.process(d);
+        process_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count());
+        calls++;
+
+        if (!published) {
+            return;
+        }
+        result.published++;
+        const double t = (sim::now_us() - start_us) * 1e-6;
+        if (t > SETTLE_S) {
+            const airspeed::Sample s = pipeline.latest();
+            const double err = s.ias_mps - true_ias(t);
+            sum_sq += err * err;
+            sum_ratio += s.ias_mps > 1.0f ? s.tas_mps / s.ias_mps : expected_tas_ratio();
+            error_samples++;
+        }
+    });
+    device.start_polling();
+    sim::run_for(static_cast<uint64_t>(seconds * 1e6));
+    device.stop_polling();
+
+    const airspeed::Stats stats = pipeline.stats();
+    result.stale = stats.stale;
+    result.zero_offset_mpa = stats.zero_offset_mpa;
+    result.rms_ias = error_samples ? std::sqrt(sum_sq / error_samples) : NAN;
+    result.tas_ratio = error_samples ? sum_ratio / error_samples : NAN;
+    result.mean_ns = calls ? static_cast<double>(process_ns) / calls : 0.0;
+    return result;
+}
+
+const char* filter_name(airspeed::FilterType filter) {
+    switch (filter) {
+        case airspeed::FilterType::None:      return "none";
+        case airspeed::FilterType::IIR:       return "iir";
+        case airspeed::FilterType::Median:    return "median";
+        case airspeed::FilterType::MedianIIR: return "median+iir";
+    }
+    return "?";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    double seconds = 20.0;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+
+    std::vector<std::string> rows;
+    for (uint32_t period_us : {500u, 2500u}) {
+        for (auto filter : {airspeed::FilterType::None, airspeed::FilterType::IIR,
+                            airspeed::FilterType::Median, airspeed::FilterType::MedianIIR}) {
+            const Result r = run(filter, period_us, seconds, seed);
+
+            char line[160];
+            snprintf(line, sizeof(line), "%-11s %-6s %9u %7u %9.1f %9.3f %9.4f %9.1f",
+                     filter_name(filter), period_us > 2000 ? "slow" : "nom", r.published, r.stale,
+                     r.zero_offset_mpa * 0.001, r.rms_ias, r.tas_ratio, r.mean_ns);
+            rows.emplace_back(line);
+        }
+    }
+
+    printf("\nAirspeed benchmark: %.0f s, zero offset %.1f Pa, noise %.1f Pa, %.0f C (TAS/IAS %.4f)\n",
+           seconds, ZERO_OFFSET_PA, NOISE_PA, AIR_TEMPERATURE_C, expected_tas_ratio());
+    printf("%-11s %-6s %9s %7s %9s %9s %9s %9s\n",
+           "filter", "conv", "published", "stale", "zero_Pa", "ias_rms", "tas/ias", "mean_ns");
+    printf("--------------------------------------------------------------------------\n");
+    for (const auto& row : rows) {
+        printf("%s\n", row.c_str());
+    }
+    return 0;
+}
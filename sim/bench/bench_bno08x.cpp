@@ -0,0 +1,241 @@
+/**
+ * @file bench_bno08x.cpp
+ * @brief BNO08x driver and SH2/SHTP decoding against the sensor hub model
+ *
+ * Runs i2c::drivers::BNO08x through init (reset, Reset Complete, product
+ * IDs, Set Feature) and then I2CDevice polling at the Traits rate, with the
+ * SH2 library parsing every SHTP transfer the hub model (bno08x_model.h)
+ * sends. Each case runs RUN_US of virtual time with one fault:
+ *
+ *   clean      reports at 100/100/200 Hz, one transfer per due time
+ *   seq gap    a skipped SHTP sequence number every 7 input transfers
+ *   unknown    an unknown report ID ahead of the reports every 10 transfers;
+ *              SH2 drops the rest of that transfer
+ *   reset      the hub resets itself at 0.8 s; the driver must re-enable the
+ *              reports after Reset Complete
+ *   oversize   reports for 300 ms leave as one transfer, longer than the SH2
+ *              receive buffer; it must be dropped, not parsed in pieces
+ *
+ * Every decoded value is matched to the report the model sent (by sensor and
+ * sequence number) and checked against its ground truth to within half an
+ * LSB of its Q format; its timestamp must be within 100 us (the SH2 timebase
+ * resolution) of the sample time. Per case:
+ *
+ *   sent       reports the hub generated
+ *   decoded    values the driver handed to the callback
+ *   expected   reports the host must decode: read, not behind an unknown ID,
+ *              not in a transfer too long for SH2
+ *   missing    expected reports never decoded
+ *   full       values the driver dropped because one update held more
+ *              than bno08x_data::MAX_VALUES (the drain of an oversize
+ *              transfer leaves a backlog that arrives as one transfer)
+ *   bad        values outside their Q resolution, or matching no report
+ *   ts_us      worst timestamp error
+ *   dropped    transfers the driver drained and discarded
+ *   bus_%      bus occupancy
+ *
+ * The bench exits non-zero if any case has a bad value, a missing one the
+ * driver did not count as full, or a timestamp error above 100 us.
+ *
+ *   bench_bno08x [baudrate]
+ */
+
+#include "i2c.h"
+#include "i2c/drivers/bno08x.h"
+
+#include "i2c_sim.h"
+#include "models/bno08x_model.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t RUN_US = 2'000'000;
+constexpr int64_t TIMESTAMP_TOLERANCE_US = 100;
+
+struct Case {
+    const char* name;
+    uint32_t seq_gap_every = 0;
+    uint32_t unknown_report_every = 0;
+    uint64_t reset_at_us = 0;
+    uint64_t merge_from_us = 0;
+    uint64_t merge_to_us = 0;
+};
+
+const Case CASES[] = {
+    {.name = "clean"},
+    {.name = "seq gap", .seq_gap_every = 7},
+    {.name = "unknown", .unknown_report_every = 10},
+    {.name = "reset", .reset_at_us = 800'000},
+    {.name = "oversize", .merge_from_us = 1'000'000, .merge_to_us = 1'300'000},
+};
+
+uint32_t g_baudrate = 400'000;
+
+// Rows are collected and printed after the run so driver log output does not
+// interleave with the table.
+std::vector<std::string> g_rows;
+
+void set_motion(sim::BNO08xModel& hub) {
+    hub.roll = sim::Waveform::sine(0.4, 0.5);
+    hub.pitch = sim::Waveform::sine(0.2, 0.3, 0.05);
+    hub.yaw = sim::Waveform::ramp(-3.0, 1.5);
+    hub.linear_accel[0] = sim::Waveform::sine(2.0, 1.0);
+    hub.linear_accel[1] = sim::Waveform::sine(1.0, 0.7, 0.3);
+    hub.linear_accel[2] = sim::Waveform::constant(-0.5);
+    hub.gyro[0] = sim::Waveform::sine(1.2, 0.5);
+    hub.gyro[1] = sim::Waveform::sine(0.6, 0.3);
+    hub.gyro[2] = sim::Waveform::constant(1.5);
+}
+
+// What the SH2 decoder put in a value, in the model's value order
+std::array<double, 5> decoded_values(const sh2_SensorValue_t& value) {
+    switch (value.sensorId) {
+    case SH2_ROTATION_VECTOR: {
+        const auto& rv = value.un.rotationVector;
+        return {rv.i, rv.j, rv.k, rv.real, rv.accuracy};
+    }
+    case SH2_LINEAR_ACCELERATION: {
+        const auto& a = value.un.linearAcceleration;
+        return {a.x, a.y, a.z};
+    }
+    case SH2_GYROSCOPE_CALIBRATED: {
+        const auto& g = value.un.gyroscope;
+        return {g.x, g.y, g.z};
+    }
+    default:
+        return {};
+    }
+}
+
+struct Result {
+    uint32_t sent = 0;
+    uint32_t decoded = 0;
+    uint32_t expected = 0;
+    uint32_t missing = 0;
+    uint32_t bad = 0;
+    int64_t worst_ts_us = 0;
+};
+
+// Matches each decoded value to the next report of its sensor with the same
+// sequence number; reports skipped over were never decoded
+Result check(const sim::BNO08xModel& hub, const std::vector<sh2_SensorValue_t>& values) {
+    const auto& history = hub.history();
+    Result r;
+    r.sent = static_cast<uint32_t>(history.size());
+    r.decoded = static_cast<uint32_t>(values.size());
+
+    std::vector<bool> matched(history.size());
+    std::array<size_t, 256> cursor{};
+    for (const sh2_SensorValue_t& value : values) {
+        size_t& i = cursor[value.sensorId];
+        while (i < history.size() &&
+               (history[i].report_id != value.sensorId || history[i].sequence != value.sequence)) {
+            ++i;
+        }
+        if (i == history.size()) {
+            r.bad++;
+            continue;
+        }
+        const sim::BNO08xModel::Sample& sample = history[i++];
+        matched[&sample - history.data()] = true;
+
+        const auto& sensor = sim::BNO08xModel::SENSORS[value.sensorId == SH2_ROTATION_VECTOR ? 0
+                                                       : value.sensorId == SH2_LINEAR_ACCELERATION ? 1 : 2];
+        const std::array<double, 5> got = decoded_values(value);
+        for (size_t v = 0; v < sensor.values; ++v) {
+            const double lsb = 1.0 / (1 << (v == 4 ? 12 : sensor.q));
+            if (std::fabs(got[v] - sample.truth[v]) > 0.5 * lsb + 1e-6) {
+                r.bad++;
+                break;
+            }
+        }
+        // SH2 extends the 32-bit host time with a rollover count that
+        // survives sh2_close(), and every case restarts the clock at zero
+        const auto ts_error = static_cast<int32_t>(static_cast<uint32_t>(value.timestamp) -
+                                                   static_cast<uint32_t>(sample.t_us));
+        r.worst_ts_us = std::max<int64_t>(r.worst_ts_us, std::abs(ts_error));
+    }
+
+    for (size_t i = 0; i < history.size(); ++i) {
+        const auto& sample = history[i];
+        if (!sample.read || sample.hidden || sample.transfer_bytes > SH2_HAL_MAX_TRANSFER_IN) continue;
+        r.expected++;
+        r.missing += !matched[i];
+    }
+    return r;
+}
+
+bool run_case(const Case& c) {
+    sim::reset();
+    i2c_init(i2c0, g_baudrate);
+
+    sim::BNO08xModel hub;
+    set_motion(hub);
+    hub.seq_gap_every = c.seq_gap_every;
+    hub.unknown_report_every = c.unknown_report_every;
+    hub.reset_at_us = c.reset_at_us;
+    hub.merge_from_us = c.merge_from_us;
+    hub.merge_to_us = c.merge_to_us;
+    sim::bus(i2c0).attach(hub);
+    hub.start();
+
+    i2c::I2CDevice<i2c::drivers::BNO08x> device;
+    if (!device.init(i2c0)) {
+        g_rows.emplace_back(std::string(c.name) + ": init failed");
+        return false;
+    }
+    std::vector<sh2_SensorValue_t> values;
+    device.set_callback([&](const i2c::drivers::bno08x_data& data) {
+        values.insert(values.end(), data.values.begin(), data.values.begin() + data.count);
+    });
+
+    sim::bus(i2c0).stats = sim::BusStats{};
+    device.start_polling();
+    sim::run_for(RUN_US);
+    device.stop_polling();
+
+    const Result r = check(hub, values);
+    const auto& driver = device.get();
+    const double bus_pct = 100.0 * static_cast<double>(sim::bus(i2c0).stats.busy_us) / RUN_US;
+    char line[128];
+    snprintf(line, sizeof(line), "%-10s %6u %8u %9u %8u %5u %5u %6lld %8u %6.2f", c.name, r.sent, r.decoded,
+             r.expected, r.missing, driver.get_dropped_values(), r.bad, static_cast<long long>(r.worst_ts_us),
+             driver.get_dropped_transfers(), bus_pct);
+    g_rows.emplace_back(line);
+
+    // SH2 keeps one global session; the next case opens its own
+    sh2_close();
+
+    // After a hub reset the driver must have sent every Set Feature again
+    const size_t configured = (c.reset_at_us ? 2 : 1) * sim::BNO08xModel::SENSORS.size();
+    return hub.set_features == configured && r.expected > 0 && r.missing == driver.get_dropped_values() && r.bad == 0 &&
+           r.worst_ts_us <= TIMESTAMP_TOLERANCE_US;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) g_baudrate = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 0));
+
+    printf("BNO08x over SHTP: %u Hz bus, %llu us virtual run per case\n", g_baudrate,
+           static_cast<unsigned long long>(RUN_US));
+
+    bool ok = true;
+    for (const Case& c : CASES) {
+        ok &= run_case(c);
+    }
+
+    printf("\n%-10s %6s %8s %9s %8s %5s %5s %6s %8s %6s\n", "case", "sent", "decoded", "expected", "missing", "full",
+           "bad", "ts_us", "dropped", "bus_%");
+    printf("--------------------------------------------------------------------------------\n");
+    for (const auto& row : g_rows) {
+        printf("%s\n", row.c_str());
+    }
+    return ok ? 0 : 1;
+}
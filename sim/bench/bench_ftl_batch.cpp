@@ -0,0 +1,214 @@
+/**
+ * @file bench_ftl_batch.cpp
+ * @brief FTL small-message batching: wire bytes, frames and latency
+ *
+ * Loops a node back onto itself through the UART/DMA model (uart_sim.h) and
+ * polls every 100 us, as a busy main loop would. Built once per setting of
+ * BATCH_ENABLED in ftl.settings:
+ *
+ *   bench_ftl_batch      BATCH_ENABLED = false
+ *   bench_ftl_batch_on   BATCH_ENABLED = true
+ *
+ * Two runs per binary:
+ * - A burst of 60 seven-byte messages followed by one 200-byte message,
+ *   queued as fast as the TX queue takes them. Reports frames and wire
+ *   bytes, whether everything came back in order, and the pool slots still
+ *   in use once the line is idle.
+ * - A steady stream of Telemetry messages at a given rate and size for
+ *   --ms. Telemetry coalesces, so when the line cannot keep up the queue
+ *   replaces waiting messages with newer ones; "dropped" counts those (and
+ *   any refused sends, which are not retried). Reports wire bytes per
+ *   delivered message and the delay from send_msg() to get_msg() in virtual
+ *   time. Every row checks that each message is either delivered, in order,
+ *   or counted as dropped.
+ *
+ * Each run is a fresh process, since FTL cannot be reinitialised.
+ *
+ *   bench_ftl_batch [--ms N] [--flush-us N]
+ */
+
+#include "ftl.h"
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t PAYLOAD_TAG = 0x42;           // Below LINK_MESSAGE_TYPE_BASE
+constexpr uint64_t STEP_US = 100;
+constexpr uint32_t DRAIN_STEPS = 200;
+constexpr size_t HEADER_SIZE = 7;               // [TAG][INDEX(2)][SENT_US(4)]
+
+std::vector<uint8_t> make_payload(size_t size, uint32_t index) {
+    std::vector<uint8_t> payload(std::max(size, HEADER_SIZE), static_cast<uint8_t>(index));
+    const uint32_t sent_us = static_cast<uint32_t>(sim::now_us());
+    payload[0] = PAYLOAD_TAG;
+    payload[1] = static_cast<uint8_t>(index);
+    payload[2] = static_cast<uint8_t>(index >> 8);
+    std::memcpy(&payload[3], &sent_us, sizeof(sent_us));
+    return payload;
+}
+
+struct Result {
+    uint32_t sent;
+    uint32_t dropped;           // Refused, pushed out or coalesced in the TX queue
+    uint32_t delivered;
+    bool in_order;
+    uint32_t frames;
+    uint64_t wire_bytes;
+    uint32_t batch_frames;
+    uint32_t pool_in_use;       // Slots still allocated once the line is idle
+    double mean_delay_ms;
+    double max_delay_ms;
+};
+
+// Moves one step: loops back what went out and collects what came in
+class Loopback {
+public:
+    explicit Loopback(Result& result) : result_(result) { result_.in_order = true; }
+
+    void step() {
+        ftl::poll();
+        sim::uart::run(STEP_US);
+        for (auto& frame : sim::uart::take_tx()) {
+            result_.frames++;
+            sim::uart::receive(frame.bytes, frame.baud);
+        }
+        ftl::poll();
+
+        while (ftl::has_msg()) {
+            const ftl::MessageHandle message = ftl::get_msg();
+            const uint8_t* data = message.data();
+            if (message.length() < HEADER_SIZE || data[0] != PAYLOAD_TAG) continue;
+            const int index = data[1] | (data[2] << 8);
+            uint32_t sent_us;
+            std::memcpy(&sent_us, &data[3], sizeof(sent_us));
+            const uint64_t delay_us = static_cast<uint32_t>(sim::now_us()) - sent_us;
+
+            result_.in_order &= index > last_index_;
+            last_index_ = index;
+            result_.delivered++;
+            delay_sum_us_ += delay_us;
+            max_delay_us_ = std::max(max_delay_us_, delay_us);
+        }
+    }
+
+    void drain() {
+        for (uint32_t idle = 0; idle < DRAIN_STEPS;) {
+            step();
+            idle = !sim::uart::tx_busy() && ftl::is_tx_queue_empty() ? idle + 1 : 0;
+        }
+    }
+
+    void finish(ftl_config::TxClass tx_class) {
+        result_.wire_bytes = sim::uart::stats().tx_bytes;
+        uint32_t peak, spills;
+        ftl::get_pool_stats(result_.pool_in_use, peak, spills);
+        uint32_t batched_messages;
+        ftl::get_tx_batch_stats(result_.batch_frames, batched_messages);
+        uint32_t sent, dropped, coalesced, peak_depth, mean_us, max_us;
+        ftl::get_tx_class_stats(tx_class, sent, dropped, coalesced, peak_depth, mean_us, max_us);
+        result_.dropped = dropped + coalesced;
+        result_.mean_delay_ms = result_.delivered ? delay_sum_us_ / 1000.0 / result_.delivered : 0.0;
+        result_.max_delay_ms = max_delay_us_ / 1000.0;
+    }
+
+private:
+    Result& result_;
+    int last_index_ = -1;
+    uint64_t delay_sum_us_ = 0;
+    uint64_t max_delay_us_ = 0;
+};
+
+Result run_burst(uint32_t flush_us) {
+    ftl::initialize();
+    ftl::set_batch_flush_us(flush_us);
+    Result result{};
+    Loopback loopback(result);
+
+    constexpr uint32_t SMALL_COUNT = 60;
+    for (uint32_t next = 0; next <= SMALL_COUNT;) {
+        if (ftl::is_tx_ready() && ftl::send_msg(make_payload(next < SMALL_COUNT ? 7 : 200, next))) {
+            result.sent++;
+            next++;
+            continue;
+        }
+        loopback.step();
+    }
+    loopback.drain();
+    loopback.finish(ftl_config::TxClass::Normal);
+    return result;
+}
+
+Result run_stream(size_t payload_size, uint32_t rate_per_s, uint64_t duration_us, uint32_t flush_us) {
+    ftl::initialize();
+    ftl::set_batch_flush_us(flush_us);
+    Result result{};
+    Loopback loopback(result);
+
+    const uint64_t start_us = sim::now_us();
+    uint32_t due_count = 0;
+    while (sim::now_us() - start_us < duration_us) {
+        const uint32_t due = static_cast<uint32_t>((sim::now_us() - start_us) * rate_per_s / 1000000);
+        for (; due_count < due; ++due_count) {
+            ftl::send_msg(make_payload(payload_size, due_count), ftl_config::TxClass::Telemetry);
+            result.sent++;
+        }
+        loopback.step();
+    }
+    loopback.drain();
+    loopback.finish(ftl_config::TxClass::Telemetry);
+    return result;
+}
+
+void print_row(const char* label, const Result& r) {
+    printf("%-16s %6u %7u %9u %6s %7u %7u %9llu %7.1f %8.2f %8.2f %5u\n", label, r.sent, r.dropped, r.delivered,
+           r.in_order ? "yes" : "NO", r.frames, r.batch_frames, static_cast<unsigned long long>(r.wire_bytes),
+           r.delivered ? static_cast<double>(r.wire_bytes) / r.delivered : 0.0, r.mean_delay_ms, r.max_delay_ms,
+           r.pool_in_use);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t duration_ms = 2000;
+    uint32_t flush_us = ftl_config::BATCH_FLUSH_US;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ms") && i + 1 < argc) duration_ms = static_cast<uint64_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--flush-us") && i + 1 < argc) flush_us = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+
+    printf("\nBatching %s (flush after %u us, items up to %zu bytes), %u baud, poll every %llu us\n",
+           ftl_config::BATCH_ENABLED ? "on" : "off", flush_us, ftl_config::BATCH_MAX_ITEM_SIZE,
+           ftl_config::BAUD_RATE, static_cast<unsigned long long>(STEP_US));
+    printf("%-16s %6s %7s %9s %6s %7s %7s %9s %7s %8s %8s %5s\n", "run", "sent", "dropped", "delivered", "order",
+           "frames", "batches", "wire", "B/msg", "mean ms", "max ms", "slots");
+    printf("-----------------------------------------------------------------------------------------------------------\n");
+
+    sim::uart::run_isolated([&] {
+        const Result r = run_burst(flush_us);
+        sim::uart::mute_stdout(false);
+        print_row("burst 60x7+200", r);
+        return r.delivered + r.dropped == r.sent && r.in_order && r.pool_in_use == 0 ? 0 : 1;
+    });
+
+    for (size_t payload_size : {8, 32, 64}) {
+        for (uint32_t rate : {200, 1000, 2000}) {
+            sim::uart::run_isolated([&] {
+                const Result r = run_stream(payload_size, rate, duration_ms * 1000, flush_us);
+                sim::uart::mute_stdout(false);
+                char label[32];
+                snprintf(label, sizeof(label), "%zu B @ %u/s", payload_size, rate);
+                print_row(label, r);
+                return r.delivered + r.dropped == r.sent && r.in_order && r.pool_in_use == 0 ? 0 : 1;
+            });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file bench_ftl_bulk.cpp
+ * @brief FTL bulk transfers through frame loss, link outages and restarts
+ *
+ * A sender and a receiver node, each a forked process (uart_sim.h
+ * PeerProcess), joined through the UART/DMA model. The sender queues
+ * transfers of 300..4000 bytes back to back with ftl::send_bulk() for
+ * SEND_MS; the receiver either reassembles them (get_bulk_msg) or takes
+ * them fragment by fragment through a stream handler. The bench sits on the
+ * line in between, dropping frames, cutting the link for a while, stopping
+ * and restarting the sender mid-transfer, or leaving the receiver's
+ * completed transfers unread so its bulk pool runs out.
+ *
+ * Every transfer carries its own sequence number and a pattern derived from
+ * it, so the receiver can check each one it gets. Per case:
+ *
+ *   started    transfers the sender(s) queued
+ *   delivered  transfers received whole and correct
+ *   corrupt    transfers delivered with the wrong length or bytes
+ *   aborted    stream handler calls with `aborted` set
+ *   timeouts   incomplete transfers reclaimed after BULK_REASSEMBLY_TIMEOUT_US
+ *   dropped    fragments discarded (out of sequence or no buffer)
+ *   open       streamed transfers neither finished nor aborted at the end
+ *   slots      message pool slots still in use on the receiver
+ *
+ * A case fails (and the bench exits non-zero) on any corrupt transfer, any
+ * open one, or a leaked slot.
+ *
+ *   bench_ftl_bulk [--seed S]
+ */
+
+#include "ftl.h"
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t STEP_US = 1000;
+constexpr uint64_t SEND_MS = 8000;
+constexpr uint64_t DRAIN_MS = 1500;             // Longer than BULK_REASSEMBLY_TIMEOUT_US
+constexpr uint64_t SENDER_BOARD_ID = 0x11;              // Source ID 0x11
+constexpr uint64_t RECEIVER_BOARD_ID = 0x22;            // Source ID 0x22
+
+uint32_t transfer_length(uint32_t seq) {
+    return 300 + (seq * 2654435761u >> 12) % 3701;
+}
+
+uint8_t transfer_byte(uint32_t seq, uint32_t offset) {
+    return static_cast<uint8_t>(seq * 31 + offset * 7 + (offset >> 8));
+}
+
+std::vector<uint8_t> make_transfer(uint32_t seq) {
+    std::vector<uint8_t> data(transfer_length(seq));
+    for (uint32_t k = 0; k < data.size(); ++k) data[k] = transfer_byte(seq, k);
+    std::memcpy(data.data(), &seq, sizeof(seq));
+    return data;
+}
+
+bool check_transfer(std::span<const uint8_t> data) {
+    uint32_t seq;
+    if (data.size() < sizeof(seq)) return false;
+    std::memcpy(&seq, data.data(), sizeof(seq));
+    if (data.size() != transfer_length(seq)) return false;
+    for (uint32_t k = sizeof(seq); k < data.size(); ++k) {
+        if (data[k] != transfer_byte(seq, k)) return false;
+    }
+    return true;
+}
+
+// Written by the node processes, read by the bench; lives in shared memory
+struct Counters {
+    uint32_t started;
+    uint32_t delivered;
+    uint32_t corrupt;
+    uint32_t aborted;
+    uint32_t timeouts;
+    uint32_t dropped;
+    uint32_t open;
+    uint32_t slots;
+};
+
+Counters* g_counters = nullptr;
+
+struct Case {
+    const char* name;
+    bool streaming = false;
+    double loss = 0.0;                  // Share of sender frames dropped
+    uint64_t outage_from_ms = 0;        // Link cut for [from, to)
+    uint64_t outage_to_ms = 0;
+    uint64_t restart_at_ms = 0;         // Sender stopped and restarted here
+    uint64_t read_from_ms = 0;          // Receiver leaves transfers unread until here
+};
+
+sim::uart::PeerProcess::Hooks sender_hooks(uint32_t first_seq, uint64_t send_us) {
+    auto seq = std::make_shared<uint32_t>(first_seq);
+    sim::uart::PeerProcess::Hooks hooks;
+    hooks.setup = [] {
+        sim::uart::mute_stdout(true);
+        ftl::initialize();
+    };
+    hooks.step = [seq, send_us] {
+        if (sim::now_us() < send_us && !ftl::is_bulk_tx_busy() && ftl::send_bulk(make_transfer(*seq))) {
+            (*seq)++;
+        }
+        ftl::poll();
+    };
+    hooks.report = [seq, first_seq] {
+        g_counters->started += *seq - first_seq;
+        return 0;
+    };
+    return hooks;
+}
+
+sim::uart::PeerProcess::Hooks receiver_hooks(const Case& c) {
+    // Streamed transfers in progress, by source and message ID
+    auto partial = std::make_shared<std::map<uint16_t, std::vector<uint8_t>>>();
+    sim::uart::PeerProcess::Hooks hooks;
+    hooks.setup = [partial, streaming = c.streaming] {
+        sim::uart::mute_stdout(true);
+        ftl::initialize();
+        if (!streaming) return;
+        ftl::set_bulk_stream_handler([partial](const ftl::BulkFragment& fragment) {
+            const uint16_t key = static_cast<uint16_t>(fragment.source_id << 8 | fragment.message_id);
+            if (fragment.aborted) {
+                g_counters->aborted++;
+                partial->erase(key);
+                return;
+            }
+            auto& data = (*partial)[key];
+            if (fragment.offset != data.size()) {
+                g_counters->corrupt++;      // A gap the stack should have caught
+            }
+            data.insert(data.end(), fragment.data.begin(), fragment.data.end());
+            if (fragment.last) {
+                (check_transfer(data) ? g_counters->delivered : g_counters->corrupt)++;
+                partial->erase(key);
+            }
+        });
+    };
+    hooks.step = [read_from_us = c.read_from_ms * 1000] {
+        ftl::poll();
+        while (ftl::has_msg()) {
+            ftl::get_msg();
+        }
+        while (sim::now_us() >= read_from_us && ftl::has_bulk_msg()) {
+            const ftl::BulkMessage message = ftl::get_bulk_msg();
+            (check_transfer(message.span()) ? g_counters->delivered : g_counters->corrupt)++;
+        }
+    };
+    hooks.report = [partial] {
+        uint32_t sent, received, fragments, peak, spills;
+        ftl::get_bulk_stats(sent, received, fragments, g_counters->timeouts, g_counters->dropped);
+        ftl::get_pool_stats(g_counters->slots, peak, spills);
+        g_counters->open = static_cast<uint32_t>(partial->size());
+        return 0;
+    };
+    return hooks;
+}
+
+bool run_case(const Case& c, uint32_t seed) {
+    *g_counters = Counters{};
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution lost(c.loss);
+
+    sim::uart::PeerProcess receiver;
+    sim::uart::PeerProcess sender;
+    receiver.start(receiver_hooks(c), RECEIVER_BOARD_ID, seed);
+    sender.start(sender_hooks(0, SEND_MS * 1000), SENDER_BOARD_ID, seed);
+
+    std::vector<sim::uart::Frame> to_receiver;
+    std::vector<sim::uart::Frame> to_sender;
+    std::vector<sim::uart::Frame> outgoing;
+    for (uint64_t ms = 0; ms < SEND_MS + DRAIN_MS; ++ms) {
+        if (c.restart_at_ms && ms == c.restart_at_ms) {
+            // Stopped between steps, the sender vanishes mid-transfer as after
+            // a reset, but still reports how many transfers it started
+            sender.stop();
+            sender.start(sender_hooks(1000, (SEND_MS - ms) * 1000), SENDER_BOARD_ID, seed + 1);
+        }
+        sender.step(to_sender, STEP_US, outgoing);
+
+        const bool outage = ms >= c.outage_from_ms && ms < c.outage_to_ms;
+        to_receiver.clear();
+        for (auto& frame : outgoing) {
+            if (!outage && !lost(rng)) to_receiver.push_back(std::move(frame));
+        }
+        receiver.step(to_receiver, STEP_US, to_sender);
+    }
+    sender.stop();
+    receiver.stop();
+
+    const Counters& r = *g_counters;
+    printf("%-16s %7u %9u %7u %7u %8u %7u %5u %5u\n", c.name, r.started, r.delivered, r.corrupt, r.aborted,
+           r.timeouts, r.dropped, r.open, r.slots);
+    return r.corrupt == 0 && r.open == 0 && r.slots == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+
+    void* shared = mmap(nullptr, sizeof(Counters), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    g_counters = static_cast<Counters*>(shared);
+
+    printf("\nBulk transfers of 300..4000 bytes for %llu ms at %u baud, %zu bulk buffers, %u ms reassembly timeout\n",
+           static_cast<unsigned long long>(SEND_MS), ftl_config::BAUD_RATE, ftl_config::BULK_POOL_SIZE,
+           ftl_config::BULK_REASSEMBLY_TIMEOUT_US / 1000);
+    printf("%-16s %7s %9s %7s %7s %8s %7s %5s %5s\n", "case", "started", "delivered", "corrupt", "aborted",
+           "timeouts", "dropped", "open", "slots");
+    printf("---------------------------------------------------------------------------------\n");
+
+    const Case cases[] = {
+        {.name = "clean"},
+        {.name = "loss 0.5%", .loss = 0.005},
+        {.name = "loss 2%", .loss = 0.02},
+        {.name = "loss 2% stream", .streaming = true, .loss = 0.02},
+        {.name = "outage 1 s", .outage_from_ms = 3000, .outage_to_ms = 4000},
+        {.name = "outage stream", .streaming = true, .outage_from_ms = 3000, .outage_to_ms = 4000},
+        {.name = "restart", .restart_at_ms = 3050},
+        {.name = "restart stream", .streaming = true, .restart_at_ms = 3050},
+        {.name = "unread 5 s", .read_from_ms = 5000},
+    };
+
+    bool ok = true;
+    for (const Case& c : cases) {
+        ok &= run_case(c, seed);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file bench_ftl_credit.cpp
+ * @brief FTL credit-based flow control against a slow receiver
+ *
+ * A sender floods Normal messages at a receiver that takes one message off
+ * its RX queue per read interval (every step for the fast reader, 4 ms for
+ * the rest, about a third of line rate), each node a PeerProcess on the
+ * UART/DMA model (uart_sim.h). Built once per setting of FLOW_CONTROL_ENABLED in
+ * ftl.settings:
+ *
+ *   bench_ftl_credit      FLOW_CONTROL_ENABLED = false
+ *   bench_ftl_credit_on   FLOW_CONTROL_ENABLED = true
+ *
+ * Each binary runs the other as a peer for the mixed cases, so both must be
+ * built side by side. The bench sits on the line between the nodes, losing
+ * frames both ways or cutting the receiver-to-sender direction (where the
+ * credit frames go) for a second. Per case:
+ *
+ *   tx/rx      flow control in the sender's and the receiver's build
+ *   sent       messages send_msg() took; refusals (queue full) are retried
+ *   delivered  messages the receiver's application got
+ *   overflow   frames the receiver dropped for want of queue room or slots
+ *   lost       sent messages never delivered (overflow and line loss)
+ *   stalls     times the sender held TX for want of credit, and for how long
+ *   link       link-layer frames (0xF0 and up) that reached an application
+ *
+ * Delivery order is checked on every case; the bench exits non-zero if it
+ * breaks, or if a credit frame reaches an application.
+ *
+ *   bench_ftl_credit [--seed S]
+ */
+
+#include "ftl.h"
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t PAYLOAD_TAG = 0x42;           // Below LINK_MESSAGE_TYPE_BASE
+constexpr size_t PAYLOAD_SIZE = 32;
+constexpr uint64_t STEP_US = 1000;
+constexpr uint64_t SEND_MS = 3000;
+constexpr uint64_t DRAIN_MS = 1000;
+constexpr uint64_t SENDER_BOARD_ID = 0x11;              // Source ID 0x11
+constexpr uint64_t RECEIVER_BOARD_ID = 0x22;            // Source ID 0x22
+
+enum class Sibling { None, Sender, Receiver };  // Node running the other build
+
+struct Case {
+    const char* name;
+    uint64_t read_us = STEP_US;         // Receiver takes one message per interval
+    double loss = 0.0;                  // Per frame, both directions
+    uint64_t outage_from_ms = 0;        // Receiver-to-sender cut for [from, to)
+    uint64_t outage_to_ms = 0;
+    Sibling sibling = Sibling::None;
+};
+
+const Case CASES[] = {
+    {.name = "fast reader", .read_us = 0},
+    {.name = "reader 4 ms", .read_us = 4000},
+    {.name = "reader 4 ms, 5% loss", .read_us = 4000, .loss = 0.05},
+    {.name = "reader 4 ms, 1 s cut", .read_us = 4000, .outage_from_ms = 1000, .outage_to_ms = 2000},
+    {.name = "mixed receiver", .read_us = 4000, .sibling = Sibling::Receiver},
+    {.name = "mixed sender", .read_us = 4000, .sibling = Sibling::Sender},
+};
+
+// Written by the nodes, read by the bench; a file mapping, so a node
+// running the other build shares it too
+struct Counters {
+    uint32_t sent;
+    uint32_t stalls;
+    uint32_t stalled_us;
+    uint32_t delivered;
+    uint32_t out_of_order;
+    uint32_t overflow;
+    uint32_t link_frames;
+};
+
+Counters* g_counters = nullptr;
+
+bool map_counters(const char* path) {
+    g_counters = static_cast<Counters*>(sim::uart::map_shared_file(path, sizeof(Counters)));
+    return g_counters != nullptr;
+}
+
+// Takes whatever reached the application; link-layer frames never should
+void count_link_frame(const ftl::MessageHandle& message) {
+    if (message.length() > 0 && message.data()[0] >= ftl_config::LINK_MESSAGE_TYPE_BASE) {
+        g_counters->link_frames++;
+    }
+}
+
+sim::uart::PeerProcess::Hooks sender_hooks() {
+    auto next = std::make_shared<uint32_t>(0);
+    sim::uart::PeerProcess::Hooks hooks;
+    hooks.setup = [] {
+        sim::uart::mute_stdout(true);
+        ftl::initialize();
+    };
+    hooks.step = [next] {
+        std::vector<uint8_t> payload(PAYLOAD_SIZE, 0x5A);
+        payload[0] = PAYLOAD_TAG;
+        while (sim::now_us() < SEND_MS * 1000) {
+            std::memcpy(&payload[1], next.get(), sizeof(uint32_t));
+            if (!ftl::send_msg(payload)) break;
+            (*next)++;
+        }
+        ftl::poll();
+        while (ftl::has_msg()) {
+            count_link_frame(ftl::get_msg());
+        }
+    };
+    hooks.report = [next] {
+        g_counters->sent = *next;
+        uint32_t overflow, credits;
+        ftl::get_flow_control_stats(g_counters->stalls, g_counters->stalled_us, overflow, credits);
+        return 0;
+    };
+    return hooks;
+}
+
+sim::uart::PeerProcess::Hooks receiver_hooks(const Case& c) {
+    auto last = std::make_shared<int64_t>(-1);
+    auto next_read_us = std::make_shared<uint64_t>(0);
+    sim::uart::PeerProcess::Hooks hooks;
+    hooks.setup = [] {
+        sim::uart::mute_stdout(true);
+        ftl::initialize();
+    };
+    hooks.step = [last, next_read_us, read_us = c.read_us] {
+        ftl::poll();
+        while (ftl::has_msg() && sim::now_us() >= *next_read_us) {
+            const ftl::MessageHandle message = ftl::get_msg();
+            *next_read_us += read_us;
+            count_link_frame(message);
+            if (message.length() != PAYLOAD_SIZE || message.data()[0] != PAYLOAD_TAG) continue;
+            uint32_t number;
+            std::memcpy(&number, message.data() + 1, sizeof(number));
+            g_counters->delivered++;
+            g_counters->out_of_order += number <= *last;
+            *last = number;
+        }
+        *next_read_us = std::max(*next_read_us, sim::now_us());
+    };
+    hooks.report = [] {
+        uint32_t stalls, stalled_us, credits;
+        ftl::get_flow_control_stats(stalls, stalled_us, g_counters->overflow, credits);
+        return 0;
+    };
+    return hooks;
+}
+
+sim::uart::PeerProcess::Hooks hooks_for(const char* role, const Case& c) {
+    return std::strcmp(role, "sender") == 0 ? sender_hooks() : receiver_hooks(c);
+}
+
+bool start_node(sim::uart::PeerProcess& node, const char* role, size_t case_index, bool sibling,
+                const std::string& self, const char* counters_path, uint64_t board_id, uint64_t rand_seed) {
+    if (!sibling) {
+        return node.start(hooks_for(role, CASES[case_index]), board_id, rand_seed);
+    }
+    return node.start_program(
+        {sim::uart::sibling_program(self), "--peer", role, std::to_string(case_index), counters_path}, board_id,
+        rand_seed);
+}
+
+bool run_case(size_t case_index, const std::string& self, const char* counters_path, uint32_t seed) {
+    const Case& c = CASES[case_index];
+    *g_counters = Counters{};
+
+    sim::uart::PeerProcess receiver;
+    sim::uart::PeerProcess sender;
+    start_node(receiver, "receiver", case_index, c.sibling == Sibling::Receiver, self, counters_path,
+               RECEIVER_BOARD_ID, seed);
+    start_node(sender, "sender", case_index, c.sibling == Sibling::Sender, self, counters_path, SENDER_BOARD_ID,
+               seed + 1);
+
+    sim::uart::Line forward(seed);
+    sim::uart::Line back(seed + 1000);
+    std::vector<sim::uart::Frame> to_receiver;
+    std::vector<sim::uart::Frame> to_sender;
+    std::vector<sim::uart::Frame> outgoing;
+    for (uint64_t ms = 0; ms < SEND_MS + DRAIN_MS; ++ms) {
+        sender.step(to_sender, STEP_US, outgoing);
+        forward.carry(outgoing, ms, {.loss = c.loss}, to_receiver);
+        receiver.step(to_receiver, STEP_US, outgoing);
+        back.carry(outgoing, ms, {.loss = c.loss, .cut = ms >= c.outage_from_ms && ms < c.outage_to_ms}, to_sender);
+    }
+    const bool sender_ok = sender.stop() == 0;
+    const bool receiver_ok = receiver.stop() == 0;
+
+    const bool own = ftl_config::FLOW_CONTROL_ENABLED;
+    const Counters& r = *g_counters;
+    printf("%-22s %3s %3s %6u %9u %8u %6u %6u %8.1f %5u\n", c.name,
+           (c.sibling == Sibling::Sender ? !own : own) ? "on" : "off",
+           (c.sibling == Sibling::Receiver ? !own : own) ? "on" : "off", r.sent, r.delivered, r.overflow,
+           r.sent - r.delivered, r.stalls, r.stalled_us / 1000.0, r.link_frames);
+    return sender_ok && receiver_ok && r.out_of_order == 0 && r.link_frames == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // bench_ftl_credit --peer <sender|receiver> <case> <counters file>
+    if (sim::uart::peer_requested()) {
+        if (argc != 5 || std::strcmp(argv[1], "--peer") != 0 || !map_counters(argv[4])) return 127;
+        const size_t case_index = static_cast<size_t>(std::atoi(argv[3]));
+        if (case_index >= std::size(CASES)) return 127;
+        sim::uart::serve_peer(hooks_for(argv[2], CASES[case_index]));
+    }
+
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+
+    char counters_path[] = "/tmp/bench_ftl_credit.XXXXXX";
+    const int fd = mkstemp(counters_path);
+    if (fd < 0 || ftruncate(fd, sizeof(Counters)) != 0) {
+        perror("counters");
+        return 1;
+    }
+    close(fd);
+    if (!map_counters(counters_path)) {
+        perror("mmap");
+        unlink(counters_path);
+        return 1;
+    }
+
+    printf("\n%zu-byte messages for %llu ms at %u baud, RX queue %zu, flow control %s in this build\n",
+           PAYLOAD_SIZE, static_cast<unsigned long long>(SEND_MS), ftl_config::BAUD_RATE,
+           ftl_config::MESSAGE_QUEUE_DEPTH, ftl_config::FLOW_CONTROL_ENABLED ? "on" : "off");
+    printf("%-22s %3s %3s %6s %9s %8s %6s %6s %8s %5s\n", "case", "tx", "rx", "sent", "delivered", "overflow",
+           "lost", "stalls", "stall ms", "link");
+    printf("-------------------------------------------------------------------------------------------\n");
+
+    const std::string self = argv[0];
+    bool ok = true;
+    for (size_t i = 0; i < std::size(CASES); ++i) {
+        ok &= run_case(i, self, counters_path, seed);
+    }
+    unlink(counters_path);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file bench_ftl_link.cpp
+ * @brief FTL baud-rate negotiation over clean, limited and failing lines
+ *
+ * Two nodes, each a PeerProcess on the UART/DMA model (uart_sim.h), send
+ * each other 64-byte Normal messages at 200/s while link negotiation runs.
+ * The bench carries frames between them and flips bits at a rate that
+ * depends on the baud rate each frame went out at, standing in for a cable
+ * that is fine up to some speed and noisy beyond it. Frames sent at a rate
+ * the other end is not listening at arrive as garbage, as on a real UART.
+ * Built once per setting of LINK_NEGOTIATION_ENABLED in ftl.settings:
+ *
+ *   bench_ftl_link      LINK_NEGOTIATION_ENABLED = false
+ *   bench_ftl_link_on   LINK_NEGOTIATION_ENABLED = true
+ *
+ * Each binary runs the other as node B for the mixed case, so both must be
+ * built side by side. Per case:
+ *
+ *   A/B         negotiation in each node's build
+ *   final       line rate of both nodes at the end
+ *   settled     when the rate of either direction last changed
+ *   trials      faster rates tried and given up on (A + B)
+ *   fallbacks   steps down for errors or silence (A + B)
+ *   lost        messages sent but not delivered, both directions
+ *   link        link-layer frames (0xF0 and up) that reached an application
+ *
+ * The bench exits non-zero if the nodes end at different rates, a link
+ * frame reaches an application, or (negotiation on at both ends) a case
+ * marked to recover is still at BAUD_RATE at the end.
+ *
+ *   bench_ftl_link [--seed S]
+ */
+
+#include "ftl.h"
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t PAYLOAD_TAG = 0x42;           // Below LINK_MESSAGE_TYPE_BASE
+constexpr size_t PAYLOAD_SIZE = 64;
+constexpr uint64_t SEND_INTERVAL_US = 5000;
+constexpr uint64_t STEP_US = 1000;
+constexpr uint64_t RUN_MS = 8000;
+constexpr uint64_t DRAIN_MS = 1000;
+constexpr uint64_t BOARD_ID[2] = {0x11, 0x22};          // Source IDs 0x11 (leads) and 0x22
+
+struct Case {
+    const char* name;
+    uint32_t clean_up_to = UINT32_MAX;  // Baud rates above this see `ber`
+    double ber = 1e-3;
+    uint64_t degrade_at_ms = 0;         // From here the line is clean only up to `degrade_to`
+    uint32_t degrade_to = 0;
+    uint64_t cut_from_ms = 0;           // Both directions cut for [from, to)
+    uint64_t cut_to_ms = 0;
+    uint64_t restart_b_ms = 0;          // Node B restarted here
+    bool b_sibling = false;             // Node B runs the other build
+    bool recovers = false;              // Must end above BAUD_RATE when both negotiate
+};
+
+const Case CASES[] = {
+    {.name = "clean"},
+    {.name = "clean to 921600", .clean_up_to = 921600},
+    {.name = "degrades at 3 s", .degrade_at_ms = 3000, .degrade_to = 460800},
+    {.name = "cut 1 s at 3 s", .cut_from_ms = 3000, .cut_to_ms = 4000, .recovers = true},
+    {.name = "B restarts at 3 s", .restart_b_ms = 3000},
+    {.name = "mixed", .b_sibling = true},
+};
+
+// Written by the nodes, read by the bench; a file mapping, so a node
+// running the other build shares it too
+struct NodeCounters {
+    uint32_t sent;
+    uint32_t delivered;
+    uint32_t out_of_order;
+    uint32_t link_frames;
+    uint32_t baud_rate;
+    uint32_t trials_failed;
+    uint32_t fallbacks;
+};
+
+struct Counters {
+    NodeCounters node[2];
+};
+
+Counters* g_counters = nullptr;
+
+bool map_counters(const char* path) {
+    g_counters = static_cast<Counters*>(sim::uart::map_shared_file(path, sizeof(Counters)));
+    return g_counters != nullptr;
+}
+
+// Sends a numbered message every SEND_INTERVAL_US and checks the peer's
+sim::uart::PeerProcess::Hooks node_hooks(int index) {
+    auto next = std::make_shared<uint32_t>(0);
+    auto last = std::make_shared<int64_t>(-1);
+    sim::uart::PeerProcess::Hooks hooks;
+    hooks.setup = [] {
+        sim::uart::mute_stdout(true);
+        ftl::initialize();
+    };
+    hooks.step = [index, next, last] {
+        NodeCounters& counters = g_counters->node[index];
+        if (sim::now_us() < RUN_MS * 1000 && sim::now_us() >= *next * SEND_INTERVAL_US) {
+            std::vector<uint8_t> payload(PAYLOAD_SIZE, 0x5A);
+            payload[0] = PAYLOAD_TAG;
+            std::memcpy(&payload[1], next.get(), sizeof(uint32_t));
+            counters.sent += ftl::send_msg(payload);
+            (*next)++;
+        }
+        ftl::poll();
+        while (ftl::has_msg()) {
+            const ftl::MessageHandle message = ftl::get_msg();
+            const uint8_t* data = message.data();
+            if (message.length() > 0 && data[0] >= ftl_config::LINK_MESSAGE_TYPE_BASE) counters.link_frames++;
+            if (message.length() != PAYLOAD_SIZE || data[0] != PAYLOAD_TAG) continue;
+            uint32_t number;
+            std::memcpy(&number, data + 1, sizeof(number));
+            counters.delivered++;
+            counters.out_of_order += number <= *last;
+            *last = number;
+        }
+    };
+    hooks.report = [index] {
+        NodeCounters& counters = g_counters->node[index];
+        uint32_t error_permille;
+        ftl::get_link_stats(counters.baud_rate, counters.trials_failed, counters.fallbacks, error_permille);
+        return 0;
+    };
+    return hooks;
+}
+
+bool start_b(sim::uart::PeerProcess& node, const Case& c, const std::string& self, const char* counters_path,
+             uint64_t rand_seed) {
+    if (!c.b_sibling) {
+        return node.start(node_hooks(1), BOARD_ID[1], rand_seed);
+    }
+    return node.start_program({sim::uart::sibling_program(self), "--peer", "1", counters_path}, BOARD_ID[1], rand_seed);
+}
+
+bool run_case(const Case& c, const std::string& self, const char* counters_path, uint32_t seed) {
+    *g_counters = Counters{};
+
+    sim::uart::PeerProcess a;
+    sim::uart::PeerProcess b;
+    a.start(node_hooks(0), BOARD_ID[0], seed);
+    start_b(b, c, self, counters_path, seed + 1);
+
+    sim::uart::Line a_to_b(seed);
+    sim::uart::Line b_to_a(seed + 1000);
+    std::vector<sim::uart::Frame> to_a;
+    std::vector<sim::uart::Frame> to_b;
+    std::vector<sim::uart::Frame> outgoing;
+    NodeCounters before_restart{};
+    for (uint64_t ms = 0; ms < RUN_MS + DRAIN_MS; ++ms) {
+        if (c.restart_b_ms && ms == c.restart_b_ms) {
+            // B's counters start again in the new process; keep what it had
+            b.stop();
+            before_restart = g_counters->node[1];
+            g_counters->node[1] = NodeCounters{};
+            start_b(b, c, self, counters_path, seed + 2);
+        }
+        // Frames flip bits above the rate the line carries cleanly
+        const sim::uart::LineFaults faults{
+            .clean_up_to = c.degrade_at_ms && ms >= c.degrade_at_ms ? c.degrade_to : c.clean_up_to,
+            .ber = c.ber,
+            .cut = ms >= c.cut_from_ms && ms < c.cut_to_ms,
+        };
+
+        a.step(to_a, STEP_US, outgoing);
+        a_to_b.carry(outgoing, ms, faults, to_b);
+        b.step(to_b, STEP_US, outgoing);
+        b_to_a.carry(outgoing, ms, faults, to_a);
+    }
+    a.stop();
+    b.stop();
+
+    NodeCounters& na = g_counters->node[0];
+    NodeCounters& nb = g_counters->node[1];
+    nb.sent += before_restart.sent;
+    nb.delivered += before_restart.delivered;
+    nb.trials_failed += before_restart.trials_failed;
+    nb.fallbacks += before_restart.fallbacks;
+
+    const bool own = ftl_config::LINK_NEGOTIATION_ENABLED;
+    const uint32_t lost = (na.sent - nb.delivered) + (nb.sent - na.delivered);
+    char final_rate[32];
+    if (na.baud_rate == nb.baud_rate) {
+        snprintf(final_rate, sizeof(final_rate), "%u", na.baud_rate);
+    } else {
+        snprintf(final_rate, sizeof(final_rate), "%u/%u", na.baud_rate, nb.baud_rate);
+    }
+    printf("%-20s %3s %3s %15s %10.2f %6u %9u %6u %5u\n", c.name, own ? "on" : "off",
+           (c.b_sibling ? !own : own) ? "on" : "off", final_rate,
+           std::max(a_to_b.baud_changed_step(), b_to_a.baud_changed_step()) / 1000.0,
+           na.trials_failed + nb.trials_failed, na.fallbacks + nb.fallbacks, lost, na.link_frames + nb.link_frames);
+    const bool recovered = !c.recovers || !own || c.b_sibling || na.baud_rate > ftl_config::BAUD_RATE;
+    return na.baud_rate == nb.baud_rate && na.link_frames + nb.link_frames == 0 && recovered;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // bench_ftl_link --peer <node index> <counters file>
+    if (sim::uart::peer_requested()) {
+        if (argc != 4 || std::strcmp(argv[1], "--peer") != 0 || !map_counters(argv[3])) return 127;
+        sim::uart::serve_peer(node_hooks(std::atoi(argv[2]) == 0 ? 0 : 1));
+    }
+
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+
+    char counters_path[] = "/tmp/bench_ftl_link.XXXXXX";
+    const int fd = mkstemp(counters_path);
+    if (fd < 0 || ftruncate(fd, sizeof(Counters)) != 0) {
+        perror("counters");
+        return 1;
+    }
+    close(fd);
+    if (!map_counters(counters_path)) {
+        perror("mmap");
+        unlink(counters_path);
+        return 1;
+    }
+
+    printf("\nLink negotiation %s in this build, %u..%u baud, %.0e BER above the clean rate, %llu ms\n",
+           ftl_config::LINK_NEGOTIATION_ENABLED ? "on" : "off", ftl_config::LINK_BAUD_RATES[0],
+           ftl_config::LINK_BAUD_RATES[ftl_config::LINK_BAUD_RATE_COUNT - 1], 1e-3,
+           static_cast<unsigned long long>(RUN_MS));
+    printf("%-20s %3s %3s %15s %10s %6s %9s %6s %5s\n", "case", "A", "B", "final", "settled s", "trials",
+           "fallbacks", "lost", "link");
+    printf("-------------------------------------------------------------------------------------\n");
+
+    const std::string self = argv[0];
+    bool ok = true;
+    for (const Case& c : CASES) {
+        ok &= run_case(c, self, counters_path, seed);
+    }
+    unlink(counters_path);
+    return ok ? 0 : 1;
+}
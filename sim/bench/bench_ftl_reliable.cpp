@@ -0,0 +1,262 @@
+/**
+ * @file bench_ftl_reliable.cpp
+ * @brief FTL reliable delivery through loss, duplication, reordering and restarts
+ *
+ * A sender and a receiver node, each a forked process (uart_sim.h
+ * PeerProcess), joined through the UART/DMA model. The sender keeps
+ * ftl::send_msg_reliable() busy with numbered 8..240-byte messages for
+ * SEND_MS, from Core 0 or Core 1; ACKs come back the other way. The bench
+ * sits on the line in between and, in both directions, drops frames,
+ * delivers some twice, holds some back a few ms so they arrive out of
+ * order, or restarts one of the nodes (a fresh process with a new random
+ * seed, so a new reliable epoch).
+ *
+ * Message numbers carry on across restarts, so the receiver can check the
+ * whole run. Per case:
+ *
+ *   accepted   messages send_msg_reliable() took
+ *   delivered  messages the receiver's get_msg() returned, checked intact
+ *   missing    numbers never delivered
+ *   dup        numbers delivered more than once
+ *   order      numbers delivered after a later one
+ *   failed     messages the sender gave up on after RELIABLE_MAX_RETRIES
+ *   retx       retransmitted frames
+ *   srtt       the sender's smoothed RTT at the end
+ *   slots      message pool slots still in use, sender + receiver
+ *
+ * Without a restart every message must arrive exactly once and in order,
+ * or be counted as failed, and no slot may stay in use; the bench exits
+ * non-zero otherwise. With a restart, what the node lost with its memory
+ * shows up as missing (sender) or dup (receiver).
+ *
+ *   bench_ftl_reliable [--seed S]
+ */
+
+#include "ftl.h"
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t PAYLOAD_TAG = 0x42;           // Below LINK_MESSAGE_TYPE_BASE
+constexpr uint64_t STEP_US = 1000;
+constexpr uint64_t SEND_MS = 5000;
+constexpr uint64_t DRAIN_MS = 5000;             // Room for RELIABLE_MAX_RETRIES at RTO_MAX
+constexpr uint32_t MAX_MESSAGES = 1 << 16;
+constexpr uint64_t SENDER_BOARD_ID = 0x11;              // Source ID 0x11
+constexpr uint64_t RECEIVER_BOARD_ID = 0x22;            // Source ID 0x22
+
+size_t message_length(uint32_t number) {
+    return 8 + (number * 2654435761u >> 16) % (ftl_config::RELIABLE_MAX_PAYLOAD - 7);
+}
+
+std::vector<uint8_t> make_message(uint32_t number) {
+    std::vector<uint8_t> data(message_length(number), static_cast<uint8_t>(number * 13));
+    data[0] = PAYLOAD_TAG;
+    std::memcpy(&data[1], &number, sizeof(number));
+    return data;
+}
+
+// Written by the node processes, read by the bench; lives in shared memory
+// so numbering and the delivery record survive a node restart
+struct Shared {
+    uint32_t next_number;
+    uint32_t accepted;
+    uint32_t failed;
+    uint32_t retransmits;
+    uint32_t srtt_us;
+    uint32_t slots;
+    uint32_t delivered;
+    uint32_t corrupt;
+    uint32_t out_of_order;
+    int64_t last_number;
+    uint8_t times_delivered[MAX_MESSAGES];
+};
+
+Shared* g_shared = nullptr;
+
+struct Case {
+    const char* name;
+    double loss = 0.0;                  // Per frame, each direction
+    double duplicate = 0.0;
+    double reorder = 0.0;               // Held back 1..4 steps
+    bool core1 = false;                 // Sender calls send_msg_reliable() on Core 1
+    uint64_t restart_sender_ms = 0;
+    uint64_t restart_receiver_ms = 0;
+};
+
+sim::uart::PeerProcess::Hooks sender_hooks(bool core1, uint64_t send_us) {
+    sim::uart::PeerProcess::Hooks hooks;
+    hooks.setup = [] {
+        sim::uart::mute_stdout(true);
+        ftl::initialize();
+    };
+    hooks.step = [core1, send_us] {
+        sim::set_core(core1 ? 1 : 0);
+        while (sim::now_us() < send_us && g_shared->next_number < MAX_MESSAGES &&
+               ftl::send_msg_reliable(make_message(g_shared->next_number))) {
+            g_shared->next_number++;
+            g_shared->accepted++;
+        }
+        sim::set_core(0);
+        ftl::poll();
+        while (ftl::has_msg()) {
+            ftl::get_msg();
+        }
+    };
+    hooks.report = [] {
+        uint32_t sent, retransmits, failed, duplicates, srtt_us;
+        ftl::get_reliable_stats(sent, retransmits, failed, duplicates, srtt_us);
+        g_shared->failed += failed;
+        g_shared->retransmits += retransmits;
+        g_shared->srtt_us = srtt_us;
+        uint32_t allocated, peak, spills;
+        ftl::get_pool_stats(allocated, peak, spills);
+        g_shared->slots += allocated;
+        return 0;
+    };
+    return hooks;
+}
+
+sim::uart::PeerProcess::Hooks receiver_hooks() {
+    sim::uart::PeerProcess::Hooks hooks;
+    hooks.setup = [] {
+        sim::uart::mute_stdout(true);
+        ftl::initialize();
+    };
+    hooks.step = [] {
+        ftl::poll();
+        while (ftl::has_msg()) {
+            const ftl::MessageHandle message = ftl::get_msg();
+            const uint8_t* data = message.data();
+            uint32_t number = MAX_MESSAGES;
+            if (message.length() >= 5 && data[0] == PAYLOAD_TAG) {
+                std::memcpy(&number, &data[1], sizeof(number));
+            }
+            if (number >= MAX_MESSAGES || message.length() != message_length(number) ||
+                !std::equal(data + 5, data + message.length(), make_message(number).begin() + 5)) {
+                g_shared->corrupt++;
+                continue;
+            }
+            g_shared->delivered++;
+            g_shared->times_delivered[number]++;
+            if (static_cast<int64_t>(number) < g_shared->last_number) {
+                g_shared->out_of_order++;
+            }
+            g_shared->last_number = std::max<int64_t>(g_shared->last_number, number);
+        }
+    };
+    hooks.report = [] {
+        uint32_t allocated, peak, spills;
+        ftl::get_pool_stats(allocated, peak, spills);
+        g_shared->slots += allocated;
+        return 0;
+    };
+    return hooks;
+}
+
+bool run_case(const Case& c, uint32_t seed) {
+    std::memset(g_shared, 0, sizeof(Shared));
+    g_shared->last_number = -1;
+
+    sim::uart::PeerProcess receiver;
+    sim::uart::PeerProcess sender;
+    uint64_t rand_seed = seed;
+    receiver.start(receiver_hooks(), RECEIVER_BOARD_ID, ++rand_seed);
+    sender.start(sender_hooks(c.core1, SEND_MS * 1000), SENDER_BOARD_ID, ++rand_seed);
+
+    const sim::uart::LineFaults faults{.loss = c.loss, .duplicate = c.duplicate, .reorder = c.reorder};
+    sim::uart::Line forward(seed);
+    sim::uart::Line back(seed + 1000);
+    std::vector<sim::uart::Frame> to_receiver;
+    std::vector<sim::uart::Frame> to_sender;
+    std::vector<sim::uart::Frame> outgoing;
+    for (uint64_t ms = 0; ms < SEND_MS + DRAIN_MS; ++ms) {
+        // Stopped between steps, a node loses everything it held, as after a
+        // reset, but still reports its counters; the slots it held go with it
+        if (c.restart_sender_ms && ms == c.restart_sender_ms) {
+            sender.stop();
+            g_shared->slots = 0;
+            sender.start(sender_hooks(c.core1, (SEND_MS - ms) * 1000), SENDER_BOARD_ID, ++rand_seed);
+        }
+        if (c.restart_receiver_ms && ms == c.restart_receiver_ms) {
+            receiver.stop();
+            g_shared->slots = 0;
+            receiver.start(receiver_hooks(), RECEIVER_BOARD_ID, ++rand_seed);
+        }
+
+        sender.step(to_sender, STEP_US, outgoing);
+        forward.carry(outgoing, ms, faults, to_receiver);
+        receiver.step(to_receiver, STEP_US, outgoing);
+        back.carry(outgoing, ms, faults, to_sender);
+    }
+    sender.stop();
+    receiver.stop();
+
+    const Shared& r = *g_shared;
+    uint32_t missing = 0;
+    uint32_t duplicated = 0;
+    for (uint32_t number = 0; number < r.next_number; ++number) {
+        missing += r.times_delivered[number] == 0;
+        duplicated += r.times_delivered[number] > 1;
+    }
+    printf("%-18s %8u %9u %7u %5u %5u %6u %6u %7.1f %5u %6.0f\n", c.name, r.accepted, r.delivered, missing,
+           duplicated, r.out_of_order, r.failed, r.retransmits, r.srtt_us / 1000.0, r.slots,
+           r.delivered * 1000.0 / SEND_MS);
+
+    const bool restarted = c.restart_sender_ms || c.restart_receiver_ms;
+    return r.corrupt == 0 && (restarted || (missing == r.failed && duplicated == 0 && r.out_of_order == 0 &&
+                                            r.slots == 0));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+
+    void* shared = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    g_shared = static_cast<Shared*>(shared);
+
+    printf("\nReliable messages of 8..%zu bytes for %llu ms at %u baud, window %zu, backlog %zu\n",
+           ftl_config::RELIABLE_MAX_PAYLOAD, static_cast<unsigned long long>(SEND_MS), ftl_config::BAUD_RATE,
+           ftl_config::RELIABLE_WINDOW, ftl_config::RELIABLE_BACKLOG);
+    printf("%-18s %8s %9s %7s %5s %5s %6s %6s %7s %5s %6s\n", "case", "accepted", "delivered", "missing", "dup",
+           "order", "failed", "retx", "srtt ms", "slots", "msg/s");
+    printf("----------------------------------------------------------------------------------------------\n");
+
+    const Case cases[] = {
+        {.name = "clean"},
+        {.name = "clean core1", .core1 = true},
+        {.name = "loss 1%", .loss = 0.01},
+        {.name = "loss 5%", .loss = 0.05},
+        {.name = "loss 20%", .loss = 0.20},
+        {.name = "dup 5%", .duplicate = 0.05},
+        {.name = "reorder 5%", .reorder = 0.05},
+        {.name = "all 5% core1", .loss = 0.05, .duplicate = 0.05, .reorder = 0.05, .core1 = true},
+        {.name = "restart sender", .loss = 0.01, .restart_sender_ms = 2500},
+        {.name = "restart receiver", .loss = 0.01, .restart_receiver_ms = 2500},
+    };
+
+    bool ok = true;
+    for (const Case& c : cases) {
+        ok &= run_case(c, seed);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file bench_ftl_rx.cpp
+ * @brief FTL RX ring scanner cost and recovery from line noise
+ *
+ * Frames a stream of messages with FTL's own TX path, then feeds the
+ * captured wire bytes back through the UART/DMA model (uart_sim.h) in bursts
+ * of --burst bytes, calling ftl::poll() after each burst as the main loop
+ * would. The second half of the table repeats each burst size with noise:
+ * random garbage between 10% of the frames and one byte corrupted in 5% of
+ * them. Reports host ns per received byte spent in poll() (the TX side is
+ * done before timing starts), and checks that every clean frame is
+ * delivered, in order, and that no wrong payload gets through. The CRC
+ * covers the payload only, so a hit on the source ID byte still delivers
+ * the frame; those show up as "intact" rather than as false accepts. Each row
+ * runs in a fresh process and exits non-zero if those checks fail.
+ *
+ *   bench_ftl_rx [--frames N] [--payload B] [--seed S]
+ */
+
+#include "ftl.h"
+#include "uart_sim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t PAYLOAD_TAG = 0x42;
+constexpr double CORRUPT_SHARE = 0.05;
+constexpr double GARBAGE_SHARE = 0.10;
+constexpr size_t GARBAGE_MAX = 40;
+
+struct Result {
+    uint32_t delivered;
+    uint32_t clean;
+    bool in_order;
+    uint32_t false_accepts;
+    uint32_t corrupted;
+    uint32_t intact;            // Corrupted frames delivered with the payload unharmed
+    uint32_t crc_errors;
+    uint32_t framing_errors;
+    double ns_per_byte;
+};
+
+Result run(uint32_t frame_count, size_t payload_size, size_t burst, bool noise, uint32_t seed) {
+    ftl::initialize();
+    std::mt19937 rng(seed);
+
+    // Frame the messages with the firmware's TX path
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<std::vector<uint8_t>> frames;
+    for (uint32_t next = 0; next < frame_count || sim::uart::tx_busy() || !ftl::is_tx_queue_empty();) {
+        while (next < frame_count && ftl::is_tx_ready()) {
+            std::vector<uint8_t> payload(payload_size);
+            payload[0] = PAYLOAD_TAG;
+            payload[1] = static_cast<uint8_t>(next);
+            payload[2] = static_cast<uint8_t>(next >> 8);
+            for (size_t k = 3; k < payload.size(); ++k) payload[k] = static_cast<uint8_t>(rng());
+            if (!ftl::send_msg(payload)) break;
+            payloads.push_back(std::move(payload));
+            next++;
+        }
+        ftl::poll();
+        sim::uart::run(1000);
+        for (auto& frame : sim::uart::take_tx()) frames.push_back(std::move(frame.bytes));
+    }
+
+    // Lay out the wire, with noise between frames and in some of them
+    Result result{};
+    std::vector<uint8_t> wire;
+    std::vector<bool> corrupted(frames.size(), false);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (noise && chance(rng) < GARBAGE_SHARE) {
+            for (size_t k = 1 + rng() % GARBAGE_MAX; k > 0; --k) wire.push_back(static_cast<uint8_t>(rng()));
+        }
+        if (noise && chance(rng) < CORRUPT_SHARE) {
+            frames[i][rng() % frames[i].size()] ^= static_cast<uint8_t>(1 + rng() % 255);
+            corrupted[i] = true;
+            result.corrupted++;
+        }
+        wire.insert(wire.end(), frames[i].begin(), frames[i].end());
+    }
+
+    uint32_t bytes_before, messages_before, queued, pool_allocated, crc_before, framing_before;
+    ftl::get_stats(bytes_before, messages_before, queued, pool_allocated, crc_before, framing_before);
+
+    int last_index = -1;
+    result.in_order = true;
+    uint64_t poll_ns = 0;
+    for (size_t pos = 0; pos < wire.size(); pos += burst) {
+        const size_t length = std::min(burst, wire.size() - pos);
+        sim::uart::receive(std::span<const uint8_t>(wire.data() + pos, length), sim::uart::baud_rate());
+
+        const auto start = std::chrono::steady_clock::now();
+        ftl::poll();
+        poll_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        while (ftl::has_msg()) {
+            const ftl::MessageHandle message = ftl::get_msg();
+            const uint8_t* data = message.data();
+            const int index = message.length() >= 3 ? (data[1] | (data[2] << 8)) : -1;
+            if (index < 0 || index >= static_cast<int>(payloads.size()) || message.length() != payload_size ||
+                !std::equal(data, data + payload_size, payloads[index].begin())) {
+                result.false_accepts++;
+                continue;
+            }
+            if (corrupted[index]) {
+                result.intact++;
+                continue;
+            }
+            result.delivered++;
+            result.in_order &= index > last_index;
+            last_index = index;
+        }
+    }
+
+    uint32_t bytes_rx, messages_rx, crc_errors, framing_errors;
+    ftl::get_stats(bytes_rx, messages_rx, queued, pool_allocated, crc_errors, framing_errors);
+    result.crc_errors = crc_errors - crc_before;
+    result.framing_errors = framing_errors - framing_before;
+    result.clean = static_cast<uint32_t>(frames.size()) - result.corrupted;
+    result.ns_per_byte = static_cast<double>(poll_ns) / wire.size();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t frame_count = 5000;
+    size_t payload_size = 200;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) frame_count = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--payload") && i + 1 < argc) payload_size = static_cast<size_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+    frame_count = std::min<uint32_t>(frame_count, 65535);
+    payload_size = std::clamp<size_t>(payload_size, 3, ftl_config::MAX_PAYLOAD_SIZE);
+
+    printf("\n%u frames of %zu bytes, %zu byte RX ring\n", frame_count, payload_size,
+           ftl_config::RX_CIRCULAR_BUFFER_SIZE);
+    printf("%-6s %6s %9s %9s %6s %9s %7s %6s %6s %8s %8s\n",
+           "noise", "burst", "delivered", "clean", "order", "corrupted", "intact", "false", "crc", "framing", "ns/B");
+    printf("--------------------------------------------------------------------------------------------\n");
+
+    for (bool noise : {false, true}) {
+        for (size_t burst : {16, 48, 256, 1024}) {
+            sim::uart::run_isolated([&] {
+                const Result r = run(frame_count, payload_size, burst, noise, seed);
+                sim::uart::mute_stdout(false);
+                printf("%-6s %6zu %9u %9u %6s %9u %7u %6u %6u %8u %8.2f\n", noise ? "yes" : "no", burst,
+                       r.delivered, r.clean, r.in_order ? "yes" : "NO", r.corrupted, r.intact, r.false_accepts,
+                       r.crc_errors, r.framing_errors, r.ns_per_byte);
+                return r.delivered == r.clean && r.in_order && r.false_accepts == 0 ? 0 : 1;
+            });
+        }
+    }
+    return 0;
+}
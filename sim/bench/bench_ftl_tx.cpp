@@ -0,0 +1,95 @@
+/**
+ * @file bench_ftl_tx.cpp
+ * @brief FTL TX line utilisation against the poll interval
+ *
+ * Keeps the FTL TX queue full and calls ftl::poll() every --poll interval,
+ * with the UART/DMA model (uart_sim.h) draining the line at BAUD_RATE. The
+ * DMA completion IRQ chains the next framed descriptor, so the line should
+ * stay busy between polls for as long as the frames already handed to the
+ * DMA last: the whole descriptor ring (TX_DESCRIPTOR_RING_SIZE) for Control
+ * messages, TX_LOW_PRIORITY_IN_FLIGHT frames for every other class. Reports,
+ * per class, payload size and poll interval:
+ *
+ *   line     share of time the model saw a byte on the wire
+ *   ftl      line_utilization_permille from ftl::get_tx_line_stats()
+ *   b2b      frames started straight from the previous completion IRQ
+ *
+ *   bench_ftl_tx [--ms N]
+ */
+
+#include "ftl.h"
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Result {
+    uint32_t frames;
+    uint32_t line_permille;
+    uint32_t ftl_permille;
+    uint32_t back_to_back;
+    uint32_t bytes_per_second;
+};
+
+Result run(ftl_config::TxClass tx_class, size_t payload_size, uint64_t poll_us, uint64_t duration_us) {
+    ftl::initialize();
+
+    std::vector<uint8_t> payload(payload_size, 0x5A);
+    payload[0] = 0x42;
+
+    const uint64_t start_us = sim::now_us();
+    uint32_t frames = 0;
+    while (sim::now_us() - start_us < duration_us) {
+        while (ftl::is_tx_ready() && ftl::send_msg(payload, tx_class)) {
+        }
+        ftl::poll();
+        sim::uart::run(poll_us);
+        frames += static_cast<uint32_t>(sim::uart::take_tx().size());
+    }
+
+    Result result{};
+    result.frames = frames;
+    result.line_permille = static_cast<uint32_t>(sim::uart::stats().tx_busy_us * 1000 / (sim::now_us() - start_us));
+    uint32_t total_bytes;
+    ftl::get_tx_line_stats(total_bytes, result.bytes_per_second, result.ftl_permille, result.back_to_back);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t duration_ms = 2000;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ms") && i + 1 < argc) duration_ms = static_cast<uint64_t>(std::atoi(argv[++i]));
+    }
+
+    printf("\nTX queue kept full for %llu ms at %u baud, %zu descriptors, %zu below Control\n",
+           static_cast<unsigned long long>(duration_ms), ftl_config::BAUD_RATE, ftl_config::TX_DESCRIPTOR_RING_SIZE,
+           ftl_config::TX_LOW_PRIORITY_IN_FLIGHT);
+    printf("%-8s %8s %8s %8s %8s %8s %8s %8s\n", "class", "payload", "poll ms", "frames", "line", "ftl", "b2b", "B/s");
+    printf("-----------------------------------------------------------------------\n");
+
+    using ftl_config::TxClass;
+    for (TxClass tx_class : {TxClass::Normal, TxClass::Control}) {
+        for (size_t payload_size : {16, 64, 248}) {
+            for (uint64_t poll_us : {500, 1000, 2000, 5000, 10000, 20000}) {
+                sim::uart::run_isolated([&] {
+                    const Result r = run(tx_class, payload_size, poll_us, duration_ms * 1000);
+                    sim::uart::mute_stdout(false);
+                    printf("%-8s %8zu %8.1f %8u %7.1f%% %7.1f%% %8u %8u\n",
+                           tx_class == TxClass::Control ? "control" : "normal", payload_size, poll_us / 1000.0,
+                           r.frames, r.line_permille / 10.0, r.ftl_permille / 10.0, r.back_to_back,
+                           r.bytes_per_second);
+                    return 0;
+                });
+            }
+        }
+    }
+    return 0;
+}
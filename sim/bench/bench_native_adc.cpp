@@ -0,0 +1,228 @@
+/**
+ * @file bench_native_adc.cpp
+ * @brief Decimation and overrun handling of the on-chip ADC capture
+ *
+ * Runs adc::NativeADC against the ADC model (adc_sim.h): free-running
+ * round-robin conversions -> DREQ-paced DMA into the capture ring, with the
+ * lap chain and IRQ as on target -> process() every PROCESS_US, as Core 1
+ * calls it. Input 0 sits at DC_VOLTS; the others carry sines of different
+ * frequencies, so a sample handed to the wrong channel shows up.
+ *
+ * Every decimated output is checked against a reference built from the
+ * model's record of each conversion: the samples of that input since the
+ * last restart, convolved with the CIC impulse response (boxcar is order 1)
+ * and scaled by 1 / decimation^(order - 1). The reference takes the input
+ * from the model, not from the capture's round-robin slot, and restarts
+ * wherever process() reports an overrun. The "stall" cases leave the ring
+ * unread for longer than a lap every STALL_EVERY_US, with stall lengths that
+ * vary so the skipped count is not always a multiple of the channel count.
+ * Their decimation keeps the outputs of one full ring within OUTPUT_SIZE, so
+ * none are dropped when process() catches up.
+ *
+ *   samples    raw samples consumed
+ *   outputs    decimated outputs read, all channels
+ *   overruns   raw samples skipped by process()
+ *   odd        overruns whose skip was not a multiple of the channel count
+ *   bad        outputs differing from the reference
+ *   dc_mV      last output of input 0 through volts_scale(), less DC_VOLTS
+ *
+ *   bench_native_adc [--seconds N]
+ *
+ * The bench exits non-zero if any output is bad or missing, a sample is
+ * neither consumed nor counted as overrun, a stall case never skips an odd
+ * count, or input 0 reads further than one LSB from DC_VOLTS.
+ */
+
+#include "adc/native_adc.h"
+
+#include "adc_sim.h"
+#include "i2c_sim.h"
+#include "uart_sim.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t PROCESS_US = 1000;
+constexpr uint32_t STALL_EVERY_US = 40'000;
+constexpr double DC_VOLTS = 1.25;
+constexpr double LSB_VOLTS = 3.3 / 4096.0;
+
+struct Case {
+    const char* name;
+    uint8_t input_mask;
+    uint32_t sample_rate_hz;
+    adc::Decimator decimator;
+    uint16_t decimation;
+    uint8_t cic_order = 1;
+    uint32_t stall_us = 0;
+};
+
+const Case CASES[] = {
+    {"boxcar 1ch", 0b00001, 200'000, adc::Decimator::Boxcar, 64},
+    {"boxcar 3ch", 0b00111, 500'000, adc::Decimator::Boxcar, 48},
+    {"cic2 3ch", 0b01011, 500'000, adc::Decimator::CIC, 50, 2},
+    {"cic3 5ch", 0b11111, 480'000, adc::Decimator::CIC, 20, 3},
+    {"stall box 5ch", 0b11111, 500'000, adc::Decimator::Boxcar, 32, 1, 9000},
+    {"stall cic2 3ch", 0b01011, 500'000, adc::Decimator::CIC, 50, 2, 9000},
+    {"stall cic3 3ch", 0b10110, 400'000, adc::Decimator::CIC, 24, 3, 11'000},
+};
+
+// Rows are collected and printed after the run so driver log output does not
+// interleave with the table.
+std::vector<std::string> g_rows;
+
+void set_inputs() {
+    sim::adc::set_input(0, sim::Waveform::constant(DC_VOLTS));
+    sim::adc::set_input(1, sim::Waveform::sine(1.2, 130.0, 1.65));
+    sim::adc::set_input(2, sim::Waveform::sine(0.8, 410.0, 2.0, 1.0));
+    sim::adc::set_input(3, sim::Waveform::sine(1.5, 57.0, 1.6, 2.0));
+    sim::adc::set_input(4, sim::Waveform::sine(0.1, 3.0, 0.7));
+}
+
+// Decimator over the samples one input received since the last restart
+struct Reference {
+    std::vector<int64_t> taps;      // CIC impulse response, length order * (decimation - 1) + 1
+    int64_t normaliser = 1;
+    uint16_t decimation = 1;
+    std::vector<uint16_t> samples;
+    std::vector<int32_t> outputs;
+
+    Reference(uint16_t decimation_, uint8_t order) : taps{1}, decimation(decimation_) {
+        for (uint8_t r = 0; r < order; ++r) {
+            std::vector<int64_t> next(taps.size() + decimation - 1);
+            for (size_t i = 0; i < taps.size(); ++i) {
+                for (size_t k = 0; k < decimation; ++k) next[i + k] += taps[i];
+            }
+            taps.swap(next);
+            if (r > 0) normaliser *= decimation;
+        }
+    }
+
+    void restart() { samples.clear(); }
+
+    void add(uint16_t sample) {
+        samples.push_back(sample);
+        if (samples.size() % decimation != 0) {
+            return;
+        }
+        int64_t sum = 0;
+        for (size_t k = 0; k < taps.size() && k < samples.size(); ++k) {
+            sum += taps[k] * samples[samples.size() - 1 - k];
+        }
+        outputs.push_back(static_cast<int32_t>(sum / normaliser));
+    }
+};
+
+bool run_case(const Case& c, uint64_t run_us) {
+    sim::reset();
+    sim::uart::reset();
+    sim::adc::reset();
+    set_inputs();
+
+    auto capture = std::make_unique<adc::NativeADC>();
+    if (!capture->init({.input_mask = c.input_mask, .sample_rate_hz = c.sample_rate_hz, .decimator = c.decimator,
+                        .decimation = c.decimation, .cic_order = c.cic_order})) {
+        g_rows.emplace_back(std::string(c.name) + ": init failed");
+        return false;
+    }
+    const uint8_t order = c.decimator == adc::Decimator::CIC ? c.cic_order : 1;
+    uint8_t channels = 0;
+    for (uint8_t input = 0; input < adc::NativeADC::MAX_INPUTS; ++input) {
+        channels += (c.input_mask >> input) & 1;
+    }
+
+    std::vector<Reference> reference(adc::NativeADC::MAX_INPUTS, Reference(c.decimation, order));
+    std::vector<std::vector<int32_t>> outputs(adc::NativeADC::MAX_INPUTS);
+    const auto& history = sim::adc::history();
+
+    uint64_t consumed_to = 0;       // Samples consumed or skipped so far
+    uint32_t odd_skips = 0;
+    uint32_t stalls = 0;
+    uint64_t next_stall_us = STALL_EVERY_US;
+    for (uint64_t t = 0; t < run_us;) {
+        uint64_t step = PROCESS_US;
+        if (c.stall_us && t >= next_stall_us) {
+            step = c.stall_us + 7 * stalls++;
+            next_stall_us += STALL_EVERY_US;
+        }
+        sim::adc::run(step);
+        t += step;
+
+        const uint32_t overruns_before = capture->stats().overruns;
+        capture->process();
+        const adc::NativeADC::Stats stats = capture->stats();
+        const uint32_t skipped = stats.overruns - overruns_before;
+        if (skipped) {
+            odd_skips += skipped % channels != 0;
+            for (Reference& ref : reference) ref.restart();
+        }
+        const uint64_t end = uint64_t{stats.samples} + stats.overruns;
+        for (uint64_t i = consumed_to + skipped; i < end && i < history.size(); ++i) {
+            reference[history[i].input].add(history[i].code);
+        }
+        consumed_to = end;
+
+        for (uint8_t input = 0; input < adc::NativeADC::MAX_INPUTS; ++input) {
+            int32_t value;
+            while (capture->read(input, value)) outputs[input].push_back(value);
+        }
+    }
+
+    const adc::NativeADC::Stats stats = capture->stats();
+    uint32_t bad = 0;
+    bool complete = stats.dropped == 0 && consumed_to == history.size() && sim::adc::stats().fifo_overflows == 0;
+    for (uint8_t input = 0; input < adc::NativeADC::MAX_INPUTS; ++input) {
+        const auto& got = outputs[input];
+        const auto& want = reference[input].outputs;
+        complete &= got.size() == want.size();
+        for (size_t i = 0; i < got.size() && i < want.size(); ++i) {
+            bad += got[i] != want[i];
+        }
+    }
+
+    double dc_error = 0.0;
+    if (c.input_mask & 1) {
+        dc_error = capture->volts_scale().to_float(capture->latest(0)) - DC_VOLTS;
+    }
+
+    char line[128];
+    snprintf(line, sizeof(line), "%-15s 0x%02X %6s/%-3u %8u %7u %8u %3u %5u %7.3f", c.name, c.input_mask,
+             c.decimator == adc::Decimator::CIC ? "cic" : "boxcar", c.decimation, stats.samples, stats.outputs,
+             stats.overruns, odd_skips, bad, dc_error * 1000.0);
+    g_rows.emplace_back(line);
+
+    const bool overruns_expected = c.stall_us != 0;
+    return complete && bad == 0 && std::fabs(dc_error) <= LSB_VOLTS && (stats.overruns > 0) == overruns_expected &&
+           (!overruns_expected || odd_skips > 0);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    double seconds = 0.4;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = std::atof(argv[++i]);
+    }
+    const auto run_us = static_cast<uint64_t>(seconds * 1e6);
+
+    bool ok = true;
+    for (const Case& c : CASES) {
+        ok &= run_case(c, run_us);
+    }
+
+    printf("\nNative ADC capture: %.1f s per case, process() every %u us, input 0 at %.3f V\n", seconds, PROCESS_US,
+           DC_VOLTS);
+    printf("%-15s %4s %10s %8s %7s %8s %3s %5s %7s\n", "case", "mask", "filter", "samples", "outputs", "overruns",
+           "odd", "bad", "dc_mV");
+    printf("------------------------------------------------------------------------------\n");
+    for (const auto& row : g_rows) {
+        printf("%s\n", row.c_str());
+    }
+    return ok ? 0 : 1;
+}
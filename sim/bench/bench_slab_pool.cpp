@@ -0,0 +1,282 @@
+/**
+ * @file bench_slab_pool.cpp
+ * @brief SlabPool free lists under exhaustion, contention and occupancy
+ *
+ * Runs the pool FTL uses for messages (ftl::MessagePoolType) on the host in
+ * three parts:
+ *
+ *   exhaustion   acquire(size) until the pool says no, per request size. A
+ *                request takes its own class first and spills upwards, so it
+ *                must get every object of its class and those above, and the
+ *                pool must hand out all of them again once they are released.
+ *   contention   threads acquire objects of random sizes, share them with
+ *                add_ref(), stamp and check them, and pass some through a
+ *                mailbox to be released by another thread, as Core 0 and
+ *                Core 1 do. An owner table catches an object handed out
+ *                twice; a stamp that changed under its holder catches the
+ *                same from the other side. A four-object pool runs the same
+ *                load, each thread holding one object at most, to make the
+ *                free-list head come round often (ABA).
+ *   occupancy    cost of an acquire/release pair with the pool empty, half
+ *                full and nearly full, which the free list keeps flat.
+ *
+ * Per contention case:
+ *
+ *   ops        pool operations across all threads
+ *   refused    acquires that found the pool empty
+ *   double     objects handed to a second owner while still held
+ *   stamp      objects whose contents changed under their holder
+ *   spills     acquires served from a larger class
+ *   peak       the most objects in use at once
+ *   left       objects still in use after every thread released its own
+ *   ns/op      wall time per operation
+ *
+ * With one host core the threads interleave only where the scheduler
+ * preempts them, which seldom falls between loading a free-list head and its
+ * CAS: a pool with the head tag taken out passes there too. Run it on a
+ * multi-core host to put the ABA case to the test. The bench exits non-zero
+ * on any double, stamp, leak or exhaustion count that differs from the
+ * layout.
+ *
+ *   bench_slab_pool [--ops N] [--seed S]
+ */
+
+#include "core/ftl_api.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Pool = ftl::MessagePoolType;
+using TinyPool = SlabPool<std::array<size_t, 1>{32}, std::array<size_t, 1>{4}, 4>;
+
+constexpr size_t MAILBOX_SIZE = 16;
+
+// How much of the pool the threads keep out of the free lists
+struct Load {
+    size_t held_max;                    // Objects one thread holds at once
+    size_t mailbox_slots;               // Mailbox slots in use
+};
+
+constexpr Load MESSAGE_LOAD = {6, MAILBOX_SIZE};
+constexpr Load TINY_LOAD = {1, 1};      // Leaves the free list two objects or more
+
+// Objects in classes 0..size_class together
+size_t class_end(size_t size_class) {
+    size_t end = 0;
+    for (size_t c = 0; c <= size_class; ++c) end += ftl_config::MESSAGE_POOL_SLOT_COUNTS[c];
+    return end;
+}
+
+bool run_exhaustion(Pool& pool) {
+    bool ok = true;
+    printf("%-8s %8s %8s %7s %7s\n", "request", "acquired", "expected", "spills", "again");
+    printf("------------------------------------------\n");
+    for (size_t c = 0; c < ftl_config::MESSAGE_POOL_CLASS_COUNT; ++c) {
+        const size_t size = ftl_config::MESSAGE_POOL_SLOT_SIZES[c];
+        const size_t expected = Pool::MAX_OBJECTS - class_end(c) + ftl_config::MESSAGE_POOL_SLOT_COUNTS[c];
+        const size_t spills_before = pool.get_spill_count();
+
+        size_t acquired[2] = {};
+        for (size_t round = 0; round < 2; ++round) {
+            std::vector<Pool::Handle> held;
+            std::array<bool, Pool::MAX_OBJECTS> seen{};
+            for (Pool::Handle h; (h = pool.acquire(size)) != Pool::INVALID;) {
+                ok &= !seen[h] && pool.capacity(h) >= size;
+                seen[h] = true;
+                held.push_back(h);
+            }
+            acquired[round] = held.size();
+            for (Pool::Handle h : held) pool.release(h);
+        }
+        const size_t spills = (pool.get_spill_count() - spills_before) / 2;
+        printf("%-8zu %8zu %8zu %7zu %7zu\n", size, acquired[0], expected, spills, acquired[1]);
+        ok &= acquired[0] == expected && acquired[1] == expected &&
+              spills == expected - ftl_config::MESSAGE_POOL_SLOT_COUNTS[c];
+    }
+    ok &= pool.get_allocated_count() == 0;
+    return ok;
+}
+
+struct Stress {
+    std::atomic<uint32_t> refused{0};
+    std::atomic<uint32_t> doubled{0};
+    std::atomic<uint32_t> stamp_errors{0};
+    std::array<std::atomic<uint8_t>, 255> owner{};          // Thread + 1 holding each object, 0 when free
+    std::array<std::atomic<uint8_t>, MAILBOX_SIZE> mailbox{};
+};
+
+template<typename P>
+void stress_thread(P& pool, Stress& s, uint8_t id, uint32_t ops, Load load, uint32_t seed) {
+    struct Held {
+        typename P::Handle handle;
+        uint32_t stamp;
+    };
+    std::mt19937 rng(seed);
+    std::vector<Held> held;
+    uint32_t next_stamp = static_cast<uint32_t>(id) << 24;
+
+    // Takes over an object: the owner table must show it free
+    const auto take = [&](typename P::Handle h) {
+        uint8_t expected = 0;
+        if (!s.owner[h].compare_exchange_strong(expected, id + 1, std::memory_order_acq_rel)) {
+            s.doubled.fetch_add(1, std::memory_order_relaxed);
+        }
+        const uint32_t stamp = ++next_stamp;
+        std::memcpy(pool.get_ptr(h), &stamp, sizeof(stamp));
+        held.push_back({h, stamp});
+    };
+    const auto drop = [&](size_t i) {
+        const Held item = held[i];
+        held[i] = held.back();
+        held.pop_back();
+        uint32_t stamp;
+        std::memcpy(&stamp, pool.get_ptr(item.handle), sizeof(stamp));
+        if (stamp != item.stamp) s.stamp_errors.fetch_add(1, std::memory_order_relaxed);
+        return item.handle;
+    };
+
+    for (uint32_t op = 0; op < ops; ++op) {
+        if (held.size() < load.held_max && rng() % 2) {
+            const typename P::Handle h = pool.acquire(1 + rng() % P::MAX_OBJECT_SIZE);
+            if (h == P::INVALID) {
+                s.refused.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                take(h);
+            }
+            continue;
+        }
+        if (held.empty()) continue;
+
+        const typename P::Handle h = drop(rng() % held.size());
+        switch (rng() % 3) {
+        case 0:
+            // Released here
+            s.owner[h].store(0, std::memory_order_release);
+            pool.release(h);
+            break;
+        case 1:
+            // Shared, then both references dropped
+            pool.add_ref(h);
+            s.owner[h].store(0, std::memory_order_release);
+            pool.release(h);
+            pool.release(h);
+            break;
+        default: {
+            // Handed to whichever thread finds it; what was there is ours now
+            s.owner[h].store(0, std::memory_order_release);
+            const uint8_t found = s.mailbox[rng() % load.mailbox_slots].exchange(h + 1, std::memory_order_acq_rel);
+            if (found != 0) {
+                take(static_cast<typename P::Handle>(found - 1));
+            }
+            break;
+        }
+        }
+    }
+    for (const Held& item : held) {
+        s.owner[item.handle].store(0, std::memory_order_release);
+        pool.release(item.handle);
+    }
+}
+
+template<typename P>
+bool run_contention(const char* name, unsigned threads, uint32_t ops, Load load, uint32_t seed) {
+    auto pool = std::make_unique<P>();
+    Stress s;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] { stress_thread(*pool, s, static_cast<uint8_t>(t), ops, load, seed + t); });
+    }
+    for (auto& worker : workers) worker.join();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Whatever is still in the mailbox goes back now
+    for (auto& slot : s.mailbox) {
+        const uint8_t h = slot.exchange(0);
+        if (h != 0) pool->release(static_cast<typename P::Handle>(h - 1));
+    }
+    const size_t left = pool->get_allocated_count();
+    const size_t spills = pool->get_spill_count();
+    const size_t peak = pool->get_peak_allocated_count();
+
+    // The free lists must still hold every object exactly once
+    std::vector<typename P::Handle> all;
+    std::array<bool, P::MAX_OBJECTS> seen{};
+    bool intact = true;
+    for (typename P::Handle h; (h = pool->acquire(1)) != P::INVALID;) {
+        intact &= !seen[h];
+        seen[h] = true;
+        all.push_back(h);
+    }
+    intact &= all.size() == P::MAX_OBJECTS;
+
+    const uint64_t total_ops = static_cast<uint64_t>(threads) * ops;
+    printf("%-12s %7u %9llu %8u %6u %5u %7zu %4zu %4zu %6.0f\n", name, threads,
+           static_cast<unsigned long long>(total_ops), s.refused.load(), s.doubled.load(), s.stamp_errors.load(),
+           spills, peak, left, std::chrono::duration<double, std::nano>(elapsed).count() / total_ops);
+    return s.doubled == 0 && s.stamp_errors == 0 && left == 0 && intact;
+}
+
+// One acquire/release pair of a full-size object, with `in_use` others held
+double ns_per_pair(Pool& pool, size_t in_use, uint32_t pairs) {
+    std::vector<Pool::Handle> held;
+    for (size_t i = 0; i < in_use; ++i) held.push_back(pool.acquire());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < pairs; ++i) {
+        pool.release(pool.acquire());
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    for (Pool::Handle h : held) pool.release(h);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / pairs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t ops = 200000;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--ops") && i + 1 < argc) ops = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<uint32_t>(std::atoi(argv[++i]));
+    }
+
+    bool ok = true;
+    auto pool = std::make_unique<Pool>();
+
+    printf("\nMessage pool, %zu objects in %zu classes, %zu bytes\n\n", Pool::MAX_OBJECTS,
+           ftl_config::MESSAGE_POOL_CLASS_COUNT, Pool::TOTAL_SIZE);
+    ok &= run_exhaustion(*pool);
+
+    printf("\n%u ops per thread, %u host cores\n", ops, std::thread::hardware_concurrency());
+    printf("%-12s %7s %9s %8s %6s %5s %7s %4s %4s %6s\n", "pool", "threads", "ops", "refused", "double", "stamp",
+           "spills", "peak", "left", "ns/op");
+    printf("-----------------------------------------------------------------------------\n");
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        ok &= run_contention<Pool>("message", threads, ops, MESSAGE_LOAD, seed);
+    }
+    for (unsigned threads : {2u, 8u}) {
+        ok &= run_contention<TinyPool>("4 objects", threads, ops, TINY_LOAD, seed);
+    }
+
+    const size_t full_size = ftl_config::MESSAGE_POOL_SLOT_COUNTS[ftl_config::MESSAGE_POOL_CLASS_COUNT - 1];
+    printf("\n%-10s %8s\n", "in use", "ns/pair");
+    printf("-------------------\n");
+    for (size_t in_use : {size_t{0}, full_size / 2, full_size - 1}) {
+        printf("%4zu/%-5zu %8.1f\n", in_use, full_size, ns_per_pair(*pool, in_use, 1000000));
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,456 @@
+#include "i2c_sim.h"
+
+#include "pico/stdlib.h"
+#include "pico/rand.h"
+#include "pico/unique_id.h"
+#include "hardware/irq.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+i2c_inst_t i2c0_inst{0};
+i2c_inst_t i2c1_inst{1};
+
+namespace sim {
+
+namespace {
+
+constexpr size_t MAX_GPIO = 48;
+
+struct GpioState {
+    bool output = false;
+    bool is_output = false;
+    bool input = true;          // Idle high (pull-ups)
+    bool input_driven = false;
+    uint32_t irq_enabled = 0;
+    uint32_t irq_pending = 0;
+    void (*irq_handler)(void) = nullptr;
+};
+
+uint64_t g_now_us = 0;
+uint32_t g_callback_depth = 0;
+uint64_t g_timer_callback_ns = 0;
+std::vector<repeating_timer_t*> g_timers;
+std::array<GpioState, MAX_GPIO> g_gpio{};
+std::array<Bus, 2> g_buses{};
+
+constexpr size_t MAX_IRQ = 64;
+constexpr uint64_t DEFAULT_BOARD_ID = 0xEDECEBEAE9E8E7E6ull;     // Bytes 0xE6..0xED
+
+struct IrqHandler {
+    irq_handler_t handler;
+    unsigned int core;
+    uint8_t order_priority;
+};
+
+struct IrqState {
+    bool enabled = false;
+    bool running = false;
+    bool pending = false;
+    std::vector<IrqHandler> handlers;
+};
+
+std::array<IrqState, MAX_IRQ> g_irqs{};
+unsigned int g_core = 0;
+uint64_t g_board_id = DEFAULT_BOARD_ID;
+std::mt19937_64 g_rand{0x464C54u};
+
+uint64_t host_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+repeating_timer_t* next_due(uint64_t limit_us) {
+    repeating_timer_t* due = nullptr;
+    for (auto* timer : g_timers) {
+        if (timer->next_fire_us <= limit_us &&
+            (!due || timer->next_fire_us < due->next_fire_us)) {
+            due = timer;
+        }
+    }
+    return due;
+}
+
+void remove_timer(repeating_timer_t* timer) {
+    g_timers.erase(std::remove(g_timers.begin(), g_timers.end(), timer), g_timers.end());
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// VIRTUAL TIME
+// ============================================================================
+uint64_t now_us() { return g_now_us; }
+
+void consume(uint64_t duration_us) { g_now_us += duration_us; }
+
+void run_for(uint64_t duration_us) {
+    // Timers never preempt a running callback, matching a single alarm IRQ.
+    if (g_callback_depth > 0) {
+        consume(duration_us);
+        return;
+    }
+
+    const uint64_t target_us = g_now_us + duration_us;
+
+    while (repeating_timer_t* timer = next_due(target_us)) {
+        g_now_us = std::max(g_now_us, timer->next_fire_us);
+        const uint64_t start_us = g_now_us;
+
+        g_callback_depth++;
+        const uint64_t t0 = host_ns();
+        bool keep = timer->callback(timer);
+        g_timer_callback_ns += host_ns() - t0;
+        g_callback_depth--;
+
+        if (!keep) {
+            remove_timer(timer);
+            continue;
+        }
+
+        // Negative delay: fixed start-to-start period. Positive: end-to-start gap.
+        if (timer->delay_us < 0) {
+            timer->next_fire_us = start_us + static_cast<uint64_t>(-timer->delay_us);
+        } else {
+            timer->next_fire_us = g_now_us + static_cast<uint64_t>(timer->delay_us);
+        }
+    }
+
+    g_now_us = std::max(g_now_us, target_us);
+}
+
+void reset() {
+    g_now_us = 0;
+    g_callback_depth = 0;
+    g_timer_callback_ns = 0;
+    g_timers.clear();
+    g_gpio.fill(GpioState{});
+    for (auto& b : g_buses) {
+        b.clear();
+    }
+    g_irqs.fill(IrqState{});
+    g_core = 0;
+    g_board_id = DEFAULT_BOARD_ID;
+    g_rand.seed(0x464C54u);
+}
+
+uint64_t timer_callback_ns() { return g_timer_callback_ns; }
+
+// ============================================================================
+// INTERRUPTS AND CORES
+// ============================================================================
+void raise_irq(unsigned int num) {
+    if (num >= MAX_IRQ) return;
+    IrqState& irq = g_irqs[num];
+    if (!irq.enabled) return;
+    if (irq.running) {
+        irq.pending = true;
+        return;
+    }
+
+    const unsigned int interrupted = g_core;
+    irq.running = true;
+    do {
+        irq.pending = false;
+        for (size_t i = 0; i < irq.handlers.size(); ++i) {
+            g_core = irq.handlers[i].core;
+            irq.handlers[i].handler();
+        }
+    } while (irq.pending);
+    irq.running = false;
+    g_core = interrupted;
+}
+
+void set_core(unsigned int core) { g_core = core; }
+
+void set_board_id(uint64_t id) { g_board_id = id; }
+
+void seed_rand(uint64_t seed) { g_rand.seed(seed); }
+
+// ============================================================================
+// GPIO
+// ============================================================================
+void set_gpio_input(unsigned int gpio, bool level) {
+    if (gpio >= MAX_GPIO) return;
+    GpioState& pin = g_gpio[gpio];
+    const bool was = pin.input;
+    pin.input = level;
+    pin.input_driven = true;
+
+    uint32_t events = 0;
+    if (was && !level) events |= GPIO_IRQ_EDGE_FALL;
+    if (!was && level) events |= GPIO_IRQ_EDGE_RISE;
+    events &= pin.irq_enabled;
+    if (events) {
+        pin.irq_pending |= events;
+        if (pin.irq_handler) pin.irq_handler();
+    }
+}
+
+bool get_gpio_output(unsigned int gpio) {
+    return gpio < MAX_GPIO && g_gpio[gpio].output;
+}
+
+// ============================================================================
+// BUS
+// ============================================================================
+void Bus::attach(DeviceModel& model) {
+    detach(model);
+    for (auto& slot : models_) {
+        if (!slot) {
+            slot = &model;
+            return;
+        }
+    }
+}
+
+void Bus::detach(DeviceModel& model) {
+    for (auto& slot : models_) {
+        if (slot == &model) {
+            slot = nullptr;
+        }
+    }
+}
+
+void Bus::clear() {
+    models_.fill(nullptr);
+    stats = BusStats{};
+    baudrate_ = 100'000;
+}
+
+DeviceModel* Bus::find(uint8_t addr) {
+    for (auto* model : models_) {
+        if (model && model->address() == addr) {
+            return model;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t Bus::wire_time_us(size_t bytes, bool nostop) const {
+    // START + (address + data) * 9 bits (+ STOP unless a repeated start follows)
+    const uint64_t bits = 1 + (bytes + 1) * 9 + (nostop ? 0 : 1);
+    return (bits * 1'000'000 + baudrate_ - 1) / baudrate_;
+}
+
+bool Bus::begin_transaction(DeviceModel* model, size_t len, bool nostop) {
+    stats.transactions++;
+
+    uint64_t wire_us = wire_time_us(model ? len : 0, nostop);
+
+    if (!model) {
+        stats.address_nacks++;
+        stats.busy_us += wire_us;
+        consume(wire_us);
+        return false;
+    }
+
+    model->stats.transactions++;
+
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    const FaultConfig& faults = model->faults;
+
+    if (model->take_forced_nack() ||
+        (faults.nack_probability > 0.0 && chance(rng_) < faults.nack_probability)) {
+        model->stats.nacks++;
+        stats.injected_nacks++;
+        wire_us = wire_time_us(0, false);
+        stats.busy_us += wire_us;
+        consume(wire_us);
+        return false;
+    }
+
+    if (faults.stretch_us > 0 &&
+        (faults.stretch_probability >= 1.0 || chance(rng_) < faults.stretch_probability)) {
+        wire_us += faults.stretch_us;
+        model->stats.stretch_us += faults.stretch_us;
+    }
+
+    model->stats.bytes += static_cast<uint32_t>(len);
+    stats.busy_us += wire_us;
+    consume(wire_us);
+
+    const uint64_t t0 = host_ns();
+    model->tick(now_us());
+    stats.model_ns += host_ns() - t0;
+    return true;
+}
+
+int Bus::write(uint8_t addr, const uint8_t* src, size_t len, bool nostop) {
+    DeviceModel* model = find(addr);
+    if (!begin_transaction(model, len, nostop)) {
+        return PICO_ERROR_GENERIC;
+    }
+
+    const uint64_t t0 = host_ns();
+    bool ok = model->on_write(src, len);
+    stats.model_ns += host_ns() - t0;
+
+    return ok ? static_cast<int>(len) : PICO_ERROR_GENERIC;
+}
+
+int Bus::read(uint8_t addr, uint8_t* dst, size_t len, bool nostop) {
+    DeviceModel* model = find(addr);
+    if (!begin_transaction(model, len, nostop)) {
+        return PICO_ERROR_GENERIC;
+    }
+
+    const uint64_t t0 = host_ns();
+    bool ok = model->on_read(dst, len);
+    stats.model_ns += host_ns() - t0;
+
+    return ok ? static_cast<int>(len) : PICO_ERROR_GENERIC;
+}
+
+Bus& bus(i2c_inst_t* instance) {
+    return g_buses[instance == i2c1 ? 1 : 0];
+}
+
+} // namespace sim
+
+// ============================================================================
+// PICO SDK SHIMS
+// ============================================================================
+uint64_t time_us_64() { return sim::now_us(); }
+uint32_t time_us_32() { return static_cast<uint32_t>(sim::now_us()); }
+
+void sleep_us(uint64_t us) { sim::run_for(us); }
+void sleep_ms(uint32_t ms) { sim::run_for(static_cast<uint64_t>(ms) * 1000); }
+void busy_wait_us(uint64_t us) { sim::consume(us); }
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* out) {
+    if (!callback || !out || delay_us == 0) {
+        return false;
+    }
+
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->next_fire_us = sim::now_us() + static_cast<uint64_t>(delay_us < 0 ? -delay_us : delay_us);
+    out->alarm_id = 1;
+
+    sim::g_timers.push_back(out);
+    return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* out) {
+    return add_repeating_timer_us(static_cast<int64_t>(delay_ms) * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t* timer) {
+    auto& timers = sim::g_timers;
+    auto it = std::find(timers.begin(), timers.end(), timer);
+    if (it == timers.end()) {
+        return false;
+    }
+    timers.erase(it);
+    timer->alarm_id = 0;
+    return true;
+}
+
+unsigned int i2c_init(i2c_inst_t* i2c, unsigned int baudrate) {
+    sim::bus(i2c).set_baudrate(baudrate);
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t* /*i2c*/) {}
+
+int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop) {
+    return sim::bus(i2c).write(addr, src, len, nostop);
+}
+
+int i2c_read_blocking(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop) {
+    return sim::bus(i2c).read(addr, dst, len, nostop);
+}
+
+void gpio_init(unsigned int gpio) {
+    if (gpio < sim::MAX_GPIO) sim::g_gpio[gpio].is_output = false;
+}
+
+void gpio_set_function(unsigned int /*gpio*/, gpio_function /*fn*/) {}
+
+void gpio_set_dir(unsigned int gpio, bool out) {
+    if (gpio < sim::MAX_GPIO) sim::g_gpio[gpio].is_output = out;
+}
+
+void gpio_pull_up(unsigned int gpio) {
+    if (gpio < sim::MAX_GPIO && !sim::g_gpio[gpio].input_driven) sim::g_gpio[gpio].input = true;
+}
+
+void gpio_pull_down(unsigned int gpio) {
+    if (gpio < sim::MAX_GPIO && !sim::g_gpio[gpio].input_driven) sim::g_gpio[gpio].input = false;
+}
+
+void gpio_put(unsigned int gpio, bool value) {
+    if (gpio < sim::MAX_GPIO) sim::g_gpio[gpio].output = value;
+}
+
+bool gpio_get(unsigned int gpio) {
+    if (gpio >= sim::MAX_GPIO) return false;
+    const auto& pin = sim::g_gpio[gpio];
+    return pin.is_output ? pin.output : pin.input;
+}
+
+void gpio_add_raw_irq_handler(unsigned int gpio, void (*handler)(void)) {
+    if (gpio < sim::MAX_GPIO) sim::g_gpio[gpio].irq_handler = handler;
+}
+
+void gpio_set_irq_enabled(unsigned int gpio, uint32_t event_mask, bool enabled) {
+    if (gpio >= sim::MAX_GPIO) return;
+    auto& pin = sim::g_gpio[gpio];
+    pin.irq_enabled = enabled ? (pin.irq_enabled | event_mask) : (pin.irq_enabled & ~event_mask);
+}
+
+uint32_t gpio_get_irq_event_mask(unsigned int gpio) {
+    return gpio < sim::MAX_GPIO ? sim::g_gpio[gpio].irq_pending : 0;
+}
+
+void gpio_acknowledge_irq(unsigned int gpio, uint32_t events) {
+    if (gpio < sim::MAX_GPIO) sim::g_gpio[gpio].irq_pending &= ~events;
+}
+
+void irq_set_enabled(unsigned int num, bool enabled) {
+    if (num < sim::MAX_IRQ) sim::g_irqs[num].enabled = enabled;
+}
+
+bool irq_is_enabled(unsigned int num) {
+    return num < sim::MAX_IRQ && sim::g_irqs[num].enabled;
+}
+
+void irq_set_exclusive_handler(unsigned int num, irq_handler_t handler) {
+    if (num < sim::MAX_IRQ) {
+        sim::g_irqs[num].handlers.assign(1, sim::IrqHandler{handler, sim::g_core, 0});
+    }
+}
+
+// Higher order priority runs first, as in the SDK's shared handler chain
+void irq_add_shared_handler(unsigned int num, irq_handler_t handler, uint8_t order_priority) {
+    if (num >= sim::MAX_IRQ) return;
+    auto& handlers = sim::g_irqs[num].handlers;
+    auto it = std::find_if(handlers.begin(), handlers.end(),
+                           [&](const sim::IrqHandler& h) { return h.order_priority < order_priority; });
+    handlers.insert(it, sim::IrqHandler{handler, sim::g_core, order_priority});
+}
+
+void irq_remove_handler(unsigned int num, irq_handler_t handler) {
+    if (num >= sim::MAX_IRQ) return;
+    auto& handlers = sim::g_irqs[num].handlers;
+    handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+                                  [&](const sim::IrqHandler& h) { return h.handler == handler; }),
+                   handlers.end());
+}
+
+unsigned int get_core_num() { return sim::g_core; }
+
+void pico_get_unique_board_id(pico_unique_board_id_t* id) {
+    for (int i = 0; i < PICO_UNIQUE_BOARD_ID_SIZE_BYTES; ++i) {
+        id->id[i] = static_cast<uint8_t>(sim::g_board_id >> (8 * i));
+    }
+}
+
+uint32_t get_rand_32() { return static_cast<uint32_t>(sim::g_rand()); }
+uint64_t get_rand_64() { return sim::g_rand(); }
@@ -0,0 +1,211 @@
+#pragma once
+
+/**
+ * @file i2c_sim.h
+ * @brief Host-side I2C bus simulator for running the i2c::drivers off-target
+ *
+ * The simulator replaces the Pico SDK's blocking I2C, GPIO and timer calls
+ * (see sim/include/) with a virtual bus and a virtual microsecond clock:
+ * - Every transfer is routed to the DeviceModel registered at its address,
+ *   and advances virtual time by its wire time at the configured baud rate.
+ * - Repeating timers fire as virtual time advances, so I2CDevice polling runs
+ *   unmodified.
+ * - Per-device fault injection (NACK, clock stretching) is deterministic for
+ *   a given seed.
+ *
+ * Example Usage:
+ *
+ *   sim::ICM20948Model imu;
+ *   imu.accel[2] = sim::Waveform::constant(9.81);
+ *   sim::bus(i2c0).attach(imu);
+ *
+ *   i2c::drivers::ICM20948 driver;
+ *   driver.init(i2c0);
+ *   sim::run_for(1'000'000);   // 1 s of virtual time, timers fire
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "hardware/i2c.h"
+#include "pico/time.h"
+
+namespace sim {
+
+// ============================================================================
+// VIRTUAL TIME
+// ============================================================================
+uint64_t now_us();
+
+// Advance virtual time, firing every repeating timer that falls due.
+void run_for(uint64_t duration_us);
+
+// Advance virtual time without firing timers (time spent blocked on the bus).
+void consume(uint64_t duration_us);
+
+// Clear the clock, timers, GPIO state, IRQ handlers, the board ID, the
+// random seed and every bus attachment.
+void reset();
+
+// Host nanoseconds spent inside timer callbacks since the last reset.
+uint64_t timer_callback_ns();
+
+// ============================================================================
+// GPIO
+// ============================================================================
+void set_gpio_input(unsigned int gpio, bool level);
+bool get_gpio_output(unsigned int gpio);
+
+// ============================================================================
+// INTERRUPTS AND CORES
+// ============================================================================
+// Run the handlers registered for `num` if it is enabled. Each handler runs
+// with get_core_num() reporting the core that registered it.
+void raise_irq(unsigned int num);
+
+// Core that get_core_num() reports to the code under test (0 after reset).
+void set_core(unsigned int core);
+
+// Board ID returned by pico_get_unique_board_id(), byte 0 in the low bits.
+void set_board_id(uint64_t id);
+
+// Restart get_rand_32()/get_rand_64() from `seed`.
+void seed_rand(uint64_t seed);
+
+// ============================================================================
+// DEVICE MODELS
+// ============================================================================
+struct FaultConfig {
+    double nack_probability = 0.0;      // Per transaction, address phase
+    double stretch_probability = 0.0;   // Per transaction
+    uint32_t stretch_us = 0;            // Added wire time when stretching
+};
+
+struct DeviceStats {
+    uint32_t transactions = 0;
+    uint32_t nacks = 0;
+    uint32_t bytes = 0;
+    uint64_t stretch_us = 0;
+};
+
+class DeviceModel {
+public:
+    explicit DeviceModel(uint8_t address) : address_(address) {}
+    virtual ~DeviceModel() = default;
+
+    DeviceModel(const DeviceModel&) = delete;
+    DeviceModel& operator=(const DeviceModel&) = delete;
+
+    virtual const char* name() const = 0;
+
+    // Write transaction payload (register pointer first for register devices).
+    // Return false to NACK.
+    virtual bool on_write(const uint8_t* data, size_t len) = 0;
+
+    // Read transaction. Return false to NACK.
+    virtual bool on_read(uint8_t* data, size_t len) = 0;
+
+    // Called at the start of every transaction addressed to this device.
+    virtual void tick(uint64_t /*now_us*/) {}
+
+    uint8_t address() const { return address_; }
+
+    // Force the next `count` transactions to be NACKed.
+    void nack_next(uint32_t count) { forced_nacks_ = count; }
+    bool take_forced_nack() {
+        if (forced_nacks_ == 0) return false;
+        forced_nacks_--;
+        return true;
+    }
+
+    FaultConfig faults{};
+    DeviceStats stats{};
+
+private:
+    uint8_t address_;
+    uint32_t forced_nacks_ = 0;
+};
+
+/**
+ * @brief Base for devices with an auto-incrementing register pointer
+ *
+ * The first byte of a write sets the pointer, the rest are register writes.
+ * Reads start at the pointer and auto-increment.
+ */
+class RegisterModel : public DeviceModel {
+public:
+    using DeviceModel::DeviceModel;
+
+    bool on_write(const uint8_t* data, size_t len) override {
+        if (len == 0) {
+            return true;
+        }
+        pointer_ = data[0];
+        for (size_t i = 1; i < len; ++i) {
+            write_register(pointer_++, data[i]);
+        }
+        return true;
+    }
+
+    bool on_read(uint8_t* data, size_t len) override {
+        begin_read(pointer_);
+        for (size_t i = 0; i < len; ++i) {
+            data[i] = read_register(pointer_++);
+        }
+        return true;
+    }
+
+protected:
+    virtual void write_register(uint8_t reg, uint8_t value) { regs_[reg] = value; }
+    virtual uint8_t read_register(uint8_t reg) { return regs_[reg]; }
+
+    // Latch shadow registers before a burst read starting at `reg`.
+    virtual void begin_read(uint8_t /*reg*/) {}
+
+    std::array<uint8_t, 256> regs_{};
+    uint8_t pointer_ = 0;
+};
+
+// ============================================================================
+// BUS
+// ============================================================================
+struct BusStats {
+    uint32_t transactions = 0;
+    uint32_t address_nacks = 0;     // No device at address
+    uint32_t injected_nacks = 0;    // Fault injection
+    uint64_t busy_us = 0;           // Virtual time the bus was occupied
+    uint64_t model_ns = 0;          // Host time spent inside models
+};
+
+class Bus {
+public:
+    static constexpr size_t MAX_MODELS = 16;
+
+    void attach(DeviceModel& model);
+    void detach(DeviceModel& model);
+    void clear();
+
+    void set_baudrate(uint32_t baudrate) { baudrate_ = baudrate; }
+    uint32_t baudrate() const { return baudrate_; }
+    void seed(uint32_t value) { rng_.seed(value); }
+
+    int write(uint8_t addr, const uint8_t* src, size_t len, bool nostop);
+    int read(uint8_t addr, uint8_t* dst, size_t len, bool nostop);
+
+    BusStats stats{};
+
+private:
+    DeviceModel* find(uint8_t addr);
+    bool begin_transaction(DeviceModel* model, size_t len, bool nostop);
+    uint64_t wire_time_us(size_t bytes, bool nostop) const;
+
+    std::array<DeviceModel*, MAX_MODELS> models_{};
+    uint32_t baudrate_ = 100'000;
+    std::mt19937 rng_{0x464C54u};
+};
+
+Bus& bus(i2c_inst_t* instance);
+
+} // namespace sim
@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file adc.h
+ * @brief Host shim for hardware/adc.h backed by the ADC model
+ *
+ * The FIFO register is only ever read by the DMA model (see dma.h); results
+ * arrive as sim::adc::run() advances virtual time (see adc_sim.h).
+ */
+
+#include <cstdint>
+
+#include "pico/types.h"
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+    volatile uint32_t intr;
+    volatile uint32_t inte;
+    volatile uint32_t intf;
+    volatile uint32_t ints;
+} adc_hw_t;
+
+extern adc_hw_t* const adc_hw;
+
+void adc_init();
+void adc_gpio_init(unsigned int gpio);
+void adc_select_input(unsigned int input);
+unsigned int adc_get_selected_input();
+void adc_set_round_robin(unsigned int input_mask);
+void adc_set_temp_sensor_enabled(bool enable);
+void adc_set_clkdiv(float clkdiv);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_fifo_drain();
+void adc_run(bool run);
@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ * @file clocks.h
+ * @brief Host shim for hardware/clocks.h (fixed 150 MHz clk_sys)
+ */
+
+#include <cstdint>
+
+enum clock_index {
+    clk_ref = 4,
+    clk_sys = 5,
+    clk_peri = 6,
+};
+
+inline uint32_t clock_get_hz(clock_index /*clock*/) { return 150'000'000; }
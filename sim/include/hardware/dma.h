@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file dma.h
+ * @brief Host shim for hardware/dma.h backed by the UART simulator
+ *
+ * Channels are modelled functionally (see uart_sim.h): memory-to-memory
+ * transfers complete inside the call that starts them, channels paced by a
+ * UART DREQ move bytes as the simulated line delivers or accepts them, and
+ * channels reading the ADC FIFO take results as the ADC model converts them.
+ * Address wrap, chaining, the alias-1 count trigger, completion IRQs and the
+ * CRC16 sniffer behave as on the RP2350.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hardware/irq.h"
+
+#define NUM_DMA_CHANNELS 16u
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2,
+};
+
+#define DREQ_UART0_TX 28u
+#define DREQ_UART0_RX 29u
+#define DREQ_UART1_TX 30u
+#define DREQ_UART1_RX 31u
+#define DREQ_ADC 48u
+#define DREQ_FORCE 63u
+
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC16 0x2u
+
+typedef struct {
+    unsigned int transfer_size;
+    unsigned int dreq;
+    unsigned int chain_to;
+    unsigned int ring_bits;
+    bool read_increment;
+    bool write_increment;
+    bool ring_write;
+    bool sniff;
+    bool high_priority;
+    bool enable;
+} dma_channel_config;
+
+// Addresses are host pointers, hence uintptr_t rather than the 32-bit registers
+typedef struct {
+    volatile uintptr_t read_addr;
+    volatile uintptr_t write_addr;
+    volatile uint32_t transfer_count;
+    volatile uint32_t al1_transfer_count_trig;     // A DMA write here reloads and starts the channel
+} dma_channel_hw_t;
+
+typedef struct {
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+extern dma_hw_t* const dma_hw;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(unsigned int channel);
+
+dma_channel_config dma_channel_get_default_config(unsigned int channel);
+
+inline void channel_config_set_transfer_data_size(dma_channel_config* c, dma_channel_transfer_size size) { c->transfer_size = size; }
+inline void channel_config_set_read_increment(dma_channel_config* c, bool incr) { c->read_increment = incr; }
+inline void channel_config_set_write_increment(dma_channel_config* c, bool incr) { c->write_increment = incr; }
+inline void channel_config_set_dreq(dma_channel_config* c, unsigned int dreq) { c->dreq = dreq; }
+inline void channel_config_set_chain_to(dma_channel_config* c, unsigned int chain_to) { c->chain_to = chain_to; }
+inline void channel_config_set_sniff_enable(dma_channel_config* c, bool sniff) { c->sniff = sniff; }
+inline void channel_config_set_high_priority(dma_channel_config* c, bool high) { c->high_priority = high; }
+inline void channel_config_set_enable(dma_channel_config* c, bool enable) { c->enable = enable; }
+inline void channel_config_set_ring(dma_channel_config* c, bool write, unsigned int size_bits) {
+    c->ring_write = write;
+    c->ring_bits = size_bits;
+}
+
+void dma_channel_configure(unsigned int channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, unsigned int transfer_count, bool trigger);
+void dma_channel_start(unsigned int channel);
+void dma_channel_abort(unsigned int channel);
+bool dma_channel_is_busy(unsigned int channel);
+void dma_channel_wait_for_finish_blocking(unsigned int channel);
+void dma_channel_transfer_from_buffer_now(unsigned int channel, const volatile void* read_addr, uint32_t transfer_count);
+dma_channel_hw_t* dma_channel_hw_addr(unsigned int channel);
+
+// Completion IRQs: DMA_IRQ_0 + irq_index
+void dma_irqn_set_channel_enabled(unsigned int irq_index, unsigned int channel, bool enabled);
+bool dma_irqn_get_channel_status(unsigned int irq_index, unsigned int channel);
+void dma_irqn_acknowledge_channel(unsigned int irq_index, unsigned int channel);
+inline unsigned int dma_get_irq_num(unsigned int irq_index) { return DMA_IRQ_0 + irq_index; }
+
+inline void dma_channel_set_irq1_enabled(unsigned int channel, bool enabled) { dma_irqn_set_channel_enabled(1, channel, enabled); }
+inline bool dma_channel_get_irq1_status(unsigned int channel) { return dma_irqn_get_channel_status(1, channel); }
+inline void dma_channel_acknowledge_irq1(unsigned int channel) { dma_irqn_acknowledge_channel(1, channel); }
+
+// Sniffer: CRC16-CCITT over the bytes the sniffed channel reads
+void dma_sniffer_enable(unsigned int channel, unsigned int mode, bool force_channel_enable);
+void dma_sniffer_disable();
+void dma_sniffer_set_data_accumulator(uint32_t seed);
+uint32_t dma_sniffer_get_data_accumulator();
@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * @file gpio.h
+ * @brief Host shim for hardware/gpio.h
+ *
+ * Pins are plain state held by the simulator; models may drive inputs with
+ * sim::set_gpio_input() (see i2c_sim.h).
+ */
+
+#include <cstdint>
+
+enum gpio_function {
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+#define GPIO_OUT 1
+#define GPIO_IN  0
+
+void gpio_init(unsigned int gpio);
+void gpio_set_function(unsigned int gpio, gpio_function fn);
+void gpio_set_dir(unsigned int gpio, bool out);
+void gpio_pull_up(unsigned int gpio);
+void gpio_pull_down(unsigned int gpio);
+void gpio_put(unsigned int gpio, bool value);
+bool gpio_get(unsigned int gpio);
+
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 0x1u,
+    GPIO_IRQ_LEVEL_HIGH = 0x2u,
+    GPIO_IRQ_EDGE_FALL = 0x4u,
+    GPIO_IRQ_EDGE_RISE = 0x8u,
+};
+
+// Raw handlers run synchronously from sim::set_gpio_input() on an enabled edge.
+void gpio_add_raw_irq_handler(unsigned int gpio, void (*handler)(void));
+void gpio_set_irq_enabled(unsigned int gpio, uint32_t event_mask, bool enabled);
+uint32_t gpio_get_irq_event_mask(unsigned int gpio);
+void gpio_acknowledge_irq(unsigned int gpio, uint32_t events);
@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * @file i2c.h
+ * @brief Host shim for hardware/i2c.h routed to the simulated bus
+ *
+ * Every blocking transfer is forwarded to the sim::Bus attached to the
+ * instance, which advances virtual time by the wire time of the transfer.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+struct i2c_inst {
+    int index;
+};
+typedef struct i2c_inst i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+unsigned int i2c_init(i2c_inst_t* i2c, unsigned int baudrate);
+void i2c_deinit(i2c_inst_t* i2c);
+int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop);
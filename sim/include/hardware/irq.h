@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file irq.h
+ * @brief Host shim for hardware/irq.h
+ *
+ * Handlers are kept per IRQ number and run synchronously when a peripheral
+ * model raises the IRQ with sim::raise_irq() (see i2c_sim.h), on the core
+ * that registered them. There is no preemption: an IRQ raised while its
+ * handler is running is delivered when the handler returns.
+ */
+
+#include <cstdint>
+
+typedef void (*irq_handler_t)(void);
+
+enum irq_num_host {
+    DMA_IRQ_0 = 10,
+    DMA_IRQ_1 = 11,
+    DMA_IRQ_2 = 12,
+    DMA_IRQ_3 = 13,
+    IO_IRQ_BANK0 = 21,
+    SIO_IRQ_FIFO = 25,
+    SIO_IRQ_BELL = 26,
+    UART0_IRQ = 33,
+    UART1_IRQ = 34,
+};
+
+#define PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY 0xff
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+#define PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY 0x00
+
+void irq_set_enabled(unsigned int num, bool enabled);
+bool irq_is_enabled(unsigned int num);
+void irq_set_exclusive_handler(unsigned int num, irq_handler_t handler);
+void irq_add_shared_handler(unsigned int num, irq_handler_t handler, uint8_t order_priority);
+void irq_remove_handler(unsigned int num, irq_handler_t handler);
+inline void irq_set_priority(unsigned int /*num*/, uint8_t /*priority*/) {}
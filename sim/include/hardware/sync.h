@@ -0,0 +1,20 @@
+#pragma once
+
+/**
+ * @file sync.h
+ * @brief Host shim for hardware/sync.h
+ *
+ * The simulator runs both cores' code on one host thread, so there is
+ * nothing to lock. get_core_num() reports the core selected with
+ * sim::set_core() (see i2c_sim.h).
+ */
+
+#include <cstdint>
+
+inline uint32_t save_and_disable_interrupts() { return 0; }
+inline void restore_interrupts(uint32_t) {}
+inline void __dmb() {}
+inline void __sev() {}
+inline void __wfe() {}
+
+unsigned int get_core_num();
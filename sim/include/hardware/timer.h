@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * @file timer.h
+ * @brief Host shim for hardware/timer.h (all timing lives in pico/time.h)
+ */
+
+#include "pico/time.h"
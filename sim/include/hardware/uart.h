@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * @file uart.h
+ * @brief Host shim for hardware/uart.h routed to the UART simulator
+ *
+ * The data register is only ever accessed by the DMA model (see dma.h and
+ * uart_sim.h); the blocking calls cover what initialisation code needs.
+ */
+
+#include <cstdint>
+
+#include "pico/types.h"
+
+typedef struct {
+    volatile uint32_t dr;
+    volatile uint32_t rsr;
+    volatile uint32_t _pad[4];
+    volatile uint32_t fr;
+} uart_hw_t;
+
+#define UART_UARTFR_BUSY_BITS 0x00000008u
+
+struct uart_inst {
+    uart_hw_t hw;
+    int index;
+};
+typedef struct uart_inst uart_inst_t;
+
+extern uart_inst_t uart0_inst;
+extern uart_inst_t uart1_inst;
+
+#define uart0 (&uart0_inst)
+#define uart1 (&uart1_inst)
+
+typedef enum {
+    UART_PARITY_NONE,
+    UART_PARITY_EVEN,
+    UART_PARITY_ODD,
+} uart_parity_t;
+
+inline uart_hw_t* uart_get_hw(uart_inst_t* uart) { return &uart->hw; }
+inline unsigned int uart_get_index(uart_inst_t* uart) { return static_cast<unsigned int>(uart->index); }
+
+// DREQ_UARTn_TX/RX from dma.h
+inline unsigned int uart_get_dreq(uart_inst_t* uart, bool is_tx) {
+    return 28u + 2u * uart_get_index(uart) + (is_tx ? 0u : 1u);
+}
+
+unsigned int uart_init(uart_inst_t* uart, unsigned int baudrate);
+void uart_deinit(uart_inst_t* uart);
+unsigned int uart_set_baudrate(uart_inst_t* uart, unsigned int baudrate);
+void uart_set_hw_flow(uart_inst_t* uart, bool cts, bool rts);
+void uart_set_format(uart_inst_t* uart, unsigned int data_bits, unsigned int stop_bits, uart_parity_t parity);
+void uart_set_fifo_enabled(uart_inst_t* uart, bool enabled);
+bool uart_is_readable(uart_inst_t* uart);
+char uart_getc(uart_inst_t* uart);
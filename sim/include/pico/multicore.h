@@ -0,0 +1,22 @@
+#pragma once
+
+/**
+ * @file multicore.h
+ * @brief Host shim for the pico/multicore.h doorbells
+ *
+ * Ringing the other core's doorbell raises SIO_IRQ_BELL there the next
+ * time the UART simulator runs (see uart_sim.h), since the host thread is
+ * still executing the ringing core's code.
+ */
+
+#include <cstdint>
+
+#include "hardware/irq.h"
+
+#define NUM_DOORBELLS 8u
+
+int multicore_doorbell_claim_unused(unsigned int core_mask, bool required);
+void multicore_doorbell_unclaim(unsigned int doorbell_num, unsigned int core_mask);
+void multicore_doorbell_set_other_core(unsigned int doorbell_num);
+void multicore_doorbell_clear_current_core(unsigned int doorbell_num);
+bool multicore_doorbell_is_set_current_core(unsigned int doorbell_num);
@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ * @file printf.h
+ * @brief Host shim for pico/printf.h (printf goes to the host's stdout)
+ */
+
+#include <cstdio>
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @file rand.h
+ * @brief Host shim for pico/rand.h
+ *
+ * Deterministic per sim::seed_rand() (see i2c_sim.h), so a run can be
+ * repeated exactly; reseed to model a reboot that draws new values.
+ */
+
+#include <cstdint>
+
+uint32_t get_rand_32();
+uint64_t get_rand_64();
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @file stdlib.h
+ * @brief Host shim for pico/stdlib.h used by the FLIGHT simulator build
+ *
+ * Only the subset of the Pico SDK that the drivers actually touch is provided.
+ * Time is virtual and owned by sim::Clock (see i2c_sim.h).
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/uart.h"
+#include "hardware/sync.h"
+
+#ifndef PICO_ERROR_NONE
+#define PICO_ERROR_NONE      0
+#define PICO_ERROR_TIMEOUT  -1
+#define PICO_ERROR_GENERIC  -2
+#endif
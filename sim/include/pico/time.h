@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @file time.h
+ * @brief Host shim for pico/time.h backed by the simulator's virtual clock
+ */
+
+#include <cstdint>
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t* rt);
+
+struct repeating_timer {
+    int64_t delay_us;
+    uint64_t next_fire_us;
+    repeating_timer_callback_t callback;
+    void* user_data;
+    int32_t alarm_id;
+};
+
+uint64_t time_us_64();
+uint32_t time_us_32();
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void busy_wait_us(uint64_t us);
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* out);
+bool cancel_repeating_timer(repeating_timer_t* timer);
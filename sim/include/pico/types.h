@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * @file types.h
+ * @brief Host shim for pico/types.h
+ */
+
+#include <cstdint>
+
+typedef unsigned int uint;
@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * @file unique_id.h
+ * @brief Host shim for pico/unique_id.h
+ *
+ * The ID is fixed unless a bench picks another with sim::set_board_id()
+ * (see i2c_sim.h), e.g. to give two simulated FTL peers distinct source IDs.
+ */
+
+#include <cstdint>
+
+#define PICO_UNIQUE_BOARD_ID_SIZE_BYTES 8
+
+typedef struct {
+    uint8_t id[PICO_UNIQUE_BOARD_ID_SIZE_BYTES];
+} pico_unique_board_id_t;
+
+void pico_get_unique_board_id(pico_unique_board_id_t* id);
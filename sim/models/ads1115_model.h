@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @file ads1115_model.h
+ * @brief Register-level model of the ADS1115 16-bit delta-sigma ADC
+ *
+ * One waveform (volts) per MUX setting. Continuous mode refreshes the
+ * conversion register at the configured data rate; single-shot mode
+ * converts once per OS write.
+ */
+
+#include "i2c_sim.h"
+#include "waveform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+
+class ADS1115Model : public DeviceModel {
+public:
+    static constexpr uint8_t DEFAULT_ADDRESS = 0x48;
+
+    static constexpr uint8_t REG_CONVERSION = 0x00;
+    static constexpr uint8_t REG_CONFIG = 0x01;
+
+    // Indexed by CONFIG[14:12]: AIN0-1, AIN0-3, AIN1-3, AIN2-3, AIN0..AIN3
+    std::array<Waveform, 8> inputs{};
+
+    explicit ADS1115Model(uint8_t address = DEFAULT_ADDRESS) : DeviceModel(address) {}
+
+    const char* name() const override { return "ADS1115"; }
+
+    bool on_write(const uint8_t* data, size_t len) override {
+        if (len == 0) return true;
+        pointer_ = data[0] & 0x03;
+        if (len >= 3 && pointer_ == REG_CONFIG) {
+            config_ = static_cast<uint16_t>((data[1] << 8) | data[2]);
+            const bool single_shot = config_ & 0x0100;
+            if (single_shot && (config_ & 0x8000)) {
+                pending_until_us_ = now_us_ + period_us();
+            }
+            config_ &= 0x7FFF;
+            last_sample_us_ = UINT64_MAX;
+        }
+        return true;
+    }
+
+    bool on_read(uint8_t* data, size_t len) override {
+        uint16_t value = (pointer_ == REG_CONFIG)
+            ? static_cast<uint16_t>(config_ | (pending_until_us_ <= now_us_ ? 0x8000 : 0))
+            : static_cast<uint16_t>(conversion_);
+        if (len > 0) data[0] = static_cast<uint8_t>(value >> 8);
+        if (len > 1) data[1] = static_cast<uint8_t>(value & 0xFF);
+        return true;
+    }
+
+    void tick(uint64_t now_us) override {
+        now_us_ = now_us;
+        const bool single_shot = config_ & 0x0100;
+        if (single_shot) {
+            if (pending_until_us_ != UINT64_MAX && now_us >= pending_until_us_) {
+                convert(pending_until_us_ * 1e-6);
+                pending_until_us_ = 0;
+            }
+            return;
+        }
+        const uint64_t period = period_us();
+        const uint64_t sample_us = (now_us / period) * period;
+        if (sample_us != last_sample_us_) {
+            last_sample_us_ = sample_us;
+            convert(sample_us * 1e-6);
+        }
+    }
+
+private:
+    static constexpr double FULL_SCALE_V[8] = {6.144, 4.096, 2.048, 1.024, 0.512, 0.256, 0.256, 0.256};
+    static constexpr double RATE_SPS[8] = {8, 16, 32, 64, 128, 250, 475, 860};
+
+    uint64_t period_us() const {
+        return static_cast<uint64_t>(1e6 / RATE_SPS[(config_ >> 5) & 0x07]);
+    }
+
+    void convert(double t) {
+        const double fs = FULL_SCALE_V[(config_ >> 9) & 0x07];
+        const double volts = inputs[(config_ >> 12) & 0x07](t);
+        conversion_ = static_cast<int16_t>(std::clamp(std::lround(volts / fs * 32768.0), -32768L, 32767L));
+    }
+
+    uint8_t pointer_ = 0;
+    uint16_t config_ = 0x0583;   // Power-on default with OS bit masked
+    int16_t conversion_ = 0;
+    uint64_t now_us_ = 0;
+    uint64_t last_sample_us_ = UINT64_MAX;
+    uint64_t pending_until_us_ = 0;
+};
+
+} // namespace sim
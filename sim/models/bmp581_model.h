@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file bmp581_model.h
+ * @brief Register-level model of the BMP581 barometer
+ *
+ * Inputs: pressure in Pa, temperature in degC. Data registers refresh at the
+ * ODR selected in ODR_CONFIG while in normal mode.
+ */
+
+#include "i2c_sim.h"
+#include "waveform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+
+class BMP581Model : public RegisterModel {
+public:
+    static constexpr uint8_t DEFAULT_ADDRESS = 0x47;
+    static constexpr uint8_t CHIP_ID_VALUE = 0x50;
+
+    static constexpr uint8_t REG_CHIP_ID = 0x01;
+    static constexpr uint8_t REG_TEMP_DATA = 0x1D;
+    static constexpr uint8_t REG_PRESS_DATA = 0x20;
+    static constexpr uint8_t REG_OSR_CONFIG = 0x36;
+    static constexpr uint8_t REG_ODR_CONFIG = 0x37;
+    static constexpr uint8_t REG_CMD = 0x7E;
+
+    Waveform pressure = Waveform::constant(101325.0);
+    Waveform temperature = Waveform::constant(20.0);
+
+    explicit BMP581Model(uint8_t address = DEFAULT_ADDRESS) : RegisterModel(address) {
+        reset_registers();
+    }
+
+    const char* name() const override { return "BMP581"; }
+
+    void tick(uint64_t now_us) override {
+        const uint8_t mode = regs_[REG_ODR_CONFIG] & 0x03;
+        if (mode != 0x01 && mode != 0x03) {
+            return;  // Standby / forced: data registers hold
+        }
+        // Continuous mode runs flat out; model it as the fastest ODR.
+        const double odr = (mode == 0x03) ? ODR_TABLE_HZ[0] : ODR_TABLE_HZ[(regs_[REG_ODR_CONFIG] >> 2) & 0x1F];
+        const uint64_t period_us = static_cast<uint64_t>(1e6 / odr);
+        const uint64_t sample_us = (now_us / period_us) * period_us;
+        if (sample_us != last_sample_us_) {
+            last_sample_us_ = sample_us;
+            convert(sample_us * 1e-6);
+        }
+    }
+
+protected:
+    // ODR_CONFIG[6:2] output data rates from the datasheet, in Hz
+    static constexpr double ODR_TABLE_HZ[32] = {
+        240.0, 218.537, 199.111, 179.2, 160.0, 149.333, 140.0, 129.855,
+        120.0, 110.164, 100.299, 89.6, 80.0, 70.0, 60.0, 50.0,
+        45.0, 40.0, 35.0, 30.0, 25.0, 20.0, 15.0, 10.0,
+        5.0, 4.0, 3.0, 2.0, 1.0, 0.5, 0.25, 0.125
+    };
+
+    void write_register(uint8_t reg, uint8_t value) override {
+        if (reg == REG_CMD) {
+            if (value == 0xB6) reset_registers();
+            return;
+        }
+        if (reg == REG_CHIP_ID || (reg >= REG_TEMP_DATA && reg < REG_PRESS_DATA + 3)) {
+            return;  // Read-only
+        }
+        regs_[reg] = value;
+    }
+
+    void reset_registers() {
+        regs_.fill(0);
+        regs_[REG_CHIP_ID] = CHIP_ID_VALUE;
+        regs_[REG_OSR_CONFIG] = 0x00;
+        regs_[REG_ODR_CONFIG] = 0x70;  // Deep standby, 1 Hz
+        last_sample_us_ = UINT64_MAX;
+    }
+
+    void convert(double t) {
+        auto temp_raw = static_cast<int32_t>(std::lround(temperature(t) * 65536.0));
+        regs_[REG_TEMP_DATA + 0] = static_cast<uint8_t>(temp_raw);
+        regs_[REG_TEMP_DATA + 1] = static_cast<uint8_t>(temp_raw >> 8);
+        regs_[REG_TEMP_DATA + 2] = static_cast<uint8_t>(temp_raw >> 16);
+
+        uint32_t press_raw = 0;
+        if (regs_[REG_OSR_CONFIG] & 0x40) {
+            press_raw = static_cast<uint32_t>(std::clamp(std::lround(pressure(t) * 64.0), 0L, 0xFFFFFFL));
+        }
+        regs_[REG_PRESS_DATA + 0] = static_cast<uint8_t>(press_raw);
+        regs_[REG_PRESS_DATA + 1] = static_cast<uint8_t>(press_raw >> 8);
+        regs_[REG_PRESS_DATA + 2] = static_cast<uint8_t>(press_raw >> 16);
+    }
+
+    uint64_t last_sample_us_ = UINT64_MAX;
+};
+
+} // namespace sim
@@ -0,0 +1,396 @@
+#pragma once
+
+/**
+ * @file bno08x_model.h
+ * @brief Model of the BNO08x sensor hub speaking SHTP over I2C, with INT/RST
+ *
+ * Inputs: orientation as roll/pitch/yaw in rad, linear acceleration in
+ * m/s^2, calibrated gyro in rad/s. The hub answers product ID requests,
+ * takes Set Feature commands for the rotation vector, linear acceleration
+ * and calibrated gyro reports, and sends each due report on the input
+ * channel behind a base timestamp reference, as the real hub does.
+ *
+ * Transfers wait in a queue while INT is held low; every read that consumes
+ * one releases INT and asserts it again (a fresh falling edge) if more are
+ * queued. A read of the 4-byte header alone leaves the transfer in place,
+ * a shorter read than the transfer turns the remainder into a continuation
+ * transfer with its own header. RST low holds the hub in reset (queue and
+ * configuration cleared, bus NACKed); it sends Reset Complete boot_us after
+ * RST goes high.
+ *
+ * Nothing happens between bus transactions unless the model's own timer
+ * runs, so call start() after sim::reset().
+ *
+ * Every report is recorded in history() with its ground truth, sequence
+ * number and what became of it, so a bench can match what the host decoded.
+ */
+
+#include "i2c_sim.h"
+#include "waveform.h"
+
+#include "hardware/gpio.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace sim {
+
+class BNO08xModel : public DeviceModel {
+public:
+    static constexpr uint8_t DEFAULT_ADDRESS = 0x4A;
+
+    static constexpr uint8_t CHANNEL_EXECUTABLE = 1;
+    static constexpr uint8_t CHANNEL_CONTROL = 2;
+    static constexpr uint8_t CHANNEL_INPUT = 3;
+
+    static constexpr uint8_t REPORT_GYROSCOPE = 0x02;
+    static constexpr uint8_t REPORT_LINEAR_ACCELERATION = 0x04;
+    static constexpr uint8_t REPORT_ROTATION_VECTOR = 0x05;
+    static constexpr uint8_t REPORT_PROD_ID_RESPONSE = 0xF8;
+    static constexpr uint8_t REPORT_PROD_ID_REQUEST = 0xF9;
+    static constexpr uint8_t REPORT_BASE_TIMESTAMP = 0xFB;
+    static constexpr uint8_t REPORT_SET_FEATURE = 0xFD;
+    static constexpr uint8_t REPORT_UNKNOWN = 0x70;     // Not an SH2 report ID
+    static constexpr uint8_t EXECUTABLE_RESET_COMPLETE = 0x01;
+    static constexpr uint32_t SOFTWARE_PART_NUMBER = 10003608;
+
+    static constexpr size_t HEADER_LEN = 4;
+    static constexpr uint32_t TICK_US = 250;
+
+    struct Sensor {
+        uint8_t report_id;
+        uint8_t length;                 // Report bytes on the wire
+        int q;                          // Fixed-point bits of the values
+        size_t values;                  // Values in the report
+    };
+
+    static constexpr std::array<Sensor, 3> SENSORS = {{
+        {REPORT_ROTATION_VECTOR, 14, 14, 5},        // i, j, k, real (Q14), accuracy (Q12)
+        {REPORT_LINEAR_ACCELERATION, 10, 8, 3},
+        {REPORT_GYROSCOPE, 10, 9, 3},
+    }};
+
+    // One report sent (or about to be) and what became of it
+    struct Sample {
+        uint8_t report_id;
+        uint8_t sequence;
+        uint64_t t_us;                  // Sample time
+        std::array<double, 5> truth;    // Physical values before quantization
+        size_t transfer_bytes = 0;      // Length of the transfer that carried it
+        bool read = false;              // Its transfer was read to the end
+        bool hidden = false;            // Behind an unknown report ID in its transfer
+    };
+
+    Waveform roll = Waveform::constant(0.0);                // rad
+    Waveform pitch = Waveform::constant(0.0);               // rad
+    Waveform yaw = Waveform::constant(0.0);                 // rad
+    std::array<Waveform, 3> linear_accel{};                 // m/s^2
+    std::array<Waveform, 3> gyro{};                         // rad/s
+    double rotation_accuracy = 0.1;                         // rad
+
+    uint32_t boot_us = 50'000;          // RST high to Reset Complete
+
+    // Faults
+    uint32_t seq_gap_every = 0;         // Skip a sequence number every N input transfers
+    uint32_t unknown_report_every = 0;  // Put an unknown report ID ahead of the reports every N
+    uint64_t reset_at_us = 0;           // The hub resets itself here
+    uint64_t merge_from_us = 0;         // Input reports in [from, to) go out as one transfer
+    uint64_t merge_to_us = 0;
+
+    explicit BNO08xModel(uint8_t address = DEFAULT_ADDRESS, unsigned int int_pin = 14, unsigned int rst_pin = 15)
+        : DeviceModel(address), int_pin_(int_pin), rst_pin_(rst_pin) {}
+
+    const char* name() const override { return "BNO08x"; }
+
+    void start() {
+        set_gpio_input(int_pin_, true);
+        add_repeating_timer_us(-static_cast<int64_t>(TICK_US), &BNO08xModel::timer_callback, this, &timer_);
+    }
+
+    bool on_write(const uint8_t* data, size_t len) override {
+        if (!running()) return false;
+        if (len < HEADER_LEN) return true;
+
+        const uint8_t* cargo = data + HEADER_LEN;
+        const size_t cargo_len = len - HEADER_LEN;
+        if (data[2] != CHANNEL_CONTROL || cargo_len == 0) return true;
+
+        if (cargo[0] == REPORT_PROD_ID_REQUEST) {
+            send_product_ids();
+        } else if (cargo[0] == REPORT_SET_FEATURE && cargo_len >= 17) {
+            uint32_t interval_us;
+            std::memcpy(&interval_us, &cargo[5], sizeof(interval_us));
+            set_feature(cargo[1], interval_us);
+        }
+        return true;
+    }
+
+    bool on_read(uint8_t* data, size_t len) override {
+        if (!running()) return false;
+        std::memset(data, 0, len);
+        if (queue_.empty()) return true;    // Zero-length header: nothing to send
+
+        Transfer& head = queue_.front();
+        const size_t remaining = head.cargo.size() - head.sent;
+        const uint16_t length = static_cast<uint16_t>(remaining + HEADER_LEN);
+        const uint8_t header[HEADER_LEN] = {
+            static_cast<uint8_t>(length & 0xFF),
+            static_cast<uint8_t>((length >> 8) | (head.sent ? 0x80 : 0x00)),
+            head.channel,
+            head.sequence,
+        };
+        std::memcpy(data, header, std::min(len, HEADER_LEN));
+        if (len <= HEADER_LEN) return true;
+
+        const size_t taken = std::min(len - HEADER_LEN, remaining);
+        std::memcpy(data + HEADER_LEN, head.cargo.data() + head.sent, taken);
+        head.sent += taken;
+        if (head.sent < head.cargo.size()) {
+            head.sequence = next_sequence(head.channel);    // The rest follows as a continuation
+        } else {
+            for (size_t i = 0; i < head.samples; ++i) history_[head.first_sample + i].read = true;
+            queue_.pop_front();
+            transfers_read++;
+        }
+        update_int(true);
+        return true;
+    }
+
+    void tick(uint64_t now_us) override { advance(now_us); }
+
+    const std::vector<Sample>& history() const { return history_; }
+
+    uint32_t transfers_read = 0;
+    uint32_t resets = 0;
+    uint32_t set_features = 0;         // Set Feature commands for known reports
+
+private:
+    struct Transfer {
+        uint8_t channel;
+        uint8_t sequence;
+        std::vector<uint8_t> cargo;
+        size_t sent = 0;                // Cargo bytes already read
+        uint64_t reference_us = 0;      // Input: time the report delays count from
+        bool timebase = false;          // Cargo starts with a base timestamp reference
+        size_t first_sample = 0;        // Samples carried, as a range of history_
+        size_t samples = 0;
+    };
+
+    struct SensorState {
+        uint32_t interval_us = 0;
+        uint64_t next_us = 0;
+        uint8_t sequence = 0;
+    };
+
+    static bool timer_callback(repeating_timer_t* rt) {
+        static_cast<BNO08xModel*>(rt->user_data)->advance(now_us());
+        return true;
+    }
+
+    bool running() const { return !in_reset_ && boot_at_us_ == 0; }
+
+    static size_t sensor_index(uint8_t report_id) {
+        for (size_t i = 0; i < SENSORS.size(); ++i) {
+            if (SENSORS[i].report_id == report_id) return i;
+        }
+        return SENSORS.size();
+    }
+
+    uint8_t next_sequence(uint8_t channel) { return channel_sequence_[channel]++; }
+
+    void advance(uint64_t now) {
+        if (!get_gpio_output(rst_pin_)) {
+            enter_reset();
+            in_reset_ = true;
+            return;
+        }
+        if (reset_at_us != 0 && !reset_done_ && now >= reset_at_us) {
+            reset_done_ = true;
+            enter_reset();
+            boot_at_us_ = now + boot_us;
+        }
+        if (in_reset_) {
+            in_reset_ = false;
+            boot_at_us_ = now + boot_us;
+        }
+        if (boot_at_us_ != 0) {
+            if (now < boot_at_us_) return;
+            boot_at_us_ = 0;
+            resets++;
+            queue_transfer(CHANNEL_EXECUTABLE, {EXECUTABLE_RESET_COMPLETE});
+        }
+
+        emit_due_reports(now);
+        update_int(false);
+    }
+
+    void enter_reset() {
+        queue_.clear();
+        merging_ = false;
+        sensors_ = {};
+        channel_sequence_ = {};
+        if (int_low_) {
+            int_low_ = false;
+            set_gpio_input(int_pin_, true);
+        }
+    }
+
+    void set_feature(uint8_t report_id, uint32_t interval_us) {
+        const size_t i = sensor_index(report_id);
+        if (i == SENSORS.size()) return;
+        set_features++;
+        sensors_[i].interval_us = interval_us;
+        sensors_[i].next_us = now_us() + interval_us;
+    }
+
+    void send_product_ids() {
+        // Four 16-byte responses in one transfer
+        constexpr size_t RESPONSE_LEN = 16;
+        std::vector<uint8_t> cargo(4 * RESPONSE_LEN);
+        for (size_t entry = 0; entry < 4; ++entry) {
+            uint8_t* response = &cargo[entry * RESPONSE_LEN];
+            const uint32_t part = SOFTWARE_PART_NUMBER;
+            const uint32_t build = 100u + static_cast<uint32_t>(entry);
+            response[0] = REPORT_PROD_ID_RESPONSE;
+            response[2] = 3;            // Version 3.2
+            response[3] = 2;
+            std::memcpy(&response[4], &part, sizeof(part));
+            std::memcpy(&response[8], &build, sizeof(build));
+        }
+        queue_transfer(CHANNEL_CONTROL, std::move(cargo));
+        update_int(false);
+    }
+
+    void queue_transfer(uint8_t channel, std::vector<uint8_t> cargo) {
+        queue_.push_back(Transfer{channel, next_sequence(channel), std::move(cargo)});
+    }
+
+    // Reports due by `now` go out together behind one base timestamp reference
+    void emit_due_reports(uint64_t now) {
+        const bool merge = now >= merge_from_us && now < merge_to_us;
+        if (!merging_) {
+            pending_ = Transfer{CHANNEL_INPUT, 0, {REPORT_BASE_TIMESTAMP, 0, 0, 0, 0}};
+            pending_.timebase = true;
+            pending_.first_sample = history_.size();
+        }
+
+        for (;;) {
+            // Earliest due report first, so the delays stay in time order
+            size_t next = SENSORS.size();
+            for (size_t i = 0; i < SENSORS.size(); ++i) {
+                if (sensors_[i].interval_us == 0 || sensors_[i].next_us > now) continue;
+                if (next == SENSORS.size() || sensors_[i].next_us < sensors_[next].next_us) next = i;
+            }
+            if (next == SENSORS.size()) break;
+            append_report(next);
+        }
+
+        merging_ = merge && pending_.samples > 0;
+        if (merging_ || pending_.samples == 0) return;
+
+        input_transfers_++;
+        if (seq_gap_every && input_transfers_ % seq_gap_every == 0) next_sequence(CHANNEL_INPUT);
+        if (unknown_report_every && input_transfers_ % unknown_report_every == 0) hide_reports();
+
+        pending_.sequence = next_sequence(CHANNEL_INPUT);
+        for (size_t i = 0; i < pending_.samples; ++i) {
+            history_[pending_.first_sample + i].transfer_bytes = pending_.cargo.size() + HEADER_LEN;
+        }
+        queue_.push_back(std::move(pending_));
+    }
+
+    void append_report(size_t index) {
+        const Sensor& sensor = SENSORS[index];
+        SensorState& state = sensors_[index];
+        const uint64_t t_us = state.next_us;
+        state.next_us += state.interval_us;
+
+        if (pending_.samples == 0) pending_.reference_us = t_us;
+        const uint32_t delay = static_cast<uint32_t>((t_us - pending_.reference_us + 50) / 100);
+
+        Sample sample{sensor.report_id, state.sequence++, t_us, truth(sensor.report_id, t_us * 1e-6)};
+        std::array<uint8_t, 14> report{};
+        report[0] = sensor.report_id;
+        report[1] = sample.sequence;
+        report[2] = static_cast<uint8_t>(((delay >> 6) & 0xFC) | 0x03);     // High accuracy
+        report[3] = static_cast<uint8_t>(delay & 0xFF);
+        for (size_t v = 0; v < sensor.values; ++v) {
+            const int q = v == 4 ? 12 : sensor.q;
+            const auto raw = static_cast<int16_t>(
+                std::clamp(std::lround(sample.truth[v] * (1 << q)), -32768L, 32767L));
+            report[4 + 2 * v] = static_cast<uint8_t>(raw & 0xFF);
+            report[5 + 2 * v] = static_cast<uint8_t>(raw >> 8);
+        }
+        pending_.cargo.insert(pending_.cargo.end(), report.begin(), report.begin() + sensor.length);
+        history_.push_back(sample);
+        pending_.samples++;
+    }
+
+    // The host's parser stops at the unknown ID and drops what follows it
+    void hide_reports() {
+        pending_.cargo.insert(pending_.cargo.begin() + 5, REPORT_UNKNOWN);     // After the timebase
+        for (size_t i = 0; i < pending_.samples; ++i) history_[pending_.first_sample + i].hidden = true;
+    }
+
+    std::array<double, 5> truth(uint8_t report_id, double t) const {
+        if (report_id == REPORT_LINEAR_ACCELERATION) {
+            return {linear_accel[0](t), linear_accel[1](t), linear_accel[2](t)};
+        }
+        if (report_id == REPORT_GYROSCOPE) {
+            return {gyro[0](t), gyro[1](t), gyro[2](t)};
+        }
+        // ZYX Euler angles to a unit quaternion
+        const double cr = std::cos(roll(t) / 2), sr = std::sin(roll(t) / 2);
+        const double cp = std::cos(pitch(t) / 2), sp = std::sin(pitch(t) / 2);
+        const double cy = std::cos(yaw(t) / 2), sy = std::sin(yaw(t) / 2);
+        return {
+            sr * cp * cy - cr * sp * sy,
+            cr * sp * cy + sr * cp * sy,
+            cr * cp * sy - sr * sp * cy,
+            cr * cp * cy + sr * sp * sy,
+            rotation_accuracy,
+        };
+    }
+
+    // INT follows the queue; a consumed transfer releases it first, so the
+    // next one is a fresh falling edge the host can timestamp
+    void update_int(bool consumed) {
+        if (consumed && int_low_) {
+            int_low_ = false;
+            set_gpio_input(int_pin_, true);
+        }
+        if (int_low_ || queue_.empty()) return;
+
+        Transfer& head = queue_.front();
+        if (head.timebase && head.sent == 0) {
+            const uint64_t now = now_us();
+            const auto timebase = static_cast<uint32_t>((now - head.reference_us + 50) / 100);
+            std::memcpy(&head.cargo[1], &timebase, sizeof(timebase));
+        }
+        int_low_ = true;
+        set_gpio_input(int_pin_, false);
+    }
+
+    unsigned int int_pin_;
+    unsigned int rst_pin_;
+    repeating_timer_t timer_{};
+
+    bool in_reset_ = true;
+    bool reset_done_ = false;
+    uint64_t boot_at_us_ = 0;
+    bool int_low_ = false;
+
+    std::array<SensorState, SENSORS.size()> sensors_{};
+    std::array<uint8_t, 6> channel_sequence_{};
+    std::deque<Transfer> queue_;
+    Transfer pending_{};
+    bool merging_ = false;
+    uint32_t input_transfers_ = 0;
+    std::vector<Sample> history_;
+};
+
+} // namespace sim
@@ -0,0 +1,246 @@
+#pragma once
+
+/**
+ * @file icm20948_model.h
+ * @brief Register-level model of the ICM-20948 6-axis IMU (4 banks x 128 registers)
+ *
+ * Inputs: accel in m/s^2, gyro in rad/s, magnetic field in uT, temperature
+ * in degC. Raw counts follow the configured full-scale ranges in bank 2.
+ *
+ * The on-die AK09916 sits behind the internal I2C master: slave 4 single
+ * transfers execute immediately, and slave 0 reads are copied into
+ * EXT_SLV_SENS_DATA whenever the data registers are latched.
+ */
+
+#include "i2c_sim.h"
+#include "waveform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+
+class ICM20948Model : public DeviceModel {
+public:
+    static constexpr uint8_t DEFAULT_ADDRESS = 0x69;
+    static constexpr uint8_t WHO_AM_I_VALUE = 0xEA;
+
+    // Bank 0
+    static constexpr uint8_t REG_WHO_AM_I = 0x00;
+    static constexpr uint8_t REG_USER_CTRL = 0x03;
+    static constexpr uint8_t REG_PWR_MGMT_1 = 0x06;
+    static constexpr uint8_t REG_I2C_MST_STATUS = 0x17;
+    static constexpr uint8_t REG_ACCEL_XOUT_H = 0x2D;
+    static constexpr uint8_t REG_TEMP_OUT_H = 0x39;
+    static constexpr uint8_t REG_EXT_SLV_SENS_DATA_00 = 0x3B;
+    static constexpr uint8_t EXT_SLV_SENS_DATA_LEN = 24;
+    // Bank 2
+    static constexpr uint8_t REG_GYRO_CONFIG_1 = 0x01;
+    static constexpr uint8_t REG_ACCEL_CONFIG = 0x14;
+    // Bank 3
+    static constexpr uint8_t REG_I2C_SLV0_ADDR = 0x03;
+    static constexpr uint8_t REG_I2C_SLV0_REG = 0x04;
+    static constexpr uint8_t REG_I2C_SLV0_CTRL = 0x05;
+    static constexpr uint8_t REG_I2C_SLV4_ADDR = 0x13;
+    static constexpr uint8_t REG_I2C_SLV4_REG = 0x14;
+    static constexpr uint8_t REG_I2C_SLV4_CTRL = 0x15;
+    static constexpr uint8_t REG_I2C_SLV4_DO = 0x16;
+    static constexpr uint8_t REG_I2C_SLV4_DI = 0x17;
+    // All banks
+    static constexpr uint8_t REG_BANK_SEL = 0x7F;
+
+    static constexpr double GRAVITY = 9.80665;
+    static constexpr double RAD_TO_DEG = 57.29577951308232;
+    static constexpr double TEMP_SENSITIVITY = 333.87;
+    static constexpr double MAG_UT_PER_LSB = 0.15;
+
+    static constexpr uint8_t AK09916_ADDRESS = 0x0C;
+
+    std::array<Waveform, 3> accel{Waveform::constant(0.0), Waveform::constant(0.0), Waveform::constant(GRAVITY)};
+    std::array<Waveform, 3> gyro{};
+    std::array<Waveform, 3> mag{Waveform::constant(20.0), Waveform::constant(0.0), Waveform::constant(-40.0)};
+    bool mag_present = true;
+    Waveform temperature = Waveform::constant(25.0);
+
+    explicit ICM20948Model(uint8_t address = DEFAULT_ADDRESS) : DeviceModel(address) {
+        reset_registers();
+    }
+
+    const char* name() const override { return "ICM20948"; }
+
+    bool on_write(const uint8_t* data, size_t len) override {
+        if (len == 0) return true;
+        pointer_ = data[0];
+        for (size_t i = 1; i < len; ++i) {
+            write_register(pointer_++, data[i]);
+        }
+        return true;
+    }
+
+    bool on_read(uint8_t* data, size_t len) override {
+        if (bank() == 0 && pointer_ < REG_EXT_SLV_SENS_DATA_00 + EXT_SLV_SENS_DATA_LEN &&
+            pointer_ + len > REG_ACCEL_XOUT_H) {
+            latch_samples();
+        }
+        for (size_t i = 0; i < len; ++i) {
+            data[i] = read_register(pointer_++);
+        }
+        return true;
+    }
+
+    void tick(uint64_t now_us) override { now_us_ = now_us; }
+
+protected:
+    uint8_t bank() const { return (banks_[0][REG_BANK_SEL & 0x7F] >> 4) & 0x03; }
+
+    uint8_t& reg(uint8_t bank_index, uint8_t address) { return banks_[bank_index][address & 0x7F]; }
+
+    virtual void write_register(uint8_t address, uint8_t value) {
+        if ((address & 0x7F) == REG_BANK_SEL) {
+            for (auto& b : banks_) b[REG_BANK_SEL] = value & 0x30;
+            return;
+        }
+        if (bank() == 0 && address == REG_PWR_MGMT_1 && (value & 0x80)) {
+            reset_registers();
+            return;
+        }
+        if (bank() == 0 && address == REG_WHO_AM_I) {
+            return;  // Read-only
+        }
+        if (bank() == 0 && address == REG_USER_CTRL) {
+            value &= ~0x02;  // I2C_MST_RST self-clears
+        }
+        reg(bank(), address) = value;
+
+        if (bank() == 3 && address == REG_I2C_SLV4_CTRL && (value & 0x80)) {
+            run_slv4();
+        }
+    }
+
+    virtual uint8_t read_register(uint8_t address) {
+        uint8_t value = reg(bank(), address);
+        if (bank() == 0 && address == REG_I2C_MST_STATUS) {
+            reg(0, REG_I2C_MST_STATUS) = 0;  // Clear on read
+        }
+        return value;
+    }
+
+    virtual void reset_registers() {
+        for (auto& b : banks_) b.fill(0);
+        reg(0, REG_WHO_AM_I) = WHO_AM_I_VALUE;
+        reg(0, REG_PWR_MGMT_1) = 0x41;  // Sleep + auto clock
+        ak_reset();
+    }
+
+    // ------------------------------------------------------------------------
+    // AK09916 behind the internal I2C master
+    // ------------------------------------------------------------------------
+    bool master_enabled() { return reg(0, REG_USER_CTRL) & 0x20; }
+
+    void ak_reset() {
+        ak_.fill(0);
+        ak_[0x00] = 0x48;   // WIA1
+        ak_[0x01] = 0x09;   // WIA2
+    }
+
+    void ak_write(uint8_t address, uint8_t value) {
+        if (address == 0x32 && (value & 0x01)) {
+            ak_reset();
+        } else if (address == 0x31) {
+            ak_[address] = value & 0x1F;
+        }
+    }
+
+    void ak_convert() {
+        if (ak_[0x31] == 0) {
+            return;  // Power-down
+        }
+        const double t = now_us_ * 1e-6;
+        bool overflow = false;
+        for (int axis = 0; axis < 3; ++axis) {
+            long counts = std::lround(mag[axis](t) / MAG_UT_PER_LSB);
+            if (counts > 32752 || counts < -32752) {
+                overflow = true;
+                counts = std::clamp(counts, -32752L, 32752L);
+            }
+            auto raw = static_cast<uint16_t>(static_cast<int16_t>(counts));
+            ak_[0x11 + axis * 2] = static_cast<uint8_t>(raw & 0xFF);
+            ak_[0x12 + axis * 2] = static_cast<uint8_t>(raw >> 8);
+        }
+        ak_[0x10] = 0x01;                   // ST1: DRDY
+        ak_[0x18] = overflow ? 0x08 : 0x00; // ST2: HOFL
+    }
+
+    void run_slv4() {
+        const uint8_t address = reg(3, REG_I2C_SLV4_ADDR);
+        reg(3, REG_I2C_SLV4_CTRL) &= ~0x80;
+
+        if (!master_enabled() || !mag_present || (address & 0x7F) != AK09916_ADDRESS) {
+            reg(0, REG_I2C_MST_STATUS) |= 0x40 | 0x10;  // DONE | NACK
+            return;
+        }
+        const uint8_t target = reg(3, REG_I2C_SLV4_REG);
+        if (address & 0x80) {
+            reg(3, REG_I2C_SLV4_DI) = ak_[target];
+        } else {
+            ak_write(target, reg(3, REG_I2C_SLV4_DO));
+        }
+        reg(0, REG_I2C_MST_STATUS) |= 0x40;
+    }
+
+    void run_slv0() {
+        const uint8_t ctrl = reg(3, REG_I2C_SLV0_CTRL);
+        const uint8_t address = reg(3, REG_I2C_SLV0_ADDR);
+        if (!master_enabled() || !mag_present || !(ctrl & 0x80) || address != (0x80 | AK09916_ADDRESS)) {
+            return;
+        }
+        ak_convert();
+        const uint8_t start = reg(3, REG_I2C_SLV0_REG);
+        const uint8_t len = ctrl & 0x0F;
+        for (uint8_t i = 0; i < len && i < EXT_SLV_SENS_DATA_LEN; ++i) {
+            reg(0, REG_EXT_SLV_SENS_DATA_00 + i) = ak_[static_cast<uint8_t>(start + i)];
+        }
+    }
+
+    bool sleeping() { return reg(0, REG_PWR_MGMT_1) & 0x40; }
+
+    double accel_lsb_per_mps2() {
+        uint8_t fs = (reg(2, REG_ACCEL_CONFIG) >> 1) & 0x03;
+        return 16384.0 / static_cast<double>(1 << fs) / GRAVITY;
+    }
+
+    double gyro_lsb_per_rads() {
+        uint8_t fs = (reg(2, REG_GYRO_CONFIG_1) >> 1) & 0x03;
+        return 131.0 / static_cast<double>(1 << fs) * RAD_TO_DEG;
+    }
+
+    static void put_be16(uint8_t* dst, double counts) {
+        auto raw = static_cast<int16_t>(std::clamp(std::lround(counts), -32768L, 32767L));
+        dst[0] = static_cast<uint8_t>(static_cast<uint16_t>(raw) >> 8);
+        dst[1] = static_cast<uint8_t>(raw & 0xFF);
+    }
+
+    virtual void latch_samples() {
+        uint8_t* out = &banks_[0][REG_ACCEL_XOUT_H];
+        if (sleeping()) {
+            std::fill(out, out + 14, 0);
+            return;
+        }
+        const double t = now_us_ * 1e-6;
+        const double a_lsb = accel_lsb_per_mps2();
+        const double g_lsb = gyro_lsb_per_rads();
+        for (int axis = 0; axis < 3; ++axis) {
+            put_be16(out + axis * 2, accel[axis](t) * a_lsb);
+            put_be16(out + 6 + axis * 2, gyro[axis](t) * g_lsb);
+        }
+        put_be16(out + 12, (temperature(t) - 21.0) * TEMP_SENSITIVITY);
+        run_slv0();
+    }
+
+    std::array<std::array<uint8_t, 128>, 4> banks_{};
+    std::array<uint8_t, 256> ak_{};
+    uint8_t pointer_ = 0;
+    uint64_t now_us_ = 0;
+};
+
+} // namespace sim
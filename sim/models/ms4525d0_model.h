@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file ms4525d0_model.h
+ * @brief Model of the MS4525DO-DS5A1 (+/-5 inH2O) differential pressure sensor
+ *
+ * The device has no registers: every read returns [status|P13:8][P7:0]
+ * [T10:3][T2:0|xxxxx]. Reading faster than the conversion period returns
+ * the previous sample with the STALE status bits set.
+ */
+
+#include "i2c_sim.h"
+#include "waveform.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+
+class MS4525D0Model : public DeviceModel {
+public:
+    static constexpr uint8_t DEFAULT_ADDRESS = 0x58;
+
+    static constexpr uint8_t STATUS_NORMAL = 0x00;
+    static constexpr uint8_t STATUS_STALE = 0x80;
+    static constexpr uint8_t STATUS_FAULT = 0xC0;
+
+    static constexpr double INH2O_TO_PA = 249.089;
+
+    Waveform differential_pressure = Waveform::constant(0.0);   // Pa
+    Waveform temperature = Waveform::constant(20.0);            // degC
+
+    uint32_t conversion_period_us = 500;
+    bool force_fault = false;
+
+    explicit MS4525D0Model(uint8_t address = DEFAULT_ADDRESS) : DeviceModel(address) {}
+
+    const char* name() const override { return "MS4525D0"; }
+
+    bool on_write(const uint8_t*, size_t) override { return true; }
+
+    bool on_read(uint8_t* data, size_t len) override {
+        const uint64_t sample_us = (now_us_ / conversion_period_us) * conversion_period_us;
+        uint8_t status = STATUS_NORMAL;
+
+        if (sample_us != last_read_sample_us_) {
+            last_read_sample_us_ = sample_us;
+            convert(sample_us * 1e-6);
+        } else {
+            status = STATUS_STALE;
+        }
+        if (force_fault) {
+            status = STATUS_FAULT;
+        }
+
+        uint8_t frame[4] = {
+            static_cast<uint8_t>(status | ((pressure_counts_ >> 8) & 0x3F)),
+            static_cast<uint8_t>(pressure_counts_ & 0xFF),
+            static_cast<uint8_t>(temperature_counts_ >> 3),
+            static_cast<uint8_t>((temperature_counts_ & 0x07) << 5),
+        };
+        std::copy_n(frame, std::min<size_t>(len, 4), data);
+        return true;
+    }
+
+    void tick(uint64_t now_us) override { now_us_ = now_us; }
+
+private:
+    void convert(double t) {
+        const double p_inh2o = differential_pressure(t) / INH2O_TO_PA;
+        const double counts = 0.1 * 16383.0 + (p_inh2o + 5.0) / 10.0 * 0.8 * 16383.0;
+        pressure_counts_ = static_cast<uint16_t>(std::clamp(std::lround(counts), 0L, 16383L));
+
+        const double t_counts = (temperature(t) + 50.0) * 2047.0 / 200.0;
+        temperature_counts_ = static_cast<uint16_t>(std::clamp(std::lround(t_counts), 0L, 2047L));
+    }
+
+    uint64_t now_us_ = 0;
+    uint64_t last_read_sample_us_ = UINT64_MAX;
+    uint16_t pressure_counts_ = 0;
+    uint16_t temperature_counts_ = 0;
+};
+
+} // namespace sim
@@ -0,0 +1,820 @@
+#include "uart_sim.h"
+
+#include "adc_sim.h"
+#include "i2c_sim.h"
+
+#include "pico/multicore.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "hardware/uart.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+uart_inst_t uart0_inst{{}, 0};
+uart_inst_t uart1_inst{{}, 1};
+
+namespace {
+
+dma_hw_t g_dma_registers{};
+
+} // anonymous namespace
+
+dma_hw_t* const dma_hw = &g_dma_registers;
+
+namespace sim::uart {
+
+namespace {
+
+constexpr size_t UART_FIFO_DEPTH = 32;
+constexpr unsigned int DMA_IRQ_COUNT = 4;
+constexpr uint64_t BITS_PER_CHARACTER = 10;     // 8N1
+
+struct Channel {
+    bool claimed = false;
+    bool busy = false;
+    dma_channel_config config{};
+    uint32_t reload = 0;            // TRANS_COUNT written by the last configure/trigger
+};
+
+struct Port {
+    uint32_t baud = 0;
+    std::deque<uint8_t> rx_fifo;
+};
+
+std::array<Channel, NUM_DMA_CHANNELS> g_channels{};
+std::array<uint32_t, DMA_IRQ_COUNT> g_irq_enabled{};
+std::array<uint32_t, DMA_IRQ_COUNT> g_irq_status{};
+std::array<bool, DMA_IRQ_COUNT> g_irq_pending{};
+std::array<Port, 2> g_ports{};
+uart_inst_t* g_active = &uart0_inst;
+bool g_pumping = false;
+
+int g_sniff_channel = -1;
+uint32_t g_sniff_data = 0;
+
+uint32_t g_doorbells_claimed = 0;
+std::array<uint32_t, 2> g_doorbells{};
+
+uint64_t g_tx_line_ns = 0;          // When the byte on the TX line finishes
+std::vector<uint8_t> g_tx_current;
+std::vector<Frame> g_tx_frames;
+LineStats g_stats{};
+std::mt19937 g_noise{0x55415254u};
+
+uart_inst_t* uart_at(uintptr_t addr) {
+    for (uart_inst_t* inst : {uart0, uart1}) {
+        if (addr == reinterpret_cast<uintptr_t>(&inst->hw.dr)) {
+            return inst;
+        }
+    }
+    return nullptr;
+}
+
+bool writes_uart(unsigned int ch) { return uart_at(dma_hw->ch[ch].write_addr) != nullptr; }
+
+uint64_t byte_ns() {
+    const uint32_t baud = g_ports[g_active->index].baud;
+    return baud ? BITS_PER_CHARACTER * 1'000'000'000ull / baud : 0;
+}
+
+void trigger(unsigned int ch) {
+    Channel& channel = g_channels[ch];
+    dma_hw->ch[ch].transfer_count = channel.reload;
+    channel.busy = channel.reload > 0;
+    if (channel.busy && writes_uart(ch)) {
+        g_tx_line_ns = std::max(g_tx_line_ns, sim::now_us() * 1000);
+        uart_hw_t& hw = uart_at(dma_hw->ch[ch].write_addr)->hw;
+        hw.fr = hw.fr | UART_UARTFR_BUSY_BITS;
+    }
+}
+
+void complete(unsigned int ch) {
+    Channel& channel = g_channels[ch];
+    channel.busy = false;
+
+    if (uart_inst_t* inst = uart_at(dma_hw->ch[ch].write_addr)) {
+        inst->hw.fr = inst->hw.fr & ~UART_UARTFR_BUSY_BITS;
+        g_tx_frames.push_back(Frame{std::move(g_tx_current), g_ports[inst->index].baud});
+        g_tx_current.clear();
+        g_stats.tx_frames++;
+    }
+
+    for (unsigned int i = 0; i < DMA_IRQ_COUNT; ++i) {
+        if (g_irq_enabled[i] & (1u << ch)) {
+            g_irq_status[i] |= 1u << ch;
+            g_irq_pending[i] = true;
+        }
+    }
+    if (channel.config.chain_to != ch) {
+        trigger(channel.config.chain_to);
+    }
+}
+
+// Moves one element; returns false if the source has nothing to give
+bool transfer_one(unsigned int ch) {
+    Channel& channel = g_channels[ch];
+    dma_channel_hw_t& hw = dma_hw->ch[ch];
+    const size_t size = size_t{1} << channel.config.transfer_size;
+
+    uint32_t value = 0;
+    if (uart_inst_t* inst = uart_at(hw.read_addr)) {
+        auto& fifo = g_ports[inst->index].rx_fifo;
+        if (fifo.empty()) {
+            return false;
+        }
+        value = fifo.front();
+        fifo.pop_front();
+    } else if (sim::adc::is_fifo(hw.read_addr)) {
+        if (!sim::adc::take_fifo(value)) {
+            return false;
+        }
+    } else {
+        std::memcpy(&value, reinterpret_cast<const void*>(hw.read_addr), size);
+    }
+
+    if (static_cast<int>(ch) == g_sniff_channel && channel.config.sniff) {
+        for (size_t b = 0; b < size; ++b) {
+            g_sniff_data ^= ((value >> (8 * b)) & 0xFFu) << 8;
+            for (int bit = 0; bit < 8; ++bit) {
+                g_sniff_data = (g_sniff_data & 0x8000u) ? (g_sniff_data << 1) ^ 0x1021u : g_sniff_data << 1;
+            }
+            g_sniff_data &= 0xFFFFu;
+        }
+    }
+
+    if (uart_at(hw.write_addr)) {
+        g_tx_current.push_back(static_cast<uint8_t>(value));
+        g_stats.tx_bytes++;
+    } else {
+        std::memcpy(reinterpret_cast<void*>(hw.write_addr), &value, size);
+        for (unsigned int k = 0; k < NUM_DMA_CHANNELS; ++k) {
+            if (hw.write_addr == reinterpret_cast<uintptr_t>(&dma_hw->ch[k].al1_transfer_count_trig)) {
+                g_channels[k].reload = value;
+                trigger(k);
+            }
+        }
+    }
+
+    if (channel.config.read_increment) {
+        hw.read_addr = hw.read_addr + size;
+    }
+    if (channel.config.write_increment) {
+        uintptr_t next = hw.write_addr + size;
+        if (channel.config.ring_write && channel.config.ring_bits) {
+            const uintptr_t mask = (uintptr_t{1} << channel.config.ring_bits) - 1;
+            next = (hw.write_addr & ~mask) | (next & mask);
+        }
+        hw.write_addr = next;
+    }
+
+    hw.transfer_count = hw.transfer_count - 1;
+    if (hw.transfer_count == 0) {
+        complete(ch);
+    }
+    return true;
+}
+
+// Runs every channel not feeding a UART as far as its source allows, then
+// the IRQs that raised.
+// Channels started from inside an IRQ handler are picked up by the same loop.
+void pump() {
+    if (g_pumping) {
+        return;
+    }
+    g_pumping = true;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (unsigned int ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+            while (g_channels[ch].busy && !writes_uart(ch) && transfer_one(ch)) {
+                progress = true;
+            }
+        }
+        for (unsigned int i = 0; i < DMA_IRQ_COUNT; ++i) {
+            if (g_irq_pending[i]) {
+                g_irq_pending[i] = false;
+                sim::raise_irq(DMA_IRQ_0 + i);
+                progress = true;
+            }
+        }
+    }
+    g_pumping = false;
+}
+
+int busy_tx_channel() {
+    for (unsigned int ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+        if (g_channels[ch].busy && writes_uart(ch)) {
+            return static_cast<int>(ch);
+        }
+    }
+    return -1;
+}
+
+void deliver_doorbells() {
+    if (g_doorbells[0] || g_doorbells[1]) {
+        sim::raise_irq(SIO_IRQ_BELL);
+    }
+}
+
+void advance_to_ns(uint64_t ns) {
+    const uint64_t target_us = ns / 1000;
+    if (target_us > sim::now_us()) {
+        sim::run_for(target_us - sim::now_us());
+    }
+}
+
+} // anonymous namespace
+
+void reset() {
+    g_dma_registers = dma_hw_t{};
+    g_channels.fill(Channel{});
+    g_irq_enabled.fill(0);
+    g_irq_status.fill(0);
+    g_irq_pending.fill(false);
+    g_ports.fill(Port{});
+    uart0_inst.hw = uart_hw_t{};
+    uart1_inst.hw = uart_hw_t{};
+    g_active = uart0;
+    g_pumping = false;
+    g_sniff_channel = -1;
+    g_sniff_data = 0;
+    g_doorbells_claimed = 0;
+    g_doorbells.fill(0);
+    g_tx_line_ns = 0;
+    g_tx_current.clear();
+    g_tx_frames.clear();
+    g_stats = LineStats{};
+    g_noise.seed(0x55415254u);
+}
+
+void run(uint64_t duration_us) {
+    const uint64_t end_ns = (sim::now_us() + duration_us) * 1000;
+    deliver_doorbells();
+
+    for (int ch = busy_tx_channel(); ch >= 0 && byte_ns() > 0; ch = busy_tx_channel()) {
+        const uint64_t done_ns = g_tx_line_ns + byte_ns();
+        if (done_ns > end_ns) {
+            break;
+        }
+        g_stats.tx_busy_us += (done_ns / 1000) - (g_tx_line_ns / 1000);
+        g_tx_line_ns = done_ns;
+        advance_to_ns(done_ns);
+
+        transfer_one(static_cast<unsigned int>(ch));
+        pump();
+        deliver_doorbells();
+    }
+
+    advance_to_ns(end_ns);
+    deliver_doorbells();
+}
+
+void pump_dma() { pump(); }
+
+bool tx_busy() { return busy_tx_channel() >= 0; }
+
+std::vector<Frame> take_tx() {
+    std::vector<Frame> frames;
+    frames.swap(g_tx_frames);
+    return frames;
+}
+
+void receive(std::span<const uint8_t> bytes, uint32_t baud) {
+    Port& line = g_ports[g_active->index];
+    g_stats.rx_bytes += bytes.size();
+
+    // The FIFO only overflows when no RX DMA channel is draining it
+    auto push = [&](uint8_t byte) {
+        line.rx_fifo.push_back(byte);
+        pump();
+        if (line.rx_fifo.size() > UART_FIFO_DEPTH) {
+            line.rx_fifo.pop_back();
+            g_stats.rx_overruns++;
+        }
+    };
+
+    if (baud == line.baud) {
+        for (uint8_t byte : bytes) {
+            push(byte);
+        }
+        return;
+    }
+
+    // Wrong rate: the receiver samples a different number of characters
+    const size_t count = line.baud ? bytes.size() * line.baud / baud : 0;
+    g_stats.rx_garbled += count;
+    for (size_t i = 0; i < count; ++i) {
+        push(static_cast<uint8_t>(g_noise()));
+    }
+}
+
+uint32_t baud_rate() { return g_ports[g_active->index].baud; }
+
+LineStats stats() { return g_stats; }
+
+void mute_stdout(bool mute) {
+    static int saved = -1;
+    std::fflush(stdout);
+    if (mute && saved < 0) {
+        saved = ::dup(STDOUT_FILENO);
+        const int null = ::open("/dev/null", O_WRONLY);
+        ::dup2(null, STDOUT_FILENO);
+        ::close(null);
+    } else if (!mute && saved >= 0) {
+        ::dup2(saved, STDOUT_FILENO);
+        ::close(saved);
+        saved = -1;
+    }
+}
+
+// ============================================================================
+// PEER PROCESS
+// ============================================================================
+namespace {
+
+enum class Command : uint8_t {
+    Step = 1,
+    Stop = 2,
+};
+
+// Pipe ends, board ID and rand seed for a program started as a peer
+constexpr const char* PEER_ENV = "SIM_UART_PEER";
+
+bool read_all(int fd, void* data, size_t length) {
+    auto* p = static_cast<uint8_t*>(data);
+    while (length > 0) {
+        const ssize_t n = ::read(fd, p, length);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool write_all(int fd, const void* data, size_t length) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        const ssize_t n = ::write(fd, p, length);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool write_frames(int fd, const std::vector<Frame>& frames) {
+    const uint32_t count = static_cast<uint32_t>(frames.size());
+    if (!write_all(fd, &count, sizeof(count))) {
+        return false;
+    }
+    for (const Frame& frame : frames) {
+        const uint32_t header[2] = {frame.baud, static_cast<uint32_t>(frame.bytes.size())};
+        if (!write_all(fd, header, sizeof(header)) || !write_all(fd, frame.bytes.data(), frame.bytes.size())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool read_frames(int fd, std::vector<Frame>& frames) {
+    uint32_t count = 0;
+    if (!read_all(fd, &count, sizeof(count))) {
+        return false;
+    }
+    frames.resize(count);
+    for (Frame& frame : frames) {
+        uint32_t header[2];
+        if (!read_all(fd, header, sizeof(header))) {
+            return false;
+        }
+        frame.baud = header[0];
+        frame.bytes.resize(header[1]);
+        if (!read_all(fd, frame.bytes.data(), frame.bytes.size())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+[[noreturn]] void child_main(const PeerProcess::Hooks& hooks, int in, int out) {
+    if (hooks.setup) {
+        hooks.setup();
+    }
+
+    int code = 0;
+    for (;;) {
+        Command command;
+        if (!read_all(in, &command, sizeof(command)) || command == Command::Stop) {
+            break;
+        }
+        uint64_t duration_us = 0;
+        std::vector<Frame> incoming;
+        if (!read_all(in, &duration_us, sizeof(duration_us)) || !read_frames(in, incoming)) {
+            break;
+        }
+        for (const Frame& frame : incoming) {
+            receive(frame.bytes, frame.baud);
+        }
+        if (hooks.step) {
+            hooks.step();
+        }
+        run(duration_us);
+        if (!write_frames(out, take_tx())) {
+            break;
+        }
+    }
+
+    if (hooks.report) {
+        code = hooks.report();
+    }
+    std::fflush(stdout);
+    ::_exit(code);
+}
+
+} // anonymous namespace
+
+int run_isolated(const std::function<int()>& body) {
+    std::fflush(stdout);
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        sim::reset();
+        reset();
+        mute_stdout(true);
+        const int code = body();
+        mute_stdout(false);
+        std::fflush(stdout);
+        ::_exit(code);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+PeerProcess::~PeerProcess() {
+    kill();
+}
+
+bool PeerProcess::start(const Hooks& hooks, uint64_t board_id, uint64_t rand_seed) {
+    return spawn([&](int in, int out) {
+        sim::reset();
+        reset();
+        sim::set_board_id(board_id);
+        sim::seed_rand(rand_seed);
+        child_main(hooks, in, out);
+    });
+}
+
+bool PeerProcess::start_program(const std::vector<std::string>& argv, uint64_t board_id, uint64_t rand_seed) {
+    if (argv.empty()) {
+        return false;
+    }
+    return spawn([&](int in, int out) {
+        char peer[96];
+        std::snprintf(peer, sizeof(peer), "%d,%d,%llu,%llu", in, out, static_cast<unsigned long long>(board_id),
+                      static_cast<unsigned long long>(rand_seed));
+        ::setenv(PEER_ENV, peer, 1);
+        std::vector<char*> args;
+        for (const std::string& arg : argv) {
+            args.push_back(const_cast<char*>(arg.c_str()));
+        }
+        args.push_back(nullptr);
+        ::execv(args[0], args.data());
+        std::perror(args[0]);
+        ::_exit(127);
+    });
+}
+
+bool PeerProcess::spawn(const std::function<void(int in, int out)>& child) {
+    kill();
+
+    int down[2];
+    int up[2];
+    if (::pipe(down) != 0 || ::pipe(up) != 0) {
+        return false;
+    }
+
+    std::fflush(stdout);
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        ::close(down[1]);
+        ::close(up[0]);
+        child(down[0], up[1]);
+        ::_exit(127);
+    }
+
+    ::close(down[0]);
+    ::close(up[1]);
+    pid_ = pid;
+    to_child_ = down[1];
+    from_child_ = up[0];
+    return true;
+}
+
+bool PeerProcess::step(const std::vector<Frame>& incoming, uint64_t duration_us, std::vector<Frame>& outgoing) {
+    outgoing.clear();
+    if (pid_ <= 0) {
+        return false;
+    }
+    const Command command = Command::Step;
+    return write_all(to_child_, &command, sizeof(command)) &&
+           write_all(to_child_, &duration_us, sizeof(duration_us)) &&
+           write_frames(to_child_, incoming) &&
+           read_frames(from_child_, outgoing);
+}
+
+void PeerProcess::kill() {
+    if (pid_ <= 0) {
+        return;
+    }
+    ::kill(pid_, SIGKILL);
+    ::waitpid(pid_, nullptr, 0);
+    ::close(to_child_);
+    ::close(from_child_);
+    pid_ = -1;
+}
+
+int PeerProcess::stop() {
+    if (pid_ <= 0) {
+        return -1;
+    }
+    const Command command = Command::Stop;
+    write_all(to_child_, &command, sizeof(command));
+    int status = 0;
+    ::waitpid(pid_, &status, 0);
+    ::close(to_child_);
+    ::close(from_child_);
+    pid_ = -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+bool peer_requested() {
+    return std::getenv(PEER_ENV) != nullptr;
+}
+
+void serve_peer(const PeerProcess::Hooks& hooks) {
+    int in = -1;
+    int out = -1;
+    unsigned long long board_id = 0;
+    unsigned long long rand_seed = 0;
+    const char* peer = std::getenv(PEER_ENV);
+    if (!peer || std::sscanf(peer, "%d,%d,%llu,%llu", &in, &out, &board_id, &rand_seed) != 4) {
+        ::_exit(127);
+    }
+    ::unsetenv(PEER_ENV);
+    sim::reset();
+    reset();
+    sim::set_board_id(board_id);
+    sim::seed_rand(rand_seed);
+    child_main(hooks, in, out);
+}
+
+void Line::carry(std::vector<Frame>& frames, uint64_t step, const LineFaults& faults, std::vector<Frame>& out) {
+    out.clear();
+    // A cut loses everything sent; frames held back earlier still arrive
+    const size_t sent = faults.cut ? 0 : frames.size();
+    for (size_t i = 0; i < sent; ++i) {
+        Frame& frame = frames[i];
+        if (last_baud_ && frame.baud != last_baud_) {
+            baud_changed_step_ = step;
+        }
+        last_baud_ = frame.baud;
+
+        if (faults.loss > 0.0 && std::bernoulli_distribution(faults.loss)(rng_)) {
+            continue;
+        }
+        if (faults.ber > 0.0 && frame.baud > faults.clean_up_to) {
+            std::geometric_distribution<uint64_t> gap(faults.ber);
+            for (uint64_t bit = gap(rng_); bit < frame.bytes.size() * 8; bit += 1 + gap(rng_)) {
+                frame.bytes[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+            }
+        }
+        if (faults.duplicate > 0.0 && std::bernoulli_distribution(faults.duplicate)(rng_)) {
+            held_.push_back({step + 1, frame});
+        }
+        if (faults.reorder > 0.0 && std::bernoulli_distribution(faults.reorder)(rng_)) {
+            held_.push_back({step + 1 + rng_() % 4, std::move(frame)});
+            continue;
+        }
+        out.push_back(std::move(frame));
+    }
+
+    for (auto it = held_.begin(); it != held_.end();) {
+        if (it->due <= step) {
+            out.push_back(std::move(it->frame));
+            it = held_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void* map_shared_file(const char* path, size_t size) {
+    const int fd = ::open(path, O_RDWR);
+    if (fd < 0) {
+        return nullptr;
+    }
+    void* shared = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    return shared == MAP_FAILED ? nullptr : shared;
+}
+
+std::string sibling_program(const std::string& self, const std::string& suffix) {
+    if (self.size() > suffix.size() && self.compare(self.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        return self.substr(0, self.size() - suffix.size());
+    }
+    return self + suffix;
+}
+
+} // namespace sim::uart
+
+// ============================================================================
+// PICO SDK SHIMS
+// ============================================================================
+using sim::uart::g_channels;
+
+unsigned int uart_init(uart_inst_t* uart, unsigned int baudrate) {
+    sim::uart::g_active = uart;
+    uart->hw = uart_hw_t{};
+    sim::uart::g_ports[uart->index] = sim::uart::Port{baudrate, {}};
+    return baudrate;
+}
+
+void uart_deinit(uart_inst_t* uart) {
+    sim::uart::g_ports[uart->index] = sim::uart::Port{};
+}
+
+unsigned int uart_set_baudrate(uart_inst_t* uart, unsigned int baudrate) {
+    sim::uart::g_ports[uart->index].baud = baudrate;
+    return baudrate;
+}
+
+void uart_set_hw_flow(uart_inst_t* /*uart*/, bool /*cts*/, bool /*rts*/) {}
+void uart_set_format(uart_inst_t* /*uart*/, unsigned int /*data_bits*/, unsigned int /*stop_bits*/, uart_parity_t /*parity*/) {}
+void uart_set_fifo_enabled(uart_inst_t* /*uart*/, bool /*enabled*/) {}
+
+bool uart_is_readable(uart_inst_t* uart) {
+    return !sim::uart::g_ports[uart->index].rx_fifo.empty();
+}
+
+char uart_getc(uart_inst_t* uart) {
+    auto& fifo = sim::uart::g_ports[uart->index].rx_fifo;
+    if (fifo.empty()) {
+        return 0;
+    }
+    const uint8_t byte = fifo.front();
+    fifo.pop_front();
+    return static_cast<char>(byte);
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (unsigned int ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+        if (!g_channels[ch].claimed) {
+            g_channels[ch].claimed = true;
+            return static_cast<int>(ch);
+        }
+    }
+    if (required) {
+        std::fprintf(stderr, "sim: no free DMA channel\n");
+        std::abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(unsigned int channel) {
+    g_channels[channel] = sim::uart::Channel{};
+}
+
+dma_channel_config dma_channel_get_default_config(unsigned int channel) {
+    dma_channel_config config{};
+    config.transfer_size = DMA_SIZE_32;
+    config.dreq = DREQ_FORCE;
+    config.chain_to = channel;
+    config.read_increment = true;
+    config.write_increment = false;
+    config.enable = true;
+    return config;
+}
+
+void dma_channel_configure(unsigned int channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, unsigned int transfer_count, bool trigger) {
+    g_channels[channel].config = *config;
+    g_channels[channel].reload = transfer_count;
+    dma_hw->ch[channel].write_addr = reinterpret_cast<uintptr_t>(write_addr);
+    dma_hw->ch[channel].read_addr = reinterpret_cast<uintptr_t>(read_addr);
+    dma_hw->ch[channel].transfer_count = transfer_count;
+    if (trigger) {
+        dma_channel_start(channel);
+    }
+}
+
+void dma_channel_start(unsigned int channel) {
+    sim::uart::trigger(channel);
+    sim::uart::pump();
+}
+
+void dma_channel_abort(unsigned int channel) {
+    g_channels[channel].busy = false;
+}
+
+bool dma_channel_is_busy(unsigned int channel) {
+    return g_channels[channel].busy;
+}
+
+void dma_channel_wait_for_finish_blocking(unsigned int channel) {
+    if (g_channels[channel].busy && sim::uart::writes_uart(channel)) {
+        while (g_channels[channel].busy) {
+            sim::uart::run(1);
+        }
+    }
+}
+
+void dma_channel_transfer_from_buffer_now(unsigned int channel, const volatile void* read_addr, uint32_t transfer_count) {
+    dma_hw->ch[channel].read_addr = reinterpret_cast<uintptr_t>(read_addr);
+    g_channels[channel].reload = transfer_count;
+    dma_channel_start(channel);
+}
+
+dma_channel_hw_t* dma_channel_hw_addr(unsigned int channel) {
+    return &dma_hw->ch[channel];
+}
+
+void dma_irqn_set_channel_enabled(unsigned int irq_index, unsigned int channel, bool enabled) {
+    auto& mask = sim::uart::g_irq_enabled[irq_index];
+    mask = enabled ? (mask | (1u << channel)) : (mask & ~(1u << channel));
+}
+
+bool dma_irqn_get_channel_status(unsigned int irq_index, unsigned int channel) {
+    return sim::uart::g_irq_status[irq_index] & (1u << channel);
+}
+
+void dma_irqn_acknowledge_channel(unsigned int irq_index, unsigned int channel) {
+    sim::uart::g_irq_status[irq_index] &= ~(1u << channel);
+}
+
+void dma_sniffer_enable(unsigned int channel, unsigned int /*mode*/, bool /*force_channel_enable*/) {
+    sim::uart::g_sniff_channel = static_cast<int>(channel);
+}
+
+void dma_sniffer_disable() {
+    sim::uart::g_sniff_channel = -1;
+}
+
+void dma_sniffer_set_data_accumulator(uint32_t seed) {
+    sim::uart::g_sniff_data = seed;
+}
+
+uint32_t dma_sniffer_get_data_accumulator() {
+    return sim::uart::g_sniff_data;
+}
+
+int multicore_doorbell_claim_unused(unsigned int /*core_mask*/, bool required) {
+    for (unsigned int bell = 0; bell < NUM_DOORBELLS; ++bell) {
+        if (!(sim::uart::g_doorbells_claimed & (1u << bell))) {
+            sim::uart::g_doorbells_claimed |= 1u << bell;
+            return static_cast<int>(bell);
+        }
+    }
+    if (required) {
+        std::fprintf(stderr, "sim: no free doorbell\n");
+        std::abort();
+    }
+    return -1;
+}
+
+void multicore_doorbell_unclaim(unsigned int doorbell_num, unsigned int /*core_mask*/) {
+    sim::uart::g_doorbells_claimed &= ~(1u << doorbell_num);
+}
+
+void multicore_doorbell_set_other_core(unsigned int doorbell_num) {
+    sim::uart::g_doorbells[get_core_num() ^ 1u] |= 1u << doorbell_num;
+}
+
+void multicore_doorbell_clear_current_core(unsigned int doorbell_num) {
+    sim::uart::g_doorbells[get_core_num() & 1u] &= ~(1u << doorbell_num);
+}
+
+bool multicore_doorbell_is_set_current_core(unsigned int doorbell_num) {
+    return sim::uart::g_doorbells[get_core_num() & 1u] & (1u << doorbell_num);
+}
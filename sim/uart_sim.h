@@ -0,0 +1,212 @@
+#pragma once
+
+/**
+ * @file uart_sim.h
+ * @brief Host-side UART and DMA model for running FTL off-target
+ *
+ * Backs the hardware/uart.h, hardware/dma.h and pico/multicore.h shims in
+ * sim/include/ so ftl/ runs unmodified on the host:
+ * - Memory-to-memory DMA (the CRC sniffer) completes inside the call that
+ *   starts it. Ring wrap, chaining and writes to another channel's alias-1
+ *   count trigger behave as on the RP2350, so the RX ring reload runs as is.
+ * - RX channels take bytes from the UART as receive() delivers them.
+ * - TX channels feed the line at the UART's baud rate (8N1) only while run()
+ *   advances virtual time; completion IRQs fire from there, so frame
+ *   chaining and line utilisation can be measured.
+ * - Every finished TX DMA transfer is captured as one Frame, tagged with the
+ *   baud rate it went out at, for a bench to pass on (or lose, corrupt,
+ *   reorder) to the other end.
+ * - Doorbells rung by one core raise SIO_IRQ_BELL on the other at the next
+ *   run() step.
+ *
+ * FTL keeps its state in globals, so one host process is one FTL node. A
+ * two-node bench forks a process per node and carries frames between them
+ * (see PeerProcess below). A node built with other compile-time settings
+ * runs as a separate program speaking the same pipe protocol.
+ *
+ * Example Usage:
+ *
+ *   ftl::initialize();
+ *   ftl::send_msg(std::string_view("hello"));
+ *   ftl::poll();
+ *   sim::uart::run(1000);                     // 1 ms on the wire
+ *   for (auto& frame : sim::uart::take_tx()) {
+ *       sim::uart::receive(frame.bytes, frame.baud);   // loop back
+ *   }
+ *   ftl::poll();                              // ftl::has_msg() is now true
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sim::uart {
+
+struct Frame {
+    std::vector<uint8_t> bytes;
+    uint32_t baud;
+};
+
+struct LineStats {
+    uint64_t tx_bytes = 0;
+    uint32_t tx_frames = 0;
+    uint64_t tx_busy_us = 0;        // Time with a byte on the TX line
+    uint64_t rx_bytes = 0;
+    uint64_t rx_garbled = 0;        // Bytes received at the wrong baud rate
+    uint64_t rx_overruns = 0;       // Bytes lost with no RX DMA draining the FIFO
+};
+
+// Release every DMA channel and doorbell, clear both UARTs, the captured
+// frames and the counters. Call before ftl::initialize() (after sim::reset()).
+void reset();
+
+// Advance virtual time by `duration_us`, moving TX bytes at line rate and
+// delivering completion IRQs and pending doorbells as it goes.
+void run(uint64_t duration_us);
+
+// Move everything DMA channels not feeding a UART can move now and deliver
+// the IRQs they raise. Other peripheral models call this after filling a FIFO
+// a channel reads (see adc_sim.h).
+void pump_dma();
+
+// True while a TX transfer is in flight.
+bool tx_busy();
+
+// Frames whose TX transfer finished since the last call, oldest first.
+std::vector<Frame> take_tx();
+
+// Bytes arriving on the RX pin, sent at `baud`. At any other rate than the
+// UART's own they arrive as the wrong number of garbage bytes.
+void receive(std::span<const uint8_t> bytes, uint32_t baud);
+
+// Baud rate of the UART the code under test initialised last.
+uint32_t baud_rate();
+
+LineStats stats();
+
+// FTL reports through printf. Benches mute stdout while the code under test
+// runs so it stays out of their tables.
+void mute_stdout(bool mute);
+
+// Run `body` in a forked child, after sim::reset() and reset(), with stdout
+// muted until `body` returns; wait for it and return its exit code. FTL
+// cannot be reinitialised, so each configuration a bench compares runs in a
+// process of its own. `body` prints its results after calling
+// mute_stdout(false).
+int run_isolated(const std::function<int()>& body);
+
+/**
+ * @brief One FTL node in a forked child process, stepped in lockstep
+ *
+ * The child runs `setup` once, then on every step() receives the frames
+ * passed in, calls `step` and advances virtual time, and sends back the
+ * frames it transmitted. `report` runs when the child is stopped and its
+ * output goes to the parent's stdout; its return value becomes the child's
+ * exit code. Fork before anything in the parent touches FTL, so every
+ * child starts from a clean process image.
+ */
+class PeerProcess {
+public:
+    struct Hooks {
+        std::function<void()> setup;
+        std::function<void()> step;
+        std::function<int()> report;
+    };
+
+    PeerProcess() = default;
+    ~PeerProcess();
+
+    PeerProcess(const PeerProcess&) = delete;
+    PeerProcess& operator=(const PeerProcess&) = delete;
+
+    // Fork a fresh child (stopping any previous one first). `board_id` and
+    // `rand_seed` set the node's source ID and reliable epoch.
+    bool start(const Hooks& hooks, uint64_t board_id, uint64_t rand_seed);
+
+    // As start(), but the child runs another program, typically the same
+    // bench built against different ftl.settings. That program must call
+    // serve_peer() when peer_requested() says so.
+    bool start_program(const std::vector<std::string>& argv, uint64_t board_id, uint64_t rand_seed);
+
+    // Deliver `incoming`, run the child for `duration_us` and collect what
+    // it sent. Returns false if the child has died.
+    bool step(const std::vector<Frame>& incoming, uint64_t duration_us, std::vector<Frame>& outgoing);
+
+    // Kill the child without a report, as a power cut would.
+    void kill();
+
+    // Ask the child to report and exit; returns its exit code (-1 on failure).
+    int stop();
+
+    bool running() const { return pid_ > 0; }
+
+private:
+    bool spawn(const std::function<void(int in, int out)>& child);
+
+    int pid_ = -1;
+    int to_child_ = -1;
+    int from_child_ = -1;
+};
+
+// Faults a Line applies to the frames it carries
+struct LineFaults {
+    double loss = 0.0;                  // Per frame
+    double duplicate = 0.0;             // Per frame; the copy arrives a step later
+    double reorder = 0.0;               // Per frame; held back 1..4 steps
+    uint32_t clean_up_to = UINT32_MAX;  // Frames sent faster than this see `ber`
+    double ber = 0.0;
+    bool cut = false;                   // Everything sent this step is lost
+};
+
+/**
+ * @brief One direction of the line between two PeerProcess nodes
+ *
+ * A bench passes the frames one node sent in a step through carry(), which
+ * applies `faults` and returns what reaches the other node in that step:
+ * the frames that got through, plus any held back earlier that are now due.
+ * Each Line draws from its own generator, so a case repeats for a seed.
+ */
+class Line {
+public:
+    explicit Line(uint32_t seed) : rng_(seed) {}
+
+    void carry(std::vector<Frame>& frames, uint64_t step, const LineFaults& faults, std::vector<Frame>& out);
+
+    // Step at which a frame last went out at another baud rate than the one
+    // before it (0 if the rate never changed)
+    uint64_t baud_changed_step() const { return baud_changed_step_; }
+
+private:
+    struct Held {
+        uint64_t due;
+        Frame frame;
+    };
+
+    std::mt19937_64 rng_;
+    std::deque<Held> held_;
+    uint32_t last_baud_ = 0;
+    uint64_t baud_changed_step_ = 0;
+};
+
+// True in a program started by PeerProcess::start_program()
+bool peer_requested();
+
+// Serve as that peer: reset the model, take the board ID and seed the
+// parent passed, and step `hooks` until stopped. Does not return.
+[[noreturn]] void serve_peer(const PeerProcess::Hooks& hooks);
+
+// Map `size` bytes of the file at `path` shared, so nodes can write counters
+// the bench reads; a file, so a node started with start_program() can map it
+// by the path it was passed. Returns nullptr on failure.
+void* map_shared_file(const char* path, size_t size);
+
+// The same bench built with a feature flag the other way: `self` with
+// `suffix` removed if it ends in it, added otherwise.
+std::string sibling_program(const std::string& self, const std::string& suffix = "_on");
+
+} // namespace sim::uart
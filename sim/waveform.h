@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file waveform.h
+ * @brief Scripted and recorded signal sources that feed the sensor models
+ *
+ * A Waveform maps virtual time (seconds) to a physical value in the unit the
+ * consuming model documents (m/s^2, rad/s, Pa, degC, V...).
+ *
+ * Example Usage:
+ *
+ *   auto vibration = sim::Waveform::sine(0.5, 120.0, 9.81).with_noise(0.02);
+ *   auto flight = sim::Waveform::from_csv("flight_042.csv", 3);  // column 3
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace sim {
+
+class Waveform {
+public:
+    using Function = std::function<double(double)>;
+
+    Waveform() : fn_([](double) { return 0.0; }) {}
+    explicit Waveform(Function fn) : fn_(std::move(fn)) {}
+
+    double operator()(double t_s) const { return fn_(t_s); }
+
+    static Waveform constant(double value) {
+        return Waveform([value](double) { return value; });
+    }
+
+    static Waveform sine(double amplitude, double frequency_hz, double offset = 0.0, double phase = 0.0) {
+        return Waveform([=](double t) {
+            return offset + amplitude * std::sin(2.0 * M_PI * frequency_hz * t + phase);
+        });
+    }
+
+    static Waveform ramp(double start, double slope_per_s) {
+        return Waveform([=](double t) { return start + slope_per_s * t; });
+    }
+
+    // Piecewise-constant steps: value of the last step whose time has passed.
+    static Waveform steps(std::vector<std::pair<double, double>> points) {
+        return Waveform([points = std::move(points)](double t) {
+            double value = points.empty() ? 0.0 : points.front().second;
+            for (const auto& [time_s, v] : points) {
+                if (t < time_s) break;
+                value = v;
+            }
+            return value;
+        });
+    }
+
+    /**
+     * @brief Load a recorded trace from CSV
+     *
+     * Column 0 is time in seconds, `column` is the value. Lines that do not
+     * parse (headers, comments) are skipped. Values are linearly interpolated
+     * and the trace loops when `loop` is set.
+     */
+    static Waveform from_csv(const char* path, int column, bool loop = true) {
+        auto samples = std::make_shared<std::vector<std::pair<double, double>>>();
+
+        if (FILE* file = std::fopen(path, "r")) {
+            char line[512];
+            while (std::fgets(line, sizeof(line), file)) {
+                double fields[16];
+                int count = 0;
+                char* cursor = line;
+                while (count < 16) {
+                    char* end = nullptr;
+                    fields[count] = std::strtod(cursor, &end);
+                    if (end == cursor) break;
+                    count++;
+                    cursor = end;
+                    while (*cursor == ',' || *cursor == ' ' || *cursor == '\t') cursor++;
+                }
+                if (count > column) {
+                    samples->emplace_back(fields[0], fields[column]);
+                }
+            }
+            std::fclose(file);
+        } else {
+            std::fprintf(stderr, "Waveform: Failed to open %s\n", path);
+        }
+
+        return Waveform([samples, loop](double t) {
+            if (samples->empty()) return 0.0;
+            const double t0 = samples->front().first;
+            const double span = samples->back().first - t0;
+            if (loop && span > 0.0) {
+                t = t0 + std::fmod(t - t0, span);
+            }
+            auto it = std::lower_bound(samples->begin(), samples->end(), t,
+                [](const auto& s, double v) { return s.first < v; });
+            if (it == samples->begin()) return it->second;
+            if (it == samples->end()) return samples->back().second;
+            auto prev = it - 1;
+            double f = (t - prev->first) / (it->first - prev->first);
+            return prev->second + f * (it->second - prev->second);
+        });
+    }
+
+    // Add zero-mean Gaussian noise with standard deviation `sigma`.
+    Waveform with_noise(double sigma, uint32_t seed = 1) const {
+        auto rng = std::make_shared<std::mt19937>(seed);
+        return Waveform([fn = fn_, rng, sigma](double t) {
+            std::normal_distribution<double> noise(0.0, sigma);
+            return fn(t) + noise(*rng);
+        });
+    }
+
+    Waveform operator+(const Waveform& other) const {
+        return Waveform([a = fn_, b = other.fn_](double t) { return a(t) + b(t); });
+    }
+
+private:
+    Function fn_;
+};
+
+} // namespace sim